@@ -0,0 +1,114 @@
+// This example measures the throughput of the inference with a shared model
+// using multiple threads. Each thread builds its own computation graph on the
+// same frozen parameters, and the number of processed samples per second is
+// reported for each number of threads.
+//
+// Usage:
+// $ ./concurrent_inference [max_threads] [num_batches]
+//
+// Compile:
+// g++
+//   -std=c++11
+//   -I/path/to/primitiv/includes (typically -I../..)
+//   -L/path/to/primitiv/libs     (typically -L../../build/primitiv)
+//   concurrent_inference.cc -lprimitiv -lpthread
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <primitiv/primitiv.h>
+
+using namespace std;
+using namespace primitiv;
+namespace F = primitiv::functions;
+namespace I = primitiv::initializers;
+
+namespace {
+
+const unsigned NUM_INPUT_UNITS = 256;
+const unsigned NUM_HIDDEN_UNITS = 512;
+const unsigned NUM_OUTPUT_UNITS = 10;
+const unsigned BATCH_SIZE = 32;
+
+// 2-layer perceptron.
+class MLP : public Model {
+  Parameter pw1_, pb1_, pw2_, pb2_;
+
+public:
+  MLP() {
+    add("pw1", pw1_);
+    add("pb1", pb1_);
+    add("pw2", pw2_);
+    add("pb2", pb2_);
+    pw1_.init({NUM_HIDDEN_UNITS, NUM_INPUT_UNITS}, I::XavierUniform());
+    pb1_.init({NUM_HIDDEN_UNITS}, I::Constant(0));
+    pw2_.init({NUM_OUTPUT_UNITS, NUM_HIDDEN_UNITS}, I::XavierUniform());
+    pb2_.init({NUM_OUTPUT_UNITS}, I::Constant(0));
+  }
+
+  // Calculates the output scores. The graph of the current thread is used.
+  Node operator()(const Node &x) {
+    const Node w1 = F::parameter<Node>(pw1_);
+    const Node b1 = F::parameter<Node>(pb1_);
+    const Node w2 = F::parameter<Node>(pw2_);
+    const Node b2 = F::parameter<Node>(pb2_);
+    const Node h = F::relu(F::matmul(w1, x) + b1);
+    return F::matmul(w2, h) + b2;
+  }
+};
+
+// Runs `num_batches` inferences on the current thread.
+void run(MLP &model, const vector<float> &inputs, unsigned num_batches) {
+  Graph g;
+  Graph::set_thread_default(g);
+  for (unsigned i = 0; i < num_batches; ++i) {
+    g.clear();
+    const Node x = F::input<Node>(
+        Shape({NUM_INPUT_UNITS}, BATCH_SIZE), inputs);
+    const vector<uint32_t> y = model(x).argmax(0);
+    static_cast<void>(y);
+  }
+  Graph::reset_thread_default();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const unsigned max_threads = argc > 1
+    ? atoi(argv[1]) : max(1u, thread::hardware_concurrency());
+  const unsigned num_batches = argc > 2 ? atoi(argv[2]) : 200;
+
+  devices::Naive dev;
+  Device::set_default(dev);
+
+  // The model is only read by the inference, and gradients are not required.
+  MLP model;
+  model.freeze();
+
+  vector<float> inputs(NUM_INPUT_UNITS * BATCH_SIZE);
+  for (unsigned i = 0; i < inputs.size(); ++i) {
+    inputs[i] = static_cast<float>(i % 17) / 17 - .5;
+  }
+
+  for (unsigned num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    const auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t) {
+      threads.emplace_back(
+          run, std::ref(model), std::cref(inputs), num_batches);
+    }
+    for (thread &th : threads) th.join();
+    const double elapsed = chrono::duration<double>(
+        chrono::steady_clock::now() - start).count();
+
+    const double samples = 1. * num_threads * num_batches * BATCH_SIZE;
+    cout << "threads=" << num_threads
+         << " time=" << elapsed << "s"
+         << " throughput=" << samples / elapsed << " samples/s" << endl;
+  }
+
+  return 0;
+}
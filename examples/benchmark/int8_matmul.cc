@@ -0,0 +1,83 @@
+// This example measures the speed of the matrix multiplication with int8
+// weights. The same weights are multiplied in the single precision and as
+// quantized int8 values, and the elapsed time of each multiplication is
+// reported with the relative error of the int8 results.
+//
+// Usage:
+// $ ./int8_matmul [num_rows] [num_columns] [batch_size] [num_iterations]
+//
+// Compile:
+// g++
+//   -std=c++11
+//   -I/path/to/primitiv/includes (typically -I../..)
+//   -L/path/to/primitiv/libs     (typically -L../../build/primitiv)
+//   int8_matmul.cc -lprimitiv
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <primitiv/primitiv.h>
+
+using namespace std;
+using namespace primitiv;
+
+namespace {
+
+// Returns the average elapsed time of `y = w . x` in seconds.
+double measure(
+    Device &dev, const Tensor &w, const Tensor &x, unsigned num_iterations,
+    vector<float> &result) {
+  // Warms up the device before measuring.
+  result = dev.matmul_fw(w, x).to_vector();
+  const auto start = chrono::steady_clock::now();
+  for (unsigned i = 0; i < num_iterations; ++i) {
+    const Tensor y = dev.matmul_fw(w, x);
+    static_cast<void>(y);
+  }
+  return chrono::duration<double>(
+      chrono::steady_clock::now() - start).count() / num_iterations;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const unsigned num_rows = argc > 1 ? atoi(argv[1]) : 1024;
+  const unsigned num_columns = argc > 2 ? atoi(argv[2]) : 1024;
+  const unsigned batch_size = argc > 3 ? atoi(argv[3]) : 32;
+  const unsigned num_iterations = argc > 4 ? atoi(argv[4]) : 100;
+
+  devices::Eigen dev;
+
+  mt19937 rng(12345);
+  normal_distribution<float> dist(0, 1);
+  vector<float> w_data(num_rows * num_columns);
+  vector<float> x_data(num_columns * batch_size);
+  for (float &v : w_data) v = dist(rng);
+  for (float &v : x_data) v = dist(rng);
+
+  const Tensor w = dev.new_tensor_by_vector({num_rows, num_columns}, w_data);
+  const Tensor qw = dev.copy_tensor(w, Precision::INT8);
+  const Tensor x = dev.new_tensor_by_vector(
+      {num_columns, batch_size}, x_data);
+
+  vector<float> expected, actual;
+  const double float_time = measure(dev, w, x, num_iterations, expected);
+  const double int8_time = measure(dev, qw, x, num_iterations, actual);
+
+  double num = 0, den = 0;
+  for (unsigned i = 0; i < expected.size(); ++i) {
+    num += (expected[i] - actual[i]) * (expected[i] - actual[i]);
+    den += expected[i] * expected[i];
+  }
+
+  cout << "float32: " << float_time * 1e3 << "ms" << endl;
+  cout << "int8:    " << int8_time * 1e3 << "ms"
+       << " (x" << float_time / int8_time << ")" << endl;
+  cout << "relative error: " << sqrt(num / den) << endl;
+
+  return 0;
+}
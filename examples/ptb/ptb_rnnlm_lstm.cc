@@ -97,7 +97,14 @@ public:
   }
 
   // Forward one step.
+  // Internal states of finished sentences are dropped when the batch size of
+  // `x` becomes smaller than the previous step.
   Var forward(const Var &x) {
+    const unsigned n = x.shape().batch();
+    if (h_.shape().batch() > n) {
+      h_ = F::batch::slice(h_, 0, n);
+      c_ = F::batch::slice(c_, 0, n);
+    }
     const Var u = F::matmul(w_, F::concat({x, h_}, 0)) + b_;
     const std::vector<Var> v = F::split(u, 0, 4);
     const Var i = F::sigmoid(v[0]);
@@ -129,22 +136,20 @@ public:
       add("hy", hy_);
     }
 
-  // Forward function of RNNLM. Input data should be arranged below:
-  // inputs = {
-  //   {sent1_word1, sent2_word1, ..., sentN_word1},  // 1st input (<bos>)
-  //   {sent1_word2, sent2_word2, ..., sentN_word2},  // 2nd input/1st output
-  //   ...,
-  //   {sent1_wordM, sent2_wordM, ..., sentN_wordM},  // last output (<eos>)
-  // };
-  vector<Var> forward(const vector<vector<unsigned>> &inputs, bool train) {
-    Var lookup = F::parameter<Var>(plookup_);
+  // Forward function of RNNLM. Sentences in `seq` are packed without
+  // paddings, and the t-th output predicts `seq.ids(t + 1)`, i.e., only
+  // sentences which have the next word are calculated.
+  vector<Var> forward(const PackedSequence &seq, bool train) {
     rnn1_.init();
     rnn2_.init();
     hy_.init();
 
     vector<Var> outputs;
-    for (unsigned i = 0; i < inputs.size() - 1; ++i) {
-      Var x = F::pick(lookup, inputs[i], 1);
+    for (unsigned t = 0; t < seq.max_length() - 1; ++t) {
+      const vector<unsigned> &ids = seq.ids(t);
+      const vector<unsigned> inputs(
+          ids.begin(), ids.begin() + seq.batch_size(t + 1));
+      Var x = F::pick_parameter<Var>(plookup_, inputs, 1);
       x = F::dropout(x, DROPOUT_RATE, train);
       Var h1 = rnn1_.forward(x);
       h1 = F::dropout(h1, DROPOUT_RATE, train);
@@ -156,14 +161,14 @@ public:
   }
 
   // Loss function.
-  Var loss(
-      const vector<Var> &outputs, const vector<vector<unsigned>> &inputs) {
+  // Sums losses of all words and divides by the number of sentences.
+  Var loss(const vector<Var> &outputs, const PackedSequence &seq) {
     vector<Var> losses;
-    for (unsigned i = 0; i < outputs.size(); ++i) {
-      losses.emplace_back(
-          F::softmax_cross_entropy(outputs[i], inputs[i + 1], 0));
+    for (unsigned t = 0; t < outputs.size(); ++t) {
+      losses.emplace_back(F::batch::sum(
+            F::softmax_cross_entropy(outputs[t], seq.ids(t + 1), 0)));
     }
-    return F::batch::mean(F::sum(losses));
+    return F::sum(losses) / seq.num_sequences();
   }
 };
 
@@ -173,7 +178,6 @@ int main() {
   // Loads vocab.
   const auto vocab = utils::make_vocab("data/ptb.train.txt");
   cout << "#vocab: " << vocab.size() << endl;  // maybe 10000
-  const unsigned eos_id = vocab.at("<s>");
 
   // Loads all corpus.
   const auto train_corpus = utils::load_corpus("data/ptb.train.txt", vocab);
@@ -201,42 +205,33 @@ int main() {
   optimizer.set_gradient_clipping(5);
   optimizer.add(lm);
 
-  // Batch randomizer.
+  // Minibatch loaders. Sentences with similar lengths are packed together,
+  // and following minibatches are prepared on background threads.
   random_device rd;
-  mt19937 rng(rd());
-
-  // Sentence IDs.
-  vector<unsigned> train_ids(num_train_sents);
-  vector<unsigned> valid_ids(num_valid_sents);
-  iota(begin(train_ids), end(train_ids), 0);
-  iota(begin(valid_ids), end(valid_ids), 0);
+  DataLoader train_loader(train_corpus, BATCH_SIZE, 4, true, rd());
+  DataLoader valid_loader(valid_corpus, BATCH_SIZE, 4, false, 0);
+  DataLoader::Batch batch;
 
   float best_valid_ppl = 1e10;
 
   // Train/valid loop.
   for (unsigned epoch = 0; epoch < MAX_EPOCH; ++epoch) {
     cout << "epoch " << (epoch + 1) << '/' << MAX_EPOCH << ':' << endl;
-    // Shuffles train sentence IDs.
-    shuffle(begin(train_ids), end(train_ids), rng);
 
     // Training.
     float train_loss = 0;
-    for (unsigned ofs = 0; ofs < num_train_sents; ofs += BATCH_SIZE) {
-      const vector<unsigned> batch_ids(
-          begin(train_ids) + ofs,
-          begin(train_ids) + std::min<unsigned>(
-            ofs + BATCH_SIZE, num_train_sents));
-      const auto batch = utils::make_batch(train_corpus, batch_ids, eos_id);
-
+    unsigned ofs = 0;
+    while (train_loader.next(batch)) {
       g.clear();
-      const auto outputs = lm.forward(batch, true);
-      const auto loss = lm.loss(outputs, batch);
-      train_loss += loss.to_float() * batch_ids.size();
+      const auto outputs = lm.forward(batch.sequences, true);
+      const auto loss = lm.loss(outputs, batch.sequences);
+      train_loss += loss.to_float() * batch.indices.size();
 
       optimizer.reset_gradients();
       loss.backward();
       optimizer.update();
 
+      ofs += batch.indices.size();
       cout << ofs << '\r' << flush;
     }
 
@@ -245,18 +240,14 @@ int main() {
 
     // Validation.
     float valid_loss = 0;
-    for (unsigned ofs = 0; ofs < num_valid_sents; ofs += BATCH_SIZE) {
-      const vector<unsigned> batch_ids(
-          begin(valid_ids) + ofs,
-          begin(valid_ids) + std::min<unsigned>(
-            ofs + BATCH_SIZE, num_valid_sents));
-      const auto batch = utils::make_batch(valid_corpus, batch_ids, eos_id);
-
+    ofs = 0;
+    while (valid_loader.next(batch)) {
       g.clear();
-      const auto outputs = lm.forward(batch, false);
-      const auto loss = lm.loss(outputs, batch);
-      valid_loss += loss.to_float() * batch_ids.size();
+      const auto outputs = lm.forward(batch.sequences, false);
+      const auto loss = lm.loss(outputs, batch.sequences);
+      valid_loss += loss.to_float() * batch.indices.size();
 
+      ofs += batch.indices.size();
       cout << ofs << '\r' << flush;
     }
 
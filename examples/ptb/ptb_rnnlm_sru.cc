@@ -144,15 +144,15 @@ public:
   //   {sent1_wordM, sent2_wordM, ..., sentN_wordM},  // last output (<eos>)
   // };
   vector<Var> forward(const vector<vector<unsigned>> &inputs, bool train) {
-    Var lookup = F::parameter<Var>(plookup_);
     rnn1_.init();
     rnn2_.init();
     hy_.init();
 
     vector<Var> xs;
     for (unsigned i = 0; i < inputs.size() - 1; ++i) {
-      xs.emplace_back(
-          F::dropout(F::pick(lookup, inputs[i], 1), DROPOUT_RATE, train));
+      xs.emplace_back(F::dropout(
+            F::pick_parameter<Var>(plookup_, inputs[i], 1),
+            DROPOUT_RATE, train));
     }
     vector<Var> hs1 = rnn1_.forward(xs);
     for (unsigned i = 0; i < inputs.size() - 1; ++i) {
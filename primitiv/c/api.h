@@ -7,6 +7,7 @@
 #include <primitiv/c/initializer_impl.h>
 #include <primitiv/c/model.h>
 #include <primitiv/c/functions.h>
+#include <primitiv/c/operator_records.h>
 #include <primitiv/c/parameter.h>
 #include <primitiv/c/shape.h>
 #include <primitiv/c/status.h>
@@ -20,6 +20,17 @@ PRIMITIV_C_STATUS primitivSetDefaultDevice(primitivDevice_t *device) try {
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
+PRIMITIV_C_STATUS primitivSetThreadDefaultDevice(primitivDevice_t *device) try {
+  PRIMITIV_C_CHECK_NOT_NULL(device);
+  Device::set_thread_default(*to_cpp_ptr(device));
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivResetThreadDefaultDevice() try {
+  Device::reset_thread_default();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
 PRIMITIV_C_STATUS primitivDeleteDevice(primitivDevice_t *device) try {
   PRIMITIV_C_CHECK_NOT_NULL(device);
   delete to_cpp_ptr(device);
@@ -26,6 +26,23 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetDefaultDevice(
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivSetDefaultDevice(
     primitivDevice_t *device);
 
+/**
+ * Specifies a new default device of the current thread.
+ * @param device Pointer of the new default device.
+ * @return Status code.
+ * @remarks The device overrides the global default device only in the current
+ *          thread.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivSetThreadDefaultDevice(
+    primitivDevice_t *device);
+
+/**
+ * Unregisters the default device of the current thread, so that the global
+ * default device is used again in the current thread.
+ * @return Status code.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivResetThreadDefaultDevice();
+
 /**
  * Deletes the Device object.
  * @param device Pointer of a handler.
@@ -0,0 +1,67 @@
+#ifndef PRIMITIV_C_DLPACK_H_
+#define PRIMITIV_C_DLPACK_H_
+
+#include <primitiv/c/define.h>
+
+/*
+ * Descriptors to exchange tensors with other libraries without copying.
+ * Each structure has the same memory layout as that of the DLPack
+ * specification, and pointers to them can be casted to/from pointers of
+ * corresponding DLPack structures (e.g., `DLManagedTensor *`).
+ */
+
+/**
+ * `device_type` of the host memory.
+ */
+#define PRIMITIV_C_DLPACK_DEVICE_CPU 1
+
+/**
+ * `code` of floating point numbers.
+ */
+#define PRIMITIV_C_DLPACK_TYPE_FLOAT 2
+
+/**
+ * Location of the memory.
+ */
+typedef struct primitivDLDevice {
+  int32_t device_type;
+  int32_t device_id;
+} primitivDLDevice_t;
+
+/**
+ * Type of each element.
+ */
+typedef struct primitivDLDataType {
+  uint8_t code;
+  uint8_t bits;
+  uint16_t lanes;
+} primitivDLDataType_t;
+
+/**
+ * Unmanaged descriptor of a tensor.
+ * `shape` and `strides` have `ndim` elements, and `strides` is counted by the
+ * number of elements. A null `strides` represents the compact row-major
+ * order.
+ */
+typedef struct primitivDLTensor {
+  void *data;
+  primitivDLDevice_t device;
+  int32_t ndim;
+  primitivDLDataType_t dtype;
+  int64_t *shape;
+  int64_t *strides;
+  uint64_t byte_offset;
+} primitivDLTensor_t;
+
+/**
+ * Descriptor of a tensor with its owner.
+ * The consumer of this object should call `deleter(self)` exactly once when
+ * the memory is no longer used.
+ */
+typedef struct primitivDLManagedTensor {
+  primitivDLTensor_t dl_tensor;
+  void *manager_ctx;
+  void (*deleter)(struct primitivDLManagedTensor *self);
+} primitivDLManagedTensor_t;
+
+#endif  // PRIMITIV_C_DLPACK_H_
@@ -1,5 +1,6 @@
 #include <primitiv/config.h>
 
+#include <memory>
 #include <vector>
 
 #include <primitiv/core/functions.h>
@@ -128,6 +129,55 @@ PRIMITIV_C_STATUS primitivApplyTensorInput(
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
+namespace {
+
+// Wraps an external array by a shared pointer with the release callback.
+std::shared_ptr<float> wrap_shared_input(
+    float *data, primitivReleaseCallback_t release, void *user_data) {
+  return std::shared_ptr<float>(data, [release, user_data](float *p) {
+      if (release) release(p, user_data);
+  });
+}
+
+// Checks the size of the external array.
+void check_shared_input_size(const primitiv::Shape &shape, std::size_t n) {
+  if (n != shape.size()) {
+    PRIMITIV_THROW_ERROR(
+        "Data sizes mismatched. required: " << shape.size()
+        << " (shape: " << shape.to_string() << ") != actual: " << n);
+  }
+}
+
+}  // namespace
+
+PRIMITIV_C_STATUS primitivApplyNodeSharedInput(
+    const primitivShape_t *shape, float *data, size_t n,
+    primitivReleaseCallback_t release, void *user_data,
+    primitivDevice_t *dev, primitivGraph_t *g, primitivNode_t **newobj) try {
+  const auto shared = ::wrap_shared_input(data, release, user_data);
+  PRIMITIV_C_CHECK_NOT_NULL(shape);
+  PRIMITIV_C_CHECK_NOT_NULL(data);
+  PRIMITIV_C_CHECK_NOT_NULL(newobj);
+  ::check_shared_input_size(*to_cpp_ptr(shape), n);
+  *newobj = to_c_ptr_from_value(primitiv::functions::shared_input_node(
+      *to_cpp_ptr(shape), shared, to_cpp_ptr(dev), to_cpp_ptr(g)));
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivApplyTensorSharedInput(
+    const primitivShape_t *shape, float *data, size_t n,
+    primitivReleaseCallback_t release, void *user_data,
+    primitivDevice_t *dev, primitivTensor_t **newobj) try {
+  const auto shared = ::wrap_shared_input(data, release, user_data);
+  PRIMITIV_C_CHECK_NOT_NULL(shape);
+  PRIMITIV_C_CHECK_NOT_NULL(data);
+  PRIMITIV_C_CHECK_NOT_NULL(newobj);
+  ::check_shared_input_size(*to_cpp_ptr(shape), n);
+  *newobj = to_c_ptr_from_value(primitiv::functions::shared_input_tensor(
+      *to_cpp_ptr(shape), shared, to_cpp_ptr(dev)));
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
 PRIMITIV_C_STATUS primitivApplyNodeParameter(
     primitivParameter_t *param, primitivGraph_t *g,
     primitivNode_t **newobj) try {
@@ -54,6 +54,22 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivApplyTensorInput(
     const primitivShape_t *shape, const float *data, size_t n,
     primitivDevice_t *dev, primitivTensor_t **newobj);
 
+/*
+ * Callback to release an external array given to primitivApply*SharedInput.
+ * `data` is the array and `user_data` is the value given with the array.
+ * The callback is called exactly once, even if the function fails.
+ */
+typedef void (*primitivReleaseCallback_t)(float *data, void *user_data);
+
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivApplyNodeSharedInput(
+    const primitivShape_t *shape, float *data, size_t n,
+    primitivReleaseCallback_t release, void *user_data,
+    primitivDevice_t *dev, primitivGraph_t *g, primitivNode_t **newobj);
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivApplyTensorSharedInput(
+    const primitivShape_t *shape, float *data, size_t n,
+    primitivReleaseCallback_t release, void *user_data,
+    primitivDevice_t *dev, primitivTensor_t **newobj);
+
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivApplyNodeParameter(
     primitivParameter_t *param, primitivGraph_t *g, primitivNode_t **newobj);
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivApplyTensorParameter(
@@ -98,6 +98,28 @@ PRIMITIV_C_STATUS primitivEvaluateNodeAsArray(
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
+PRIMITIV_C_STATUS primitivCopyNodeToArray(
+    const primitivNode_t *node, float *buffer, size_t size) try {
+  PRIMITIV_C_CHECK_NOT_NULL(node);
+  PRIMITIV_C_CHECK_NOT_NULL(buffer);
+  const Node &x = *to_cpp_ptr(node);
+  primitiv::c::internal::copy_tensor_to_array(
+      x.graph().forward(x), buffer, size);
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivGetNodeData(
+    const primitivNode_t *node, const float **retval, size_t *size) try {
+  PRIMITIV_C_CHECK_NOT_NULL(node);
+  PRIMITIV_C_CHECK_NOT_NULL(retval);
+  PRIMITIV_C_CHECK_NOT_NULL(size);
+  const Node &x = *to_cpp_ptr(node);
+  const primitiv::Tensor &value = x.graph().forward(x);
+  *retval = value.host_data();
+  *size = value.shape().size();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
 PRIMITIV_C_STATUS primitivGetNodeArgmax(
     const primitivNode_t *node, uint32_t dim, uint32_t *retval,
     size_t *size) try {
@@ -148,12 +170,33 @@ PRIMITIV_C_STATUS primitivSetDefaultGraph(primitivGraph_t *graph) try {
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
+PRIMITIV_C_STATUS primitivSetThreadDefaultGraph(primitivGraph_t *graph) try {
+  PRIMITIV_C_CHECK_NOT_NULL(graph);
+  Graph::set_thread_default(*to_cpp_ptr(graph));
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivResetThreadDefaultGraph() try {
+  Graph::reset_thread_default();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
 PRIMITIV_C_STATUS primitivClearGraph(primitivGraph_t *graph) try {
   PRIMITIV_C_CHECK_NOT_NULL(graph);
   to_cpp_ptr(graph)->clear();
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
+PRIMITIV_C_STATUS primitivGetNodeFromGraph(
+    primitivGraph_t *graph, uint32_t operator_id, uint32_t value_id,
+    primitivNode_t **newobj) try {
+  PRIMITIV_C_CHECK_NOT_NULL(graph);
+  PRIMITIV_C_CHECK_NOT_NULL(newobj);
+  *newobj = to_c_ptr_from_value(
+      to_cpp_ptr(graph)->get_node(operator_id, value_id));
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
 PRIMITIV_C_STATUS primitivExecuteGraphForward(
     primitivGraph_t *graph, const primitivNode_t *node,
     const primitivTensor_t **retval) try {
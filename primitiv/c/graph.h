@@ -117,6 +117,36 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivEvaluateNodeAsFloat(
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivEvaluateNodeAsArray(
     const primitivNode_t *node, float *retval, size_t *size);
 
+/**
+ * Calculates the value of this node and copies it into a preallocated array.
+ * @param node Pointer of a handler.
+ * @param buffer Array to receive calculated values.
+ * @param size Length of `buffer`, which should be at least the number of
+ *             values in the node.
+ * @return Status code.
+ * @remarks This function calls Graph::forward() internally.
+ *          Unlike `primitivEvaluateNodeAsArray()`, this function copies
+ *          values only once and does not require to retrieve the length in
+ *          advance.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivCopyNodeToArray(
+    const primitivNode_t *node, float *buffer, size_t size);
+
+/**
+ * Calculates the value of this node and retrieves the pointer to it without
+ * copying.
+ * @param node Pointer of a handler.
+ * @param retval Pointer to receive the read-only pointer to calculated values
+ *               ordered by the column-major order.
+ * @param size Pointer to receive the number of values.
+ * @return Status code.
+ * @remarks This function calls Graph::forward() internally, and can be used
+ *          only when the node is on a device on the host (e.g., Naive and
+ *          Eigen). The pointer is available until the graph is cleared.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetNodeData(
+    const primitivNode_t *node, const float **retval, size_t *size);
+
 /**
  * Returns argmax indices along an axis of this node.
  * @param node Pointer of a handler.
@@ -183,6 +213,23 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetDefaultGraph(
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivSetDefaultGraph(
     primitivGraph_t *graph);
 
+/**
+ * Specifies a new default graph of the current thread.
+ * @param graph Pointer of the new default graph.
+ * @return Status code.
+ * @remarks The graph overrides the global default graph only in the current
+ *          thread.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivSetThreadDefaultGraph(
+    primitivGraph_t *graph);
+
+/**
+ * Unregisters the default graph of the current thread, so that the global
+ * default graph is used again in the current thread.
+ * @return Status code.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivResetThreadDefaultGraph();
+
 /**
  * Clear all operators in the graph.
  * @param graph Pointer of a handler.
@@ -193,6 +240,20 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivSetDefaultGraph(
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivClearGraph(
     primitivGraph_t *graph);
 
+/**
+ * Retrieves the node by its location.
+ * @param graph Pointer of a handler.
+ * @param operator_id Operator ID of the node.
+ * @param value_id Value ID of the node.
+ * @param newobj Pointer to receive a handler.
+ * @return Status code.
+ * @remarks This function is used to restore nodes from IDs obtained by
+ *          `primitivGetNodeOperatorId()` and `primitivGetNodeValueId()`.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetNodeFromGraph(
+    primitivGraph_t *graph, uint32_t operator_id, uint32_t value_id,
+    primitivNode_t **newobj);
+
 /**
  * Calculates the value of given node.
  * @param graph Pointer of a handler.
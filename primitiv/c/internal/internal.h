@@ -154,6 +154,15 @@ inline void copy_vector_to_array(
   }
 }
 
+inline void copy_tensor_to_array(
+    const primitiv::Tensor &src, float *array, std::size_t size) {
+  const std::uint32_t num_values = src.shape().size();
+  if (size < num_values) {
+    PRIMITIV_THROW_ERROR("Size is not enough to copy a tensor.");
+  }
+  src.to_array(0, num_values, array);
+}
+
 inline void copy_string_to_array(
     const std::string &str, char *buffer, std::size_t *size) {
   if (buffer) {
@@ -0,0 +1,130 @@
+#include <primitiv/config.h>
+
+#include <utility>
+#include <vector>
+
+#include <primitiv/core/error.h>
+#include <primitiv/core/functions.h>
+#include <primitiv/core/graph.h>
+#include <primitiv/c/internal/internal.h>
+#include <primitiv/c/operator_records.h>
+
+using primitiv::Graph;
+using primitiv::Node;
+using primitiv::c::internal::to_cpp_ptr;
+
+namespace {
+
+// Applies an operator described by the record.
+Node apply_record(
+    const primitivOperatorRecord_t &rec, const std::vector<Node> &values) {
+  namespace F = primitiv::functions;
+
+  auto arg = [&](std::uint32_t i) -> const Node & {
+    const std::uint32_t index = rec.args[i];
+    if (index >= values.size()) {
+      PRIMITIV_THROW_ERROR(
+          "Invalid argument index. args[" << i << "]: " << index
+          << ", available values: " << values.size());
+    }
+    return values[index];
+  };
+  const std::uint32_t *ia = rec.iattrs;
+  const float f = rec.fattr;
+
+  switch (rec.opcode) {
+    case PRIMITIV_C_OP_POSITIVE: return F::positive(arg(0));
+    case PRIMITIV_C_OP_NEGATIVE: return F::negative(arg(0));
+    case PRIMITIV_C_OP_ADD: return F::add(arg(0), arg(1));
+    case PRIMITIV_C_OP_ADD_XC: return F::add(arg(0), f);
+    case PRIMITIV_C_OP_SUBTRACT: return F::subtract(arg(0), arg(1));
+    case PRIMITIV_C_OP_SUBTRACT_XC: return F::subtract(arg(0), f);
+    case PRIMITIV_C_OP_SUBTRACT_CX: return F::subtract(f, arg(0));
+    case PRIMITIV_C_OP_MULTIPLY: return F::multiply(arg(0), arg(1));
+    case PRIMITIV_C_OP_MULTIPLY_XC: return F::multiply(arg(0), f);
+    case PRIMITIV_C_OP_DIVIDE: return F::divide(arg(0), arg(1));
+    case PRIMITIV_C_OP_DIVIDE_XC: return F::divide(arg(0), f);
+    case PRIMITIV_C_OP_DIVIDE_CX: return F::divide(f, arg(0));
+    case PRIMITIV_C_OP_POW: return F::pow(arg(0), arg(1));
+    case PRIMITIV_C_OP_POW_XC: return F::pow(arg(0), f);
+    case PRIMITIV_C_OP_POW_CX: return F::pow(f, arg(0));
+    case PRIMITIV_C_OP_POWN:
+      return F::pown(arg(0), static_cast<std::int32_t>(ia[0]));
+    case PRIMITIV_C_OP_MATMUL: return F::matmul(arg(0), arg(1));
+    case PRIMITIV_C_OP_ABS: return F::abs(arg(0));
+    case PRIMITIV_C_OP_SQRT: return F::sqrt(arg(0));
+    case PRIMITIV_C_OP_EXP: return F::exp(arg(0));
+    case PRIMITIV_C_OP_LOG: return F::log(arg(0));
+    case PRIMITIV_C_OP_TANH: return F::tanh(arg(0));
+    case PRIMITIV_C_OP_SIGMOID: return F::sigmoid(arg(0));
+    case PRIMITIV_C_OP_SOFTPLUS: return F::softplus(arg(0));
+    case PRIMITIV_C_OP_SIN: return F::sin(arg(0));
+    case PRIMITIV_C_OP_COS: return F::cos(arg(0));
+    case PRIMITIV_C_OP_TAN: return F::tan(arg(0));
+    case PRIMITIV_C_OP_RELU: return F::relu(arg(0));
+    case PRIMITIV_C_OP_LRELU: return F::lrelu(arg(0));
+    case PRIMITIV_C_OP_PRELU: return F::prelu(arg(0), f);
+    case PRIMITIV_C_OP_ELU: return F::elu(arg(0), f);
+    case PRIMITIV_C_OP_SELU: return F::selu(arg(0));
+    case PRIMITIV_C_OP_DROPOUT: return F::dropout(arg(0), f, ia[0] != 0);
+    case PRIMITIV_C_OP_STOP_GRADIENT: return F::stop_gradient(arg(0));
+    case PRIMITIV_C_OP_SLICE: return F::slice(arg(0), ia[0], ia[1], ia[2]);
+    case PRIMITIV_C_OP_CONCAT:
+      return F::concat(std::vector<const Node *> { &arg(0), &arg(1) }, ia[0]);
+    case PRIMITIV_C_OP_FLATTEN: return F::flatten(arg(0));
+    case PRIMITIV_C_OP_TRANSPOSE: return F::transpose(arg(0));
+    case PRIMITIV_C_OP_FLIP: return F::flip(arg(0), ia[0]);
+    case PRIMITIV_C_OP_SUM: return F::sum(arg(0), ia[0]);
+    case PRIMITIV_C_OP_MEAN: return F::mean(arg(0), ia[0]);
+    case PRIMITIV_C_OP_MAX: return F::max(arg(0), ia[0]);
+    case PRIMITIV_C_OP_MIN: return F::min(arg(0), ia[0]);
+    case PRIMITIV_C_OP_BROADCAST: return F::broadcast(arg(0), ia[0], ia[1]);
+    case PRIMITIV_C_OP_LOGSUMEXP: return F::logsumexp(arg(0), ia[0]);
+    case PRIMITIV_C_OP_SOFTMAX: return F::softmax(arg(0), ia[0]);
+    case PRIMITIV_C_OP_LOG_SOFTMAX: return F::log_softmax(arg(0), ia[0]);
+    case PRIMITIV_C_OP_SOFTMAX_CROSS_ENTROPY:
+      return F::softmax_cross_entropy(arg(0), arg(1), ia[0]);
+    case PRIMITIV_C_OP_BATCH_SLICE:
+      return F::batch::slice(arg(0), ia[0], ia[1]);
+    case PRIMITIV_C_OP_BATCH_SUM: return F::batch::sum(arg(0));
+    case PRIMITIV_C_OP_BATCH_MEAN: return F::batch::mean(arg(0));
+    case PRIMITIV_C_OP_PICK: return F::pick(arg(0), { ia[0] }, ia[1]);
+    case PRIMITIV_C_OP_RESHAPE:
+      return F::reshape(arg(0), primitiv::Shape({ ia[0], ia[1], ia[2] }));
+    case PRIMITIV_C_OP_BATCH_CONCAT:
+      return F::batch::concat(std::vector<const Node *> { &arg(0), &arg(1) });
+    default: PRIMITIV_THROW_ERROR("Unknown opcode: " << rec.opcode);
+  }
+}
+
+}  // namespace
+
+PRIMITIV_C_STATUS primitivApplyNodeRecords(
+    primitivGraph_t *graph,
+    const primitivNodeId_t *inputs, size_t num_inputs,
+    const primitivOperatorRecord_t *records, size_t num_records,
+    primitivNodeId_t *retval) try {
+  PRIMITIV_C_CHECK_NOT_NULL(graph);
+  if (num_inputs > 0) {
+    PRIMITIV_C_CHECK_NOT_NULL(inputs);
+  }
+  if (num_records > 0) {
+    PRIMITIV_C_CHECK_NOT_NULL(records);
+    PRIMITIV_C_CHECK_NOT_NULL(retval);
+  }
+  Graph &g = *to_cpp_ptr(graph);
+
+  // The value table: `inputs` followed by results of `records`.
+  std::vector<Node> values;
+  values.reserve(num_inputs + num_records);
+  for (std::size_t i = 0; i < num_inputs; ++i) {
+    values.emplace_back(g.get_node(inputs[i].operator_id, inputs[i].value_id));
+  }
+
+  for (std::size_t i = 0; i < num_records; ++i) {
+    Node y = ::apply_record(records[i], values);
+    retval[i] = { y.operator_id(), y.value_id() };
+    values.emplace_back(std::move(y));
+  }
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
@@ -0,0 +1,125 @@
+#ifndef PRIMITIV_C_OPERATOR_RECORDS_H_
+#define PRIMITIV_C_OPERATOR_RECORDS_H_
+
+#include <primitiv/c/define.h>
+#include <primitiv/c/graph.h>
+
+/*
+ * Opcodes of operator records.
+ * Each comment describes the corresponding function and how the fields of
+ * `primitivOperatorRecord_t` are used: `a` and `b` are the values specified by
+ * `args[0]` and `args[1]`, `i0`, `i1` and `i2` are `iattrs[0]`, `iattrs[1]`
+ * and `iattrs[2]`, and `f` is `fattr`.
+ */
+#define PRIMITIV_C_OP_POSITIVE 0u  /* positive(a) */
+#define PRIMITIV_C_OP_NEGATIVE 1u  /* negative(a) */
+#define PRIMITIV_C_OP_ADD 2u  /* add(a, b) */
+#define PRIMITIV_C_OP_ADD_XC 3u  /* add(a, f) */
+#define PRIMITIV_C_OP_SUBTRACT 4u  /* subtract(a, b) */
+#define PRIMITIV_C_OP_SUBTRACT_XC 5u  /* subtract(a, f) */
+#define PRIMITIV_C_OP_SUBTRACT_CX 6u  /* subtract(f, a) */
+#define PRIMITIV_C_OP_MULTIPLY 7u  /* multiply(a, b) */
+#define PRIMITIV_C_OP_MULTIPLY_XC 8u  /* multiply(a, f) */
+#define PRIMITIV_C_OP_DIVIDE 9u  /* divide(a, b) */
+#define PRIMITIV_C_OP_DIVIDE_XC 10u  /* divide(a, f) */
+#define PRIMITIV_C_OP_DIVIDE_CX 11u  /* divide(f, a) */
+#define PRIMITIV_C_OP_POW 12u  /* pow(a, b) */
+#define PRIMITIV_C_OP_POW_XC 13u  /* pow(a, f) */
+#define PRIMITIV_C_OP_POW_CX 14u  /* pow(f, a) */
+#define PRIMITIV_C_OP_POWN 15u  /* pown(a, (int32_t)i0) */
+#define PRIMITIV_C_OP_MATMUL 16u  /* matmul(a, b) */
+#define PRIMITIV_C_OP_ABS 17u  /* abs(a) */
+#define PRIMITIV_C_OP_SQRT 18u  /* sqrt(a) */
+#define PRIMITIV_C_OP_EXP 19u  /* exp(a) */
+#define PRIMITIV_C_OP_LOG 20u  /* log(a) */
+#define PRIMITIV_C_OP_TANH 21u  /* tanh(a) */
+#define PRIMITIV_C_OP_SIGMOID 22u  /* sigmoid(a) */
+#define PRIMITIV_C_OP_SOFTPLUS 23u  /* softplus(a) */
+#define PRIMITIV_C_OP_SIN 24u  /* sin(a) */
+#define PRIMITIV_C_OP_COS 25u  /* cos(a) */
+#define PRIMITIV_C_OP_TAN 26u  /* tan(a) */
+#define PRIMITIV_C_OP_RELU 27u  /* relu(a) */
+#define PRIMITIV_C_OP_LRELU 28u  /* lrelu(a) */
+#define PRIMITIV_C_OP_PRELU 29u  /* prelu(a, f) */
+#define PRIMITIV_C_OP_ELU 30u  /* elu(a, f) */
+#define PRIMITIV_C_OP_SELU 31u  /* selu(a) */
+#define PRIMITIV_C_OP_DROPOUT 32u  /* dropout(a, f, i0 != 0) */
+#define PRIMITIV_C_OP_STOP_GRADIENT 33u  /* stop_gradient(a) */
+#define PRIMITIV_C_OP_SLICE 34u  /* slice(a, i0, i1, i2) */
+#define PRIMITIV_C_OP_CONCAT 35u  /* concat({a, b}, i0) */
+#define PRIMITIV_C_OP_FLATTEN 36u  /* flatten(a) */
+#define PRIMITIV_C_OP_TRANSPOSE 37u  /* transpose(a) */
+#define PRIMITIV_C_OP_FLIP 38u  /* flip(a, i0) */
+#define PRIMITIV_C_OP_SUM 39u  /* sum(a, i0) */
+#define PRIMITIV_C_OP_MEAN 40u  /* mean(a, i0) */
+#define PRIMITIV_C_OP_MAX 41u  /* max(a, i0) */
+#define PRIMITIV_C_OP_MIN 42u  /* min(a, i0) */
+#define PRIMITIV_C_OP_BROADCAST 43u  /* broadcast(a, i0, i1) */
+#define PRIMITIV_C_OP_LOGSUMEXP 44u  /* logsumexp(a, i0) */
+#define PRIMITIV_C_OP_SOFTMAX 45u  /* softmax(a, i0) */
+#define PRIMITIV_C_OP_LOG_SOFTMAX 46u  /* log_softmax(a, i0) */
+/* softmax_cross_entropy(a, b, i0) */
+#define PRIMITIV_C_OP_SOFTMAX_CROSS_ENTROPY 47u
+#define PRIMITIV_C_OP_BATCH_SLICE 48u  /* batch::slice(a, i0, i1) */
+#define PRIMITIV_C_OP_BATCH_SUM 49u  /* batch::sum(a) */
+#define PRIMITIV_C_OP_BATCH_MEAN 50u  /* batch::mean(a) */
+#define PRIMITIV_C_OP_PICK 51u  /* pick(a, {i0}, i1) */
+#define PRIMITIV_C_OP_RESHAPE 52u  /* reshape(a, Shape({i0, i1, i2})) */
+#define PRIMITIV_C_OP_BATCH_CONCAT 53u  /* batch::concat({a, b}) */
+
+/*
+ * Operators that require variable-length data or produce multiple results have
+ * no opcodes because records have fixed sizes: `input()`, `parameter()` and
+ * `pick_parameter()` (use `inputs` made by `primitivApplyNode*()` functions
+ * instead), `pick()` with multiple IDs, `reshape()` with more than 3
+ * dimensions, and `split()` (use `PRIMITIV_C_OP_SLICE` for each part).
+ */
+
+/**
+ * Location of a node in the computation graph.
+ */
+typedef struct primitivNodeId {
+  uint32_t operator_id;
+  uint32_t value_id;
+} primitivNodeId_t;
+
+/**
+ * Description of an operator applied by `primitivApplyNodeRecords()`.
+ * Unused fields are ignored.
+ */
+typedef struct primitivOperatorRecord {
+  /** One of `PRIMITIV_C_OP_*` values. */
+  uint32_t opcode;
+  /** Indices of arguments in the value table. */
+  uint32_t args[2];
+  /** Integer attributes. */
+  uint32_t iattrs[3];
+  /** Floating point attribute. */
+  float fattr;
+} primitivOperatorRecord_t;
+
+/**
+ * Applies a sequence of operators to the graph in one call.
+ * @param graph Pointer of a handler.
+ * @param inputs Array of nodes in `graph` used as arguments.
+ * @param num_inputs Number of nodes in `inputs`.
+ * @param records Array of operators to be applied.
+ * @param num_records Number of operators in `records`.
+ * @param retval Array to receive `num_records` nodes of resulting values.
+ * @return Status code.
+ * @remarks Arguments of each record are specified by indices in the value
+ *          table, which contains `inputs` followed by the results of
+ *          `records`, i.e., the index `num_inputs + i` represents the result
+ *          of `records[i]`, and each record can refer only preceding results.
+ *          Resulting nodes can be restored by `primitivGetNodeFromGraph()`
+ *          or used as `inputs` of another call.
+ *          If an error occurred, the operators applied before the error remain
+ *          in the graph and the contents of `retval` are undefined.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivApplyNodeRecords(
+    primitivGraph_t *graph,
+    const primitivNodeId_t *inputs, size_t num_inputs,
+    const primitivOperatorRecord_t *records, size_t num_records,
+    primitivNodeId_t *retval);
+
+#endif  // PRIMITIV_C_OPERATOR_RECORDS_H_
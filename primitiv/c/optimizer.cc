@@ -93,6 +93,21 @@ PRIMITIV_C_STATUS primitivSetOptimizerGradientClipping(
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
+PRIMITIV_C_STATUS primitivGetOptimizerAccumulationSteps(
+    const primitivOptimizer_t *optimizer, uint32_t *retval) try {
+  PRIMITIV_C_CHECK_NOT_NULL(optimizer);
+  PRIMITIV_C_CHECK_NOT_NULL(retval);
+  *retval = to_cpp_ptr(optimizer)->get_accumulation_steps();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivSetOptimizerAccumulationSteps(
+    primitivOptimizer_t *optimizer, uint32_t steps) try {
+  PRIMITIV_C_CHECK_NOT_NULL(optimizer);
+  to_cpp_ptr(optimizer)->set_accumulation_steps(steps);
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
 PRIMITIV_C_STATUS primitivAddParameterToOptimizer(
     primitivOptimizer_t *optimizer, primitivParameter_t *param) try {
   PRIMITIV_C_CHECK_NOT_NULL(optimizer);
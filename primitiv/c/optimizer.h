@@ -113,6 +113,26 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetOptimizerGradientClipping(
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivSetOptimizerGradientClipping(
     primitivOptimizer_t *optimizer, float threshold);
 
+/**
+ * Retrieves current number of gradient accumulation steps.
+ * @param optimizer Pointer of a handler.
+ * @param retval Number of micro-batches per one update.
+ * @return Status code.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetOptimizerAccumulationSteps(
+    const primitivOptimizer_t *optimizer, uint32_t *retval);
+
+/**
+ * Sets number of gradient accumulation steps.
+ * @param optimizer Pointer of a handler.
+ * @param steps New number of micro-batches per one update, or 1 to disable
+ *              the gradient accumulation.
+ * @return Status code.
+ * @remarks Could not set 0.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivSetOptimizerAccumulationSteps(
+    primitivOptimizer_t *optimizer, uint32_t steps);
+
 /**
  * Registers a parameter.
  * @param optimizer Pointer of a handler.
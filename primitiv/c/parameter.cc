@@ -102,6 +102,28 @@ PRIMITIV_C_STATUS primitivIsValidParameter(
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
+PRIMITIV_C_STATUS primitivFreezeParameter(
+    primitivParameter_t *parameter) try {
+  PRIMITIV_C_CHECK_NOT_NULL(parameter);
+  to_cpp_ptr(parameter)->freeze();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivUnfreezeParameter(
+    primitivParameter_t *parameter) try {
+  PRIMITIV_C_CHECK_NOT_NULL(parameter);
+  to_cpp_ptr(parameter)->unfreeze();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivIsFrozenParameter(
+    const primitivParameter_t *parameter, PRIMITIV_C_BOOL *retval) try {
+  PRIMITIV_C_CHECK_NOT_NULL(parameter);
+  PRIMITIV_C_CHECK_NOT_NULL(retval);
+  *retval = to_cpp_ptr(parameter)->frozen();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
 PRIMITIV_C_STATUS primitivResetParameterGradients(
     primitivParameter_t *parameter) try {
   PRIMITIV_C_CHECK_NOT_NULL(parameter);
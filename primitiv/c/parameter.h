@@ -113,6 +113,34 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivSaveParameter(
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivIsValidParameter(
     const primitivParameter_t *parameter, PRIMITIV_C_BOOL *retval);
 
+/**
+ * Makes the parameter read-only.
+ * @param parameter Pointer of a handler.
+ * @return Status code.
+ * @remarks Frozen parameters do not hold gradients and can be shared by
+ *          graphs on multiple threads.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivFreezeParameter(
+    primitivParameter_t *parameter);
+
+/**
+ * Makes the frozen parameter trainable again.
+ * @param parameter Pointer of a handler.
+ * @return Status code.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivUnfreezeParameter(
+    primitivParameter_t *parameter);
+
+/**
+ * Returns whether the parameter is frozen or not.
+ * @param parameter Pointer of a handler.
+ * @param retval Pointer to receive a result: true or false w.r.t. the parameter
+ *               is frozen or not.
+ * @return Status code.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivIsFrozenParameter(
+    const primitivParameter_t *parameter, PRIMITIV_C_BOOL *retval);
+
 /**
  * Set all gradients to 0.
  * @param parameter Pointer of a handler.
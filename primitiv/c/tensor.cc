@@ -1,16 +1,46 @@
 #include <primitiv/config.h>
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
+#include <primitiv/core/device.h>
+#include <primitiv/core/dlpack.h>
 #include <primitiv/core/tensor.h>
 #include <primitiv/c/internal/internal.h>
 #include <primitiv/c/tensor.h>
 
+using primitiv::Device;
 using primitiv::Tensor;
 using primitiv::c::internal::to_c_ptr;
 using primitiv::c::internal::to_cpp_ptr;
 using primitiv::c::internal::to_c_ptr_from_value;
 
+namespace dlpack = primitiv::dlpack;
+
+// NOTE:
+// Descriptors in the C API are casted to those in the core library directly.
+static_assert(
+    sizeof(primitivDLManagedTensor_t) == sizeof(dlpack::DLManagedTensor),
+    "Mismatched sizes of primitivDLManagedTensor_t.");
+static_assert(
+    offsetof(primitivDLManagedTensor_t, dl_tensor.byte_offset)
+    == offsetof(dlpack::DLManagedTensor, dl_tensor.byte_offset),
+    "Mismatched layouts of primitivDLTensor_t.");
+static_assert(
+    offsetof(primitivDLManagedTensor_t, deleter)
+    == offsetof(dlpack::DLManagedTensor, deleter),
+    "Mismatched layouts of primitivDLManagedTensor_t.");
+
+namespace {
+
+// Calls the deleter of the descriptor.
+void delete_managed_tensor(primitivDLManagedTensor_t *src) {
+  if (src->deleter) src->deleter(src);
+}
+
+}  // namespace
+
 PRIMITIV_C_STATUS primitivCreateTensor(primitivTensor_t **newobj) try {
   PRIMITIV_C_CHECK_NOT_NULL(newobj);
   *newobj = to_c_ptr(new Tensor());
@@ -72,6 +102,61 @@ PRIMITIV_C_STATUS primitivEvaluateTensorAsArray(
   return PRIMITIV_C_OK;
 } PRIMITIV_C_HANDLE_EXCEPTIONS
 
+PRIMITIV_C_STATUS primitivCopyTensorToArray(
+    const primitivTensor_t *tensor, float *buffer, size_t size) try {
+  PRIMITIV_C_CHECK_NOT_NULL(tensor);
+  PRIMITIV_C_CHECK_NOT_NULL(buffer);
+  primitiv::c::internal::copy_tensor_to_array(
+      *to_cpp_ptr(tensor), buffer, size);
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivGetTensorData(
+    const primitivTensor_t *tensor, const float **retval, size_t *size) try {
+  PRIMITIV_C_CHECK_NOT_NULL(tensor);
+  PRIMITIV_C_CHECK_NOT_NULL(retval);
+  PRIMITIV_C_CHECK_NOT_NULL(size);
+  const Tensor &x = *to_cpp_ptr(tensor);
+  *retval = x.host_data();
+  *size = x.shape().size();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivGetTensorMutableData(
+    primitivTensor_t *tensor, float **retval, size_t *size) try {
+  PRIMITIV_C_CHECK_NOT_NULL(tensor);
+  PRIMITIV_C_CHECK_NOT_NULL(retval);
+  PRIMITIV_C_CHECK_NOT_NULL(size);
+  Tensor &x = *to_cpp_ptr(tensor);
+  *retval = x.mutable_host_data();
+  *size = x.shape().size();
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivCreateTensorFromDLPack(
+    primitivDLManagedTensor_t *src, PRIMITIV_C_BOOL batched,
+    primitivDevice_t *device, primitivTensor_t **newobj) try {
+  std::unique_ptr<
+    primitivDLManagedTensor_t, decltype(&::delete_managed_tensor)>
+      holder(src, ::delete_managed_tensor);
+  PRIMITIV_C_CHECK_NOT_NULL(src);
+  PRIMITIV_C_CHECK_NOT_NULL(newobj);
+  Device &dev = Device::get_reference_or_default(to_cpp_ptr(device));
+  *newobj = to_c_ptr_from_value(dev.new_tensor_by_dlpack(
+      reinterpret_cast<dlpack::DLManagedTensor *>(holder.release()),
+      batched));
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
+PRIMITIV_C_STATUS primitivExportTensorToDLPack(
+    const primitivTensor_t *tensor, primitivDLManagedTensor_t **retval) try {
+  PRIMITIV_C_CHECK_NOT_NULL(tensor);
+  PRIMITIV_C_CHECK_NOT_NULL(retval);
+  *retval = reinterpret_cast<primitivDLManagedTensor_t *>(
+      to_cpp_ptr(tensor)->to_dlpack());
+  return PRIMITIV_C_OK;
+} PRIMITIV_C_HANDLE_EXCEPTIONS
+
 PRIMITIV_C_STATUS primitivGetTensorArgmax(
     const primitivTensor_t *tensor, uint32_t dim, uint32_t *retval,
     size_t *size) try {
@@ -3,6 +3,7 @@
 
 #include <primitiv/c/define.h>
 #include <primitiv/c/device.h>
+#include <primitiv/c/dlpack.h>
 #include <primitiv/c/shape.h>
 
 /**
@@ -88,6 +89,86 @@ PRIMITIV_C_API PRIMITIV_C_STATUS primitivEvaluateTensorAsFloat(
 PRIMITIV_C_API PRIMITIV_C_STATUS primitivEvaluateTensorAsArray(
     const primitivTensor_t *tensor, float *retval, size_t *size);
 
+/**
+ * Copies internal values in the tensor into a preallocated array.
+ * @param tensor Pointer of a handler.
+ * @param buffer Array to receive internal values.
+ * @param size Length of `buffer`, which should be at least the number of
+ *             values in the tensor.
+ * @return Status code.
+ * @remarks Each resulting values are ordered by the column-major order, and
+ *          the batch size is assumed as the last dimension of the tensor.
+ *          Unlike `primitivEvaluateTensorAsArray()`, this function copies
+ *          values only once and does not require to retrieve the length in
+ *          advance.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivCopyTensorToArray(
+    const primitivTensor_t *tensor, float *buffer, size_t size);
+
+/**
+ * Retrieves the pointer to internal values of the tensor without copying.
+ * @param tensor Pointer of a handler.
+ * @param retval Pointer to receive the read-only pointer to internal values
+ *               ordered by the column-major order.
+ * @param size Pointer to receive the number of values.
+ * @return Status code.
+ * @remarks This function can be used only when the tensor is managed by a
+ *          device on the host (e.g., Naive and Eigen) and has the single
+ *          precision. The pointer is available while the tensor is not
+ *          deleted or modified.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetTensorData(
+    const primitivTensor_t *tensor, const float **retval, size_t *size);
+
+/**
+ * Retrieves the writable pointer to internal values of the tensor without
+ * copying.
+ * @param tensor Pointer of a handler.
+ * @param retval Pointer to receive the pointer to internal values ordered by
+ *               the column-major order.
+ * @param size Pointer to receive the number of values.
+ * @return Status code.
+ * @remarks Requirements are same as `primitivGetTensorData()`. If the memory
+ *          is shared with other tensors, it is duplicated before returning
+ *          the pointer, so that writing values does not affect other
+ *          tensors.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivGetTensorMutableData(
+    primitivTensor_t *tensor, float **retval, size_t *size);
+
+/**
+ * Creates a new Tensor object from a DLPack descriptor.
+ * @param src Descriptor of a single-precision tensor on the host memory. This
+ *            function takes the ownership of `src` and calls its `deleter`
+ *            when the memory is no longer used, even if an error occurred.
+ * @param batched If true, the last dimension of `src` is treated as the batch
+ *                size.
+ * @param device Pointer of a handler of the device, or null to use the
+ *               default device.
+ * @param newobj Pointer to receive a handler.
+ * @return Status code.
+ * @remarks Values in the column-major order (e.g., Fortran-ordered arrays) are
+ *          used without copying on devices on the host. Values with other
+ *          strides are copied.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivCreateTensorFromDLPack(
+    primitivDLManagedTensor_t *src, PRIMITIV_C_BOOL batched,
+    primitivDevice_t *device, primitivTensor_t **newobj);
+
+/**
+ * Exports the tensor as a DLPack descriptor without copying.
+ * @param tensor Pointer of a handler.
+ * @param retval Pointer to receive a new descriptor. The caller should call
+ *               its `deleter` after using it.
+ * @return Status code.
+ * @remarks Requirements are same as `primitivGetTensorData()`. The descriptor
+ *          has the dimensions of the shape followed by the batch size
+ *          (omitted if it is 1) with column-major strides, and keeps the
+ *          memory alive even if the tensor is deleted.
+ */
+PRIMITIV_C_API PRIMITIV_C_STATUS primitivExportTensorToDLPack(
+    const primitivTensor_t *tensor, primitivDLManagedTensor_t **retval);
+
 /**
  * Retrieves argmax indices along an axis.
  * @param tensor Pointer of a handler.
@@ -278,31 +278,6 @@ inline type_traits::Identity<Var> ones(const Shape &shape) {
   return constant<Var>(shape, 1.);
 }
 
-/**
- * Applies the dropout:
- * @f[
- *  \begin{array}{rcl}
- *    w & \sim & \mathrm{Bernoulli}(w; 1 - r), \\
- *    \mathrm{dropout}(x) & := & \frac{1}{1 - r} \times w \times x.
- *  \end{array}
- * @f]
- * @param x A variable representing original values.
- * @param rate The dropout probability \f$ r \f$.
- *             `0` maintains all values and `1` discards all values.
- * @param enabled If `true`, this function applies the operation.
- *                Otherwise, this function performs nothing.
- * @return A new variable.
- * @remarks This function is implemented as a composite of some other functions.
- */
-template<typename Var>
-inline type_traits::Identity<Var> dropout(
-    const Var &x, float rate, bool enabled) {
-  if (!enabled) return x;
-  if (rate == 1.) return 0. * x;
-  const float p = 1. - rate;
-  return (1. / p) * x * random::bernoulli<Var>(x.shape(), p, x.device());
-}
-
 }  // namespace functions
 }  // namespace primitiv
 
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <cstdint>
 #include <initializer_list>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <primitiv/core/error.h>
@@ -190,9 +192,11 @@ type_traits::Identity<Var> pown(const Var &x, std::int32_t k);
  * @param dev Device to manage inner data of the Tensor, or `nullptr` to use the
  *            default device.
  * @return A new Tensor.
+ * @remarks Devices on the host use the memory of `data` directly, and passing
+ *          an rvalue avoids copying values.
  */
 Tensor input_tensor(
-    const Shape &shape, const std::vector<float> &data, Device *dev);
+    const Shape &shape, std::vector<float> data, Device *dev);
 
 /**
  * Creates a new Node from specific shape and data.
@@ -205,9 +209,12 @@ Tensor input_tensor(
  * @param g Graph to manage the instance of the Node, or `nullptr` to use the
  *          default graph.
  * @return A new Node.
+ * @remarks The Node holds `data` until the graph is cleared. Devices on the
+ *          host use the memory of `data` directly, and passing an rvalue
+ *          avoids copying values.
  */
 Node input_node(
-    const Shape &shape, const std::vector<float> &data, Device *dev, Graph *g);
+    const Shape &shape, std::vector<float> data, Device *dev, Graph *g);
 
 /**
  * Creates a new variable from specific shape and data.
@@ -223,20 +230,20 @@ Node input_node(
  */
 template<typename Var>
 type_traits::Identity<Var> input(
-    const Shape &shape, const std::vector<float> &data, Device *dev);
+    const Shape &shape, std::vector<float> data, Device *dev);
 
 /// @cond
 
 template<>
 inline Tensor input<Tensor>(
-    const Shape &shape, const std::vector<float> &data, Device *dev) {
-  return input_tensor(shape, data, dev);
+    const Shape &shape, std::vector<float> data, Device *dev) {
+  return input_tensor(shape, std::move(data), dev);
 }
 
 template<>
 inline Node input<Node>(
-    const Shape &shape, const std::vector<float> &data, Device *dev) {
-  return input_node(shape, data, dev, nullptr);
+    const Shape &shape, std::vector<float> data, Device *dev) {
+  return input_node(shape, std::move(data), dev, nullptr);
 }
 
 /// @endcond
@@ -253,8 +260,8 @@ inline Node input<Node>(
  */
 template<typename Var>
 inline type_traits::Identity<Var> input(
-    const Shape &shape, const std::vector<float> &data, Device &dev) {
-  return input<Var>(shape, data, &dev);
+    const Shape &shape, std::vector<float> data, Device &dev) {
+  return input<Var>(shape, std::move(data), &dev);
 }
 
 /**
@@ -268,8 +275,107 @@ inline type_traits::Identity<Var> input(
  */
 template<typename Var>
 inline type_traits::Identity<Var> input(
-    const Shape &shape, const std::vector<float> &data) {
-  return input<Var>(shape, data, nullptr);
+    const Shape &shape, std::vector<float> data) {
+  return input<Var>(shape, std::move(data), nullptr);
+}
+
+/**
+ * Creates a new Tensor from specific shape and an external array.
+ * @param shape Shape of the new Tensor.
+ * @param data Shared pointer to the array with `shape.size()` values ordered
+ *             by the column-major order. The deleter of `data` is called when
+ *             all objects that refer the array are released.
+ * @param dev Device to manage inner data of the Tensor, or `nullptr` to use the
+ *            default device.
+ * @return A new Tensor.
+ * @remarks Devices on the host use the array directly as the memory of the
+ *          Tensor if it is aligned to `float`. The array should not be
+ *          modified while the deleter is not called, and in-place operations
+ *          on the resulting Tensor may modify the array.
+ */
+Tensor shared_input_tensor(
+    const Shape &shape, const std::shared_ptr<float> &data, Device *dev);
+
+/**
+ * Creates a new Node from specific shape and an external array.
+ * @param shape Shape of the new Node.
+ * @param data Shared pointer to the array with `shape.size()` values ordered
+ *             by the column-major order. The deleter of `data` is called when
+ *             all objects that refer the array are released.
+ * @param dev Device to manage inner data of the Node, or `nullptr` to use the
+ *            default device.
+ * @param g Graph to manage the instance of the Node, or `nullptr` to use the
+ *          default graph.
+ * @return A new Node.
+ * @remarks Devices on the host use the array directly as the memory of the
+ *          Node if it is aligned to `float`. The array should not be modified
+ *          while the deleter is not called.
+ */
+Node shared_input_node(
+    const Shape &shape, const std::shared_ptr<float> &data, Device *dev,
+    Graph *g);
+
+/**
+ * Creates a new variable from specific shape and an external array.
+ * @param shape Shape of the new variable.
+ * @param data Shared pointer to the array with `shape.size()` values ordered
+ *             by the column-major order. The deleter of `data` is called when
+ *             all objects that refer the array are released.
+ * @param dev Device to manage inner data of the variable, or `nullptr` to use
+ *            the default device.
+ * @return A new variable.
+ * @remarks This function uses the default graph when specifying Node as the
+ *          template variable.
+ */
+template<typename Var>
+type_traits::Identity<Var> shared_input(
+    const Shape &shape, const std::shared_ptr<float> &data, Device *dev);
+
+/// @cond
+
+template<>
+inline Tensor shared_input<Tensor>(
+    const Shape &shape, const std::shared_ptr<float> &data, Device *dev) {
+  return shared_input_tensor(shape, data, dev);
+}
+
+template<>
+inline Node shared_input<Node>(
+    const Shape &shape, const std::shared_ptr<float> &data, Device *dev) {
+  return shared_input_node(shape, data, dev, nullptr);
+}
+
+/// @endcond
+
+/**
+ * Creates a new variable from specific shape and an external array.
+ * @param shape Shape of the new variable.
+ * @param data Shared pointer to the array with `shape.size()` values ordered
+ *             by the column-major order.
+ * @param dev Device to manage inner data of the variable.
+ * @return A new variable.
+ * @remarks This function uses the default graph when specifying Node as the
+ *          template variable.
+ */
+template<typename Var>
+inline type_traits::Identity<Var> shared_input(
+    const Shape &shape, const std::shared_ptr<float> &data, Device &dev) {
+  return shared_input<Var>(shape, data, &dev);
+}
+
+/**
+ * Creates a new variable from specific shape and an external array.
+ * @param shape Shape of the new variable.
+ * @param data Shared pointer to the array with `shape.size()` values ordered
+ *             by the column-major order.
+ * @return A new variable.
+ * @remarks This function always uses the default device, and also uses the
+ *          default graph when specifying Node as the template variable.
+ */
+template<typename Var>
+inline type_traits::Identity<Var> shared_input(
+    const Shape &shape, const std::shared_ptr<float> &data) {
+  return shared_input<Var>(shape, data, nullptr);
 }
 
 /**
@@ -312,6 +418,66 @@ inline Node parameter<Node>(Parameter &param) {
 
 /// @endcond
 
+/**
+ * Picks values from a specific Parameter.
+ * This function is equivalent to `pick(parameter<Var>(param), ids, dim)`,
+ * but the gradient is propagated to `param` as a row-sparse gradient.
+ * @param param Parameter to be associated with the Tensor.
+ * @param ids List of IDs to pick.
+ * @param dim Dimension to pick.
+ * @return A new Tensor.
+ */
+Tensor pick_parameter_tensor(
+    Parameter &param, const std::vector<std::uint32_t> &ids, std::uint32_t dim);
+
+/**
+ * Picks values from a specific Parameter.
+ * This function is equivalent to `pick(parameter<Var>(param), ids, dim)`,
+ * but the gradient is propagated to `param` as a row-sparse gradient.
+ * @param param Parameter to be associated with the Node.
+ * @param ids List of IDs to pick.
+ * @param dim Dimension to pick.
+ * @param g Graph to manage the instance of the Node, or `nullptr` to use the
+ *          default graph.
+ * @return A new Node.
+ */
+Node pick_parameter_node(
+    Parameter &param, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+    Graph *g);
+
+/**
+ * Picks values from a specific Parameter.
+ * This function is equivalent to `pick(parameter<Var>(param), ids, dim)`,
+ * but the gradient is propagated to `param` as a row-sparse gradient, and
+ * optimizers update only picked rows of `param`.
+ * This is typically used for lookup tables of embeddings.
+ * @param param Parameter to be associated with the variable.
+ * @param ids List of IDs to pick.
+ * @param dim Dimension to pick.
+ * @return A new variable.
+ * @remarks This function uses the default graph when specifying Node as the
+ *          template variable.
+ */
+template<typename Var>
+type_traits::Identity<Var> pick_parameter(
+    Parameter &param, const std::vector<std::uint32_t> &ids, std::uint32_t dim);
+
+/// @cond
+
+template<>
+inline Tensor pick_parameter<Tensor>(
+    Parameter &param, const std::vector<std::uint32_t> &ids, std::uint32_t dim) {
+  return pick_parameter_tensor(param, ids, dim);
+}
+
+template<>
+inline Node pick_parameter<Node>(
+    Parameter &param, const std::vector<std::uint32_t> &ids, std::uint32_t dim) {
+  return pick_parameter_node(param, ids, dim, nullptr);
+}
+
+/// @endcond
+
 /**
  * Copies a variable onto a specific device.
  * @param x A variable to be copied.
@@ -795,6 +961,26 @@ type_traits::Identity<Var> prelu(const Var &x, float a);
 template<typename Var>
 type_traits::Identity<Var> elu(const Var &x, float a);
 
+/**
+ * Applies the dropout:
+ * @f[
+ *  \begin{array}{rcl}
+ *    w & \sim & \mathrm{Bernoulli}(w; 1 - r), \\
+ *    \mathrm{dropout}(x) & := & \frac{1}{1 - r} \times w \times x.
+ *  \end{array}
+ * @f]
+ * @param x A variable representing original values.
+ * @param rate The dropout probability \f$ r \f$.
+ *             `0` maintains all values and `1` discards all values.
+ * @param enabled If `true`, this function applies the operation.
+ *                Otherwise, this function performs nothing.
+ * @return A new variable.
+ * @remarks The mask \f$ w \f$ is not stored. The backward pass regenerates
+ *          it from a seed drawn at the forward pass.
+ */
+template<typename Var>
+type_traits::Identity<Var> dropout(const Var &x, float rate, bool enabled);
+
 /**
  * Retrieves maximum values along an axis.
  * Following examples show how this function work:
@@ -0,0 +1,217 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include <primitiv/core/batcher.h>
+#include <primitiv/core/device.h>
+#include <primitiv/core/error.h>
+#include <primitiv/core/functions.h>
+#include <primitiv/core/graph.h>
+
+namespace {
+
+// Pads values along `dim` from `shape[dim]` to `length` elements.
+std::vector<float> pad_data(
+    const std::vector<float> &data, const primitiv::Shape &shape,
+    std::uint32_t dim, std::uint32_t length, float pad_value) {
+  const std::uint32_t src_block = shape.lower_volume(dim + 1);
+  const std::uint32_t dest_block = shape.lower_volume(dim) * length;
+  const std::uint32_t repeat = shape.volume() / src_block;
+  std::vector<float> ret;
+  ret.reserve(repeat * dest_block);
+  for (std::uint32_t i = 0; i < repeat; ++i) {
+    const auto src = data.begin() + i * src_block;
+    ret.insert(ret.end(), src, src + src_block);
+    ret.insert(ret.end(), dest_block - src_block, pad_value);
+  }
+  return ret;
+}
+
+}  // namespace
+
+namespace primitiv {
+
+Batcher::Batcher(
+    Function func,
+    std::uint32_t max_batch_size,
+    std::uint32_t max_delay_us,
+    Device *device)
+: Batcher(
+    std::move(func), max_batch_size, max_delay_us,
+    0, std::vector<std::uint32_t>(), 0, device) {}
+
+Batcher::Batcher(
+    Function func,
+    std::uint32_t max_batch_size,
+    std::uint32_t max_delay_us,
+    std::uint32_t length_dim,
+    std::vector<std::uint32_t> bucket_lengths,
+    float pad_value,
+    Device *device)
+: func_(std::move(func))
+, max_batch_size_(max_batch_size)
+, max_delay_(max_delay_us)
+, length_dim_(length_dim)
+, bucket_lengths_(std::move(bucket_lengths))
+, pad_value_(pad_value)
+, device_(&Device::get_reference_or_default(device))
+, buckets_()
+, num_batches_(0)
+, stopped_(false) {
+  if (!func_) PRIMITIV_THROW_ERROR("Function is empty.");
+  if (max_batch_size_ == 0) {
+    PRIMITIV_THROW_ERROR("max_batch_size should be greater than 0.");
+  }
+  if (length_dim_ >= Shape::MAX_DEPTH) {
+    PRIMITIV_THROW_ERROR(
+        "length_dim exceeds the depth limit. length_dim: " << length_dim_
+        << " >= MAX_DEPTH: " << Shape::MAX_DEPTH);
+  }
+  for (std::uint32_t i = 0; i < bucket_lengths_.size(); ++i) {
+    if (bucket_lengths_[i] == 0 ||
+        (i > 0 && bucket_lengths_[i] <= bucket_lengths_[i - 1])) {
+      PRIMITIV_THROW_ERROR(
+          "bucket_lengths should be positive and strictly ascending.");
+    }
+  }
+  thread_ = std::thread(&Batcher::run, this);
+}
+
+Batcher::~Batcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  cond_.notify_one();
+  thread_.join();
+}
+
+std::future<Tensor> Batcher::push(
+    const Shape &shape, std::vector<float> data) {
+  if (shape.batch() != 1) {
+    PRIMITIV_THROW_ERROR(
+        "Batch size of the input should be 1. shape: " << shape.to_string());
+  }
+  if (data.size() != shape.size()) {
+    PRIMITIV_THROW_ERROR(
+        "Data sizes mismatched. required: " << shape.size()
+        << " (shape: " << shape.to_string() << ") != actual: " << data.size());
+  }
+
+  Request req;
+  req.length = shape[length_dim_];
+  Shape padded = shape;
+  const auto bound = std::lower_bound(
+      bucket_lengths_.begin(), bucket_lengths_.end(), req.length);
+  if (bound != bucket_lengths_.end() && *bound > req.length) {
+    padded = shape.resize_dim(length_dim_, *bound);
+    data = ::pad_data(data, shape, length_dim_, *bound, pad_value_);
+  }
+  req.deadline = Clock::now() + max_delay_;
+  req.data = std::move(data);
+  std::future<Tensor> future = req.promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buckets_[padded.dims()].emplace_back(std::move(req));
+  }
+  cond_.notify_one();
+  return future;
+}
+
+std::uint64_t Batcher::num_batches() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_batches_;
+}
+
+void Batcher::run() {
+  Graph g;
+  Graph::set_thread_default(g);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // Chooses the bucket with the oldest request from buckets which are full
+    // or exceed the deadline.
+    const Clock::time_point now = Clock::now();
+    auto ready = buckets_.end();
+    // The thread also wakes up periodically while no request is pending.
+    Clock::time_point next = now + std::chrono::seconds(1);
+    for (auto it = buckets_.begin(); it != buckets_.end(); ++it) {
+      const Clock::time_point deadline = it->second.front().deadline;
+      if (stopped_
+          || it->second.size() >= max_batch_size_ || deadline <= now) {
+        if (ready == buckets_.end()
+            || deadline < ready->second.front().deadline) {
+          ready = it;
+        }
+      } else if (deadline < next) {
+        next = deadline;
+      }
+    }
+
+    if (ready == buckets_.end()) {
+      if (stopped_) break;
+      cond_.wait_until(lock, next);
+      continue;
+    }
+
+    const Shape shape(ready->first);
+    std::deque<Request> &bucket = ready->second;
+    const std::size_t n = std::min<std::size_t>(bucket.size(), max_batch_size_);
+    std::vector<Request> requests;
+    requests.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      requests.emplace_back(std::move(bucket.front()));
+      bucket.pop_front();
+    }
+    if (bucket.empty()) buckets_.erase(ready);
+    ++num_batches_;
+
+    lock.unlock();
+    process(shape, requests);
+    g.clear();
+    lock.lock();
+  }
+
+  Graph::reset_thread_default();
+}
+
+void Batcher::process(const Shape &shape, std::vector<Request> &requests) {
+  namespace F = functions;
+  const std::uint32_t n = requests.size();
+  std::uint32_t done = 0;
+  try {
+    std::vector<Node> xs;
+    xs.reserve(n);
+    for (Request &req : requests) {
+      xs.emplace_back(F::input<Node>(shape, std::move(req.data), device_));
+    }
+    const Node x = n == 1 ? xs[0] : F::batch::concat(xs);
+    const Node y = func_(x);
+    if (y.shape().batch() != n) {
+      PRIMITIV_THROW_ERROR(
+          "Batch size of the output mismatched. required: " << n
+          << " != actual: " << y.shape().batch());
+    }
+
+    // Scatters the minibatch of outputs.
+    const Tensor &ys = y.graph().forward(y);
+    const std::uint32_t padded = shape[length_dim_];
+    for (; done < n; ++done) {
+      Tensor yi = n == 1 ? ys : F::batch::slice(ys, done, done + 1);
+      const std::uint32_t length = requests[done].length;
+      if (length < padded && yi.shape()[length_dim_] == padded) {
+        // Removes padded elements.
+        yi = F::slice(yi, length_dim_, 0, length);
+      }
+      requests[done].promise.set_value(std::move(yi));
+    }
+  } catch (...) {
+    for (; done < n; ++done) {
+      requests[done].promise.set_exception(std::current_exception());
+    }
+  }
+}
+
+}  // namespace primitiv
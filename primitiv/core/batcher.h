@@ -0,0 +1,200 @@
+#ifndef PRIMITIV_CORE_BATCHER_H_
+#define PRIMITIV_CORE_BATCHER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <primitiv/core/mixins/nonmovable.h>
+#include <primitiv/core/shape.h>
+#include <primitiv/core/tensor.h>
+
+namespace primitiv {
+
+class Device;
+class Node;
+
+/**
+ * Dynamic batching of inference requests.
+ * Requests pushed from multiple threads are collected for a limited time, and
+ * requests with the same input shape are processed by one computation graph
+ * as a minibatch.
+ *
+ * Usage:
+ *
+ *     Batcher batcher([&](const Node &x) { return model(x); }, 32, 1000);
+ *     // On each thread:
+ *     std::future<Tensor> y = batcher.push({256}, data);
+ *     std::vector<float> result = y.get().to_vector();
+ *
+ * Variable-length inputs can be batched together by length buckets, e.g.,
+ * inputs with the shape `{256, length}` are padded to the lengths 16, 32 or
+ * 64 with:
+ *
+ *     Batcher batcher(func, 32, 1000, 1, {16, 32, 64});
+ *
+ * @remarks The function is called on a background thread of the Batcher with
+ *          its own default Graph, and should not modify shared objects (e.g.,
+ *          use frozen parameters). The device should be accessible from other
+ *          threads.
+ */
+class Batcher : mixins::Nonmovable<Batcher> {
+public:
+  /**
+   * Type of functions to calculate outputs.
+   * The argument is the minibatch of inputs, and the function returns the
+   * minibatch of outputs with the same batch size.
+   */
+  using Function = std::function<Node(const Node &)>;
+
+  /**
+   * Creates a new Batcher object and starts the background thread.
+   * @param func Function to calculate outputs.
+   * @param max_batch_size Maximum number of requests in one minibatch.
+   * @param max_delay_us Maximum time in microseconds to wait for other
+   *                     requests after the first request of a minibatch
+   *                     arrived.
+   * @param device Device to manage inputs, or `nullptr` to use the default
+   *               device.
+   */
+  Batcher(
+      Function func,
+      std::uint32_t max_batch_size,
+      std::uint32_t max_delay_us,
+      Device *device = nullptr);
+
+  /**
+   * Creates a new Batcher object with length buckets and starts the
+   * background thread.
+   * @param func Function to calculate outputs.
+   * @param max_batch_size Maximum number of requests in one minibatch.
+   * @param max_delay_us Maximum time in microseconds to wait for other
+   *                     requests after the first request of a minibatch
+   *                     arrived.
+   * @param length_dim Dimension of inputs which holds the variable length.
+   * @param bucket_lengths Upper bounds of lengths of each bucket in the
+   *                       ascending order.
+   * @param pad_value Value of padded elements.
+   * @param device Device to manage inputs, or `nullptr` to use the default
+   *               device.
+   * @remarks Each input is padded with `pad_value` along `length_dim` to the
+   *          smallest bound in `bucket_lengths` which is not less than its
+   *          length. Inputs longer than every bound are not padded.
+   *          Outputs with the padded length along `length_dim` are sliced
+   *          back to the original length of the input, and other outputs are
+   *          returned as they are. The function should ignore padded
+   *          elements (e.g., by masking them) if they affect other elements.
+   */
+  Batcher(
+      Function func,
+      std::uint32_t max_batch_size,
+      std::uint32_t max_delay_us,
+      std::uint32_t length_dim,
+      std::vector<std::uint32_t> bucket_lengths,
+      float pad_value = 0,
+      Device *device = nullptr);
+
+  /**
+   * Processes all remaining requests and stops the background thread.
+   */
+  ~Batcher();
+
+  /**
+   * Registers a new request.
+   * @param shape Shape of the input. The batch size should be 1.
+   * @param data Values of the input with the column-major order.
+   * @return Future object which holds the output with the batch size 1, or
+   *         the exception thrown while calculating the minibatch.
+   * @remarks Requests are grouped into buckets by `shape` (after padding if
+   *          length buckets are given), and each minibatch consists of
+   *          requests in the same bucket.
+   */
+  std::future<Tensor> push(const Shape &shape, std::vector<float> data);
+
+  /**
+   * Retrieves the maximum number of requests in one minibatch.
+   * @return The maximum batch size.
+   */
+  std::uint32_t max_batch_size() const { return max_batch_size_; }
+
+  /**
+   * Retrieves the maximum delay of requests.
+   * @return The maximum delay in microseconds.
+   */
+  std::uint32_t max_delay_us() const {
+    return static_cast<std::uint32_t>(max_delay_.count());
+  }
+
+  /**
+   * Retrieves the dimension of variable lengths.
+   * @return The dimension used by length buckets.
+   */
+  std::uint32_t length_dim() const { return length_dim_; }
+
+  /**
+   * Retrieves upper bounds of lengths of each bucket.
+   * @return List of lengths, or an empty vector if inputs are not padded.
+   */
+  const std::vector<std::uint32_t> &bucket_lengths() const {
+    return bucket_lengths_;
+  }
+
+  /**
+   * Retrieves the value of padded elements.
+   * @return The padding value.
+   */
+  float pad_value() const { return pad_value_; }
+
+  /**
+   * Retrieves the number of minibatches processed so far.
+   * @return Number of minibatches.
+   */
+  std::uint64_t num_batches() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Request {
+    Clock::time_point deadline;
+    std::vector<float> data;
+    std::uint32_t length;
+    std::promise<Tensor> promise;
+  };
+
+  /**
+   * Main loop of the background thread.
+   */
+  void run();
+
+  /**
+   * Calculates outputs of one minibatch and fulfills their promises.
+   * @param shape Shape of each input after padding.
+   * @param requests Requests in the minibatch.
+   */
+  void process(const Shape &shape, std::vector<Request> &requests);
+
+  Function func_;
+  std::uint32_t max_batch_size_;
+  std::chrono::microseconds max_delay_;
+  std::uint32_t length_dim_;
+  std::vector<std::uint32_t> bucket_lengths_;
+  float pad_value_;
+  Device *device_;
+  std::map<std::vector<std::uint32_t>, std::deque<Request>> buckets_;
+  std::uint64_t num_batches_;
+  bool stopped_;
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread thread_;
+};
+
+}  // namespace primitiv
+
+#endif  // PRIMITIV_CORE_BATCHER_H_
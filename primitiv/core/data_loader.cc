@@ -0,0 +1,137 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include <primitiv/core/data_loader.h>
+#include <primitiv/core/device.h>
+#include <primitiv/core/error.h>
+
+namespace primitiv {
+
+constexpr std::chrono::hours DataLoader::MAX_WAIT;
+
+DataLoader::DataLoader(
+    std::vector<std::vector<std::uint32_t>> corpus,
+    std::uint32_t batch_size,
+    std::uint32_t num_prefetch,
+    bool shuffle,
+    std::uint32_t seed,
+    Function func,
+    Device *device)
+: corpus_(std::move(corpus))
+, batch_size_(batch_size)
+, num_prefetch_(num_prefetch)
+, shuffle_(shuffle)
+, seed_(seed)
+, func_(std::move(func))
+, device_(&Device::get_reference_or_default(device))
+, queue_()
+, stopped_(false) {
+  if (corpus_.empty()) PRIMITIV_THROW_ERROR("Corpus is empty.");
+  for (std::uint32_t i = 0; i < corpus_.size(); ++i) {
+    if (corpus_[i].empty()) {
+      PRIMITIV_THROW_ERROR("Sequence " << i << " is empty.");
+    }
+  }
+  if (batch_size_ == 0) {
+    PRIMITIV_THROW_ERROR("batch_size should be greater than 0.");
+  }
+  if (num_prefetch_ == 0) {
+    PRIMITIV_THROW_ERROR("num_prefetch should be greater than 0.");
+  }
+  thread_ = std::thread(&DataLoader::run, this);
+}
+
+DataLoader::~DataLoader() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  not_full_.notify_one();
+  thread_.join();
+}
+
+bool DataLoader::next(Batch &batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!not_empty_.wait_for(
+        lock, MAX_WAIT, [this]() { return !queue_.empty(); })) {}
+  Item item = std::move(queue_.front());
+  queue_.pop_front();
+  lock.unlock();
+  not_full_.notify_one();
+
+  if (item.error) std::rethrow_exception(item.error);
+  if (item.end) return false;
+  batch = std::move(item.batch);
+  return true;
+}
+
+void DataLoader::run() {
+  std::mt19937 rng(seed_);
+  while (true) {
+    for (std::vector<std::uint32_t> &indices : make_plan(rng)) {
+      Item item;
+      item.end = false;
+      try {
+        make_batch(std::move(indices), item.batch);
+      } catch (...) {
+        item.error = std::current_exception();
+      }
+      if (!push(std::move(item))) return;
+    }
+    Item item;
+    item.end = true;
+    if (!push(std::move(item))) return;
+  }
+}
+
+std::vector<std::vector<std::uint32_t>> DataLoader::make_plan(
+    std::mt19937 &rng) const {
+  std::vector<std::uint32_t> ids(corpus_.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  if (shuffle_) std::shuffle(ids.begin(), ids.end(), rng);
+
+  // Sequences with the same length keep the shuffled order.
+  std::stable_sort(
+      ids.begin(), ids.end(),
+      [&](std::uint32_t a, std::uint32_t b) {
+        return corpus_[a].size() < corpus_[b].size();
+      });
+
+  std::vector<std::vector<std::uint32_t>> plan;
+  plan.reserve(num_batches());
+  for (std::uint32_t ofs = 0; ofs < ids.size(); ofs += batch_size_) {
+    const std::uint32_t end = std::min<std::uint32_t>(
+        ofs + batch_size_, ids.size());
+    plan.emplace_back(ids.begin() + ofs, ids.begin() + end);
+  }
+  if (shuffle_) std::shuffle(plan.begin(), plan.end(), rng);
+  return plan;
+}
+
+void DataLoader::make_batch(
+    std::vector<std::uint32_t> indices, Batch &batch) const {
+  std::vector<std::vector<std::uint32_t>> seqs;
+  seqs.reserve(indices.size());
+  for (const std::uint32_t i : indices) seqs.emplace_back(corpus_[i]);
+  batch.sequences = PackedSequence(seqs);
+  batch.indices = std::move(indices);
+  if (func_) batch.tensors = func_(batch.sequences, *device_);
+}
+
+bool DataLoader::push(Item item) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!not_full_.wait_for(lock, MAX_WAIT, [this]() {
+          return stopped_ || queue_.size() < num_prefetch_;
+    })) {}
+    if (stopped_) return false;
+    queue_.emplace_back(std::move(item));
+  }
+  not_empty_.notify_one();
+  return true;
+}
+
+}  // namespace primitiv
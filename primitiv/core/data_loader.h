@@ -0,0 +1,198 @@
+#ifndef PRIMITIV_CORE_DATA_LOADER_H_
+#define PRIMITIV_CORE_DATA_LOADER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <primitiv/core/mixins/nonmovable.h>
+#include <primitiv/core/packed_sequence.h>
+#include <primitiv/core/tensor.h>
+
+namespace primitiv {
+
+class Device;
+
+/**
+ * Asynchronous minibatch loader of sequence corpora.
+ * Sequences with similar lengths are grouped into the same minibatch, and a
+ * background thread prepares following minibatches while the caller is
+ * training on the current one.
+ *
+ * Usage:
+ *
+ *     DataLoader loader(corpus, 64, 4, true, seed);
+ *     DataLoader::Batch batch;
+ *     for (std::uint32_t epoch = 0; epoch < num_epochs; ++epoch) {
+ *       while (loader.next(batch)) {
+ *         // Uses batch.sequences (and batch.tensors).
+ *       }
+ *     }
+ *
+ * @remarks The function is called on the background thread, and the device
+ *          should be accessible from other threads.
+ */
+class DataLoader : mixins::Nonmovable<DataLoader> {
+public:
+  /**
+   * Minibatch prepared by the loader.
+   */
+  struct Batch {
+    /**
+     * Indices of sequences in the corpus.
+     */
+    std::vector<std::uint32_t> indices;
+
+    /**
+     * Packed sequences. `sequences.order()` refers `indices`.
+     */
+    PackedSequence sequences;
+
+    /**
+     * Tensors made by the user function, or empty if no function is given.
+     */
+    std::vector<Tensor> tensors;
+  };
+
+  /**
+   * Type of functions to make tensors of each minibatch, e.g., inputs and
+   * labels which are transferred to the device in advance.
+   */
+  using Function = std::function<
+    std::vector<Tensor>(const PackedSequence &, Device &)>;
+
+  /**
+   * Creates a new DataLoader object and starts the background thread.
+   * @param corpus List of sequences of IDs. Every sequence should have at
+   *               least one element.
+   * @param batch_size Maximum number of sequences in one minibatch.
+   * @param num_prefetch Maximum number of minibatches prepared in advance.
+   * @param shuffle Whether to shuffle sequences with the same length and the
+   *                order of minibatches at every epoch. If `false`,
+   *                minibatches are always generated in the ascending order of
+   *                lengths.
+   *                Sequences are not exchanged across lengths: each minibatch
+   *                always holds a contiguous range of the sorted lengths, and
+   *                only sequences in a group of the same length are mixed
+   *                between epochs.
+   * @param seed Seed value of the random number generator for shuffling.
+   * @param func Function to make tensors of each minibatch, or an empty
+   *             function.
+   * @param device Device passed to `func`, or `nullptr` to use the default
+   *               device.
+   */
+  DataLoader(
+      std::vector<std::vector<std::uint32_t>> corpus,
+      std::uint32_t batch_size,
+      std::uint32_t num_prefetch,
+      bool shuffle,
+      std::uint32_t seed,
+      Function func = Function(),
+      Device *device = nullptr);
+
+  /**
+   * Stops the background thread and discards remaining minibatches.
+   */
+  ~DataLoader();
+
+  /**
+   * Retrieves the next minibatch.
+   * This function blocks until the minibatch becomes ready.
+   * @param batch Object to store the minibatch.
+   * @return `true` if `batch` was filled, or `false` at the end of each epoch.
+   *         The next call after returning `false` starts a new epoch.
+   * @throw primitiv::Error or other exceptions thrown while preparing the
+   *        minibatch. The next call retrieves the following minibatch.
+   */
+  bool next(Batch &batch);
+
+  /**
+   * Retrieves the number of sequences in the corpus.
+   * @return Number of sequences.
+   */
+  std::uint32_t num_sequences() const { return corpus_.size(); }
+
+  /**
+   * Retrieves the number of minibatches in one epoch.
+   * @return Number of minibatches.
+   */
+  std::uint32_t num_batches() const {
+    return (corpus_.size() + batch_size_ - 1) / batch_size_;
+  }
+
+  /**
+   * Retrieves the maximum number of sequences in one minibatch.
+   * @return The maximum batch size.
+   */
+  std::uint32_t batch_size() const { return batch_size_; }
+
+  /**
+   * Retrieves the maximum number of minibatches prepared in advance.
+   * @return Number of minibatches.
+   */
+  std::uint32_t num_prefetch() const { return num_prefetch_; }
+
+private:
+  // NOTE:
+  // Waits are woken up by notifications. The timeout only splits an
+  // unbounded wait, because `std::condition_variable::wait()` requires a
+  // newer runtime than timed waits with some standard libraries.
+  static constexpr std::chrono::hours MAX_WAIT { 24 };
+
+  struct Item {
+    bool end;
+    Batch batch;
+    std::exception_ptr error;
+  };
+
+  /**
+   * Main loop of the background thread.
+   */
+  void run();
+
+  /**
+   * Splits the corpus into minibatches of one epoch.
+   * @param rng Random number generator.
+   * @return List of indices of each minibatch.
+   */
+  std::vector<std::vector<std::uint32_t>> make_plan(std::mt19937 &rng) const;
+
+  /**
+   * Prepares one minibatch.
+   * @param indices Indices of sequences.
+   * @param batch Object to store the minibatch.
+   */
+  void make_batch(std::vector<std::uint32_t> indices, Batch &batch) const;
+
+  /**
+   * Waits until the queue has a space and appends an item.
+   * @param item Item to be appended.
+   * @return `false` if the loader was stopped, `true` otherwise.
+   */
+  bool push(Item item);
+
+  std::vector<std::vector<std::uint32_t>> corpus_;
+  std::uint32_t batch_size_;
+  std::uint32_t num_prefetch_;
+  bool shuffle_;
+  std::uint32_t seed_;
+  Function func_;
+  Device *device_;
+  std::deque<Item> queue_;
+  bool stopped_;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::thread thread_;
+};
+
+}  // namespace primitiv
+
+#endif  // PRIMITIV_CORE_DATA_LOADER_H_
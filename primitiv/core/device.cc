@@ -1,7 +1,10 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
+
 #include <primitiv/core/device.h>
 #include <primitiv/core/error.h>
+#include <primitiv/core/numeric_utils.h>
 #include <primitiv/core/shape_ops.h>
 
 using std::vector;
@@ -15,6 +18,14 @@ using std::vector;
         << " != this: " << this); \
   }
 
+#define CHECK_SAME_SHAPE(name, x, a) \
+  if ((a).shape() != (x).shape()) { \
+    PRIMITIV_THROW_ERROR( \
+        "Shape mismatched at " #name \
+        << ". " #x ".shape: " << (x).shape().to_string() \
+        << ", " #a ".shape: " << (a).shape().to_string()); \
+  }
+
 namespace primitiv {
 
 Tensor Device::new_raw_tensor(const Shape &shape) {
@@ -40,9 +51,227 @@ Tensor Device::new_tensor_by_vector(
   return ret;
 }
 
+Tensor Device::new_tensor_by_vector(
+    const Shape &shape, vector<float> &&values) {
+  if (values.size() != shape.size()) {
+    PRIMITIV_THROW_ERROR(
+        "Data sizes mismatched. required: " << shape.size()
+        << " (shape: " << shape.to_string() << ") != actual: "
+        << values.size());
+  }
+  const auto holder = std::make_shared<vector<float>>(std::move(values));
+  return new_tensor_by_shared_array(
+      shape, std::shared_ptr<float>(holder, holder->data()));
+}
+
+Tensor Device::new_tensor_by_shared_array(
+    const Shape &shape, const std::shared_ptr<float> &values) {
+  const std::uint32_t group
+    = static_cast<std::uint32_t>(type())
+    & static_cast<std::uint32_t>(DeviceType::GROUP_FILTER);
+  const bool aligned
+    = reinterpret_cast<std::uintptr_t>(values.get()) % alignof(float) == 0;
+  if (group == static_cast<std::uint32_t>(DeviceType::GROUP_CPU) && aligned) {
+    return Tensor(shape, *this, values);
+  }
+  return new_tensor_by_array(shape, values.get());
+}
+
+Tensor Device::new_tensor_by_dlpack(
+    dlpack::DLManagedTensor *src, bool batched) {
+  if (!src) PRIMITIV_THROW_ERROR("Descriptor is null.");
+  const std::shared_ptr<dlpack::DLManagedTensor> holder(
+      src, [](dlpack::DLManagedTensor *p) { if (p->deleter) p->deleter(p); });
+  const dlpack::DLTensor &dl = src->dl_tensor;
+
+  if (dl.device.device_type != dlpack::DEVICE_CPU) {
+    PRIMITIV_THROW_ERROR(
+        "Only the host memory is supported. device_type: "
+        << dl.device.device_type);
+  }
+  if (dl.dtype.code != dlpack::TYPE_FLOAT || dl.dtype.bits != 32 ||
+      dl.dtype.lanes != 1) {
+    PRIMITIV_THROW_ERROR(
+        "Only single-precision values are supported. code: "
+        << static_cast<std::uint32_t>(dl.dtype.code)
+        << ", bits: " << static_cast<std::uint32_t>(dl.dtype.bits)
+        << ", lanes: " << dl.dtype.lanes);
+  }
+  const std::int32_t ndim = dl.ndim;
+  const std::int32_t depth = batched ? ndim - 1 : ndim;
+  if (depth < 0 || depth > static_cast<std::int32_t>(Shape::MAX_DEPTH)) {
+    PRIMITIV_THROW_ERROR(
+        "Invalid number of dimensions. ndim: " << ndim
+        << ", batched: " << batched);
+  }
+  if (ndim > 0 && !dl.shape) PRIMITIV_THROW_ERROR("Shape is null.");
+  for (std::int32_t i = 0; i < ndim; ++i) {
+    if (dl.shape[i] <= 0 || dl.shape[i] > 0xffffffffll) {
+      PRIMITIV_THROW_ERROR(
+          "Invalid dimension. shape[" << i << "]: " << dl.shape[i]);
+    }
+  }
+  if (!dl.data) PRIMITIV_THROW_ERROR("Data is null.");
+
+  const vector<std::uint32_t> dims(dl.shape, dl.shape + depth);
+  const Shape shape(
+      dims, batched ? static_cast<std::uint32_t>(dl.shape[depth]) : 1);
+  float *data = reinterpret_cast<float *>(
+      static_cast<char *>(dl.data) + dl.byte_offset);
+
+  // Null strides represent the compact row-major order.
+  vector<std::int64_t> strides(ndim);
+  if (dl.strides) {
+    strides.assign(dl.strides, dl.strides + ndim);
+  } else {
+    std::int64_t stride = 1;
+    for (std::int32_t i = ndim - 1; i >= 0; --i) {
+      strides[i] = stride;
+      stride *= dl.shape[i];
+    }
+  }
+
+  // Strides of dimensions with size 1 are ignored.
+  bool column_major = true;
+  std::int64_t expected = 1;
+  for (std::int32_t i = 0; i < ndim; ++i) {
+    if (dl.shape[i] > 1 && strides[i] != expected) column_major = false;
+    expected *= dl.shape[i];
+  }
+  if (column_major) {
+    return new_tensor_by_shared_array(
+        shape, std::shared_ptr<float>(holder, data));
+  }
+
+  vector<float> values(shape.size());
+  vector<std::int64_t> index(ndim, 0);
+  for (float &value : values) {
+    std::int64_t offset = 0;
+    for (std::int32_t i = 0; i < ndim; ++i) offset += index[i] * strides[i];
+    value = data[offset];
+    for (std::int32_t i = 0; i < ndim; ++i) {
+      if (++index[i] < dl.shape[i]) break;
+      index[i] = 0;
+    }
+  }
+  return new_tensor_by_vector(shape, std::move(values));
+}
+
+Tensor Device::packed_storage(const Tensor &x) {
+  return Tensor(
+      Shape({packed_size(x.shape(), x.precision())}),
+      x.device(), x.handle_);
+}
+
 vector<float> Device::tensor_to_vector(const Tensor &x) {
   CHECK_DEVICE(x);
-  return tensor_to_vector_impl(x);
+  if (x.precision() == Precision::FLOAT32) {
+    return tensor_to_vector_impl(x);
+  }
+  const Shape &s = x.shape();
+  const vector<float> packed = tensor_to_vector_impl(packed_storage(x));
+  vector<float> ret(s.size());
+  if (x.precision() == Precision::INT8) {
+    const std::uint32_t num_scales = s[0] * s.batch();
+    numeric_utils::dequantize_int8(
+        packed.data(),
+        reinterpret_cast<const std::int8_t *>(packed.data() + num_scales),
+        s[0], s.volume() / s[0], s.batch(), ret.data());
+  } else {
+    numeric_utils::decode_packed(
+        packed.data(), x.precision(), ret.size(), ret.data());
+  }
+  return ret;
+}
+
+void Device::tensor_to_array(
+    const Tensor &x, std::uint32_t offset, std::uint32_t size,
+    float values[]) {
+  CHECK_DEVICE(x);
+  const std::uint32_t x_size = x.shape().size();
+  if (offset > x_size || size > x_size - offset) {
+    PRIMITIV_THROW_ERROR(
+        "Invalid range to retrieve values. shape: "
+        << x.shape().to_string() << ", offset: " << offset
+        << ", size: " << size);
+  }
+  if (size == 0) return;
+  switch (x.precision()) {
+    case Precision::FLOAT32:
+      tensor_to_array_impl(x, offset, size, values);
+      return;
+    case Precision::FLOAT16:
+    case Precision::BFLOAT16:
+      {
+        // Decodes the range of packed words including all requested values.
+        const std::uint32_t begin = offset & ~1u;
+        const std::uint32_t num_decoded = offset + size - begin;
+        vector<float> packed((num_decoded + 1) / 2);
+        tensor_to_array_impl(
+            packed_storage(x), begin / 2, packed.size(), packed.data());
+        vector<float> decoded(num_decoded);
+        numeric_utils::decode_packed(
+            packed.data(), x.precision(), num_decoded, decoded.data());
+        std::copy(
+            decoded.begin() + (offset - begin), decoded.end(), values);
+        return;
+      }
+    default:
+      {
+        // Retrieves only scales and quantized values used by the range.
+        const Shape &s = x.shape();
+        const Tensor storage = packed_storage(x);
+        const std::uint32_t rows = s[0];
+        const std::uint32_t volume = s.volume();
+        const std::uint32_t num_scales = rows * s.batch();
+        const std::uint32_t end = offset + size;
+        const std::uint32_t b0 = offset / volume;
+        const std::uint32_t b1 = (end - 1) / volume;
+        const std::uint32_t first_row = offset % rows;
+        const std::uint32_t last_row = (end - 1) % rows;
+
+        // Ranges of scales, which are ordered by (batch, row).
+        struct ScaleRange {
+          std::uint32_t begin;
+          vector<float> scales;
+        };
+        vector<ScaleRange> ranges;
+        const auto add_range = [&](std::uint32_t begin, std::uint32_t end) {
+          ranges.push_back(ScaleRange { begin, vector<float>(end - begin) });
+          tensor_to_array_impl(
+              storage, begin, end - begin, ranges.back().scales.data());
+        };
+        if (size >= rows) {
+          add_range(b0 * rows, (b1 + 1) * rows);
+        } else if (first_row <= last_row) {
+          add_range(b0 * rows + first_row, b0 * rows + last_row + 1);
+        } else if (b0 != b1) {
+          add_range(b0 * rows + first_row, b1 * rows + last_row + 1);
+        } else {
+          add_range(b0 * rows + first_row, (b0 + 1) * rows);
+          add_range(b0 * rows, b0 * rows + last_row + 1);
+        }
+
+        // Quantized values are stored 4 bytes per word after scales.
+        const std::uint32_t word_begin = offset / 4;
+        const std::uint32_t word_end = (end + 3) / 4;
+        vector<float> words(word_end - word_begin);
+        tensor_to_array_impl(
+            storage, num_scales + word_begin, words.size(), words.data());
+        const std::int8_t *src
+          = reinterpret_cast<const std::int8_t *>(words.data())
+          + (offset - 4 * word_begin);
+
+        for (std::uint32_t k = offset; k < end; ++k) {
+          const std::uint32_t index = k / volume * rows + k % rows;
+          const ScaleRange *r = &ranges[0];
+          if (index < r->begin || index >= r->begin + r->scales.size()) {
+            r = &ranges[1];
+          }
+          values[k - offset] = r->scales[index - r->begin] * src[k - offset];
+        }
+      }
+  }
 }
 
 vector<std::uint32_t> Device::argmax(const Tensor &x, std::uint32_t dim) {
@@ -82,11 +311,91 @@ Tensor Device::copy_tensor(const Tensor &x) {
   // NOTE(odashi):
   // This function should return always different memory with x.
   if (!x.valid()) PRIMITIV_THROW_ERROR("Attempted to copy an invalid tensor.");
+  if (x.precision() != Precision::FLOAT32) {
+    // Copies the packed memory as single precision values.
+    const Tensor y = copy_tensor(packed_storage(x));
+    return Tensor(x.shape(), *this, y.handle_, x.precision());
+  }
   Tensor y = new_raw_tensor(x.shape());
   copy_tensor_impl(x, y);
   return y;
 }
 
+Tensor Device::copy_tensor(const Tensor &x, Precision precision) {
+  if (!x.valid()) PRIMITIV_THROW_ERROR("Attempted to copy an invalid tensor.");
+  if (x.precision() == precision) return copy_tensor(x);
+  const vector<float> values = x.to_vector();
+  switch (precision) {
+    case Precision::FLOAT32:
+      return new_tensor_by_vector(x.shape(), values);
+    case Precision::FLOAT16:
+    case Precision::BFLOAT16:
+      {
+        const std::uint32_t size = x.shape().size();
+        const std::uint32_t storage_size = packed_size(size, precision);
+        vector<float> packed(storage_size, 0);
+        numeric_utils::encode_packed(
+            values.data(), precision, size, packed.data());
+        const Tensor y = new_tensor_by_vector({storage_size}, packed);
+        return Tensor(x.shape(), *this, y.handle_, precision);
+      }
+    case Precision::INT8:
+      {
+        const Shape &s = x.shape();
+        const std::uint32_t num_scales = s[0] * s.batch();
+        const std::uint32_t storage_size = packed_size(s, precision);
+        vector<float> packed(storage_size, 0);
+        numeric_utils::quantize_int8(
+            values.data(), s[0], s.volume() / s[0], s.batch(), packed.data(),
+            reinterpret_cast<std::int8_t *>(packed.data() + num_scales));
+        const Tensor y = new_tensor_by_vector({storage_size}, packed);
+        return Tensor(s, *this, y.handle_, precision);
+      }
+    default:
+      PRIMITIV_THROW_ERROR(
+          "Invalid precision: " << static_cast<std::uint32_t>(precision));
+  }
+}
+
+void Device::check_view_range(
+    const Tensor &x, std::uint32_t offset, const Shape &shape) {
+  CHECK_DEVICE(x);
+  check_single_precision(x);
+  if (offset + shape.size() > x.shape().size()) {
+    PRIMITIV_THROW_ERROR(
+        "Invalid range of the view. offset: " << offset
+        << ", shape: " << shape.to_string()
+        << ", x.shape: " << x.shape().to_string());
+  }
+}
+
+Tensor Device::new_view(
+    const Tensor &x, std::uint32_t offset, const Shape &shape) {
+  check_view_range(x, offset, shape);
+  void *data = offset_handle(const_cast<void *>(x.handle()), offset);
+  // NOTE:
+  // The view has its own reference counter so that in-place operations on the
+  // view do not duplicate the memory, and the deleter retains the source.
+  std::shared_ptr<void> source = x.handle_;
+  return Tensor(
+      shape, *this, std::shared_ptr<void>(data, [source](void *) {}));
+}
+
+Tensor Device::new_shared_view(
+    const Tensor &x, std::uint32_t offset, const Shape &shape) {
+  check_view_range(x, offset, shape);
+  void *data = offset_handle(const_cast<void *>(x.handle()), offset);
+  return Tensor(shape, *this, std::shared_ptr<void>(x.handle_, data));
+}
+
+bool Device::is_view(
+    const Tensor &view, const Tensor &x, std::uint32_t offset) {
+  if (!view.valid() || !x.valid()) return false;
+  if (&view.device() != this || &x.device() != this) return false;
+  if (offset + view.shape().size() > x.shape().size()) return false;
+  return view.handle() == offset_handle(const_cast<void *>(x.handle()), offset);
+}
+
 Tensor Device::identity(std::uint32_t size) {
   if (size == 0) {
     PRIMITIV_THROW_ERROR("Invalid size of the identity matrix: " << size);
@@ -139,6 +448,10 @@ Tensor Device::random_log_normal(const Shape &shape, float mean, float sd) {
   return y;
 }
 
+std::uint32_t Device::random_seed() {
+  return random_seed_impl();
+}
+
 Tensor Device::pick_fw(
     const Tensor &x, const vector<std::uint32_t> &ids, std::uint32_t dim) {
   CHECK_DEVICE(x);
@@ -676,6 +989,33 @@ void Device::batch_slice_bw(
   batch_slice_bw_impl(gy, offset, gx);
 }
 
+Tensor Device::dropout_fw(
+    const Tensor &x, float rate, std::uint32_t seed) {
+  CHECK_DEVICE(x);
+  if (!(rate >= 0 && rate < 1)) {
+    PRIMITIV_THROW_ERROR("Invalid dropout rate: " << rate);
+  }
+  Tensor y = new_raw_tensor(x.shape());
+  dropout_fw_impl(x, rate, seed, y);
+  return y;
+}
+
+void Device::dropout_bw(
+    const Tensor &gy, float rate, std::uint32_t seed, Tensor &gx) {
+  CHECK_DEVICE(gy);
+  CHECK_DEVICE(gx);
+  if (!(rate >= 0 && rate < 1)) {
+    PRIMITIV_THROW_ERROR("Invalid dropout rate: " << rate);
+  }
+  if (gy.shape() != gx.shape()) {
+    PRIMITIV_THROW_ERROR(
+        "Shape mismatched at dropout_bw"
+        << ". gy.shape: " << gy.shape().to_string()
+        << ", gx.shape: " << gx.shape().to_string());
+  }
+  dropout_bw_impl(gy, rate, seed, gx);
+}
+
 void Device::inplace_multiply_const(float k, Tensor &x) {
   CHECK_DEVICE(x);
   inplace_multiply_const_impl(k, x);
@@ -707,4 +1047,120 @@ void Device::inplace_subtract(const Tensor &x, Tensor &y) {
   inplace_subtract_impl(x, y);
 }
 
+void Device::inplace_pick_assign(
+    const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+    Tensor &y) {
+  CHECK_DEVICE(x);
+  CHECK_DEVICE(y);
+  const Shape sx = shape_ops::pick(y.shape(), ids, dim);
+  if (x.shape() != sx) {
+    PRIMITIV_THROW_ERROR(
+        "Shape mismatched. x.shape(): " << x.shape().to_string()
+        << " != expected shape: " << sx.to_string());
+  }
+  if (x.precision() != y.precision() || x.precision() == Precision::INT8) {
+    PRIMITIV_THROW_ERROR(
+        "Invalid precisions of inplace_pick_assign. x.precision: "
+        << static_cast<std::uint32_t>(x.precision())
+        << ", y.precision: " << static_cast<std::uint32_t>(y.precision()));
+  }
+  inplace_pick_assign_impl(x, ids, dim, y);
+}
+
+void Device::inplace_pick_reset(
+    float k, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+    Tensor &y) {
+  CHECK_DEVICE(y);
+  shape_ops::pick(y.shape(), ids, dim);  // Checks arguments.
+  inplace_pick_reset_impl(k, ids, dim, y);
+}
+
+void Device::sgd_update(const Tensor &g, float eta, Tensor &x) {
+  CHECK_DEVICE(g);
+  CHECK_DEVICE(x);
+  CHECK_SAME_SHAPE(sgd_update, x, g);
+  sgd_update_impl(g, eta, x);
+}
+
+void Device::momentum_sgd_update(
+    const Tensor &g, float eta, float momentum, Tensor &m, Tensor &x) {
+  CHECK_DEVICE(g);
+  CHECK_DEVICE(m);
+  CHECK_DEVICE(x);
+  CHECK_SAME_SHAPE(momentum_sgd_update, x, g);
+  CHECK_SAME_SHAPE(momentum_sgd_update, x, m);
+  momentum_sgd_update_impl(g, eta, momentum, m, x);
+}
+
+void Device::adagrad_update(
+    const Tensor &g, float eta, float eps, Tensor &m, Tensor &x) {
+  CHECK_DEVICE(g);
+  CHECK_DEVICE(m);
+  CHECK_DEVICE(x);
+  CHECK_SAME_SHAPE(adagrad_update, x, g);
+  CHECK_SAME_SHAPE(adagrad_update, x, m);
+  adagrad_update_impl(g, eta, eps, m, x);
+}
+
+void Device::rmsprop_update(
+    const Tensor &g, float eta, float alpha, float eps, Tensor &m, Tensor &x) {
+  CHECK_DEVICE(g);
+  CHECK_DEVICE(m);
+  CHECK_DEVICE(x);
+  CHECK_SAME_SHAPE(rmsprop_update, x, g);
+  CHECK_SAME_SHAPE(rmsprop_update, x, m);
+  rmsprop_update_impl(g, eta, alpha, eps, m, x);
+}
+
+void Device::adadelta_update(
+    const Tensor &g, float scale, float rho, float eps,
+    Tensor &m1, Tensor &m2, Tensor &x) {
+  CHECK_DEVICE(g);
+  CHECK_DEVICE(m1);
+  CHECK_DEVICE(m2);
+  CHECK_DEVICE(x);
+  CHECK_SAME_SHAPE(adadelta_update, x, g);
+  CHECK_SAME_SHAPE(adadelta_update, x, m1);
+  CHECK_SAME_SHAPE(adadelta_update, x, m2);
+  adadelta_update_impl(g, scale, rho, eps, m1, m2, x);
+}
+
+void Device::adam_update(
+    const Tensor &g, float alpha, float beta1, float beta2, float eps,
+    std::uint32_t epoch, Tensor &m1, Tensor &m2, Tensor &x) {
+  CHECK_DEVICE(g);
+  CHECK_DEVICE(m1);
+  CHECK_DEVICE(m2);
+  CHECK_DEVICE(x);
+  CHECK_SAME_SHAPE(adam_update, x, g);
+  CHECK_SAME_SHAPE(adam_update, x, m1);
+  CHECK_SAME_SHAPE(adam_update, x, m2);
+  const Precision precision = m1.precision();
+  const bool valid = precision == Precision::FLOAT32
+    ? m2.precision() == Precision::FLOAT32
+    : (precision == Precision::FLOAT16 || precision == Precision::BFLOAT16)
+      && m2.precision() == Precision::BFLOAT16;
+  if (!valid) {
+    PRIMITIV_THROW_ERROR(
+        "Invalid precisions of moments in adam_update. m1.precision: "
+        << static_cast<std::uint32_t>(precision)
+        << ", m2.precision: " << static_cast<std::uint32_t>(m2.precision()));
+  }
+  if (epoch == 0) {
+    PRIMITIV_THROW_ERROR("Invalid epoch of adam_update: " << epoch);
+  }
+  if (precision == Precision::FLOAT32) {
+    adam_update_impl(g, alpha, beta1, beta2, eps, epoch, m1, m2, x);
+  } else {
+    adam_update_packed_impl(
+        g, alpha, beta1, beta2, eps, epoch, precision, m1, m2, x);
+  }
+}
+
+float Device::squared_norm(const std::vector<const Tensor *> &xs) {
+  for (const Tensor *x : xs) CHECK_DEVICE(*x);
+  if (xs.empty()) return 0;
+  return squared_norm_impl(xs);
+}
+
 }  // namespace primitiv
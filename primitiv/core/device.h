@@ -6,6 +6,7 @@
 
 #include <primitiv/core/mixins/default_settable.h>
 #include <primitiv/core/mixins/nonmovable.h>
+#include <primitiv/core/precision.h>
 #include <primitiv/core/shape.h>
 #include <primitiv/core/tensor.h>
 
@@ -65,6 +66,37 @@ private:
    */
   Tensor new_raw_tensor(const Shape &shape);
 
+  /**
+   * Provides a single precision tensor that shares the packed memory of a
+   * tensor.
+   * @param x A tensor.
+   * @return A new Tensor object with the shape `{packed_size}`.
+   */
+  static Tensor packed_storage(const Tensor &x);
+
+  /**
+   * Checks whether the tensor holds single precision values or not.
+   * @param x A tensor.
+   * @throw primitiv::Error `x` has a reduced precision.
+   */
+  static void check_single_precision(const Tensor &x) {
+    if (x.precision() != Precision::FLOAT32) {
+      PRIMITIV_THROW_ERROR(
+          "This operation does not support tensors with reduced precisions. "
+          "precision: " << static_cast<std::uint32_t>(x.precision()));
+    }
+  }
+
+  /**
+   * Checks whether a view can be made from the tensor or not.
+   * @param x A source tensor.
+   * @param offset Offset of the first element in `x`.
+   * @param shape Shape of the view.
+   * @throw primitiv::Error The range exceeds `x` or `x` is not supported.
+   */
+  void check_view_range(
+      const Tensor &x, std::uint32_t offset, const Shape &shape);
+
 public:
   /**
    * Provides a new Tensor object with same-value elements.
@@ -91,6 +123,50 @@ public:
   Tensor new_tensor_by_vector(
       const Shape &shape, const std::vector<float> &values);
 
+  /**
+   * Provides a new Tensor object with specific values.
+   * @param shape Shape of the tensor.
+   * @param values List of internal values.
+   * @return A new Tensor object.
+   * @remarks Devices on the host (e.g., Naive and Eigen) take the ownership of
+   *          `values` and use it as the internal memory of the resulting
+   *          tensor without copying.
+   */
+  Tensor new_tensor_by_vector(const Shape &shape, std::vector<float> &&values);
+
+  /**
+   * Provides a new Tensor object using an array on the host memory.
+   * @param shape Shape of the tensor.
+   * @param values Shared pointer to the array of internal values. The array
+   *               should have at least `shape.size()` writable elements.
+   * @return A new Tensor object.
+   * @remarks Devices on the host (e.g., Naive and Eigen) use `values` directly
+   *          as the internal memory of the resulting tensor if it is aligned
+   *          to `float`. Otherwise the values are copied to a new memory.
+   *          Since the array may be shared with other objects, the resulting
+   *          tensor should not be updated through `values`.
+   */
+  Tensor new_tensor_by_shared_array(
+      const Shape &shape, const std::shared_ptr<float> &values);
+
+  /**
+   * Provides a new Tensor object using a DLPack descriptor.
+   * @param src Descriptor of a single-precision tensor on the host memory.
+   *            This function takes the ownership of `src` and calls its
+   *            `deleter` when the memory is no longer used, even if an error
+   *            occurred.
+   * @param batched If true, the last dimension of `src` is treated as the
+   *                batch size.
+   * @return A new Tensor object.
+   * @throw primitiv::Error `src` has an unsupported device, data type or
+   *                        shape.
+   * @remarks Values in the column-major order are used without copying as
+   *          described in `new_tensor_by_shared_array()`. Values with other
+   *          strides (e.g., the row-major order) are copied into the
+   *          column-major order.
+   */
+  Tensor new_tensor_by_dlpack(dlpack::DLManagedTensor *src, bool batched);
+
   /**
    * Copies the tensor to this device with allocating a new memory.
    * @param x A tensor to be copied.
@@ -101,6 +177,58 @@ public:
    */
   Tensor copy_tensor(const Tensor &x);
 
+  /**
+   * Copies the tensor to this device with converting the storage format.
+   * @param x A tensor to be copied.
+   * @param precision Storage format of the resulting tensor.
+   * @return Copied tensor.
+   * @remarks 16-bit formats halve the memory of tensors. Values are rounded to
+   *          the nearest even. `Precision::INT8` quantizes each row (the first
+   *          dimension) with its own scale. The conversion is performed
+   *          through the host memory.
+   */
+  Tensor copy_tensor(const Tensor &x, Precision precision);
+
+  /**
+   * Provides a new Tensor object that shares a part of the internal memory of
+   * another tensor.
+   * @param x A source tensor.
+   * @param offset Offset of the first element in `x`.
+   * @param shape Shape of the new tensor.
+   * @return A new Tensor object that refers the range
+   *         `[offset, offset + shape.size())` of `x`.
+   * @remarks The view keeps the memory of `x` alive, and the copy-on-write is
+   *          not applied between the view and `x` (or other views of `x`).
+   *          In-place operations on copies of the view still duplicate the
+   *          memory and detach the copy from `x`.
+   */
+  Tensor new_view(const Tensor &x, std::uint32_t offset, const Shape &shape);
+
+  /**
+   * Provides a new tensor that refers a range of the memory of another tensor
+   * and shares the reference counter with it.
+   * @param x A source tensor.
+   * @param offset Offset of the first element in `x`.
+   * @param shape Shape of the new tensor.
+   * @return A new Tensor object that refers the range
+   *         `[offset, offset + shape.size())` of `x`.
+   * @remarks Unlike `new_view()`, the copy-on-write is applied between the
+   *          view and `x`: in-place operations on either of them duplicate
+   *          the memory while the other one is alive.
+   */
+  Tensor new_shared_view(
+      const Tensor &x, std::uint32_t offset, const Shape &shape);
+
+  /**
+   * Checks whether a tensor is a view of another tensor.
+   * @param view A tensor to be checked.
+   * @param x A source tensor.
+   * @param offset Expected offset of `view` in `x`.
+   * @return true if `view` refers the memory of `x` starting at `offset`,
+   *         false otherwise.
+   */
+  bool is_view(const Tensor &view, const Tensor &x, std::uint32_t offset);
+
   // Provides an identity matrix.
   Tensor identity(std::uint32_t size);
 
@@ -110,6 +238,13 @@ public:
   Tensor random_normal(const Shape &shape, float mean, float sd);
   Tensor random_log_normal(const Shape &shape, float mean, float sd);
 
+  /**
+   * Draws a seed value for stateless random operations from the random number
+   * generator of this device.
+   * @return A new seed value.
+   */
+  std::uint32_t random_seed();
+
   // Tensor manipulations.
   Tensor pick_fw(const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim);
   Tensor slice_fw(const Tensor &x, std::uint32_t dim, std::uint32_t lower, std::uint32_t upper);
@@ -177,6 +312,26 @@ public:
 
   void pown_bw(const Tensor &x, const Tensor &y, const Tensor &gy, std::int32_t k, Tensor &gx);
 
+  /**
+   * Applies the dropout using a mask generated from the seed.
+   * @param x A tensor to be masked.
+   * @param rate Dropout probability in [0, 1).
+   * @param seed A seed value of the mask.
+   * @return A tensor in which each element is either 0 or x / (1 - rate).
+   * @remarks The mask is never stored. `dropout_bw()` regenerates the same
+   *          mask from the same seed.
+   */
+  Tensor dropout_fw(const Tensor &x, float rate, std::uint32_t seed);
+
+  /**
+   * Calculates gradients of the dropout.
+   * @param gy Gradients of the output.
+   * @param rate Dropout probability used at `dropout_fw()`.
+   * @param seed A seed value used at `dropout_fw()`.
+   * @param gx A tensor to which the gradients are accumulated.
+   */
+  void dropout_bw(const Tensor &gy, float rate, std::uint32_t seed, Tensor &gx);
+
   // Tensor-scalar operations.
   Tensor add_scalar_fw(const Tensor &x, const Tensor &k);
   Tensor subtract_scalar_r_fw(const Tensor &x, const Tensor &k);
@@ -290,6 +445,138 @@ public:
    */
   void inplace_subtract(const Tensor &x, Tensor &y);
 
+  /**
+   * Directly overwrites sub-tensors of the second tensor with the first tensor.
+   * This is the assignment version of `pick_bw()`.
+   * @param x A tensor to be written, which should have the same shape as
+   *          `pick_fw(y, ids, dim)`.
+   * @param ids List of integers as IDs of sub-tensors of `y`.
+   * @param dim Dimension to pick.
+   * @param y A tensor to be updated.
+   * @remarks The result is undefined if `ids` refers the same sub-tensor more
+   *          than once.
+   *          CPU devices also accept `x` and `y` with the same 16-bit
+   *          precision, and copy their values without conversions.
+   */
+  void inplace_pick_assign(
+      const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+      Tensor &y);
+
+  /**
+   * Directly resets sub-tensors of the tensor using a constant.
+   * @param k A value used to initialize each element.
+   * @param ids List of integers as IDs of sub-tensors of `y`.
+   * @param dim Dimension to pick.
+   * @param y A tensor to be updated.
+   */
+  void inplace_pick_reset(
+      float k, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+      Tensor &y);
+
+  /**
+   * Applies the update rule of SGD:
+   *   x -= eta * g.
+   * @param g A tensor of gradients.
+   * @param eta Learning rate.
+   * @param x A tensor to be updated.
+   */
+  void sgd_update(const Tensor &g, float eta, Tensor &x);
+
+  /**
+   * Applies the update rule of MomentumSGD:
+   *   m = momentum * m - eta * g,
+   *   x += m.
+   * @param g A tensor of gradients.
+   * @param eta Learning rate.
+   * @param momentum Decay factor of the momentum.
+   * @param m A tensor of the momentum to be updated.
+   * @param x A tensor to be updated.
+   */
+  void momentum_sgd_update(
+      const Tensor &g, float eta, float momentum, Tensor &m, Tensor &x);
+
+  /**
+   * Applies the update rule of AdaGrad:
+   *   m += g * g,
+   *   x -= eta * g / (sqrt(m) + eps).
+   * @param g A tensor of gradients.
+   * @param eta Learning rate.
+   * @param eps Bias of power.
+   * @param m A tensor of the accumulated squared gradients to be updated.
+   * @param x A tensor to be updated.
+   */
+  void adagrad_update(
+      const Tensor &g, float eta, float eps, Tensor &m, Tensor &x);
+
+  /**
+   * Applies the update rule of RMSProp:
+   *   m = alpha * m + (1 - alpha) * g * g,
+   *   x -= eta * g / (sqrt(m) + eps).
+   * @param g A tensor of gradients.
+   * @param eta Learning rate.
+   * @param alpha Decay factor of the moment.
+   * @param eps Bias of power.
+   * @param m A tensor of the moment to be updated.
+   * @param x A tensor to be updated.
+   */
+  void rmsprop_update(
+      const Tensor &g, float eta, float alpha, float eps, Tensor &m, Tensor &x);
+
+  /**
+   * Applies the update rule of AdaDelta:
+   *   m2 = rho * m2 + (1 - rho) * g * g,
+   *   d = sqrt((m1 + eps) / (m2 + eps)) * g,
+   *   m1 = rho * m1 + (1 - rho) * d * d,
+   *   x -= scale * d.
+   * @param g A tensor of gradients.
+   * @param scale Scaling factor of the update.
+   * @param rho Decay factor of the moments.
+   * @param eps Bias of power.
+   * @param m1 A tensor of the first moment to be updated.
+   * @param m2 A tensor of the second moment to be updated.
+   * @param x A tensor to be updated.
+   */
+  void adadelta_update(
+      const Tensor &g, float scale, float rho, float eps,
+      Tensor &m1, Tensor &m2, Tensor &x);
+
+  /**
+   * Applies the update rule of Adam:
+   *   m1 = beta1 * m1 + (1 - beta1) * g,
+   *   m2 = beta2 * m2 + (1 - beta2) * g * g,
+   *   x -= alpha * (m1 / (1 - beta1^t)) / (sqrt(m2 / (1 - beta2^t)) + eps).
+   * @param g A tensor of gradients.
+   * @param alpha Learning rate.
+   * @param beta1 Decay factor of the first moment.
+   * @param beta2 Decay factor of the second moment.
+   * @param eps Bias of power.
+   * @param epoch Number of the current step `t` (starting from 1).
+   * @param m1 A tensor of the first moment to be updated.
+   * @param m2 A tensor of the second moment to be updated.
+   * @param x A tensor to be updated.
+   * @remarks Moments can be stored in reduced precisions to save the memory.
+   *          If `m1` has `Precision::FLOAT16` or `Precision::BFLOAT16`, `m2`
+   *          should have `Precision::BFLOAT16`. The kernel converts moments to
+   *          the single precision, updates them, and stores them with the
+   *          rounding to the nearest even.
+   *          The second moment does not use `Precision::FLOAT16` because
+   *          squared gradients smaller than about 6e-8 (e.g., `|g| < 7.7e-3`
+   *          with `beta2 = .999`) underflow to 0 in this format.
+   */
+  void adam_update(
+      const Tensor &g, float alpha, float beta1, float beta2, float eps,
+      std::uint32_t epoch, Tensor &m1, Tensor &m2, Tensor &x);
+
+  /**
+   * Calculates the sum of squared elements over multiple tensors:
+   *   sum_i sum_j xs[i][j]^2.
+   * @param xs List of tensors.
+   * @return The squared L2 norm of all elements in `xs`.
+   * @remarks This function does not create any temporary tensors, and
+   *          synchronizes with the device only once.
+   */
+  float squared_norm(const std::vector<const Tensor *> &xs);
+
 private:
   /**
    * Retrieves internal values of the tensor as a vector.
@@ -300,6 +587,18 @@ private:
    */
   std::vector<float> tensor_to_vector(const Tensor &x);
 
+  /**
+   * Retrieves a part of internal values of the tensor.
+   * @param x A tensor.
+   * @param offset Index of the first element to be retrieved.
+   * @param size Number of elements to be retrieved.
+   * @param values Array to store `size` elements.
+   * @remarks Each values are ordered by the same order as `tensor_to_vector()`.
+   */
+  void tensor_to_array(
+      const Tensor &x, std::uint32_t offset, std::uint32_t size,
+      float values[]);
+
   /**
    * Retrieves argmax indices along an axis.
    * @param x A tensor.
@@ -323,6 +622,7 @@ protected:
    * @return Inner handle of `x`.
    */
   static const void *get_handle(const Tensor &x) {
+    check_single_precision(x);
     return x.handle();
   }
 
@@ -332,6 +632,29 @@ protected:
    * @return Mutable inner handle of `x`.
    */
   static void *get_mutable_handle(Tensor &x) {
+    check_single_precision(x);
+    return x.mutable_handle();
+  }
+
+  /**
+   * Obtains an inner handle from a Tensor with any precision.
+   * @param x Target Tensor object.
+   * @return Inner handle of `x`.
+   * @remarks The handle of 16-bit tensors points packed `std::uint16_t` values.
+   *          The handle of int8 tensors points per-row scales followed by
+   *          `std::int8_t` values.
+   */
+  static const void *get_packed_handle(const Tensor &x) {
+    return x.handle();
+  }
+
+  /**
+   * Obtains a mutable inner handle from a Tensor with any precision.
+   * @param x Target Tensor object.
+   * @return Mutable inner handle of `x`.
+   * @remarks The layout of the memory is same as `get_packed_handle()`.
+   */
+  static void *get_mutable_packed_handle(Tensor &x) {
     return x.mutable_handle();
   }
 
@@ -366,8 +689,10 @@ private:
   // device-specific implementations.
 
   virtual std::shared_ptr<void> new_handle(const Shape &shape) = 0;
+  virtual void *offset_handle(void *handle, std::uint32_t offset) = 0;
 
   virtual std::vector<float> tensor_to_vector_impl(const Tensor &x) = 0;
+  virtual void tensor_to_array_impl(const Tensor &x, std::uint32_t offset, std::uint32_t size, float values[]) = 0;
   virtual std::vector<std::uint32_t> argmax_impl(const Tensor &x, std::uint32_t dim) = 0;
   virtual std::vector<std::uint32_t> argmin_impl(const Tensor &x, std::uint32_t dim) = 0;
 
@@ -382,6 +707,7 @@ private:
   virtual void random_uniform_impl(float lower, float upper, Tensor &y) = 0;
   virtual void random_normal_impl(float mean, float sd, Tensor &y) = 0;
   virtual void random_log_normal_impl(float mean, float sd, Tensor &y) = 0;
+  virtual std::uint32_t random_seed_impl() = 0;
 
   virtual void pick_fw_impl(const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim, Tensor &y) = 0;
   virtual void slice_fw_impl(const Tensor &x, std::uint32_t dim, std::uint32_t offset, Tensor &y) = 0;
@@ -447,6 +773,9 @@ private:
 
   virtual void pown_bw_impl(const Tensor &x, const Tensor &y, const Tensor &gy, std::int32_t k, Tensor &gx) = 0;
 
+  virtual void dropout_fw_impl(const Tensor &x, float rate, std::uint32_t seed, Tensor &y) = 0;
+  virtual void dropout_bw_impl(const Tensor &gy, float rate, std::uint32_t seed, Tensor &gx) = 0;
+
   virtual void add_scalar_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) = 0;
   virtual void subtract_scalar_r_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) = 0;
   virtual void subtract_scalar_l_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) = 0;
@@ -532,6 +861,29 @@ private:
 
   virtual void inplace_add_impl(const Tensor &x, Tensor &y) = 0;
   virtual void inplace_subtract_impl(const Tensor &x, Tensor &y) = 0;
+  virtual void inplace_pick_assign_impl(const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim, Tensor &y) = 0;
+  virtual void inplace_pick_reset_impl(float k, const std::vector<std::uint32_t> &ids, std::uint32_t dim, Tensor &y) = 0;
+
+  virtual void sgd_update_impl(const Tensor &g, float eta, Tensor &x) = 0;
+  virtual void momentum_sgd_update_impl(
+      const Tensor &g, float eta, float momentum, Tensor &m, Tensor &x) = 0;
+  virtual void adagrad_update_impl(
+      const Tensor &g, float eta, float eps, Tensor &m, Tensor &x) = 0;
+  virtual void rmsprop_update_impl(
+      const Tensor &g, float eta, float alpha, float eps,
+      Tensor &m, Tensor &x) = 0;
+  virtual void adadelta_update_impl(
+      const Tensor &g, float scale, float rho, float eps,
+      Tensor &m1, Tensor &m2, Tensor &x) = 0;
+  virtual void adam_update_impl(
+      const Tensor &g, float alpha, float beta1, float beta2, float eps,
+      std::uint32_t epoch, Tensor &m1, Tensor &m2, Tensor &x) = 0;
+  virtual void adam_update_packed_impl(
+      const Tensor &g, float alpha, float beta1, float beta2, float eps,
+      std::uint32_t epoch, Precision precision,
+      Tensor &m1, Tensor &m2, Tensor &x) = 0;
+
+  virtual float squared_norm_impl(const std::vector<const Tensor *> &xs) = 0;
 };
 
 }  // namespace primitiv
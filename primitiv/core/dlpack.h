@@ -0,0 +1,75 @@
+#ifndef PRIMITIV_CORE_DLPACK_H_
+#define PRIMITIV_CORE_DLPACK_H_
+
+#include <cstdint>
+
+namespace primitiv {
+
+/**
+ * Descriptors to exchange tensors with other libraries without copying.
+ * Each structure has the same memory layout as that of the DLPack
+ * specification (https://github.com/dmlc/dlpack), and pointers to them can be
+ * passed to/from libraries supporting DLPack (e.g., `DLManagedTensor *`)
+ * directly.
+ */
+namespace dlpack {
+
+/**
+ * `device_type` of the host memory.
+ */
+constexpr std::int32_t DEVICE_CPU = 1;
+
+/**
+ * `code` of floating point numbers.
+ */
+constexpr std::uint8_t TYPE_FLOAT = 2;
+
+/**
+ * Location of the memory.
+ */
+struct DLDevice {
+  std::int32_t device_type;
+  std::int32_t device_id;
+};
+
+/**
+ * Type of each element.
+ */
+struct DLDataType {
+  std::uint8_t code;
+  std::uint8_t bits;
+  std::uint16_t lanes;
+};
+
+/**
+ * Unmanaged descriptor of a tensor.
+ * `shape` and `strides` have `ndim` elements, and `strides` is counted by the
+ * number of elements. A null `strides` represents the compact row-major
+ * order.
+ */
+struct DLTensor {
+  void *data;
+  DLDevice device;
+  std::int32_t ndim;
+  DLDataType dtype;
+  std::int64_t *shape;
+  std::int64_t *strides;
+  std::uint64_t byte_offset;
+};
+
+/**
+ * Descriptor of a tensor with its owner.
+ * The consumer of this object should call `deleter(self)` exactly once when
+ * the memory is no longer used.
+ */
+struct DLManagedTensor {
+  DLTensor dl_tensor;
+  void *manager_ctx;
+  void (*deleter)(DLManagedTensor *self);
+};
+
+}  // namespace dlpack
+
+}  // namespace primitiv
+
+#endif  // PRIMITIV_CORE_DLPACK_H_
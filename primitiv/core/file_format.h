@@ -10,6 +10,15 @@ namespace primitiv {
 class FileFormat {
 public:
   class CurrentVersion {
+  public:
+    static const std::uint32_t MAJOR = 0;
+    static const std::uint32_t MINOR = 2;
+  };
+
+  /**
+   * The oldest version which can be read by the current implementation.
+   */
+  class MinimumVersion {
   public:
     static const std::uint32_t MAJOR = 0;
     static const std::uint32_t MINOR = 1;
@@ -23,10 +32,26 @@ public:
     OPTIMIZER = 0x400,
   };
 
+  /**
+   * Retrieves the minor version written to files of the given type.
+   * Only Model files use the current layout; other files are unchanged since
+   * v0.1 and keep the old version to remain readable by older readers.
+   * @param type Data type of the file.
+   * @return Minor version of the file.
+   */
+  static std::uint32_t written_minor_version(DataType type) {
+    return type == DataType::MODEL
+      ? CurrentVersion::MINOR : MinimumVersion::MINOR;
+  }
+
   static void assert_version(std::uint32_t major, std::uint32_t minor) {
-    if (major != CurrentVersion::MAJOR || minor != CurrentVersion::MINOR) {
+    static_assert(MinimumVersion::MAJOR == CurrentVersion::MAJOR, "");
+    if (major != CurrentVersion::MAJOR ||
+        minor < MinimumVersion::MINOR || minor > CurrentVersion::MINOR) {
       PRIMITIV_THROW_ERROR(
           "File version mismatched. required: "
+          << MinimumVersion::MAJOR << "." << MinimumVersion::MINOR
+          << " to "
           << CurrentVersion::MAJOR << "." << CurrentVersion::MINOR
           << ", observed: "
           << major << "." << minor);
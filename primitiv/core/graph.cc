@@ -1,8 +1,10 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <utility>
 
@@ -150,6 +152,147 @@ const Tensor &Graph::forward(const Node &node) {
   return *forward_recursive(Address { node.oid_, node.vid_ });
 }
 
+std::uint32_t Graph::forward_batched(const std::vector<Node> &nodes) {
+  // Finds operators which are required to calculate `nodes`.
+  std::uint32_t end = 0;
+  vector<bool> required(ops_.size(), false);
+  for (const Node &node : nodes) {
+    CHECK_NODE(node);
+    required[node.oid_] = true;
+    end = std::max(end, node.oid_ + 1);
+  }
+  for (std::uint32_t oid = end; oid-- > 0; ) {
+    if (!required[oid]) continue;
+    const OperatorInfo &f = ops_[oid];
+    if (f.op->has_inner_values() || f.rets.empty() || f.rets[0].value.valid()) {
+      required[oid] = false;
+      continue;
+    }
+    for (const Address arg : f.args) required[arg.oid] = true;
+  }
+
+  // Returns the key to batch the operator, or an empty string if the operator
+  // should be calculated solely.
+  auto batch_key = [&](std::uint32_t oid) -> std::string {
+    const OperatorInfo &f = ops_[oid];
+    if (f.rets.size() != 1) return std::string();
+    const std::string signature = f.op->batch_signature();
+    if (signature.empty()) return std::string();
+    const NodeInfo &ret = f.rets[0];
+    std::stringstream ss;
+    ss << signature << '|' << ret.device;
+    for (const Address arg : f.args) {
+      const NodeInfo &arg_n = ops_[arg.oid].rets[arg.vid];
+      if (arg_n.device != ret.device) return std::string();
+      ss << '|' << arg_n.shape.resize_batch(1).to_string();
+      if (arg_n.shape.batch() != ret.shape.batch()) {
+        // Broadcasted arguments should be shared by all batched operators.
+        ss << '@' << arg.oid << ':' << arg.vid;
+      }
+    }
+    return ss.str();
+  };
+
+  // Groups operators by their depths and keys. Operators with the same depth
+  // do not depend on each other.
+  vector<std::uint32_t> depth(end, 0);
+  vector<std::map<std::string, vector<std::uint32_t>>> levels;
+  vector<vector<std::uint32_t>> solos;
+  for (std::uint32_t oid = 0; oid < end; ++oid) {
+    if (!required[oid]) continue;
+    std::uint32_t d = 0;
+    for (const Address arg : ops_[oid].args) {
+      if (required[arg.oid]) d = std::max(d, depth[arg.oid] + 1);
+    }
+    depth[oid] = d;
+    if (levels.size() <= d) {
+      levels.resize(d + 1);
+      solos.resize(d + 1);
+    }
+    const std::string key = batch_key(oid);
+    if (key.empty()) solos[d].emplace_back(oid);
+    else levels[d][key].emplace_back(oid);
+  }
+
+  auto arg_value = [&](const Address arg) -> const Tensor * {
+    OperatorInfo &arg_f = ops_[arg.oid];
+    return arg_f.op->has_inner_values()
+      ? arg_f.op->get_inner_values()[arg.vid]
+      : &arg_f.rets[arg.vid].value;
+  };
+
+  auto forward_solo = [&](std::uint32_t oid) {
+    OperatorInfo &f = ops_[oid];
+    vector<const Tensor *> args_v;
+    vector<Tensor *> rets_v;
+    args_v.reserve(f.args.size());
+    rets_v.reserve(f.rets.size());
+    for (const Address arg : f.args) args_v.emplace_back(arg_value(arg));
+    for (NodeInfo &ret : f.rets) rets_v.emplace_back(&ret.value);
+    f.op->forward(args_v, rets_v);
+  };
+
+  auto forward_group = [&](const vector<std::uint32_t> &oids) {
+    const OperatorInfo &f0 = ops_[oids[0]];
+    const std::uint32_t argn = f0.args.size();
+
+    // Concatenates arguments. Arguments shared by all operators with the batch
+    // size 1 are used directly and broadcasted.
+    vector<Tensor> merged(argn);
+    vector<const Tensor *> args_v(argn);
+    bool all_shared = true;
+    for (std::uint32_t i = 0; i < argn; ++i) {
+      const Address a0 = f0.args[i];
+      bool shared = true;
+      for (const std::uint32_t oid : oids) {
+        const Address a = ops_[oid].args[i];
+        shared = shared && a.oid == a0.oid && a.vid == a0.vid;
+      }
+      args_v[i] = arg_value(a0);
+      if (shared && args_v[i]->shape().batch() == 1) continue;
+
+      all_shared = false;
+      vector<const Tensor *> xs;
+      xs.reserve(oids.size());
+      for (const std::uint32_t oid : oids) {
+        xs.emplace_back(arg_value(ops_[oid].args[i]));
+      }
+      merged[i] = functions::batch::concat(xs);
+      args_v[i] = &merged[i];
+    }
+
+    Tensor y;
+    f0.op->forward(args_v, vector<Tensor *> { &y });
+
+    // Splits the result into each operator.
+    std::uint32_t lower = 0;
+    for (const std::uint32_t oid : oids) {
+      NodeInfo &ret = ops_[oid].rets[0];
+      if (all_shared) {
+        ret.value = y;
+      } else {
+        const std::uint32_t upper = lower + ret.shape.batch();
+        ret.value = functions::batch::slice(y, lower, upper);
+        lower = upper;
+      }
+    }
+  };
+
+  std::uint32_t num_calls = 0;
+  for (std::uint32_t d = 0; d < levels.size(); ++d) {
+    for (const std::uint32_t oid : solos[d]) {
+      forward_solo(oid);
+      ++num_calls;
+    }
+    for (const auto &kv : levels[d]) {
+      if (kv.second.size() == 1) forward_solo(kv.second[0]);
+      else forward_group(kv.second);
+      ++num_calls;
+    }
+  }
+  return num_calls;
+}
+
 void Graph::backward(const Node &node) {
   CHECK_NODE(node);
 
@@ -232,6 +375,16 @@ Device &Graph::get_device(const Node &node) const {
   return *ops_[node.oid_].rets[node.vid_].device;
 }
 
+Node Graph::get_node(std::uint32_t operator_id, std::uint32_t value_id) {
+  if (operator_id >= ops_.size() ||
+      value_id >= ops_[operator_id].rets.size()) {
+    PRIMITIV_THROW_ERROR(
+        "Invalid node. operator_id: " << operator_id
+        << ", value_id: " << value_id);
+  }
+  return Node(*this, operator_id, value_id);
+}
+
 std::string Graph::dump(const std::string &format) const {
   if (format != "dot") PRIMITIV_THROW_ERROR("Unknown format: " << format);
 
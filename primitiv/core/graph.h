@@ -177,6 +177,21 @@ public:
    */
   const Tensor &forward(const Node &node);
 
+  /**
+   * Calculates values of given nodes with automatic batching.
+   * @param nodes List of target nodes.
+   * @return Number of operator calls performed.
+   * @remarks This function calculates the same values as `forward()`, but
+   *          operators with the same batch signature, the same argument shapes
+   *          (except the batch size) and the same depth in the subgraph are
+   *          calculated by a single call with arguments concatenated along the
+   *          batch axis, and the results are split into each node.
+   *          This is useful for calculating many independent examples which
+   *          have different structures, e.g., trees and sequences with
+   *          different lengths.
+   */
+  std::uint32_t forward_batched(const std::vector<Node> &nodes);
+
   /**
    * Calculates the backpropagation.
    * @param node Node object specifying the output node.
@@ -199,6 +214,17 @@ public:
    */
   Device &get_device(const Node &node) const;
 
+  /**
+   * Retrieves the node by its location.
+   * @param operator_id Operator ID of the node.
+   * @param value_id Value ID of the node.
+   * @return A Node object.
+   * @throw primitiv::Error The graph has no corresponding node.
+   * @remarks This function is used to restore nodes from IDs obtained by
+   *          `Node::operator_id()` and `Node::value_id()`.
+   */
+  Node get_node(std::uint32_t operator_id, std::uint32_t value_id);
+
   /**
    * Dump internal graph structure.
    * @param format Name of the format. Available options:
@@ -0,0 +1,111 @@
+#include <primitiv/config.h>
+
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+#include <primitiv/core/error.h>
+#include <primitiv/core/mapped_file.h>
+
+namespace primitiv {
+
+#ifdef _WIN32
+
+// NOTE:
+// Memory mapping is not implemented on Windows yet. The whole file is read
+// into an ordinary memory instead.
+MappedFile::MappedFile(const std::string &path)
+: data_(nullptr), size_(0), mapped_(false) {
+  std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+  if (!ifs.is_open()) {
+    PRIMITIV_THROW_ERROR("Could not open file: " << path);
+  }
+  size_ = static_cast<std::size_t>(ifs.tellg());
+  if (size_ > 0) {
+    data_ = static_cast<char *>(std::malloc(size_));
+    if (!data_) {
+      PRIMITIV_THROW_ERROR(
+          "Memory allocation failed. Requested size: " << size_);
+    }
+    ifs.seekg(0);
+    if (!ifs.read(data_, size_)) {
+      std::free(data_);
+      PRIMITIV_THROW_ERROR("Could not read file: " << path);
+    }
+  }
+  setg(data_, data_, data_ + size_);
+}
+
+MappedFile::~MappedFile() {
+  std::free(data_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &path)
+: data_(nullptr), size_(0), mapped_(false) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    PRIMITIV_THROW_ERROR("Could not open file: " << path);
+  }
+  struct ::stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    PRIMITIV_THROW_ERROR("Could not retrieve the status of file: " << path);
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ > 0) {
+    // NOTE:
+    // MAP_PRIVATE makes written pages copy-on-write, so that tensors on the
+    // mapped memory can be updated without modifying the file.
+    void *addr = ::mmap(
+        nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      PRIMITIV_THROW_ERROR("Could not map file: " << path);
+    }
+    data_ = static_cast<char *>(addr);
+    mapped_ = true;
+  }
+  ::close(fd);
+  setg(data_, data_, data_ + size_);
+}
+
+MappedFile::~MappedFile() {
+  if (mapped_) ::munmap(data_, size_);
+}
+
+#endif  // _WIN32
+
+MappedFile::pos_type MappedFile::seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+  if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+  off_type base;
+  switch (dir) {
+    case std::ios_base::beg: base = 0; break;
+    case std::ios_base::cur: base = gptr() - eback(); break;
+    case std::ios_base::end: base = size_; break;
+    default: return pos_type(off_type(-1));
+  }
+  return seekpos(pos_type(base + off), which);
+}
+
+MappedFile::pos_type MappedFile::seekpos(
+    pos_type pos, std::ios_base::openmode which) {
+  const off_type off = pos;
+  if (!(which & std::ios_base::in) ||
+      off < 0 || static_cast<std::size_t>(off) > size_) {
+    return pos_type(off_type(-1));
+  }
+  setg(data_, data_ + off, data_ + size_);
+  return pos;
+}
+
+}  // namespace primitiv
@@ -0,0 +1,61 @@
+#ifndef PRIMITIV_CORE_MAPPED_FILE_H_
+#define PRIMITIV_CORE_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+
+#include <primitiv/core/mixins/nonmovable.h>
+
+namespace primitiv {
+
+/**
+ * Read-only stream buffer backed by the whole contents of a file.
+ * The file is mapped into the memory if the platform supports it, and the
+ * mapped pages are private to this process: writing into `data()` never
+ * modifies the file.
+ */
+class MappedFile : public std::streambuf, mixins::Nonmovable<MappedFile> {
+public:
+  /**
+   * Maps a file.
+   * @param path Path of the file.
+   * @throw primitiv::Error The file could not be opened or mapped.
+   */
+  explicit MappedFile(const std::string &path);
+
+  ~MappedFile() override;
+
+  /**
+   * Retrieves the head of the file contents.
+   * @return Pointer to the first byte of the file.
+   */
+  char *data() const { return data_; }
+
+  /**
+   * Retrieves the size of the file.
+   * @return Number of bytes in the file.
+   */
+  std::size_t size() const { return size_; }
+
+  /**
+   * Retrieves the current reading position.
+   * @return Number of bytes from the head of the file.
+   */
+  std::size_t position() const { return gptr() - eback(); }
+
+protected:
+  pos_type seekoff(
+      off_type off, std::ios_base::seekdir dir,
+      std::ios_base::openmode which) override;
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+private:
+  char *data_;
+  std::size_t size_;
+  bool mapped_;
+};
+
+}  // namespace primitiv
+
+#endif  // PRIMITIV_CORE_MAPPED_FILE_H_
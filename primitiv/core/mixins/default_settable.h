@@ -1,6 +1,8 @@
 #ifndef PRIMITIV_CORE_MIXINS_DEFAULT_SETTABLE_H_
 #define PRIMITIV_CORE_MIXINS_DEFAULT_SETTABLE_H_
 
+#include <atomic>
+
 #include <primitiv/core/error.h>
 
 namespace primitiv {
@@ -8,6 +10,9 @@ namespace mixins {
 
 /**
  * Mix-in class to provide default value setter/getter.
+ * Each thread can override the global default object by its own default
+ * object, so that threads can use different objects without passing them
+ * explicitly.
  */
 template<typename T>
 class DefaultSettable {
@@ -17,39 +22,70 @@ class DefaultSettable {
   DefaultSettable &operator=(DefaultSettable &&) = delete;
 
   /**
-   * Pointer of current default object.
+   * Pointer of current global default object.
+   */
+  static std::atomic<T *> default_obj_;
+
+  /**
+   * Pointer of current default object of each thread.
    */
-  static T *default_obj_;
+  static thread_local T *thread_default_obj_;
 
 protected:
   DefaultSettable() = default;
 
   ~DefaultSettable() {
     // If the current default object is this, unregister it.
-    if (default_obj_ == static_cast<T *>(this)) {
-      default_obj_ = nullptr;
+    // NOTE:
+    // Default objects of other threads can not be unregistered here. Users
+    // should reset them before deleting the object.
+    T *expected = static_cast<T *>(this);
+    default_obj_.compare_exchange_strong(expected, nullptr);
+    if (thread_default_obj_ == static_cast<T *>(this)) {
+      thread_default_obj_ = nullptr;
     }
   }
 
 public:
   /**
    * Retrieves the current default object.
-   * @return Reference of the current default object.
+   * @return Reference of the default object of the current thread if it is
+   *         specified, or reference of the global default object otherwise.
    * @throw primitiv::Error Default object is null.
    */
   static T &get_default() {
-    if (!default_obj_) PRIMITIV_THROW_ERROR("Default object is null.");
-    return *default_obj_;
+    T *obj = thread_default_obj_ ? thread_default_obj_ : default_obj_.load();
+    if (!obj) PRIMITIV_THROW_ERROR("Default object is null.");
+    return *obj;
   }
 
   /**
-   * Specifies a new default object.
+   * Specifies a new global default object.
    * @param obj Reference of the new default object.
+   * @remarks Threads which have their own default objects are not affected.
    */
   static void set_default(T &obj) {
     default_obj_ = &obj;
   }
 
+  /**
+   * Specifies a new default object of the current thread.
+   * @param obj Reference of the new default object.
+   * @remarks The object overrides the global default object only in the
+   *          current thread.
+   */
+  static void set_thread_default(T &obj) {
+    thread_default_obj_ = &obj;
+  }
+
+  /**
+   * Unregisters the default object of the current thread, so that the global
+   * default object is used again in the current thread.
+   */
+  static void reset_thread_default() {
+    thread_default_obj_ = nullptr;
+  }
+
   /**
    * Obtains the reference of the object pointed by a pointer, or obtains the
    * default object.
@@ -65,7 +101,10 @@ public:
 };
 
 template<typename T>
-T *DefaultSettable<T>::default_obj_ = nullptr;
+std::atomic<T *> DefaultSettable<T>::default_obj_(nullptr);
+
+template<typename T>
+thread_local T *DefaultSettable<T>::thread_default_obj_ = nullptr;
 
 }  // namespace mixins
 }  // namespace primitiv
@@ -1,76 +1,479 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <exception>
 #include <fstream>
+#include <future>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif  // _WIN32
 
 #include <primitiv/core/device.h>
 #include <primitiv/core/error.h>
 #include <primitiv/core/file_format.h>
+#include <primitiv/core/mapped_file.h>
 #include <primitiv/core/model.h>
 #include <primitiv/core/parameter.h>
 #include <primitiv/core/string_utils.h>
 #include <primitiv/msgpack/reader.h>
 #include <primitiv/msgpack/writer.h>
 
+namespace {
+
+// Reads the header of the model file.
+// Returns the minor version of the file format.
+std::uint32_t read_header(primitiv::msgpack::Reader &reader) {
+  std::uint32_t major, minor;
+  reader >> major >> minor;
+  primitiv::FileFormat::assert_version(major, minor);
+
+  std::uint32_t datatype;
+  reader >> datatype;
+  primitiv::FileFormat::assert_datatype(
+      primitiv::FileFormat::DataType::MODEL, datatype);
+
+  return minor;
+}
+
+// Removes `prefix` from the head of `key`.
+// Returns false if `key` does not begin with `prefix`.
+bool strip_prefix(
+    const std::vector<std::string> &prefix, std::vector<std::string> &key) {
+  if (key.size() <= prefix.size() ||
+      !std::equal(prefix.begin(), prefix.end(), key.begin())) {
+    return false;
+  }
+  key.erase(key.begin(), key.begin() + prefix.size());
+  return true;
+}
+
+// Writes the header and the index of the model file.
+void write_header(
+    const std::vector<const std::vector<std::string> *> &keys,
+    const std::vector<std::uint64_t> &offsets,
+    primitiv::msgpack::Writer &writer) {
+  writer << primitiv::FileFormat::CurrentVersion::MAJOR;
+  writer << primitiv::FileFormat::written_minor_version(
+      primitiv::FileFormat::DataType::MODEL);
+  writer << static_cast<std::uint32_t>(primitiv::FileFormat::DataType::MODEL);
+  writer << static_cast<std::uint32_t>(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    writer << *keys[i] << offsets[i];
+  }
+}
+
+// Checks whether the device can be used by multiple threads concurrently.
+bool is_concurrent(const primitiv::Device &device) {
+  // NOTE:
+  // Other devices have thread-unsafe states (e.g., memory pools) for now.
+  const std::uint32_t group
+    = static_cast<std::uint32_t>(device.type())
+    & static_cast<std::uint32_t>(primitiv::DeviceType::GROUP_FILTER);
+  return group == static_cast<std::uint32_t>(primitiv::DeviceType::GROUP_CPU);
+}
+
+// Retrieves the number of threads actually used to save/load parameters.
+std::uint32_t get_num_threads(std::uint32_t num_threads, std::size_t num_jobs) {
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return static_cast<std::uint32_t>(std::max<std::size_t>(
+        1, std::min<std::size_t>(num_threads, num_jobs)));
+}
+
+// Makes a unique path of the temporary file in the same directory as `path`.
+std::string make_temporary_path(const std::string &path) {
+  static std::atomic<std::uint64_t> counter(0);
+#ifdef _WIN32
+  const int pid = ::_getpid();
+#else
+  const int pid = ::getpid();
+#endif  // _WIN32
+  std::ostringstream ss;
+  ss << path << ".tmp." << pid << '.' << counter++;
+  return ss.str();
+}
+
+// Flushes the contents of the file to the storage.
+void sync_file(const std::string &path) {
+#ifdef _WIN32
+  const int fd = ::_open(path.c_str(), _O_RDWR | _O_BINARY);
+  const bool ok = fd >= 0 && ::_commit(fd) == 0;
+  if (fd >= 0) ::_close(fd);
+#else
+  const int fd = ::open(path.c_str(), O_RDWR);
+  const bool ok = fd >= 0 && ::fsync(fd) == 0;
+  if (fd >= 0) ::close(fd);
+#endif  // _WIN32
+  if (!ok) PRIMITIV_THROW_ERROR("Could not synchronize file: " << path);
+}
+
+// Flushes the directory entry of the file to the storage.
+void sync_directory(const std::string &path) {
+#ifndef _WIN32
+  const std::size_t pos = path.find_last_of('/');
+  const std::string dir
+    = pos == std::string::npos ? "." : pos == 0 ? "/" : path.substr(0, pos);
+  const int fd = ::open(dir.c_str(), O_RDONLY);
+  const bool ok = fd >= 0 && ::fsync(fd) == 0;
+  if (fd >= 0) ::close(fd);
+  if (!ok) PRIMITIV_THROW_ERROR("Could not synchronize directory: " << dir);
+#else
+  // NOTE:
+  // Directories could not be synchronized on Windows, and renaming is
+  // persisted by the file system.
+  static_cast<void>(path);
+#endif  // _WIN32
+}
+
+// Replaces the file at `path` by the file at `temp_path`.
+void replace_file(const std::string &temp_path, const std::string &path) {
+#ifdef _WIN32
+  // NOTE:
+  // std::rename() on Windows fails if the destination exists.
+  std::remove(path.c_str());
+#endif  // _WIN32
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    PRIMITIV_THROW_ERROR("Could not rename file: " << temp_path
+        << " to " << path);
+  }
+}
+
+// Calls `fn(i, t)` for each `i` in [0, n) using `num_threads` threads, where
+// `t` is the index of the thread.
+// The first exception thrown by `fn` is rethrown after all threads finished.
+template<typename Fn>
+void parallel_for(std::uint32_t n, std::uint32_t num_threads, Fn fn) {
+  if (num_threads <= 1) {
+    for (std::uint32_t i = 0; i < n; ++i) fn(i, 0);
+    return;
+  }
+
+  std::atomic<std::uint32_t> next(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr error;
+  std::mutex mutex;
+  const auto worker = [&](std::uint32_t t) {
+    while (!failed) {
+      const std::uint32_t i = next++;
+      if (i >= n) return;
+      try {
+        fn(i, t);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) error = std::current_exception();
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::uint32_t t = 1; t < num_threads; ++t) {
+    threads.emplace_back(worker, t);
+  }
+  worker(0);
+  for (std::thread &th : threads) th.join();
+  if (error) std::rethrow_exception(error);
+}
+
+}  // namespace
+
 namespace primitiv {
 
-void Model::load(const std::string &path, bool with_stats, Device *device) {
-  std::ifstream ifs(path);
+void Model::load_file(
+    const std::string &path, const std::vector<std::string> &prefix,
+    bool with_stats, bool lazy, Device *device) {
+  std::ifstream ifs(path, std::ios::binary);
   if (!ifs.is_open()) {
     PRIMITIV_THROW_ERROR("Could not open file: " << path);
   }
   msgpack::Reader reader(ifs);
+  Device &dev = Device::get_reference_or_default(device);
 
-  std::uint32_t major, minor;
-  reader >> major >> minor;
-  FileFormat::assert_version(major, minor);
+  if (::read_header(reader) == 1) {
+    load_inner(reader, prefix, with_stats, dev, nullptr);
+    return;
+  }
 
-  std::uint32_t datatype;
-  reader >> datatype;
-  FileFormat::assert_datatype(FileFormat::DataType::MODEL, datatype);
+  const auto entries = read_index(reader, prefix);
+  if (lazy) {
+    for (const auto &entry : entries) {
+      entry.first->load_lazy_inner(path, entry.second, with_stats, dev);
+    }
+    return;
+  }
+
+  const std::uint32_t num_threads = ::is_concurrent(dev)
+    ? ::get_num_threads(num_io_threads_, entries.size()) : 1;
+  std::vector<std::unique_ptr<std::ifstream>> streams(num_threads);
+  ::parallel_for(
+      entries.size(), num_threads,
+      [&](std::uint32_t i, std::uint32_t t) {
+        if (!streams[t]) {
+          streams[t].reset(new std::ifstream(path, std::ios::binary));
+          if (!streams[t]->is_open()) {
+            PRIMITIV_THROW_ERROR("Could not open file: " << path);
+          }
+        }
+        streams[t]->seekg(entries[i].second);
+        msgpack::Reader record_reader(*streams[t]);
+        std::string name;
+        record_reader >> name;
+        entries[i].first->load_inner(record_reader, with_stats, dev);
+      });
+}
+
+void Model::load_mapped(
+    const std::string &path, bool with_stats, Device *device) {
+  const auto file = std::make_shared<MappedFile>(path);
+  std::istream is(file.get());
+  msgpack::Reader reader(is);
+  Device &dev = Device::get_reference_or_default(device);
 
+  if (::read_header(reader) == 1) {
+    load_inner(reader, {}, with_stats, dev, file);
+    return;
+  }
+
+  for (const auto &entry : read_index(reader, {})) {
+    is.seekg(entry.second);
+    std::string name;
+    reader >> name;
+    entry.first->load_inner(reader, with_stats, dev, file);
+  }
+}
+
+void Model::load_inner(
+    msgpack::Reader &reader, const std::vector<std::string> &prefix,
+    bool with_stats, Device &device, const std::shared_ptr<MappedFile> &file) {
   std::uint32_t num_params;
   reader >> num_params;
 
   const auto params = get_all_parameters();
+  bool found = false;
   for (std::uint32_t i = 0; i < num_params; ++i) {
     std::vector<std::string> key;
     reader >> key;
+    if (!::strip_prefix(prefix, key)) {
+      Parameter::skip_inner(reader);
+      continue;
+    }
     const auto it = params.find(key);
     if (it == params.end()) {
       PRIMITIV_THROW_ERROR(
           "Model does not have a parameter with name: '"
           << string_utils::join(key, ".") << "'");
     }
-    it->second->load_inner(
-        reader, with_stats, Device::get_reference_or_default(device));
+    it->second->load_inner(reader, with_stats, device, file);
+    found = true;
+  }
+
+  if (!prefix.empty() && !found) {
+    PRIMITIV_THROW_ERROR(
+        "Submodel not found in the file: '"
+        << string_utils::join(prefix, ".") << "'");
   }
 }
 
-void Model::save(const std::string &path, bool with_stats) const {
-  std::ofstream ofs(path);
-  if (!ofs.is_open()) {
-    PRIMITIV_THROW_ERROR("Could not open file: " << path);
+std::vector<std::pair<Parameter *, std::uint64_t>> Model::read_index(
+    msgpack::Reader &reader, const std::vector<std::string> &prefix) const {
+  std::uint32_t num_params;
+  reader >> num_params;
+
+  const auto params = get_all_parameters();
+  std::vector<std::pair<Parameter *, std::uint64_t>> entries;
+  for (std::uint32_t i = 0; i < num_params; ++i) {
+    std::vector<std::string> key;
+    std::uint64_t offset;
+    reader >> key >> offset;
+    if (!::strip_prefix(prefix, key)) continue;
+    const auto it = params.find(key);
+    if (it == params.end()) {
+      PRIMITIV_THROW_ERROR(
+          "Model does not have a parameter with name: '"
+          << string_utils::join(key, ".") << "'");
+    }
+    entries.emplace_back(it->second, offset);
   }
-  msgpack::Writer writer(ofs);
 
-  writer << FileFormat::CurrentVersion::MAJOR;
-  writer << FileFormat::CurrentVersion::MINOR;
-  writer << static_cast<std::uint32_t>(FileFormat::DataType::MODEL);
+  if (!prefix.empty() && entries.empty()) {
+    PRIMITIV_THROW_ERROR(
+        "Submodel not found in the file: '"
+        << string_utils::join(prefix, ".") << "'");
+  }
+  return entries;
+}
 
+void Model::save(const std::string &path, bool with_stats) const {
   const auto params = get_all_parameters();
+  std::vector<const std::vector<std::string> *> keys;
+  std::vector<const Parameter *> values;
+  for (const auto &kv : params) {
+    keys.emplace_back(&kv.first);
+    values.emplace_back(kv.second);
+  }
+  save_file(path, keys, values, with_stats, num_io_threads_);
+}
+
+std::future<void> Model::save_async(
+    const std::string &path, bool with_stats) const {
+  const auto params = get_all_parameters();
+  bool concurrent = true;
+  for (const auto &kv : params) {
+    if (kv.second->valid()) {
+      concurrent = concurrent && ::is_concurrent(kv.second->device());
+    }
+  }
+
+  if (!concurrent) {
+    // NOTE:
+    // Other devices could not be accessed from the background thread.
+    std::promise<void> promise;
+    try {
+      save(path, with_stats);
+      promise.set_value();
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+    return promise.get_future();
+  }
+
+  // Takes a snapshot of all parameters. Tensors in the snapshot share the
+  // memory with the original parameters, and in-place updates of parameters
+  // duplicate the memory before modifying it.
+  struct Snapshot {
+    std::vector<std::vector<std::string>> keys;
+    std::vector<std::unique_ptr<Parameter>> values;
+  };
+  const auto snapshot = std::make_shared<Snapshot>();
+  for (const auto &kv : params) {
+    const Parameter &src = *kv.second;
+    std::unique_ptr<Parameter> dest(new Parameter());
+    if (src.valid()) {
+      src.check_valid();
+      dest->shape_ = src.shape_;
+      dest->device_ = src.device_;
+      dest->value_ = src.value_;
+      if (with_stats) dest->stats_ = src.stats_;
+    }
+    snapshot->keys.emplace_back(kv.first);
+    snapshot->values.emplace_back(std::move(dest));
+  }
+
+  const std::uint32_t num_threads = num_io_threads_;
+  return std::async(std::launch::async, [=]() {
+      std::vector<const std::vector<std::string> *> keys;
+      std::vector<const Parameter *> values;
+      for (std::size_t i = 0; i < snapshot->keys.size(); ++i) {
+        keys.emplace_back(&snapshot->keys[i]);
+        values.emplace_back(snapshot->values[i].get());
+      }
+      save_file(path, keys, values, with_stats, num_threads);
+  });
+}
+
+void Model::save_file(
+    const std::string &path,
+    const std::vector<const std::vector<std::string> *> &keys,
+    const std::vector<const Parameter *> &values,
+    bool with_stats, std::uint32_t num_io_threads) {
 #ifdef PRIMITIV_WORDSIZE_64
-  if (params.size() > 0xffffffffull) {
+  if (keys.size() > 0xffffffffull) {
     PRIMITIV_THROW_ERROR(
         "Could not store more than 2^32 - 1 parameters in one model file.");
   }
 #else
   static_assert(sizeof(std::size_t) == sizeof(std::uint32_t), "");
 #endif
-  writer << static_cast<std::uint32_t>(params.size());
 
-  for (const auto &kv : params) {
-    writer << kv.first;
-    kv.second->save_inner(writer, with_stats);
+  bool concurrent = true;
+  for (const Parameter *value : values) {
+    if (value->valid()) {
+      concurrent = concurrent && ::is_concurrent(value->device());
+    }
+  }
+
+  // NOTE:
+  // Each parameter is written into the region with the size of the upper
+  // bound, so that all offsets can be determined before writing parameters.
+  // Encoded sizes of the header do not depend on values of offsets.
+  std::vector<std::uint64_t> offsets(keys.size(), 0);
+  {
+    std::ostringstream ss;
+    msgpack::Writer writer(ss);
+    ::write_header(keys, offsets, writer);
+    std::uint64_t offset = ss.str().size();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      offsets[i] = offset;
+      offset += values[i]->max_saved_size(with_stats, &keys[i]->back());
+    }
+  }
+
+  // NOTE:
+  // The file is written into a temporary file, flushed to the storage and
+  // then renamed, so that the existing file is kept until the new one is
+  // durably completed. This also protects models that map the existing file
+  // by `load_mapped()`.
+  const std::string temp_path = ::make_temporary_path(path);
+  try {
+    {
+      std::ofstream ofs(temp_path, std::ios::binary);
+      if (!ofs.is_open()) {
+        PRIMITIV_THROW_ERROR("Could not open file: " << temp_path);
+      }
+      msgpack::Writer writer(ofs);
+      ::write_header(keys, offsets, writer);
+      if (!ofs) PRIMITIV_THROW_ERROR("Could not write file: " << temp_path);
+    }
+
+    const std::uint32_t num_threads = concurrent
+      ? ::get_num_threads(num_io_threads, values.size()) : 1;
+    std::vector<std::unique_ptr<std::fstream>> streams(num_threads);
+    ::parallel_for(
+        values.size(), num_threads,
+        [&](std::uint32_t i, std::uint32_t t) {
+          if (!streams[t]) {
+            streams[t].reset(new std::fstream(
+                  temp_path, std::ios::in | std::ios::out | std::ios::binary));
+            if (!streams[t]->is_open()) {
+              PRIMITIV_THROW_ERROR("Could not open file: " << temp_path);
+            }
+          }
+          streams[t]->seekp(offsets[i]);
+          msgpack::Writer writer(*streams[t]);
+          values[i]->save_inner(writer, with_stats, &keys[i]->back());
+          if (!*streams[t]) {
+            PRIMITIV_THROW_ERROR("Could not write file: " << temp_path);
+          }
+        });
+
+    for (const auto &stream : streams) {
+      if (stream && !stream->flush()) {
+        PRIMITIV_THROW_ERROR("Could not write file: " << temp_path);
+      }
+    }
+    streams.clear();
+
+    ::sync_file(temp_path);
+    ::replace_file(temp_path, path);
+    ::sync_directory(path);
+  } catch (...) {
+    std::remove(temp_path.c_str());
+    throw;
   }
 }
 
@@ -176,6 +579,27 @@ std::map<std::vector<std::string>, Parameter *> Model::get_all_parameters(
   return params;
 }
 
+std::map<std::vector<std::string>, Parameter *>
+Model::get_trainable_parameters() const {
+  std::map<std::vector<std::string>, Parameter *> params;
+  for (const auto &kv : get_all_parameters()) {
+    if (!kv.second->frozen()) params.emplace(kv);
+  }
+  return params;
+}
+
+void Model::freeze() {
+  for (const auto &kv : get_all_parameters()) {
+    kv.second->freeze();
+  }
+}
+
+void Model::unfreeze() {
+  for (const auto &kv : get_all_parameters()) {
+    kv.second->unfreeze();
+  }
+}
+
 bool Model::has_submodel(const Model &model) const {
   for (const Model *sm : submodel_set_) {
     if (sm == &model) return true;
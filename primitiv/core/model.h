@@ -1,9 +1,13 @@
 #ifndef PRIMITIV_CORE_MODEL_H_
 #define PRIMITIV_CORE_MODEL_H_
 
+#include <cstdint>
+#include <future>
 #include <initializer_list>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -14,23 +18,48 @@
 namespace primitiv {
 
 class Device;
+class MappedFile;
 class Parameter;
 
+namespace msgpack {
+class Reader;
+}  // namespace msgpack
+
 /**
  * Set of parameters and specific algorithms.
  */
 class Model : mixins::Nonmovable<Model> {
 public:
-  Model() = default;
+  Model() : num_io_threads_(0) {}
   virtual ~Model() = default;
 
+  /**
+   * Retrieves the number of threads to save/load parameters.
+   * @return Number of threads. 0 means the number of hardware threads.
+   */
+  std::uint32_t get_num_io_threads() const { return num_io_threads_; }
+
+  /**
+   * Specifies the number of threads to save/load parameters.
+   * @param num_threads Number of threads. 0 means the number of hardware
+   *                    threads.
+   * @remarks Parameters on devices other than Naive and Eigen are always
+   *          processed by one thread. Loading files with the format v0.1 is
+   *          also performed sequentially.
+   */
+  void set_num_io_threads(std::uint32_t num_threads) {
+    num_io_threads_ = num_threads;
+  }
+
   /**
    * Loads all parameters from a file.
    * @param path Path of the file.
    * @param with_stats Whether or not to load all additional statistics.
    * @param device Device object to manage parameters.
    */
-  void load(const std::string &path, bool with_stats, Device *device);
+  void load(const std::string &path, bool with_stats, Device *device) {
+    load_file(path, {}, with_stats, false, device);
+  }
 
   /**
    * Loads all parameters from a file.
@@ -59,10 +88,165 @@ public:
     load(path, true, nullptr);
   }
 
+  /**
+   * Loads parameters of a submodel stored in a file.
+   * @param path Path of the file.
+   * @param prefix Name hierarchy of the submodel in the file. Parameters with
+   *               keys beginning with `prefix` are loaded into this model
+   *               after removing `prefix`, and other parameters are ignored.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param device Device object to manage parameters.
+   * @throw primitiv::Error The file does not have any parameters in `prefix`,
+   *                        or this model does not have some of them.
+   * @remarks Files with the format v0.2 or later are read only in regions of
+   *          the requested parameters.
+   */
+  void load_submodel(
+      const std::string &path, const std::vector<std::string> &prefix,
+      bool with_stats, Device *device) {
+    load_file(path, prefix, with_stats, false, device);
+  }
+
+  /**
+   * Loads parameters of a submodel stored in a file.
+   * @param path Path of the file.
+   * @param prefix Name hierarchy of the submodel in the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param device Device object to manage parameters.
+   * @remarks See `load_submodel(path, prefix, with_stats, device)` for
+   *          details.
+   */
+  void load_submodel(
+      const std::string &path, const std::vector<std::string> &prefix,
+      bool with_stats, Device &device) {
+    load_file(path, prefix, with_stats, false, &device);
+  }
+
+  /**
+   * Loads parameters of a submodel stored in a file.
+   * @param path Path of the file.
+   * @param prefix Name hierarchy of the submodel in the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @remarks See `load_submodel(path, prefix, with_stats, device)` for
+   *          details.
+   */
+  void load_submodel(
+      const std::string &path, const std::vector<std::string> &prefix,
+      bool with_stats) {
+    load_file(path, prefix, with_stats, false, nullptr);
+  }
+
+  /**
+   * Loads parameters of a submodel stored in a file.
+   * @param path Path of the file.
+   * @param prefix Name hierarchy of the submodel in the file.
+   * @remarks See `load_submodel(path, prefix, with_stats, device)` for
+   *          details.
+   */
+  void load_submodel(
+      const std::string &path, const std::vector<std::string> &prefix) {
+    load_file(path, prefix, true, false, nullptr);
+  }
+
+  /**
+   * Loads all parameters from a file at their first access.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param device Device object to manage parameters.
+   * @remarks This function reads only the index of the file, and each
+   *          parameter reads its data when it is accessed at the first time
+   *          (see `Parameter::pending()`). The file should not be modified
+   *          until all parameters are loaded. Deferred loading is
+   *          thread-safe: each parameter reads its data only once even if
+   *          multiple threads access it concurrently (see the remarks of
+   *          Parameter).
+   *          Files with the format v0.1 are loaded immediately.
+   */
+  void load_lazy(const std::string &path, bool with_stats, Device *device) {
+    load_file(path, {}, with_stats, true, device);
+  }
+
+  /**
+   * Loads all parameters from a file at their first access.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param device Device object to manage parameters.
+   * @remarks See `load_lazy(path, with_stats, device)` for details.
+   */
+  void load_lazy(const std::string &path, bool with_stats, Device &device) {
+    load_file(path, {}, with_stats, true, &device);
+  }
+
+  /**
+   * Loads all parameters from a file at their first access.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @remarks See `load_lazy(path, with_stats, device)` for details.
+   */
+  void load_lazy(const std::string &path, bool with_stats) {
+    load_file(path, {}, with_stats, true, nullptr);
+  }
+
+  /**
+   * Loads all parameters from a file at their first access.
+   * @param path Path of the file.
+   * @remarks See `load_lazy(path, with_stats, device)` for details.
+   */
+  void load_lazy(const std::string &path) {
+    load_file(path, {}, true, true, nullptr);
+  }
+
+  /**
+   * Loads all parameters from a file using the memory mapping.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param device Device object to manage parameters.
+   * @remarks Parameters on devices on the host directly use the mapped memory
+   *          of the file if possible, and they are copied into a new memory
+   *          at the first update. The mapping is private to this process and
+   *          the file is never modified through parameters, but the file
+   *          should not be overwritten or truncated while parameters refer
+   *          it.
+   */
+  void load_mapped(const std::string &path, bool with_stats, Device *device);
+
+  /**
+   * Loads all parameters from a file using the memory mapping.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param device Device object to manage parameters.
+   * @remarks See `load_mapped(path, with_stats, device)` for details.
+   */
+  void load_mapped(const std::string &path, bool with_stats, Device &device) {
+    load_mapped(path, with_stats, &device);
+  }
+
+  /**
+   * Loads all parameters from a file using the memory mapping.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @remarks See `load_mapped(path, with_stats, device)` for details.
+   */
+  void load_mapped(const std::string &path, bool with_stats) {
+    load_mapped(path, with_stats, nullptr);
+  }
+
+  /**
+   * Loads all parameters from a file using the memory mapping.
+   * @param path Path of the file.
+   * @remarks See `load_mapped(path, with_stats, device)` for details.
+   */
+  void load_mapped(const std::string &path) {
+    load_mapped(path, true, nullptr);
+  }
+
   /**
    * Saves all parameters to a file.
    * @param path Path of the file.
    * @param with_stats Whether or not to save all additional statistics.
+   * @remarks The data is written into a temporary file in the same directory,
+   *          which is flushed to the storage and renamed to `path` at last.
+   *          The existing file is kept if an error occurred while writing.
    */
   void save(const std::string &path, bool with_stats) const;
 
@@ -74,6 +258,35 @@ public:
     save(path, true);
   }
 
+  /**
+   * Saves all parameters to a file in the background.
+   * @param path Path of the file.
+   * @param with_stats Whether or not to save all additional statistics.
+   * @return Future object which becomes ready when the file is completely
+   *         written and flushed to the storage, or holds the exception thrown
+   *         while writing the file.
+   * @remarks This function takes a snapshot of current parameters and returns
+   *          immediately. The snapshot shares the memory with parameters, and
+   *          the memory is duplicated only if parameters are updated before
+   *          finishing the writing. Devices of parameters should be alive
+   *          until the future becomes ready.
+   *          If some parameters are on devices other than Naive and Eigen, the
+   *          file is written in this function and the returned future is
+   *          already ready.
+   */
+  std::future<void> save_async(const std::string &path, bool with_stats) const;
+
+  /**
+   * Saves all parameters to a file in the background.
+   * @param path Path of the file.
+   * @return Future object which becomes ready when the file is completely
+   *         written and flushed to the storage.
+   * @remarks See `save_async(path, with_stats)` for details.
+   */
+  std::future<void> save_async(const std::string &path) const {
+    return save_async(path, true);
+  }
+
   /**
    * Registers a new parameter.
    * @param name Name of the parameter.
@@ -230,16 +443,74 @@ public:
 
   /**
    * Retrieves trainable parameters in the model.
-   * @return Dictionary of parameters.
+   * @return Dictionary of parameters which are not frozen.
    */
   std::map<std::vector<std::string>, Parameter *> get_trainable_parameters(
-      ) const {
-    // NOTE(odashi):
-    // Currently this function returns all parameters.
-    return get_all_parameters();
-  }
+      ) const;
+
+  /**
+   * Freezes all parameters in the model.
+   * @remarks See `Parameter::freeze()`.
+   */
+  void freeze();
+
+  /**
+   * Unfreezes all parameters in the model.
+   * @remarks See `Parameter::unfreeze()`.
+   */
+  void unfreeze();
 
 private:
+  /**
+   * Loads parameters from a file.
+   * @param path Path of the file.
+   * @param prefix Name hierarchy of the submodel in the file to be loaded.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param lazy Whether or not to defer loading each parameter.
+   * @param device Device object to manage parameters.
+   */
+  void load_file(
+      const std::string &path, const std::vector<std::string> &prefix,
+      bool with_stats, bool lazy, Device *device);
+
+  /**
+   * Loads parameters stored by the format v0.1 from msgpack::Reader w/o
+   * checking the header.
+   * @param reader msgpack::Reader object.
+   * @param prefix Name hierarchy of the submodel in the file to be loaded.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param device Device object to manage parameters.
+   * @param file MappedFile object used as the stream of `reader`, or nullptr.
+   */
+  void load_inner(
+      msgpack::Reader &reader, const std::vector<std::string> &prefix,
+      bool with_stats, Device &device,
+      const std::shared_ptr<MappedFile> &file);
+
+  /**
+   * Saves parameters to a file.
+   * @param path Path of the file.
+   * @param keys List of keys of parameters.
+   * @param values List of parameters corresponding to `keys`.
+   * @param with_stats Whether or not to save all additional statistics.
+   * @param num_io_threads Number of threads to write parameters.
+   */
+  static void save_file(
+      const std::string &path,
+      const std::vector<const std::vector<std::string> *> &keys,
+      const std::vector<const Parameter *> &values,
+      bool with_stats, std::uint32_t num_io_threads);
+
+  /**
+   * Reads the index of parameters w/o checking the header.
+   * @param reader msgpack::Reader object.
+   * @param prefix Name hierarchy of the submodel in the file to be loaded.
+   * @return List of parameters and their offsets in the file.
+   * @throw primitiv::Error The model does not have a parameter in the index.
+   */
+  std::vector<std::pair<Parameter *, std::uint64_t>> read_index(
+      msgpack::Reader &reader, const std::vector<std::string> &prefix) const;
+
   /**
    * Check whether specified model is contained or not in the submodel
    * hierarchy.
@@ -255,6 +526,7 @@ private:
   std::unordered_set<std::string> name_set_;
   std::unordered_set<Parameter *> param_set_;
   std::unordered_set<Model *> submodel_set_;
+  std::uint32_t num_io_threads_;
 
   /**
    * Searches semi-terminal submodel with specified name hierarchy.
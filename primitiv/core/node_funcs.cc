@@ -120,7 +120,16 @@ template<>
 Node pown(const Node &x, std::int32_t k) { return REGX(x, PowN(k), x)[0]; }
 
 Node input_node(
-    const Shape &shape, const std::vector<float> &data, Device *dev, Graph *g) {
+    const Shape &shape, std::vector<float> data, Device *dev, Graph *g) {
+  return REG(
+      Graph::get_reference_or_default(g),
+      Input(shape, std::move(data), Device::get_reference_or_default(dev))
+  )[0];
+}
+
+Node shared_input_node(
+    const Shape &shape, const std::shared_ptr<float> &data, Device *dev,
+    Graph *g) {
   return REG(
       Graph::get_reference_or_default(g),
       Input(shape, data, Device::get_reference_or_default(dev))
@@ -131,6 +140,14 @@ Node parameter_node(primitiv::Parameter &param, Graph *g) {
   return REG(Graph::get_reference_or_default(g), Parameter(param))[0];
 }
 
+Node pick_parameter_node(
+    primitiv::Parameter &param, const std::vector<std::uint32_t> &ids,
+    std::uint32_t dim, Graph *g) {
+  return REG(
+      Graph::get_reference_or_default(g),
+      ParameterPick(param, ids, dim))[0];
+}
+
 template<>
 Node copy(const Node &x, Device *dev) {
   return REGX(x, Copy(Device::get_reference_or_default(dev)), x)[0];
@@ -267,6 +284,13 @@ Node elu(const Node &x, float a) {
   return REGX(x, ELU(a), x)[0];
 }
 
+template<>
+Node dropout(const Node &x, float rate, bool enabled) {
+  if (!enabled) return x;
+  if (rate == 1.) return 0. * x;
+  return REGX(x, Dropout(rate), x)[0];
+}
+
 template<>
 Node max(const Node &x, std::uint32_t dim) {
   return REGX(x, Max(dim), x)[0];
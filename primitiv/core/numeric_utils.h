@@ -1,7 +1,13 @@
 #ifndef PRIMITIV_CORE_NUMERIC_UTILS_H_
 #define PRIMITIV_CORE_NUMERIC_UTILS_H_
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+
+#include <primitiv/core/precision.h>
 
 namespace primitiv {
 namespace numeric_utils {
@@ -36,6 +42,271 @@ inline std::uint64_t calculate_shifts(std::uint64_t x) {
   return b - (1ull << (b - 1) == x);
 }
 
+/**
+ * Retrieves the bit representation of a single precision value.
+ * @param x A single precision value.
+ * @return Bits of `x`.
+ */
+inline std::uint32_t float_to_bits(float x) {
+  std::uint32_t b;
+  std::memcpy(&b, &x, sizeof(b));
+  return b;
+}
+
+/**
+ * Makes a single precision value from its bit representation.
+ * @param b Bits of the value.
+ * @return A single precision value.
+ */
+inline float bits_to_float(std::uint32_t b) {
+  float x;
+  std::memcpy(&x, &b, sizeof(x));
+  return x;
+}
+
+/**
+ * Converts a single precision value to the IEEE 754 half precision.
+ * @param x A single precision value.
+ * @return Bits of the half precision value.
+ * @remarks This function rounds `x` to the nearest even, and also supports
+ *          subnormals, infinities and NaNs.
+ */
+inline std::uint16_t float_to_half(float x) {
+  const std::uint32_t b = float_to_bits(x);
+  const std::uint32_t sign = (b >> 16) & 0x8000u;
+  const std::uint32_t abs = b & 0x7fffffffu;
+  if (abs >= 0x7f800000u) {
+    // Infinity or NaN.
+    return sign | 0x7c00u | (abs > 0x7f800000u ? 0x200u : 0u);
+  }
+  if (abs >= 0x477ff000u) {
+    // Overflows to infinity after rounding.
+    return sign | 0x7c00u;
+  }
+  if (abs < 0x38800000u) {
+    // Subnormal or zero.
+    if (abs < 0x33000000u) return sign;
+    const std::uint32_t shift = 126 - (abs >> 23);
+    const std::uint32_t mant = (abs & 0x7fffffu) | 0x800000u;
+    const std::uint32_t h = mant >> shift;
+    const std::uint32_t rem = mant & ((1u << shift) - 1);
+    const std::uint32_t tie = 1u << (shift - 1);
+    return sign | (h + (rem > tie || (rem == tie && (h & 1))));
+  }
+  // Normal. The carry of the rounding correctly moves to the exponent.
+  const std::uint32_t v = abs - 0x38000000u;
+  const std::uint32_t h = v >> 13;
+  const std::uint32_t rem = v & 0x1fffu;
+  return sign | (h + (rem > 0x1000u || (rem == 0x1000u && (h & 1))));
+}
+
+/**
+ * Converts an IEEE 754 half precision value to the single precision.
+ * @param h Bits of the half precision value.
+ * @return A single precision value.
+ */
+inline float half_to_float(std::uint16_t h) {
+  const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+  const std::uint32_t exp = (h >> 10) & 0x1fu;
+  const std::uint32_t mant = h & 0x3ffu;
+  if (exp == 0x1fu) {
+    return bits_to_float(sign | 0x7f800000u | (mant << 13));
+  }
+  if (exp == 0) {
+    const float v = mant * (1.f / 16777216.f);
+    return sign ? -v : v;
+  }
+  return bits_to_float(sign | ((exp + 112) << 23) | (mant << 13));
+}
+
+/**
+ * Converts a single precision value to the bfloat16 format.
+ * @param x A single precision value.
+ * @return Bits of the bfloat16 value.
+ * @remarks This function rounds `x` to the nearest even.
+ */
+inline std::uint16_t float_to_bfloat16(float x) {
+  const std::uint32_t b = float_to_bits(x);
+  if ((b & 0x7fffffffu) > 0x7f800000u) {
+    // Keeps NaN quiet.
+    return (b >> 16) | 0x40u;
+  }
+  return (b + 0x7fffu + ((b >> 16) & 1)) >> 16;
+}
+
+/**
+ * Converts a bfloat16 value to the single precision.
+ * @param h Bits of the bfloat16 value.
+ * @return A single precision value.
+ */
+inline float bfloat16_to_float(std::uint16_t h) {
+  return bits_to_float(static_cast<std::uint32_t>(h) << 16);
+}
+
+/**
+ * Converts single precision values to packed values with a specific
+ * precision.
+ * @param src Single precision values.
+ * @param precision Storage format of the destination.
+ * @param size Number of values.
+ * @param dest Destination memory with enough size.
+ */
+inline void encode_packed(
+    const float *src, Precision precision, std::uint32_t size, void *dest) {
+  switch (precision) {
+    case Precision::FLOAT16:
+      {
+        std::uint16_t *p = static_cast<std::uint16_t *>(dest);
+        for (std::uint32_t i = 0; i < size; ++i) p[i] = float_to_half(src[i]);
+      }
+      break;
+    case Precision::BFLOAT16:
+      {
+        std::uint16_t *p = static_cast<std::uint16_t *>(dest);
+        for (std::uint32_t i = 0; i < size; ++i) {
+          p[i] = float_to_bfloat16(src[i]);
+        }
+      }
+      break;
+    default:
+      std::memcpy(dest, src, sizeof(float) * size);
+  }
+}
+
+/**
+ * Converts packed values with a specific precision to single precision
+ * values.
+ * @param src Packed values.
+ * @param precision Storage format of the source.
+ * @param size Number of values.
+ * @param dest Destination array of single precision values.
+ */
+inline void decode_packed(
+    const void *src, Precision precision, std::uint32_t size, float *dest) {
+  switch (precision) {
+    case Precision::FLOAT16:
+      {
+        const std::uint16_t *p = static_cast<const std::uint16_t *>(src);
+        for (std::uint32_t i = 0; i < size; ++i) dest[i] = half_to_float(p[i]);
+      }
+      break;
+    case Precision::BFLOAT16:
+      {
+        const std::uint16_t *p = static_cast<const std::uint16_t *>(src);
+        for (std::uint32_t i = 0; i < size; ++i) {
+          dest[i] = bfloat16_to_float(p[i]);
+        }
+      }
+      break;
+    default:
+      std::memcpy(dest, src, sizeof(float) * size);
+  }
+}
+
+/**
+ * Quantizes single precision values to int8 values with per-row scales.
+ * @param src Single precision values. Each minibatch is a column-major matrix
+ *            with `rows` rows and `cols` columns.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param bs Minibatch size.
+ * @param scales Destination of `rows * bs` scales.
+ * @param dest Destination of `rows * cols * bs` quantized values.
+ * @remarks Each row is quantized symmetrically so that the maximum absolute
+ *          value is mapped to 127.
+ */
+inline void quantize_int8(
+    const float *src, std::uint32_t rows, std::uint32_t cols, std::uint32_t bs,
+    float *scales, std::int8_t *dest) {
+  const std::uint32_t volume = rows * cols;
+  for (std::uint32_t b = 0; b < bs; ++b) {
+    for (std::uint32_t i = 0; i < rows; ++i) {
+      float max_abs = 0;
+      for (std::uint32_t j = 0; j < cols; ++j) {
+        max_abs = std::max(max_abs, std::abs(src[i + j * rows]));
+      }
+      const float scale = max_abs / 127;
+      const float inv = scale > 0 ? 1 / scale : 0;
+      for (std::uint32_t j = 0; j < cols; ++j) {
+        const float q = std::nearbyint(src[i + j * rows] * inv);
+        dest[i + j * rows] = static_cast<std::int8_t>(
+            std::min(127.f, std::max(-127.f, q)));
+      }
+      scales[i] = scale;
+    }
+    src += volume;
+    dest += volume;
+    scales += rows;
+  }
+}
+
+/**
+ * Restores single precision values from int8 values with per-row scales.
+ * @param scales `rows * bs` scales.
+ * @param src Quantized values.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param bs Minibatch size.
+ * @param dest Destination of `rows * cols * bs` single precision values.
+ */
+inline void dequantize_int8(
+    const float *scales, const std::int8_t *src, std::uint32_t rows,
+    std::uint32_t cols, std::uint32_t bs, float *dest) {
+  const std::uint32_t volume = rows * cols;
+  for (std::uint32_t b = 0; b < bs; ++b) {
+    for (std::uint32_t j = 0; j < cols; ++j) {
+      for (std::uint32_t i = 0; i < rows; ++i) {
+        dest[i + j * rows] = scales[i] * src[i + j * rows];
+      }
+    }
+    src += volume;
+    dest += volume;
+    scales += rows;
+  }
+}
+
+/**
+ * Read-only pointer-like object over packed 16-bit values, which converts
+ * each value to the single precision on access.
+ * This class provides a subset of operations of `const float *` so that CPU
+ * kernels can be written once for every precision.
+ */
+template<float (*Decode)(std::uint16_t)>
+class PackedConstPointer {
+public:
+  explicit PackedConstPointer(const void *ptr)
+    : ptr_(static_cast<const std::uint16_t *>(ptr)) {}
+
+  float operator*() const { return Decode(*ptr_); }
+  float operator[](std::ptrdiff_t i) const { return Decode(ptr_[i]); }
+
+  PackedConstPointer operator+(std::ptrdiff_t n) const {
+    return PackedConstPointer(ptr_ + n);
+  }
+
+  PackedConstPointer &operator+=(std::ptrdiff_t n) {
+    ptr_ += n;
+    return *this;
+  }
+
+  PackedConstPointer &operator++() {
+    ++ptr_;
+    return *this;
+  }
+
+  PackedConstPointer operator++(int) {
+    PackedConstPointer ret = *this;
+    ++ptr_;
+    return ret;
+  }
+
+private:
+  const std::uint16_t *ptr_;
+};
+
+using HalfConstPointer = PackedConstPointer<half_to_float>;
+using BFloat16ConstPointer = PackedConstPointer<bfloat16_to_float>;
+
 }  // namespace numeric_utils
 }  // namespace primitiv
 
@@ -57,6 +57,18 @@ public:
    */
   virtual Device *get_device() const { return nullptr; }
 
+  /**
+   * Returns the signature to batch the operator with others.
+   * @return A string which identifies the operation and all its attributes, or
+   *         an empty string if the operator can not be batched.
+   * @remarks Operators with the same non-empty signature should calculate
+   *          each batch element independently, i.e., applying the operator to
+   *          arguments concatenated along the batch axis should be equivalent
+   *          to applying it to each argument and concatenating the results.
+   *          Arguments with the batch size 1 are broadcasted.
+   */
+  virtual std::string batch_signature() const { return std::string(); }
+
   /**
    * Calculates only the resulting shape.
    * @param args Shapes of argument values.
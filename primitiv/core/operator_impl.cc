@@ -1,6 +1,7 @@
 #include <primitiv/config.h>
 
 #include <algorithm>
+#include <cstring>
 
 #include <primitiv/core/device.h>
 #include <primitiv/core/error.h>
@@ -21,16 +22,28 @@ namespace operators {
  * Constructors.
  */
 
-Input::Input(const Shape &shape, const vector<float> &data, Device &device)
+Input::Input(const Shape &shape, vector<float> &&data, Device &device)
 : shape_(shape)
-, data_(data)
+, data_()
 , device_(device) {
-  if (data_.size() != shape_.size()) {
+  if (data.size() != shape_.size()) {
     PRIMITIV_THROW_ERROR(
         "Data sizes mismatched."
         << " operator: Input"
         << ", required: " << shape_.size() << " (" << shape_.to_string() << ")"
-        << ", actual: " << data_.size());
+        << ", actual: " << data.size());
+  }
+  const auto holder = std::make_shared<vector<float>>(std::move(data));
+  data_ = std::shared_ptr<float>(holder, holder->data());
+}
+
+Input::Input(
+    const Shape &shape, const std::shared_ptr<float> &data, Device &device)
+: shape_(shape)
+, data_(data)
+, device_(device) {
+  if (!data_) {
+    PRIMITIV_THROW_ERROR("Null data is given to operator: Input");
   }
 }
 
@@ -52,6 +65,7 @@ Input::Input(const Shape &shape, const vector<float> &data, Device &device)
 
 IMPL_NAME_0(Input);
 IMPL_NAME_0(Parameter);
+IMPL_NAME_1(ParameterPick, dim_);
 IMPL_NAME_0(Copy);
 IMPL_NAME_1(Constant, k_);
 IMPL_NAME_1(Identity, size_);
@@ -80,6 +94,7 @@ IMPL_NAME_1(Min, dim_);
 IMPL_NAME_1(Sum, dim_);
 IMPL_NAME_1(LogSumExp, dim_);
 IMPL_NAME_2(Broadcast, dim_, size_);
+IMPL_NAME_1(Dropout, rate_);
 IMPL_NAME_1(SoftmaxCrossEntropy, dim_);
 IMPL_NAME_1(SparseSoftmaxCrossEntropy, dim_);
 IMPL_NAME_0(StopGradient);
@@ -168,6 +183,91 @@ std::string MaxPooling2D::name() const {
 #undef IMPL_NAME_1
 #undef IMPL_NAME_2
 
+/*
+ * Batch signatures.
+ */
+
+namespace {
+
+// Represents the exact value of the floating point attribute.
+std::string exact_string(float k) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &k, sizeof(bits));
+  return string_utils::to_string(bits);
+}
+
+}  // namespace
+
+#define IMPL_BATCH_SIGNATURE(cls) \
+  std::string cls::batch_signature() const { return name(); }
+#define IMPL_BATCH_SIGNATURE_K(cls) \
+  std::string cls::batch_signature() const { \
+  return #cls "(" + exact_string(k_) + ')'; \
+}
+
+IMPL_BATCH_SIGNATURE(Slice);
+IMPL_BATCH_SIGNATURE(Concat);
+IMPL_BATCH_SIGNATURE(Flip);
+IMPL_BATCH_SIGNATURE(Max);
+IMPL_BATCH_SIGNATURE(Min);
+IMPL_BATCH_SIGNATURE(Sum);
+IMPL_BATCH_SIGNATURE(LogSumExp);
+IMPL_BATCH_SIGNATURE(Broadcast);
+IMPL_BATCH_SIGNATURE(StopGradient);
+IMPL_BATCH_SIGNATURE(Flatten);
+IMPL_BATCH_SIGNATURE(Positive);
+IMPL_BATCH_SIGNATURE(Negative);
+
+IMPL_BATCH_SIGNATURE_K(AddConst);
+IMPL_BATCH_SIGNATURE_K(SubtractConstR);
+IMPL_BATCH_SIGNATURE_K(SubtractConstL);
+IMPL_BATCH_SIGNATURE_K(MultiplyConst);
+IMPL_BATCH_SIGNATURE_K(DivideConstR);
+IMPL_BATCH_SIGNATURE_K(DivideConstL);
+IMPL_BATCH_SIGNATURE_K(PowConstR);
+IMPL_BATCH_SIGNATURE_K(PowConstL);
+IMPL_BATCH_SIGNATURE_K(PReLU);
+IMPL_BATCH_SIGNATURE_K(ELU);
+
+IMPL_BATCH_SIGNATURE(PowN);
+
+IMPL_BATCH_SIGNATURE(AddScalar);
+IMPL_BATCH_SIGNATURE(SubtractScalarR);
+IMPL_BATCH_SIGNATURE(SubtractScalarL);
+IMPL_BATCH_SIGNATURE(MultiplyScalar);
+IMPL_BATCH_SIGNATURE(DivideScalarR);
+IMPL_BATCH_SIGNATURE(DivideScalarL);
+IMPL_BATCH_SIGNATURE(PowScalarR);
+IMPL_BATCH_SIGNATURE(PowScalarL);
+
+IMPL_BATCH_SIGNATURE(Add);
+IMPL_BATCH_SIGNATURE(Subtract);
+IMPL_BATCH_SIGNATURE(Multiply);
+IMPL_BATCH_SIGNATURE(Divide);
+IMPL_BATCH_SIGNATURE(Pow);
+
+IMPL_BATCH_SIGNATURE(Transpose);
+IMPL_BATCH_SIGNATURE(MatrixMultiply);
+
+IMPL_BATCH_SIGNATURE(Abs);
+IMPL_BATCH_SIGNATURE(Sqrt);
+IMPL_BATCH_SIGNATURE(Exp);
+IMPL_BATCH_SIGNATURE(Log);
+IMPL_BATCH_SIGNATURE(Tanh);
+IMPL_BATCH_SIGNATURE(Sigmoid);
+IMPL_BATCH_SIGNATURE(Softplus);
+IMPL_BATCH_SIGNATURE(Sin);
+IMPL_BATCH_SIGNATURE(Cos);
+IMPL_BATCH_SIGNATURE(Tan);
+IMPL_BATCH_SIGNATURE(ReLU);
+IMPL_BATCH_SIGNATURE(LReLU);
+
+IMPL_BATCH_SIGNATURE(Convolution2D);
+IMPL_BATCH_SIGNATURE(MaxPooling2D);
+
+#undef IMPL_BATCH_SIGNATURE
+#undef IMPL_BATCH_SIGNATURE_K
+
 /*
  * Shape forwarding operations.
  */
@@ -188,6 +288,10 @@ std::string MaxPooling2D::name() const {
 
 FWD_SHAPE(Input) { UNUSED(x); *y[0] = shape_; }
 FWD_SHAPE(Parameter) { UNUSED(x); *y[0] = param_.shape(); }
+FWD_SHAPE(ParameterPick) {
+  UNUSED(x);
+  *y[0] = shape_ops::pick(param_.shape(), ids_, dim_);
+}
 FWD_SHAPE(Copy) { *y[0] = *x[0]; }
 FWD_SHAPE(Constant) { UNUSED(x); *y[0] = shape_; }
 FWD_SHAPE(Identity) { UNUSED(x); *y[0] = Shape({size_, size_}); }
@@ -241,6 +345,7 @@ FWD_SHAPE_UNARY(ReLU);
 FWD_SHAPE_UNARY(LReLU);
 FWD_SHAPE_UNARY(PReLU);
 FWD_SHAPE_UNARY(ELU);
+FWD_SHAPE_UNARY(Dropout);
 FWD_SHAPE_UNARY(PowN);
 FWD_SHAPE_UNARY(Flip);
 FWD_SHAPE_SCALAR(AddScalar);
@@ -313,7 +418,11 @@ FWD_SHAPE_UNARY(StopGradient);
  */
 
 vector<const Tensor *> Parameter::get_inner_values() const {
-  return std::vector<const Tensor *> { &param_.value() };
+  // NOTE:
+  // Only const accessors of parameters are used in the forward operation so
+  // that multiple threads can share parameters.
+  const primitiv::Parameter &param = param_;
+  return std::vector<const Tensor *> { &param.value() };
 }
 
 /*
@@ -327,7 +436,13 @@ vector<const Tensor *> Parameter::get_inner_values() const {
 
 FORWARD(Input) {
   UNUSED(x);
-  *y[0] = functions::input<Tensor>(shape_, data_, device_);
+  *y[0] = device_.new_tensor_by_shared_array(shape_, data_);
+}
+
+FORWARD(ParameterPick) {
+  UNUSED(x);
+  const primitiv::Parameter &param = param_;
+  *y[0] = functions::pick(param.value(), ids_, dim_);
 }
 
 FORWARD(Copy) { *y[0] = functions::copy(*x[0], device_); }
@@ -399,6 +514,12 @@ FORWARD(PowConstL) { *y[0] = functions::pow(k_, *x[0]); }
 FORWARD(PReLU) { *y[0] = functions::prelu(*x[0], k_); }
 FORWARD(ELU) { *y[0] = functions::elu(*x[0], k_); }
 
+FORWARD(Dropout) {
+  Device &dev = x[0]->device();
+  seed_ = dev.random_seed();
+  *y[0] = dev.dropout_fw(*x[0], rate_, seed_);
+}
+
 FORWARD(PowN) { *y[0] = functions::pown(*x[0], k_); }
 
 FORWARD(AddScalar) { *y[0] = *x[0] + *x[1]; }
@@ -430,7 +551,26 @@ FORWARD(Max) { *y[0] = functions::max(*x[0], dim_); }
 FORWARD(Min) { *y[0] = functions::min(*x[0], dim_); }
 
 FORWARD(BatchPick) { *y[0] = functions::batch::pick(*x[0], ids_); }
-FORWARD(BatchSlice) { *y[0] = functions::batch::slice(*x[0], lower_, upper_); }
+FORWARD(BatchSlice) {
+  // NOTE:
+  // The batch axis is the outermost one, and each slice is a contiguous range
+  // of the argument. Host devices provide it as a view without copying, and
+  // the view shares the reference counter with the argument so that in-place
+  // operations on the result do not modify the argument (e.g., a parameter).
+  const Tensor &src = *x[0];
+  Device &dev = src.device();
+  const std::uint32_t group
+    = static_cast<std::uint32_t>(dev.type())
+    & static_cast<std::uint32_t>(DeviceType::GROUP_FILTER);
+  if (group == static_cast<std::uint32_t>(DeviceType::GROUP_CPU)
+      && src.precision() == Precision::FLOAT32
+      && lower_ < upper_ && upper_ <= src.shape().batch()) {
+    const Shape shape = src.shape().resize_batch(upper_ - lower_);
+    *y[0] = dev.new_shared_view(src, lower_ * src.shape().volume(), shape);
+    return;
+  }
+  *y[0] = functions::batch::slice(src, lower_, upper_);
+}
 FORWARD(BatchSplit) {
   const std::uint32_t total = x[0]->shape().batch();
   const std::uint32_t span = total / n_;
@@ -489,9 +629,18 @@ BACKWARD(Parameter) {
   UNUSED(x);
   UNUSED(y);
   UNUSED(gx);
+  if (param_.frozen()) return;
   param_.gradient() += *gy[0];
 }
 
+BACKWARD(ParameterPick) {
+  UNUSED(x);
+  UNUSED(y);
+  UNUSED(gx);
+  if (param_.frozen()) return;
+  param_.add_sparse_gradient(*gy[0], ids_, dim_);
+}
+
 BACKWARD(Copy) {
   UNUSED(x);
   UNUSED(y);
@@ -656,6 +805,12 @@ BACKWARD(ELU) {
   gy[0]->device().elu_bw(*x[0], *y[0], *gy[0], k_, *gx[0]);
 }
 
+BACKWARD(Dropout) {
+  UNUSED(x);
+  UNUSED(y);
+  gy[0]->device().dropout_bw(*gy[0], rate_, seed_, *gx[0]);
+}
+
 BACKWARD(PowN) {
   gy[0]->device().pown_bw(*x[0], *y[0], *gy[0], k_, *gx[0]);
 }
@@ -2,6 +2,7 @@
 #define PRIMITIV_CORE_OPERATOR_IMPL_H_
 
 #include <cstdint>
+#include <memory>
 
 #include <primitiv/core/operator.h>
 #include <primitiv/core/parameter.h>
@@ -35,14 +36,22 @@ public: \
       const std::vector<const Tensor *> &args, \
       const std::vector<Tensor *> &rets) const override;
 
+#define PRIMITIV_DECL_BATCHABLE \
+public: \
+  std::string batch_signature() const override;
+
 class Input : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
 public:
-  Input(const Shape &shape, const std::vector<float> &data, Device &device);
+  Input(const Shape &shape, const std::vector<float> &data, Device &device)
+    : Input(shape, std::vector<float>(data), device) {}
+  Input(const Shape &shape, std::vector<float> &&data, Device &device);
+  Input(
+      const Shape &shape, const std::shared_ptr<float> &data, Device &device);
   Device *get_device() const override { return &device_; }
 private:
   Shape shape_;
-  std::vector<float> data_;
+  std::shared_ptr<float> data_;
   Device &device_;
 };
 
@@ -56,6 +65,20 @@ private:
   primitiv::Parameter &param_;
 };
 
+class ParameterPick : public Operator {
+  PRIMITIV_DECL_DEFAULTS_AND_FORWARD(0, 1);
+public:
+  ParameterPick(
+      primitiv::Parameter &param,
+      const std::vector<std::uint32_t> &ids, std::uint32_t dim)
+    : param_(param), ids_(ids), dim_(dim) {}
+  Device *get_device() const override { return &param_.device(); }
+private:
+  primitiv::Parameter &param_;
+  std::vector<std::uint32_t> ids_;
+  std::uint32_t dim_;
+};
+
 class Copy : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
 public:
@@ -150,6 +173,7 @@ private:
 
 class Slice : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   Slice(std::uint32_t dim, std::uint32_t lower, std::uint32_t upper)
     : dim_(dim), lower_(lower), upper_(upper) {}
@@ -170,6 +194,7 @@ private:
 
 class Concat : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(Operator::NONZERO, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   explicit Concat(std::uint32_t dim) : dim_(dim) {}
 private:
@@ -186,6 +211,7 @@ private:
 
 class Flip : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   explicit Flip(std::uint32_t dim) : dim_(dim) {}
 private:
@@ -194,6 +220,7 @@ private:
 
 class Max : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   explicit Max(std::uint32_t dim) : dim_(dim) {}
 private:
@@ -202,6 +229,7 @@ private:
 
 class Min : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   explicit Min(std::uint32_t dim) : dim_(dim) {}
 private:
@@ -210,6 +238,7 @@ private:
 
 class Sum : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   explicit Sum(std::uint32_t dim) : dim_(dim) {}
 private:
@@ -218,6 +247,7 @@ private:
 
 class LogSumExp : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   explicit LogSumExp(std::uint32_t dim) : dim_(dim) {}
 private:
@@ -226,6 +256,7 @@ private:
 
 class Broadcast : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   Broadcast(std::uint32_t dim, std::uint32_t size) : dim_(dim), size_(size) {}
 private:
@@ -233,6 +264,15 @@ private:
   std::uint32_t size_;
 };
 
+class Dropout : public Operator {
+  PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+public:
+  explicit Dropout(float rate) : rate_(rate), seed_(0) {}
+private:
+  float rate_;
+  mutable std::uint32_t seed_;  // Drawn at forward() and reused at backward()
+};
+
 class SoftmaxCrossEntropy : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
 public:
@@ -257,12 +297,14 @@ private:
 #define PRIMITIV_DECL_UNARY(name_) \
   class name_ : public Operator { \
     PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1); \
+    PRIMITIV_DECL_BATCHABLE; \
   }
 
 // Unary operator with a constant.
 #define PRIMITIV_DECL_UNARY_K(name_, type) \
   class name_ : public Operator { \
     PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1); \
+    PRIMITIV_DECL_BATCHABLE; \
   public: \
     explicit name_(type k) : k_(k) {} \
   private: \
@@ -273,6 +315,7 @@ private:
 #define PRIMITIV_DECL_BINARY(name_) \
   class name_ : public Operator { \
     PRIMITIV_DECL_DEFAULTS_AND_FORWARD(2, 1); \
+    PRIMITIV_DECL_BATCHABLE; \
   }
 
 PRIMITIV_DECL_UNARY(StopGradient);
@@ -364,10 +407,13 @@ class BatchConcat : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(Operator::NONZERO, 1);
 };
 
-PRIMITIV_DECL_UNARY(BatchSum);
+class BatchSum : public Operator {
+  PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+};
 
 class Convolution2D : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(2, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   Convolution2D(
       std::uint32_t padding0, std::uint32_t padding1,
@@ -384,6 +430,7 @@ private:
 
 class MaxPooling2D : public Operator {
   PRIMITIV_DECL_DEFAULTS_AND_FORWARD(1, 1);
+  PRIMITIV_DECL_BATCHABLE;
 public:
   MaxPooling2D(
       std::uint32_t window0, std::uint32_t window1,
@@ -402,6 +449,8 @@ private:
 #undef PRIMITIV_DECL_UNARY_K
 #undef PRIMITIV_DECL_BINARY
 
+#undef PRIMITIV_DECL_BATCHABLE
+
 #undef PRIMITIV_DECL_DEFAULTS_AND_FORWARD
 #undef PRIMITIV_DECL_DEFAULTS
 
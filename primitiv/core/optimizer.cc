@@ -1,7 +1,11 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <functional>
+#include <primitiv/core/arithmetic.h>
+#include <primitiv/core/device.h>
 #include <primitiv/core/error.h>
 #include <primitiv/core/file_format.h>
 #include <primitiv/core/functions.h>
@@ -11,8 +15,34 @@
 #include <primitiv/msgpack/reader.h>
 #include <primitiv/msgpack/writer.h>
 
+namespace {
+
+// Writes configurations of the optimizer to a file.
+void write_configs(
+    const std::string &path,
+    const std::unordered_map<std::string, std::uint32_t> &uint_configs,
+    const std::unordered_map<std::string, float> &float_configs) {
+  std::ofstream ofs(path);
+  if (!ofs.is_open()) {
+    PRIMITIV_THROW_ERROR("Could not open file: " << path);
+  }
+  primitiv::msgpack::Writer writer(ofs);
+
+  writer << primitiv::FileFormat::CurrentVersion::MAJOR;
+  writer << primitiv::FileFormat::written_minor_version(
+      primitiv::FileFormat::DataType::OPTIMIZER);
+  writer << static_cast<std::uint32_t>(
+      primitiv::FileFormat::DataType::OPTIMIZER);
+  writer << uint_configs << float_configs;
+  if (!ofs.flush()) PRIMITIV_THROW_ERROR("Could not write file: " << path);
+}
+
+}  // namespace
+
 namespace primitiv {
 
+Optimizer::~Optimizer() = default;
+
 void Optimizer::load(const std::string &path) {
   std::ifstream ifs(path);
   if (!ifs.is_open()) {
@@ -38,26 +68,29 @@ void Optimizer::save(const std::string &path) const {
   std::unordered_map<std::string, std::uint32_t> uint_configs;
   std::unordered_map<std::string, float> float_configs;
   get_configs(uint_configs, float_configs);
+  ::write_configs(path, uint_configs, float_configs);
+}
 
-  std::ofstream ofs(path);
-  if (!ofs.is_open()) {
-    PRIMITIV_THROW_ERROR("Could not open file: " << path);
-  }
-  msgpack::Writer writer(ofs);
-
-  writer << FileFormat::CurrentVersion::MAJOR;
-  writer << FileFormat::CurrentVersion::MINOR;
-  writer << static_cast<std::uint32_t>(FileFormat::DataType::OPTIMIZER);
-  writer << uint_configs << float_configs;
+std::future<void> Optimizer::save_async(const std::string &path) const {
+  std::unordered_map<std::string, std::uint32_t> uint_configs;
+  std::unordered_map<std::string, float> float_configs;
+  get_configs(uint_configs, float_configs);
+  return std::async(std::launch::async, [=]() {
+      ::write_configs(path, uint_configs, float_configs);
+  });
 }
 
 void Optimizer::add_inner(Parameter &param) {
-  if (params_.find(&param) != params_.end()) {
+  if (param_set_.find(&param) != param_set_.end()) {
     // Explicitly allows to call this function multiple time using the same
     // Parameter object.
     return;
   }
-  params_.insert(&param);
+  if (param.frozen()) {
+    PRIMITIV_THROW_ERROR("Could not add a frozen parameter.");
+  }
+  params_.emplace_back(&param);
+  param_set_.insert(&param);
   configure_parameter(param);
 }
 
@@ -67,46 +100,348 @@ void Optimizer::add_inner(const Model &model) {
   }
 }
 
-void Optimizer::reset_gradients() {
+void Optimizer::pack_parameters() {
+  struct Group {
+    Device *device;
+    std::vector<std::string> stats_names;
+    std::vector<Parameter *> params;
+    std::uint32_t size;
+    std::unique_ptr<Parameter> buffer;
+    std::vector<Tensor> value_views;
+    std::vector<Tensor> grad_views;
+    std::unordered_map<std::string, std::vector<Tensor>> stats_views;
+  };
+
+  // Groups parameters by the device and names of statistics.
+  std::vector<Group> groups;
+  for (Parameter *param : params_) {
+    if (!param->valid()) continue;
+    param->check_valid();
+    const std::uint32_t size = param->shape_.size();
+    std::vector<std::string> stats_names;
+    bool packable = true;
+    for (const auto &kv : param->stats_) {
+      if (kv.second.shape() != param->shape_) packable = false;
+      stats_names.emplace_back(kv.first);
+    }
+    if (!packable) continue;
+    std::sort(stats_names.begin(), stats_names.end());
+
+    auto it = std::find_if(
+        groups.begin(), groups.end(), [&](const Group &g) {
+          return g.device == param->device_ &&
+            g.stats_names == stats_names &&
+            g.size <= 0xffffffffu - size;
+        });
+    if (it == groups.end()) {
+      groups.emplace_back();
+      it = groups.end() - 1;
+      it->device = param->device_;
+      it->stats_names = std::move(stats_names);
+      it->size = 0;
+    }
+    it->params.emplace_back(param);
+    it->size += size;
+  }
+
+  // Allocates buffers and copies all tensors into them.
+  // Parameters are not modified until all allocations succeeded.
+  for (Group &g : groups) {
+    Device &dev = *g.device;
+    const Shape flat_shape({g.size});
+    const auto pack = [&](
+        const std::vector<const Tensor *> &srcs, std::vector<Tensor> &views) {
+      const Tensor storage = functions::zeros<Tensor>(flat_shape, dev);
+      std::uint32_t offset = 0;
+      for (const Tensor *src : srcs) {
+        Tensor view = dev.new_view(storage, offset, src->shape());
+        view += *src;
+        views.emplace_back(std::move(view));
+        offset += src->shape().size();
+      }
+      // NOTE:
+      // `storage` is released here and the flat buffer is also a view, so
+      // that in-place operations on the buffer do not duplicate the memory.
+      return dev.new_view(storage, 0, flat_shape);
+    };
+
+    std::vector<const Tensor *> values, grads;
+    for (const Parameter *param : g.params) {
+      values.emplace_back(&param->value_);
+      grads.emplace_back(&param->grad_);
+    }
+
+    g.buffer.reset(new Parameter());
+    g.buffer->shape_ = flat_shape;
+    g.buffer->device_ = &dev;
+    g.buffer->value_ = pack(values, g.value_views);
+    g.buffer->grad_ = pack(grads, g.grad_views);
+    for (const std::string &name : g.stats_names) {
+      std::vector<const Tensor *> stats;
+      for (const Parameter *param : g.params) {
+        stats.emplace_back(&param->stats_.at(name));
+      }
+      g.buffer->stats_.emplace(name, pack(stats, g.stats_views[name]));
+    }
+  }
+
+  // Replaces tensors of all parameters by views.
+  buffers_.clear();
+  packed_entries_.clear();
+  packed_set_.clear();
+  for (Group &g : groups) {
+    const std::size_t buffer_id = buffers_.size();
+    std::uint32_t offset = 0;
+    for (std::size_t i = 0; i < g.params.size(); ++i) {
+      Parameter &param = *g.params[i];
+      param.value_ = std::move(g.value_views[i]);
+      param.grad_ = std::move(g.grad_views[i]);
+      for (const std::string &name : g.stats_names) {
+        param.stats_.at(name) = std::move(g.stats_views[name][i]);
+      }
+      // NOTE:
+      // Gradients of packed parameters are processed through buffers.
+      param.sparse_grad_ = false;
+      param.sparse_ids_.clear();
+      packed_entries_.emplace_back(PackedEntry { &param, buffer_id, offset });
+      packed_set_.insert(&param);
+      offset += param.shape_.size();
+    }
+    buffers_.emplace_back(std::move(g.buffer));
+  }
+}
+
+bool Optimizer::packed() {
+  validate_packed_parameters();
+  return !buffers_.empty();
+}
+
+void Optimizer::validate_packed_parameters() {
+  for (const PackedEntry &entry : packed_entries_) {
+    const Parameter &param = *entry.param;
+    const Parameter &buffer = *buffers_[entry.buffer_id];
+    Device &dev = *buffer.device_;
+    bool ok = param.device_ == &dev &&
+      param.stats_.size() == buffer.stats_.size() &&
+      dev.is_view(param.value_, buffer.value_, entry.offset) &&
+      dev.is_view(param.grad_, buffer.grad_, entry.offset);
+    for (const auto &kv : buffer.stats_) {
+      if (!ok) break;
+      const auto it = param.stats_.find(kv.first);
+      ok = it != param.stats_.end() &&
+        dev.is_view(it->second, kv.second, entry.offset);
+    }
+    if (!ok) {
+      // Falls back to the per-parameter processing. Remaining views keep the
+      // memory of buffers alive.
+      buffers_.clear();
+      packed_entries_.clear();
+      packed_set_.clear();
+      return;
+    }
+  }
+}
+
+void Optimizer::unshare_packed_parameters() {
+  std::vector<std::vector<const PackedEntry *>> entries(buffers_.size());
+  for (const PackedEntry &entry : packed_entries_) {
+    entries[entry.buffer_id].emplace_back(&entry);
+  }
+
+  for (std::size_t i = 0; i < buffers_.size(); ++i) {
+    Parameter &buffer = *buffers_[i];
+    Device &dev = *buffer.device_;
+    // NOTE:
+    // Shared views (e.g., snapshots of parameters) should not be modified
+    // through buffers. Like the copy-on-write of Tensor, the memory is
+    // duplicated and other objects keep the old memory.
+    const auto unshare = [&](
+        Tensor &flat, const std::function<Tensor &(Parameter &)> &member) {
+      bool shared = false;
+      for (const PackedEntry *entry : entries[i]) {
+        shared = shared || member(*entry->param).shared();
+      }
+      if (!shared) return;
+      const Tensor storage = dev.copy_tensor(flat);
+      for (const PackedEntry *entry : entries[i]) {
+        Parameter &param = *entry->param;
+        member(param) = dev.new_view(storage, entry->offset, param.shape_);
+      }
+      flat = dev.new_view(storage, 0, flat.shape());
+    };
+
+    unshare(buffer.value_, [](Parameter &p) -> Tensor & { return p.value_; });
+    unshare(buffer.grad_, [](Parameter &p) -> Tensor & { return p.grad_; });
+    for (auto &kv : buffer.stats_) {
+      const std::string &name = kv.first;
+      unshare(kv.second, [&name](Parameter &p) -> Tensor & {
+          return p.stats_.at(name);
+      });
+    }
+  }
+}
+
+std::vector<Parameter *> Optimizer::update_targets() {
+  validate_packed_parameters();
+  unshare_packed_parameters();
+  std::vector<Parameter *> targets;
+  targets.reserve(buffers_.size() + params_.size() - packed_set_.size());
+  for (const auto &buffer : buffers_) {
+    targets.emplace_back(buffer.get());
+  }
   for (Parameter *param : params_) {
+    // NOTE:
+    // Parameters may be frozen after they are added.
+    if (!param->frozen() && packed_set_.find(param) == packed_set_.end()) {
+      targets.emplace_back(param);
+    }
+  }
+  return targets;
+}
+
+void Optimizer::reset_gradients() {
+  if (accum_count_ > 0) {
+    // Keeps accumulated gradients.
+    return;
+  }
+  for (Parameter *param : update_targets()) {
     param->reset_gradient();
   }
 }
 
 void Optimizer::update() {
+  if (++accum_count_ < accum_steps_) {
+    // Waits remaining micro-batches.
+    return;
+  }
+  const std::uint32_t num_micro_batches = accum_count_;
+  accum_count_ = 0;
+
+  std::vector<Parameter *> targets = update_targets();
+
+  // Replaces parameters with row-sparse gradients by their rows so that
+  // following passes process only those rows.
+  std::vector<std::pair<std::unique_ptr<Parameter>, Parameter *>> sparse_params;
+  for (Parameter *&param : targets) {
+    std::unique_ptr<Parameter> rows = gather_rows(*param);
+    if (rows) {
+      sparse_params.emplace_back(std::move(rows), param);
+      param = sparse_params.back().first.get();
+    }
+  }
+
+  if (num_micro_batches > 1) {
+    // Averages accumulated gradients.
+    const float accum_scale = 1.f / num_micro_batches;
+    for (Parameter *param : targets) {
+      param->gradient() *= accum_scale;
+    }
+  }
+
   if (l2_strength_ > 0) {
     // Weight decay
-    for (Parameter *param : params_) {
+    for (Parameter *param : targets) {
       param->gradient() += l2_strength_ * param->value();
     }
   }
 
   if (clip_threshold_ > 0) {
     // Gradient clipping
+    std::vector<Device *> devices;
+    std::unordered_map<Device *, std::vector<const Tensor *>> grads;
+    for (const Parameter *param : targets) {
+      std::vector<const Tensor *> &dev_grads = grads[&param->device()];
+      if (dev_grads.empty()) devices.emplace_back(&param->device());
+      dev_grads.emplace_back(&param->gradient());
+    }
     float sq_norm = 0;
-    for (const Parameter *param : params_) {
-      const Tensor &g = param->gradient();
-      sq_norm += functions::sum(functions::flatten(g * g), 0).to_float();
+    for (Device *dev : devices) {
+      sq_norm += dev->squared_norm(grads[dev]);
     }
     if (sq_norm > clip_threshold_ * clip_threshold_) {
       float clip_scale = clip_threshold_ / std::sqrt(sq_norm);
-      for (Parameter *param : params_) {
+      for (Parameter *param : targets) {
         param->gradient() *= clip_scale;
       }
     }
   }
 
-  for (Parameter *param : params_) {
+  for (Parameter *param : targets) {
     update_parameter(lr_scale_, *param);
   }
 
+  for (auto &kv : sparse_params) {
+    scatter_rows(*kv.first, *kv.second);
+  }
+
   ++epoch_;
 }
 
+std::unique_ptr<Parameter> Optimizer::gather_rows(const Parameter &param) {
+  if (!param.valid() || !param.sparse_grad_ || param.sparse_ids_.empty()) {
+    return nullptr;
+  }
+  Device &dev = *param.device_;
+  const bool on_cpu
+    = (static_cast<std::uint32_t>(dev.type())
+        & static_cast<std::uint32_t>(DeviceType::GROUP_FILTER))
+    == static_cast<std::uint32_t>(DeviceType::GROUP_CPU);
+  for (const auto &kv : param.stats_) {
+    if (kv.second.shape() != param.shape_) return nullptr;
+    switch (kv.second.precision()) {
+      case Precision::FLOAT32:
+        break;
+      case Precision::FLOAT16:
+      case Precision::BFLOAT16:
+        // Only CPU devices pick and write back 16-bit values.
+        if (!on_cpu) return nullptr;
+        break;
+      default:
+        return nullptr;
+    }
+  }
+  const std::vector<std::uint32_t> &ids = param.sparse_ids_;
+  const std::uint32_t dim = param.sparse_dim_;
+  std::unique_ptr<Parameter> rows(new Parameter());
+  rows->value_ = dev.pick_fw(param.value_, ids, dim);
+  rows->grad_ = dev.pick_fw(param.grad_, ids, dim);
+  for (const auto &kv : param.stats_) {
+    Tensor picked = dev.pick_fw(kv.second, ids, dim);
+    if (kv.second.precision() != Precision::FLOAT32) {
+      // NOTE:
+      // pick_fw() always returns single precision values, which are restored
+      // to the original precision without rounding errors.
+      picked = dev.copy_tensor(picked, kv.second.precision());
+    }
+    rows->stats_.emplace(kv.first, std::move(picked));
+  }
+  rows->shape_ = rows->value_.shape();
+  rows->device_ = &dev;
+  return rows;
+}
+
+void Optimizer::scatter_rows(const Parameter &rows, Parameter &param) {
+  Device &dev = *param.device_;
+  const std::vector<std::uint32_t> &ids = param.sparse_ids_;
+  const std::uint32_t dim = param.sparse_dim_;
+  dev.inplace_pick_assign(rows.value_, ids, dim, param.value_);
+  dev.inplace_pick_assign(rows.grad_, ids, dim, param.grad_);
+  for (auto &kv : param.stats_) {
+    const Tensor &src = rows.stats_.at(kv.first);
+    if (kv.second.precision() != src.precision()) {
+      // The optimizer changed the storage format of the statistics.
+      kv.second = dev.copy_tensor(kv.second, src.precision());
+    }
+    dev.inplace_pick_assign(src, ids, dim, kv.second);
+  }
+}
+
 void Optimizer::get_configs(
     std::unordered_map<std::string, std::uint32_t> &uint_configs,
     std::unordered_map<std::string, float> &float_configs) const {
   uint_configs.insert(std::make_pair("Optimizer.epoch", epoch_));
+  uint_configs.insert(std::make_pair("Optimizer.accum_steps", accum_steps_));
+  uint_configs.insert(std::make_pair("Optimizer.accum_count", accum_count_));
   float_configs.insert(std::make_pair("Optimizer.lr_scale", lr_scale_));
   float_configs.insert(std::make_pair("Optimizer.l2_strength", l2_strength_));
   float_configs.insert(std::make_pair("Optimizer.clip_threshold", clip_threshold_));
@@ -121,6 +456,20 @@ void Optimizer::set_configs(
     dest = it->second; \
   } \
 }
+  std::uint32_t accum_steps = accum_steps_;
+  std::uint32_t accum_count = accum_count_;
+  SET_CONFIG(accum_steps, uint_configs, "Optimizer.accum_steps");
+  SET_CONFIG(accum_count, uint_configs, "Optimizer.accum_count");
+  if (accum_steps == 0) {
+    PRIMITIV_THROW_ERROR("Could not set 0 to Optimizer.accum_steps.");
+  }
+  if (accum_count >= accum_steps) {
+    PRIMITIV_THROW_ERROR(
+        "Optimizer.accum_count should be less than Optimizer.accum_steps. "
+        "accum_count: " << accum_count << ", accum_steps: " << accum_steps);
+  }
+  accum_steps_ = accum_steps;
+  accum_count_ = accum_count;
   SET_CONFIG(epoch_, uint_configs, "Optimizer.epoch");
   SET_CONFIG(lr_scale_, float_configs, "Optimizer.lr_scale");
   SET_CONFIG(l2_strength_, float_configs, "Optimizer.l2_strength");
@@ -2,9 +2,12 @@
 #define PRIMITIV_CORE_OPTIMIZER_H_
 
 #include <cstdint>
+#include <future>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <primitiv/core/error.h>
 #include <primitiv/core/mixins/nonmovable.h>
@@ -19,9 +22,11 @@ class Parameter;
  */
 class Optimizer : mixins::Nonmovable<Optimizer> {
 public:
-  Optimizer() : epoch_(0), lr_scale_(1), l2_strength_(0), clip_threshold_(0) {}
+  Optimizer()
+    : epoch_(0), lr_scale_(1), l2_strength_(0), clip_threshold_(0)
+    , accum_steps_(1), accum_count_(0) {}
 
-  virtual ~Optimizer() = default;
+  virtual ~Optimizer();
 
   /**
    * Loads configurations from a file.
@@ -35,6 +40,15 @@ public:
    */
   void save(const std::string &path) const;
 
+  /**
+   * Saves current configurations to a file in the background.
+   * @param path Path of the file that will store optimizer parameters.
+   * @return Future object which becomes ready when the file is completely
+   *         written, or holds the exception thrown while writing the file.
+   * @remarks Configurations are retrieved before returning this function.
+   */
+  std::future<void> save_async(const std::string &path) const;
+
   /**
    * Retrieves current epoch.
    * @return Current epoch.
@@ -98,6 +112,51 @@ public:
     clip_threshold_ = threshold;
   }
 
+  /**
+   * Retrieves current number of gradient accumulation steps.
+   * @return Number of micro-batches per one update.
+   */
+  std::uint32_t get_accumulation_steps() const { return accum_steps_; }
+
+  /**
+   * Sets number of gradient accumulation steps.
+   * @param steps New number of micro-batches per one update, or 1 to disable
+   *              the gradient accumulation.
+   * @remarks Could not set 0, and could not be changed while accumulating
+   *          gradients, i.e., `get_accumulated_count()` is not 0.
+   *          If `steps` is greater than 1, `reset_gradients()` and `update()`
+   *          behave as follows:
+   *
+   *            - `reset_gradients()` resets gradients only at the beginning of
+   *              each accumulation, and otherwise does nothing.
+   *            - `update()` updates parameters only at the last micro-batch
+   *              using the average of accumulated gradients, and otherwise
+   *              only counts the micro-batch.
+   *
+   *          Then the usual training loop:
+   *
+   *              optimizer.reset_gradients();
+   *              loss.backward();
+   *              optimizer.update();
+   *
+   *          accumulates gradients of `steps` micro-batches in the gradient
+   *          tensors of parameters without any extra memory.
+   */
+  void set_accumulation_steps(std::uint32_t steps) {
+    if (steps == 0) PRIMITIV_THROW_ERROR(
+        "Could not set 0 to accumulation_steps.");
+    if (accum_count_ > 0 && steps != accum_steps_) PRIMITIV_THROW_ERROR(
+        "Could not change accumulation_steps while accumulating gradients. "
+        "accumulated micro-batches: " << accum_count_);
+    accum_steps_ = steps;
+  }
+
+  /**
+   * Retrieves the number of micro-batches accumulated after the last update.
+   * @return Number of accumulated micro-batches.
+   */
+  std::uint32_t get_accumulated_count() const { return accum_count_; }
+
   /**
    * Do nothing.
    * This function is used as the sentinel of other specialized functions.
@@ -116,6 +175,10 @@ public:
    *     add(a, b, c, d);
    *     add(a, b); add(c, d);
    *     add(a); add(b); add(c); add(d);
+   *
+   * Frozen parameters in each Model are skipped, and adding a frozen Parameter
+   * directly throws an exception. Parameters frozen after adding are skipped
+   * by `reset_gradients()` and `update()` until they are unfrozen.
    */
   template<typename T, typename... Args>
   void add(T &model_or_param, Args &... args) {
@@ -139,14 +202,54 @@ private:
 public:
   /**
    * Resets all gradients of registered parameters.
+   * @remarks This function does nothing while accumulating gradients.
    */
   void reset_gradients();
 
   /**
    * Updates parameter values.
+   * @remarks While accumulating gradients, this function only counts the
+   *          micro-batch and does not update parameters and the epoch.
+   *          Parameters with row-sparse gradients (e.g., lookup tables used
+   *          through `functions::pick_parameter()`) are updated lazily: the
+   *          weight decay, the gradient clipping and the update rule are
+   *          applied only to recorded rows, and statistics of other rows are
+   *          kept unchanged. Results differ from dense updates if untouched
+   *          rows would also change, e.g., with the weight decay or
+   *          MomentumSGD.
    */
   void update();
 
+  /**
+   * Reallocates values, gradients and statistics of all registered parameters
+   * into contiguous buffers for each device.
+   * After calling this function, each Parameter object holds views of the
+   * buffers, and `reset_gradients()` and `update()` process each buffer at
+   * once instead of each parameter.
+   * @remarks Parameters that are added after calling this function are
+   *          processed separately until this function is called again.
+   *          If a packed parameter is reinitialized, loaded or obtains a new
+   *          statistics, or its tensors are replaced, all buffers are
+   *          released and the optimizer falls back to the per-parameter
+   *          processing.
+   *          Modifying copies of the parameter tensors does not affect the
+   *          buffers due to the copy-on-write. Conversely, if some tensors
+   *          of packed parameters are shared with other Tensor objects (e.g.,
+   *          snapshots taken by `Model::save_async()`) at `update()`, the
+   *          corresponding buffers are duplicated so that those objects are
+   *          not modified, and parameters are kept packed.
+   *          Devices that do not support Device::new_view() can not be used
+   *          with this function.
+   */
+  void pack_parameters();
+
+  /**
+   * Checks whether the registered parameters are packed or not.
+   * @return true if some parameters are processed through packed buffers,
+   *         false otherwise.
+   */
+  bool packed();
+
   /**
    * Gathers configuration values.
    * @param uint_configs Configurations with std::uint32_t type.
@@ -170,11 +273,64 @@ private:
   float lr_scale_;
   float l2_strength_;
   float clip_threshold_;
+  std::uint32_t accum_steps_;
+  std::uint32_t accum_count_;
 
+  // NOTE:
+  // `params_` holds registered parameters in the registration order.
   // TODO(odashi):
   // This lookup table does not work if a different Parameter object is
   // allocated at the same pointer.
-  std::unordered_set<Parameter *> params_;
+  std::vector<Parameter *> params_;
+  std::unordered_set<Parameter *> param_set_;
+
+  // Location of a packed parameter in the flat buffers.
+  struct PackedEntry {
+    Parameter *param;
+    std::size_t buffer_id;
+    std::uint32_t offset;
+  };
+
+  // Flat parameters that hold all buffers, and packed parameters.
+  std::vector<std::unique_ptr<Parameter>> buffers_;
+  std::vector<PackedEntry> packed_entries_;
+  std::unordered_set<Parameter *> packed_set_;
+
+  /**
+   * Releases buffers if some packed parameters are not views of them anymore.
+   */
+  void validate_packed_parameters();
+
+  /**
+   * Duplicates buffers if some packed tensors are shared with other objects.
+   */
+  void unshare_packed_parameters();
+
+  /**
+   * Obtains parameters that should be processed by each pass.
+   * @return List of flat buffers and unpacked parameters.
+   */
+  std::vector<Parameter *> update_targets();
+
+  /**
+   * Gathers rows of a parameter with a row-sparse gradient.
+   * @param param Source parameter.
+   * @return A new Parameter object that holds rows of the value, gradient and
+   *         statistics of `param`, or `nullptr` if `param` does not have a
+   *         row-sparse gradient or has statistics that could not be gathered.
+   * @remarks Rows of statistics keep their precisions. Statistics with 16-bit
+   *          precisions are gathered only on CPU devices.
+   */
+  std::unique_ptr<Parameter> gather_rows(const Parameter &param);
+
+  /**
+   * Writes rows gathered by `gather_rows()` back to the parameter.
+   * @param rows Parameter object returned by `gather_rows(param)`.
+   * @param param Destination parameter.
+   * @remarks Statistics of `param` are converted to the precisions of `rows`
+   *          beforehand if they are different.
+   */
+  void scatter_rows(const Parameter &rows, Parameter &param);
 
   /**
    * Event handler on adding a new parameter.
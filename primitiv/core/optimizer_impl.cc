@@ -1,12 +1,30 @@
 #include <primitiv/config.h>
 
-#include <algorithm>
-#include <cmath>
-
-#include <primitiv/core/functions.h>
+#include <primitiv/core/device.h>
+#include <primitiv/core/error.h>
 #include <primitiv/core/parameter.h>
 #include <primitiv/core/optimizer_impl.h>
 
+namespace {
+
+// Converts moments of Adam to the storage format if necessary.
+void convert_adam_moments(
+    primitiv::Precision precision, primitiv::Parameter &param) {
+  using primitiv::Precision;
+  primitiv::Device &dev = param.device();
+  if (dev.type() == primitiv::DeviceType::CUDA16) {
+    precision = Precision::FLOAT32;
+  }
+  const Precision m2_precision
+    = precision == Precision::FLOAT32 ? precision : Precision::BFLOAT16;
+  primitiv::Tensor &m1 = param.stats("Adam.m1");
+  primitiv::Tensor &m2 = param.stats("Adam.m2");
+  if (m1.precision() != precision) m1 = dev.copy_tensor(m1, precision);
+  if (m2.precision() != m2_precision) m2 = dev.copy_tensor(m2, m2_precision);
+}
+
+}  // namespace
+
 namespace primitiv {
 namespace optimizers {
 
@@ -20,7 +38,7 @@ namespace optimizers {
 void SGD::configure_parameter(Parameter &) {}
 
 void SGD::update_parameter(float scale, Parameter &param) {
-  param.value() -= (scale * eta_) * param.gradient();
+  param.device().sgd_update(param.gradient(), scale * eta_, param.value());
 }
 
 void SGD::get_configs(
@@ -45,10 +63,9 @@ void MomentumSGD::configure_parameter(Parameter &param) {
 }
 
 void MomentumSGD::update_parameter(float scale, Parameter &param) {
-  Tensor &m = param.stats("MomentumSGD.m");
-  m *= momentum_;
-  m -= (scale * eta_) * param.gradient();
-  param.value() += m;
+  param.device().momentum_sgd_update(
+      param.gradient(), scale * eta_, momentum_,
+      param.stats("MomentumSGD.m"), param.value());
 }
 
 void MomentumSGD::get_configs(
@@ -75,10 +92,9 @@ void AdaGrad::configure_parameter(Parameter &param) {
 }
 
 void AdaGrad::update_parameter(float scale, Parameter &param) {
-  const Tensor &g = param.gradient();
-  Tensor &m = param.stats("AdaGrad.m");
-  m += g * g;
-  param.value() -= (scale * eta_) * g / (functions::sqrt(m) + eps_);
+  param.device().adagrad_update(
+      param.gradient(), scale * eta_, eps_,
+      param.stats("AdaGrad.m"), param.value());
 }
 
 void AdaGrad::get_configs(
@@ -105,10 +121,9 @@ void RMSProp::configure_parameter(Parameter &param) {
 }
 
 void RMSProp::update_parameter(float scale, Parameter &param) {
-  const Tensor &g = param.gradient();
-  Tensor &m = param.stats("RMSProp.m");
-  m = alpha_ * m + (1 - alpha_) * g * g;
-  param.value() -= (scale * eta_) * g / (functions::sqrt(m) + eps_);
+  param.device().rmsprop_update(
+      param.gradient(), scale * eta_, alpha_, eps_,
+      param.stats("RMSProp.m"), param.value());
 }
 
 void RMSProp::get_configs(
@@ -138,15 +153,9 @@ void AdaDelta::configure_parameter(Parameter &param) {
 }
 
 void AdaDelta::update_parameter(float scale, Parameter &param) {
-  const Tensor &g = param.gradient();
-  Tensor &m1 = param.stats("AdaDelta.m1");
-  Tensor &m2 = param.stats("AdaDelta.m2");
-  m2 *= rho_;
-  m2 += (1 - rho_) * g * g;
-  const Tensor dx = functions::sqrt((m1 + eps_) / (m2 + eps_)) * g;
-  m1 *= rho_;
-  m1 += (1 - rho_) * dx * dx;
-  param.value() -= scale * dx;
+  param.device().adadelta_update(
+      param.gradient(), scale, rho_, eps_,
+      param.stats("AdaDelta.m1"), param.stats("AdaDelta.m2"), param.value());
 }
 
 void AdaDelta::get_configs(
@@ -165,24 +174,31 @@ void AdaDelta::set_configs(
   SET_CONFIG(eps_, float_configs, "AdaDelta.eps");
 }
 
+void Adam::set_stats_precision(Precision precision) {
+  switch (precision) {
+    case Precision::FLOAT32:
+    case Precision::FLOAT16:
+    case Precision::BFLOAT16:
+      stats_precision_ = precision;
+      break;
+    default:
+      PRIMITIV_THROW_ERROR(
+          "Invalid precision: " << static_cast<std::uint32_t>(precision));
+  }
+}
+
 void Adam::configure_parameter(Parameter &param) {
   for (const char *name : {"Adam.m1", "Adam.m2"}) {
-    if (!param.has_stats(name)) {
-      param.add_stats(name, param.shape());
-    }
+    if (!param.has_stats(name)) param.add_stats(name, param.shape());
   }
+  ::convert_adam_moments(stats_precision_, param);
 }
 
 void Adam::update_parameter(float scale, Parameter &param) {
-  const std::uint32_t epoch = get_epoch() + 1;
-  const Tensor &g = param.gradient();
-  Tensor &m1 = param.stats("Adam.m1");
-  Tensor &m2 = param.stats("Adam.m2");
-  m1 = beta1_ * m1 + (1 - beta1_) * g;
-  m2 = beta2_ * m2 + (1 - beta2_) * g * g;
-  const Tensor mm1 = m1 / (1 - std::pow(beta1_, epoch));
-  const Tensor mm2 = m2 / (1 - std::pow(beta2_, epoch));
-  param.value() -= (scale * alpha_) * mm1 / (functions::sqrt(mm2) + eps_);
+  ::convert_adam_moments(stats_precision_, param);
+  param.device().adam_update(
+      param.gradient(), scale * alpha_, beta1_, beta2_, eps_, get_epoch() + 1,
+      param.stats("Adam.m1"), param.stats("Adam.m2"), param.value());
 }
 
 void Adam::get_configs(
@@ -193,6 +209,8 @@ void Adam::get_configs(
   float_configs.insert(std::make_pair("Adam.beta1", beta1_));
   float_configs.insert(std::make_pair("Adam.beta2", beta2_));
   float_configs.insert(std::make_pair("Adam.eps", eps_));
+  uint_configs.insert(std::make_pair(
+      "Adam.stats_precision", static_cast<std::uint32_t>(stats_precision_)));
 }
 
 void Adam::set_configs(
@@ -203,6 +221,10 @@ void Adam::set_configs(
   SET_CONFIG(beta1_, float_configs, "Adam.beta1");
   SET_CONFIG(beta2_, float_configs, "Adam.beta2");
   SET_CONFIG(eps_, float_configs, "Adam.eps");
+  const auto it = uint_configs.find("Adam.stats_precision");
+  if (it != uint_configs.end()) {
+    set_stats_precision(static_cast<Precision>(it->second));
+  }
 }
 
 #undef SET_CONFIG
@@ -2,6 +2,7 @@
 #define PRIMITIV_CORE_OPTIMIZER_IMPL_H_
 
 #include <primitiv/core/optimizer.h>
+#include <primitiv/core/precision.h>
 
 namespace primitiv {
 namespace optimizers {
@@ -196,7 +197,8 @@ public:
   Adam(
       float alpha = 0.001, float beta1 = 0.9, float beta2 = 0.999,
       float eps = 1e-8)
-    : alpha_(alpha), beta1_(beta1), beta2_(beta2), eps_(eps) {}
+    : alpha_(alpha), beta1_(beta1), beta2_(beta2), eps_(eps)
+    , stats_precision_(Precision::FLOAT32) {}
 
   /**
    * Returns the hyperparameter alpha.
@@ -222,11 +224,32 @@ public:
    */
   float eps() const { return eps_; }
 
+  /**
+   * Retrieves the storage format of moments.
+   * @return The storage format of moments.
+   */
+  Precision get_stats_precision() const { return stats_precision_; }
+
+  /**
+   * Specifies the storage format of moments.
+   * @param precision The storage format of moments.
+   * @remarks `Adam.m1` and `Adam.m2` statistics with 16-bit formats occupy the
+   *          half of the memory of the single precision ones. The second
+   *          moment always uses `Precision::BFLOAT16` since small squared
+   *          gradients underflow in `Precision::FLOAT16`. Moments with other
+   *          formats, e.g., those restored by `Model::load()`, are converted
+   *          by the next update.
+   *          Devices whose storage is already half precision (CUDA16) always
+   *          use single precision moments.
+   */
+  void set_stats_precision(Precision precision);
+
 private:
   float alpha_;
   float beta1_;
   float beta2_;
   float eps_;
+  Precision stats_precision_;
 };
 
 #undef PRIMITIV_DECL_DEFAULTS
@@ -0,0 +1,128 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include <primitiv/core/error.h>
+#include <primitiv/core/functions.h>
+#include <primitiv/core/graph.h>
+#include <primitiv/core/packed_sequence.h>
+#include <primitiv/core/tensor.h>
+
+namespace primitiv {
+
+PackedSequence::PackedSequence(
+    const std::vector<std::vector<std::uint32_t>> &seqs)
+: order_(seqs.size())
+, position_(seqs.size())
+, lengths_(seqs.size())
+, batch_sizes_()
+, ids_()
+, num_tokens_(0) {
+  if (seqs.empty()) PRIMITIV_THROW_ERROR("No sequences to be packed.");
+  for (std::uint32_t i = 0; i < seqs.size(); ++i) {
+    if (seqs[i].empty()) {
+      PRIMITIV_THROW_ERROR("Sequence " << i << " is empty.");
+    }
+  }
+
+  // Sorts sequences by their lengths. Sequences with the same length keep
+  // their original order.
+  std::iota(order_.begin(), order_.end(), 0);
+  std::stable_sort(
+      order_.begin(), order_.end(),
+      [&](std::uint32_t a, std::uint32_t b) {
+        return seqs[a].size() > seqs[b].size();
+      });
+
+  const std::uint32_t max_len = seqs[order_[0]].size();
+  batch_sizes_.resize(max_len, 0);
+  ids_.resize(max_len);
+  for (std::uint32_t j = 0; j < order_.size(); ++j) {
+    const std::vector<std::uint32_t> &seq = seqs[order_[j]];
+    position_[order_[j]] = j;
+    lengths_[j] = seq.size();
+    num_tokens_ += seq.size();
+    for (std::uint32_t t = 0; t < seq.size(); ++t) {
+      ++batch_sizes_[t];
+      ids_[t].emplace_back(seq[t]);
+    }
+  }
+}
+
+std::uint32_t PackedSequence::batch_size(std::uint32_t t) const {
+  if (t >= batch_sizes_.size()) {
+    PRIMITIV_THROW_ERROR(
+        "Step out of range. t: " << t << ", max_length: "
+        << batch_sizes_.size());
+  }
+  return batch_sizes_[t];
+}
+
+const std::vector<std::uint32_t> &PackedSequence::ids(std::uint32_t t) const {
+  if (t >= ids_.size()) {
+    PRIMITIV_THROW_ERROR(
+        "Step out of range. t: " << t << ", max_length: " << ids_.size());
+  }
+  return ids_[t];
+}
+
+std::vector<float> PackedSequence::mask(std::uint32_t t) const {
+  const std::uint32_t n = batch_size(t);
+  std::vector<float> ret(order_.size(), 0);
+  std::fill(ret.begin(), ret.begin() + n, 1);
+  return ret;
+}
+
+template<typename Var>
+void PackedSequence::check_steps(const std::vector<Var> &steps) const {
+  if (steps.size() != batch_sizes_.size()) {
+    PRIMITIV_THROW_ERROR(
+        "Number of steps mismatched. required: " << batch_sizes_.size()
+        << " != actual: " << steps.size());
+  }
+  for (std::uint32_t t = 0; t < steps.size(); ++t) {
+    const std::uint32_t batch = steps[t].shape().batch();
+    if (batch != batch_sizes_[t]) {
+      PRIMITIV_THROW_ERROR(
+          "Batch size mismatched at step " << t << ". required: "
+          << batch_sizes_[t] << " != actual: " << batch);
+    }
+  }
+}
+
+template<typename Var>
+std::vector<std::vector<Var>> PackedSequence::unpack(
+    const std::vector<Var> &steps) const {
+  check_steps(steps);
+  std::vector<std::vector<Var>> ret(order_.size());
+  for (std::uint32_t i = 0; i < order_.size(); ++i) {
+    const std::uint32_t j = position_[i];
+    ret[i].reserve(lengths_[j]);
+    for (std::uint32_t t = 0; t < lengths_[j]; ++t) {
+      ret[i].emplace_back(functions::batch::slice(steps[t], j, j + 1));
+    }
+  }
+  return ret;
+}
+
+template<typename Var>
+Var PackedSequence::last(const std::vector<Var> &steps) const {
+  check_steps(steps);
+  std::vector<Var> xs;
+  xs.reserve(order_.size());
+  for (std::uint32_t i = 0; i < order_.size(); ++i) {
+    const std::uint32_t j = position_[i];
+    xs.emplace_back(functions::batch::slice(steps[lengths_[j] - 1], j, j + 1));
+  }
+  return functions::batch::concat(xs);
+}
+
+template std::vector<std::vector<Tensor>> PackedSequence::unpack(
+    const std::vector<Tensor> &) const;
+template std::vector<std::vector<Node>> PackedSequence::unpack(
+    const std::vector<Node> &) const;
+template Tensor PackedSequence::last(const std::vector<Tensor> &) const;
+template Node PackedSequence::last(const std::vector<Node> &) const;
+
+}  // namespace primitiv
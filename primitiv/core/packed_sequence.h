@@ -0,0 +1,152 @@
+#ifndef PRIMITIV_CORE_PACKED_SEQUENCE_H_
+#define PRIMITIV_CORE_PACKED_SEQUENCE_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace primitiv {
+
+/**
+ * Minibatch of variable-length sequences without padding.
+ * Sequences are sorted by their lengths in the descending order, and the
+ * `t`-th step holds only sequences longer than `t`, i.e., the batch size
+ * shrinks as the step proceeds.
+ *
+ * Usage (RNN over token IDs):
+ *
+ *     PackedSequence seq(sentences);
+ *     std::vector<Node> hs;
+ *     Node h = F::zeros<Node>({n});
+ *     for (std::uint32_t t = 0; t < seq.max_length(); ++t) {
+ *       const Node x = F::pick_parameter<Node>(embed, seq.ids(t), 1);
+ *       // Drops states of sequences which already finished.
+ *       if (t > 0) h = F::batch::slice(h, 0, seq.batch_size(t));
+ *       h = F::tanh(F::matmul(w, F::concat({x, h}, 0)));
+ *       hs.emplace_back(h);
+ *     }
+ *     const Node last = seq.last(hs);  // Final states in the original order.
+ *
+ * @remarks `functions::batch::slice()` of nodes on host devices refers the
+ *          memory of the argument directly, and shrinking states does not
+ *          copy them.
+ */
+class PackedSequence {
+public:
+  /**
+   * Creates an empty object.
+   */
+  PackedSequence() : num_tokens_(0) {}
+
+  /**
+   * Creates a new object from the list of sequences.
+   * @param seqs List of sequences of IDs. Every sequence should have at least
+   *             one element.
+   */
+  explicit PackedSequence(const std::vector<std::vector<std::uint32_t>> &seqs);
+
+  /**
+   * Retrieves the number of sequences.
+   * @return Number of sequences.
+   */
+  std::uint32_t num_sequences() const { return order_.size(); }
+
+  /**
+   * Retrieves the length of the longest sequence.
+   * @return Number of steps.
+   */
+  std::uint32_t max_length() const { return batch_sizes_.size(); }
+
+  /**
+   * Retrieves the total number of elements in all sequences.
+   * @return Number of elements.
+   */
+  std::uint32_t num_tokens() const { return num_tokens_; }
+
+  /**
+   * Retrieves the number of sequences in each step.
+   * @return List of batch sizes, which is non-increasing.
+   */
+  const std::vector<std::uint32_t> &batch_sizes() const {
+    return batch_sizes_;
+  }
+
+  /**
+   * Retrieves the number of sequences in a step.
+   * @param t Step.
+   * @return Batch size of the step.
+   * @throw primitiv::Error `t` is out of range.
+   */
+  std::uint32_t batch_size(std::uint32_t t) const;
+
+  /**
+   * Retrieves IDs of a step.
+   * @param t Step.
+   * @return List of `batch_size(t)` IDs in the sorted order.
+   * @throw primitiv::Error `t` is out of range.
+   */
+  const std::vector<std::uint32_t> &ids(std::uint32_t t) const;
+
+  /**
+   * Retrieves the original indices of sorted sequences.
+   * @return List of indices: `order()[j]` is the index of the `j`-th sorted
+   *         sequence in the original list.
+   */
+  const std::vector<std::uint32_t> &order() const { return order_; }
+
+  /**
+   * Retrieves lengths of sorted sequences.
+   * @return List of lengths in the sorted order.
+   */
+  const std::vector<std::uint32_t> &lengths() const { return lengths_; }
+
+  /**
+   * Makes the mask of a step over all sequences.
+   * @param t Step.
+   * @return List of `num_sequences()` values in the sorted order: 1 for
+   *         sequences in the step and 0 for others.
+   * @throw primitiv::Error `t` is out of range.
+   * @remarks This is useful to calculate losses of padded minibatches.
+   */
+  std::vector<float> mask(std::uint32_t t) const;
+
+  /**
+   * Splits packed values into each sequence.
+   * @param steps List of `max_length()` variables, the `t`-th of which has the
+   *              batch size `batch_size(t)`.
+   * @return `ret[i][t]` is the value of the `t`-th step of the `i`-th sequence
+   *         in the original order, with the batch size 1.
+   */
+  template<typename Var>
+  std::vector<std::vector<Var>> unpack(const std::vector<Var> &steps) const;
+
+  /**
+   * Gathers values of the last step of each sequence.
+   * @param steps List of `max_length()` variables, the `t`-th of which has the
+   *              batch size `batch_size(t)`.
+   * @return A variable with the batch size `num_sequences()`, the `i`-th batch
+   *         of which is the last value of the `i`-th sequence in the original
+   *         order.
+   */
+  template<typename Var>
+  Var last(const std::vector<Var> &steps) const;
+
+private:
+  /**
+   * Checks whether the list of variables matches batch sizes.
+   * @param steps List of variables.
+   * @throw primitiv::Error `steps` does not match.
+   */
+  template<typename Var>
+  void check_steps(const std::vector<Var> &steps) const;
+
+  std::vector<std::uint32_t> order_;
+  std::vector<std::uint32_t> position_;
+  std::vector<std::uint32_t> lengths_;
+  std::vector<std::uint32_t> batch_sizes_;
+  std::vector<std::vector<std::uint32_t>> ids_;
+  std::uint32_t num_tokens_;
+};
+
+}  // namespace primitiv
+
+#endif  // PRIMITIV_CORE_PACKED_SEQUENCE_H_
@@ -1,12 +1,18 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <memory>
 
+#include <primitiv/core/arithmetic.h>
 #include <primitiv/core/device.h>
 #include <primitiv/core/error.h>
 #include <primitiv/core/file_format.h>
 #include <primitiv/core/functions.h>
 #include <primitiv/core/initializer.h>
+#include <primitiv/core/mapped_file.h>
 #include <primitiv/core/parameter.h>
 
 using std::string;
@@ -22,20 +28,96 @@ primitiv::Shape read_shape(primitiv::msgpack::Reader &reader) {
   return primitiv::Shape(dims, batch);
 }
 
+// Maximum number of bytes in one bin object of MessagePack.
+constexpr std::size_t MAX_BIN_SIZE = 0xffffffffull;
+
+// Number of bytes in each bin object when the tensor data is split.
+constexpr std::size_t BIN_CHUNK_SIZE = 1ull << 31;
+
+// Number of elements copied from the device at once while saving tensors.
+constexpr std::uint32_t SAVE_CHUNK_SIZE = 1u << 20;
+
+// Alignment of the tensor data written by write_aligned_tensor().
+constexpr std::size_t DATA_ALIGNMENT = sizeof(float);
+
+// Reads Tensor data following the shape.
+// NOTE:
+// Data with more than MAX_BIN_SIZE bytes is stored as consecutive bin objects
+// with BIN_CHUNK_SIZE bytes (except the last one).
+primitiv::Tensor read_data(
+    const primitiv::Shape &shape,
+    primitiv::msgpack::Reader &reader, primitiv::Device &device) {
+  const std::size_t num_bytes = sizeof(float) * shape.size();
+  if (num_bytes <= MAX_BIN_SIZE) {
+    primitiv::msgpack::objects::Binary data;
+    reader >> data;
+    if (data.size() != num_bytes) {
+      PRIMITIV_THROW_ERROR(
+          "Shape and data length mismatched. "
+          "shape.size() * sizeof(float): " << num_bytes
+          << " != data.size(): " << data.size());
+    }
+    return device.new_tensor_by_array(
+        shape, reinterpret_cast<const float *>(data.data()));
+  }
+  std::vector<float> values(shape.size());
+  char *dest = reinterpret_cast<char *>(values.data());
+  for (std::size_t offset = 0; offset < num_bytes; ) {
+    primitiv::msgpack::objects::Binary data;
+    reader >> data;
+    const std::size_t expected = std::min(BIN_CHUNK_SIZE, num_bytes - offset);
+    if (data.size() != expected) {
+      PRIMITIV_THROW_ERROR(
+          "Shape and data length mismatched. "
+          "expected chunk size: " << expected
+          << " != data.size(): " << data.size());
+    }
+    std::memcpy(dest + offset, data.data(), expected);
+    offset += expected;
+  }
+  return device.new_tensor_by_vector(shape, values);
+}
+
 // Reads Tensor data.
+// If `file` is specified, the resulting tensor may refer the mapped memory
+// directly.
 primitiv::Tensor read_tensor(
-    primitiv::msgpack::Reader &reader, primitiv::Device &device) {
-  primitiv::Shape shape = ::read_shape(reader);
-  primitiv::msgpack::objects::Binary data;
-  reader >> data;
-  if (data.size() != shape.size() * sizeof(float)) {
+    primitiv::msgpack::Reader &reader, primitiv::Device &device,
+    const std::shared_ptr<primitiv::MappedFile> &file) {
+  const primitiv::Shape shape = ::read_shape(reader);
+  const std::size_t num_bytes = sizeof(float) * shape.size();
+  if (!file || num_bytes > MAX_BIN_SIZE) {
+    return ::read_data(shape, reader, device);
+  }
+  const std::size_t size = reader.read_binary_header();
+  if (size != num_bytes) {
     PRIMITIV_THROW_ERROR(
         "Shape and data length mismatched. "
-        "shape.size() * sizeof(float): " << (shape.size() * sizeof(float))
-        << " != data.size(): " << data.size());
+        "shape.size() * sizeof(float): " << num_bytes
+        << " != data.size(): " << size);
+  }
+  char *data = file->data() + file->position();
+  reader.skip(size);
+  return device.new_tensor_by_shared_array(
+      shape, std::shared_ptr<float>(file, reinterpret_cast<float *>(data)));
+}
+
+// Skips Tensor data.
+void skip_tensor(primitiv::msgpack::Reader &reader) {
+  const primitiv::Shape shape = ::read_shape(reader);
+  const std::size_t num_bytes = sizeof(float) * shape.size();
+  for (std::size_t offset = 0; offset < num_bytes; ) {
+    const std::size_t expected = num_bytes <= MAX_BIN_SIZE
+      ? num_bytes : std::min(BIN_CHUNK_SIZE, num_bytes - offset);
+    const std::size_t size = reader.read_binary_header();
+    if (size != expected) {
+      PRIMITIV_THROW_ERROR(
+          "Shape and data length mismatched. "
+          "expected size: " << expected << " != data.size(): " << size);
+    }
+    reader.skip(size);
+    offset += size;
   }
-  return device.new_tensor_by_array(
-      shape, reinterpret_cast<const float *>(data.data()));
 }
 
 // Writes Shape data.
@@ -44,16 +126,92 @@ void write_shape(
   writer << src.dims() << src.batch();
 }
 
+// Writes Tensor data following the shape.
+// NOTE:
+// Values are copied to the host memory every SAVE_CHUNK_SIZE elements and
+// written to the stream directly, so that saving large tensors does not
+// require the whole copy of them.
+void write_data(
+    const primitiv::Tensor &src, primitiv::msgpack::Writer &writer) {
+  const std::uint32_t size = src.shape().size();
+  const std::size_t num_bytes = sizeof(float) * size;
+  const std::uint32_t bin_size
+    = num_bytes <= MAX_BIN_SIZE ? size : BIN_CHUNK_SIZE / sizeof(float);
+  std::vector<float> buffer(std::min(size, SAVE_CHUNK_SIZE));
+  for (std::uint32_t bin_offset = 0; bin_offset < size; ) {
+    const std::uint32_t bin_end = bin_offset + std::min(
+        bin_size, size - bin_offset);
+    writer.write_binary_header(sizeof(float) * (bin_end - bin_offset));
+    for (std::uint32_t offset = bin_offset; offset < bin_end; ) {
+      const std::uint32_t chunk_size = std::min(
+          static_cast<std::uint32_t>(buffer.size()), bin_end - offset);
+      src.to_array(offset, chunk_size, buffer.data());
+      writer.write_bytes(
+          reinterpret_cast<const char *>(buffer.data()),
+          sizeof(float) * chunk_size);
+      offset += chunk_size;
+    }
+    bin_offset = bin_end;
+  }
+}
+
 // Writes Tensor data.
 void write_tensor(
     const primitiv::Tensor &src, primitiv::msgpack::Writer &writer) {
+  ::write_shape(src.shape(), writer);
+  ::write_data(src, writer);
+}
+
+// Retrieves the upper bound of the number of bytes written by write_tensor()
+// or write_aligned_tensor() except the string.
+std::uint64_t max_tensor_size(const primitiv::Shape &shape) {
+  const std::uint64_t num_bytes = sizeof(float) * shape.size();
+  const std::uint64_t num_bins
+    = num_bytes <= MAX_BIN_SIZE
+    ? 1 : (num_bytes + BIN_CHUNK_SIZE - 1) / BIN_CHUNK_SIZE;
+  // NOTE:
+  // Every header of MessagePack objects is at most 5 bytes.
+  return 5 + 5 * shape.depth() + 5 + 5 * num_bins + num_bytes;
+}
+
+// Writes a string and Tensor data.
+// NOTE:
+// Headers of the string and the dimensions are extended if necessary so that
+// the tensor data is aligned to DATA_ALIGNMENT bytes from the head of the
+// stream, which allows MappedFile to provide the data without copying.
+void write_aligned_tensor(
+    const std::string &key, const primitiv::Tensor &src,
+    primitiv::msgpack::Writer &writer) {
   const primitiv::Shape &shape = src.shape();
-  const std::vector<float> raw_data = src.to_vector();
-  primitiv::msgpack::objects::Binary data(
-      shape.size() * sizeof(float),
-      reinterpret_cast<const char *>(raw_data.data()));
-  ::write_shape(shape, writer);
-  writer << data;
+  const std::vector<std::uint32_t> dims = shape.dims();
+  const std::streamoff pos = writer.position();
+  if (pos >= 0) {
+    const std::size_t num_bytes = sizeof(float) * shape.size();
+    const std::size_t bin_header_size
+      = num_bytes < (1 << 8) ? 2 : num_bytes < (1 << 16) ? 3 : 5;
+    // Number of bytes before the data except headers of the string and dims.
+    const std::uint64_t base
+      = pos + key.size() + 5 * (dims.size() + 1) + bin_header_size;
+    const std::uint64_t key_size = key.size();
+    for (const std::size_t kh : {1, 2, 3, 5}) {
+      if ((kh == 1 && key_size >= (1 << 5)) ||
+          (kh == 2 && key_size >= (1 << 8)) ||
+          (kh == 3 && key_size >= (1 << 16))) continue;
+      // NOTE: dims.size() <= Shape::MAX_DEPTH < 16.
+      for (const std::size_t dh : {1, 3, 5}) {
+        if ((base + kh + dh) % DATA_ALIGNMENT == 0) {
+          writer.write_string(key, kh);
+          writer.write_array_header(dims.size(), dh);
+          for (const std::uint32_t d : dims) writer << d;
+          writer << shape.batch();
+          ::write_data(src, writer);
+          return;
+        }
+      }
+    }
+  }
+  writer << key;
+  ::write_tensor(src, writer);
 }
 
 void assert_shape(
@@ -82,7 +240,13 @@ Parameter::Parameter(
 : shape_(shape)
 , device_(&Device::get_reference_or_default(device))
 , value_(functions::input<Tensor>(shape, value, device_))
-, grad_(functions::zeros<Tensor>(shape, device_)) {
+, grad_(functions::zeros<Tensor>(shape, device_))
+, sparse_grad_(true)
+, sparse_dim_(0)
+, sparse_ids_()
+, pending_()
+, has_pending_(false)
+, frozen_(false) {
   ::assert_shape(value_, grad_);
 }
 
@@ -91,7 +255,13 @@ Parameter::Parameter(
 : shape_(shape)
 , device_(&Device::get_reference_or_default(device))
 , value_(functions::zeros<Tensor>(shape, device_))
-, grad_(functions::zeros<Tensor>(shape, device_)) {
+, grad_(functions::zeros<Tensor>(shape, device_))
+, sparse_grad_(true)
+, sparse_dim_(0)
+, sparse_ids_()
+, pending_()
+, has_pending_(false)
+, frozen_(false) {
   ::assert_shape(value_, grad_);
   initializer.apply(value_);
 }
@@ -108,8 +278,11 @@ void Parameter::init(
   shape_ = shape;
   device_ = &device_temp;
   value_ = std::move(value_temp);
-  grad_ = std::move(grad_temp);
+  grad_ = frozen_ ? Tensor() : std::move(grad_temp);
   stats_.clear();
+  reset_sparse_gradient();
+  pending_.reset();
+  has_pending_ = false;
 }
 
 void Parameter::init(
@@ -125,13 +298,17 @@ void Parameter::init(
   shape_ = shape;
   device_ = &device_temp;
   value_ = std::move(value_temp);
-  grad_ = std::move(grad_temp);
+  grad_ = frozen_ ? Tensor() : std::move(grad_temp);
   stats_.clear();
+  reset_sparse_gradient();
+  pending_.reset();
+  has_pending_ = false;
 }
 
 void Parameter::load_inner(
-    msgpack::Reader &reader, bool with_stats, Device &device) {
-  Tensor value_temp = ::read_tensor(reader, device);
+    msgpack::Reader &reader, bool with_stats, Device &device,
+    const std::shared_ptr<MappedFile> &file) {
+  Tensor value_temp = ::read_tensor(reader, device, file);
 
   std::uint32_t num_stats;
   reader >> num_stats;
@@ -140,7 +317,7 @@ void Parameter::load_inner(
   for (std::uint32_t i = 0; i < num_stats; ++i) {
     std::string key;
     reader >> key;
-    Tensor value = ::read_tensor(reader, device);
+    Tensor value = ::read_tensor(reader, device, file);
     if (with_stats) {
       stats.emplace(std::move(key), std::move(value));
     }
@@ -154,12 +331,63 @@ void Parameter::load_inner(
   shape_ = shape_temp;
   device_ = &device;
   value_ = std::move(value_temp);
-  grad_ = std::move(grad_temp);
+  grad_ = frozen_ ? Tensor() : std::move(grad_temp);
   stats_ = std::move(stats);
+  reset_sparse_gradient();
+  pending_.reset();
+  has_pending_ = false;
+}
+
+void Parameter::skip_inner(msgpack::Reader &reader) {
+  ::skip_tensor(reader);
+  std::uint32_t num_stats;
+  reader >> num_stats;
+  for (std::uint32_t i = 0; i < num_stats; ++i) {
+    std::string key;
+    reader >> key;
+    ::skip_tensor(reader);
+  }
 }
 
-void Parameter::save_inner(msgpack::Writer &writer, bool with_stats) const {
-  ::write_tensor(value_, writer);
+void Parameter::load_lazy_inner(
+    const std::string &path, std::uint64_t offset, bool with_stats,
+    Device &device) {
+  // NOTE:
+  // Previous data is discarded here so that the parameter does not have
+  // inconsistent states with the pending data.
+  shape_ = Shape();
+  device_ = &device;
+  value_ = Tensor();
+  grad_ = Tensor();
+  stats_.clear();
+  reset_sparse_gradient();
+  pending_.reset(new PendingData { path, offset, with_stats });
+  has_pending_ = true;
+}
+
+void Parameter::load_pending() {
+  std::lock_guard<std::mutex> lock(pending_mutex_);
+  // The data may have been loaded by another thread.
+  if (!pending_) return;
+  std::ifstream ifs(pending_->path, std::ios::binary);
+  if (!ifs.is_open()) {
+    PRIMITIV_THROW_ERROR("Could not open file: " << pending_->path);
+  }
+  ifs.seekg(pending_->offset);
+  msgpack::Reader reader(ifs);
+  std::string name;
+  reader >> name;
+  load_inner(reader, pending_->with_stats, *device_);
+}
+
+void Parameter::save_inner(
+    msgpack::Writer &writer, bool with_stats, const std::string *key) const {
+  if (has_pending_) const_cast<Parameter *>(this)->load_pending();
+  if (key) {
+    ::write_aligned_tensor(*key, value_, writer);
+  } else {
+    ::write_tensor(value_, writer);
+  }
 
   if (with_stats) {
 #ifdef PRIMITIV_WORDSIZE_64
@@ -172,14 +400,26 @@ void Parameter::save_inner(msgpack::Writer &writer, bool with_stats) const {
 #endif
     writer << static_cast<std::uint32_t>(stats_.size());
     for (const auto &kv : stats_) {
-      writer << kv.first;
-      ::write_tensor(kv.second, writer);
+      ::write_aligned_tensor(kv.first, kv.second, writer);
     }
   } else {
     writer << std::uint32_t(0);
   }
 }
 
+std::uint64_t Parameter::max_saved_size(
+    bool with_stats, const std::string *key) const {
+  if (has_pending_) const_cast<Parameter *>(this)->load_pending();
+  std::uint64_t ret = ::max_tensor_size(value_.shape()) + 5;
+  if (key) ret += 5 + key->size();
+  if (with_stats) {
+    for (const auto &kv : stats_) {
+      ret += 5 + kv.first.size() + ::max_tensor_size(kv.second.shape());
+    }
+  }
+  return ret;
+}
+
 void Parameter::load(const string &path, bool with_stats, Device *device) {
   std::ifstream ifs(path);
   if (!ifs.is_open()) {
@@ -208,19 +448,70 @@ void Parameter::save(const string &path, bool with_stats) const  {
   msgpack::Writer writer(ofs);
 
   writer << FileFormat::CurrentVersion::MAJOR;
-  writer << FileFormat::CurrentVersion::MINOR;
+  writer << FileFormat::written_minor_version(FileFormat::DataType::PARAMETER);
   writer << static_cast<std::uint32_t>(FileFormat::DataType::PARAMETER);
 
   save_inner(writer, with_stats);
 }
 
 void Parameter::reset_gradient() {
-  if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
-  grad_.reset(0);
+  check_mutable();
+  if (sparse_grad_) {
+    if (!sparse_ids_.empty()) {
+      device_->inplace_pick_reset(0, sparse_ids_, sparse_dim_, grad_);
+    }
+  } else {
+    grad_.reset(0);
+  }
+  reset_sparse_gradient();
+}
+
+void Parameter::add_sparse_gradient(
+    const Tensor &gy, const std::vector<std::uint32_t> &ids,
+    std::uint32_t dim) {
+  check_mutable();
+  device_->pick_bw(gy, ids, dim, grad_);
+  if (!sparse_grad_) return;
+  if (!sparse_ids_.empty() && dim != sparse_dim_) {
+    // Different kinds of rows could not be represented.
+    sparse_grad_ = false;
+    sparse_ids_.clear();
+    return;
+  }
+  std::vector<std::uint32_t> new_ids(ids);
+  std::sort(new_ids.begin(), new_ids.end());
+  std::vector<std::uint32_t> merged;
+  merged.reserve(sparse_ids_.size() + new_ids.size());
+  std::set_union(
+      sparse_ids_.begin(), sparse_ids_.end(), new_ids.begin(), new_ids.end(),
+      std::back_inserter(merged));
+  merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+  sparse_dim_ = dim;
+  sparse_ids_ = std::move(merged);
+}
+
+void Parameter::freeze() {
+  check_valid();
+  frozen_ = true;
+  grad_ = Tensor();
+  reset_sparse_gradient();
+}
+
+void Parameter::unfreeze() {
+  check_valid();
+  if (!frozen_) return;
+  grad_ = functions::zeros<Tensor>(shape_, *device_);
+  reset_sparse_gradient();
+  frozen_ = false;
+}
+
+void Parameter::convert_value(Precision precision) {
+  check_valid();
+  value_ = device_->copy_tensor(value_, precision);
 }
 
 void Parameter::add_stats(const string &name, const Shape &shape) {
-  if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+  check_mutable();
   if (has_stats(name)) {
     PRIMITIV_THROW_ERROR("Statistics with name `" << name << "` already exists.");
   }
@@ -1,6 +1,10 @@
 #ifndef PRIMITIV_CORE_PARAMETER_H_
 #define PRIMITIV_CORE_PARAMETER_H_
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -16,12 +20,20 @@ namespace primitiv {
 
 class Device;
 class Initializer;
+class MappedFile;
 
 /**
  * Class to manage a trainable tensor parameter.
+ * @remarks Const member functions, including loading the data deferred by
+ *          `Model::load_lazy()`, can be called from multiple threads
+ *          concurrently. Thus one parameter can be shared by graphs in
+ *          different threads for inference, as long as no thread updates the
+ *          parameter (e.g., calls non-const member functions, the backward
+ *          operation, or `Optimizer::update()`) at the same time.
  */
 class Parameter : mixins::Nonmovable<Parameter> {
   friend class Model;
+  friend class Optimizer;
 
 private:
   /**
@@ -29,21 +41,59 @@ private:
    * @param reader msgpack::Reader object.
    * @param with_stats Whether or not to load all additional statistics.
    * @param device Device object to manage the parameter.
+   * @param file MappedFile object used as the stream of `reader`, or nullptr.
+   *             If specified, tensors may directly use the mapped memory.
    */
-  void load_inner(msgpack::Reader &reader, bool with_stats, Device &device);
+  void load_inner(
+      msgpack::Reader &reader, bool with_stats, Device &device,
+      const std::shared_ptr<MappedFile> &file = nullptr);
+
+  /**
+   * Skips parameters in msgpack::Reader w/o loading them.
+   * @param reader msgpack::Reader object.
+   */
+  static void skip_inner(msgpack::Reader &reader);
+
+  /**
+   * Defers loading the parameter until the first access to its data.
+   * @param path Path of the model file.
+   * @param offset Position of the record (the name of the parameter followed
+   *               by the parameter) in the file.
+   * @param with_stats Whether or not to load all additional statistics.
+   * @param device Device object to manage the parameter.
+   */
+  void load_lazy_inner(
+      const std::string &path, std::uint64_t offset, bool with_stats,
+      Device &device);
 
   /**
    * Saves parameters to msgpack::Writer.
    * @param writer msgpack::Writer object.
    * @param with_stats Whether or not to save all additional statistics.
+   * @param key If not nullptr, this string is written just before the value
+   *            with adjusting the position of the data.
    */
-  void save_inner(msgpack::Writer &writer, bool with_stats) const;
+  void save_inner(
+      msgpack::Writer &writer, bool with_stats,
+      const std::string *key = nullptr) const;
+
+  /**
+   * Retrieves the upper bound of the number of bytes written by save_inner().
+   * @param with_stats Whether or not to save all additional statistics.
+   * @param key Same as the argument of save_inner().
+   * @return Upper bound of the number of bytes.
+   */
+  std::uint64_t max_saved_size(
+      bool with_stats, const std::string *key = nullptr) const;
 
 public:
   /**
    * Creates an invalid parameter object.
    */
-  Parameter() : shape_(), device_(nullptr), value_(), grad_() {}
+  Parameter()
+    : shape_(), device_(nullptr), value_(), grad_()
+    , sparse_grad_(false), sparse_dim_(0), sparse_ids_(), pending_()
+    , has_pending_(false), frozen_(false) {}
 
   /**
    * Creates a new Parameter object.
@@ -221,14 +271,105 @@ public:
   /**
    * Returns whether the parameter is valid or not.
    * @return true or false w.r.t. the parameter is valid or not.
+   * @remarks This function does not load the deferred data of the parameter
+   *          loaded by `Model::load_lazy()`.
    */
   bool valid() const { return !!device_; }
 
+  /**
+   * Returns whether the data of the parameter is still deferred or not.
+   * @return true if the parameter was loaded by `Model::load_lazy()` and its
+   *         data has not been accessed yet, false otherwise.
+   */
+  bool pending() const { return has_pending_; }
+
+  /**
+   * Makes the parameter read-only for inference.
+   * @remarks Frozen parameters release their gradients, ignore gradients
+   *          propagated by the backward operation, and are not returned by
+   *          `Model::get_trainable_parameters()`. Accessors to mutable tensors
+   *          (`value()`, `gradient()` and `stats()` of non-const objects) and
+   *          operations on gradients or statistics throw an error.
+   *          Initializing or loading the parameter does not change this
+   *          state.
+   */
+  void freeze();
+
+  /**
+   * Makes the frozen parameter trainable again.
+   * @remarks The gradient is reset to 0.
+   */
+  void unfreeze();
+
+  /**
+   * Returns whether the parameter is frozen or not.
+   * @return true if `freeze()` was called, false otherwise.
+   */
+  bool frozen() const { return frozen_; }
+
   /**
    * Set all gradients to 0.
+   * @remarks If the gradient is row-sparse, only recorded rows are reset.
    */
   void reset_gradient();
 
+  /**
+   * Adds a gradient of some rows of the parameter.
+   * @param gy Gradient w.r.t. `pick(value(), ids, dim)`.
+   * @param ids List of row IDs.
+   * @param dim Dimension of rows.
+   * @remarks If the gradient is row-sparse, `ids` are recorded so that
+   *          optimizers can update only those rows.
+   *          The gradient becomes dense if it obtains another sparse gradient
+   *          with different `dim` or the mutable gradient tensor is accessed.
+   */
+  void add_sparse_gradient(
+      const Tensor &gy, const std::vector<std::uint32_t> &ids,
+      std::uint32_t dim);
+
+  /**
+   * Checks whether the gradient is row-sparse or not.
+   * @return true if all nonzero rows of the gradient are recorded in
+   *         `sparse_gradient_ids()`, false otherwise.
+   * @remarks The gradient becomes row-sparse with no rows by
+   *          `reset_gradient()` and the initialization.
+   */
+  bool has_sparse_gradient() const {
+    check_valid();
+    return sparse_grad_;
+  }
+
+  /**
+   * Returns the dimension of rows of the row-sparse gradient.
+   * @return Dimension of rows.
+   */
+  std::uint32_t sparse_gradient_dim() const {
+    if (!has_sparse_gradient()) PRIMITIV_THROW_ERROR(
+        "The gradient is not row-sparse.");
+    return sparse_dim_;
+  }
+
+  /**
+   * Returns row IDs of the row-sparse gradient.
+   * @return Sorted list of unique row IDs that may have nonzero gradients.
+   */
+  const std::vector<std::uint32_t> &sparse_gradient_ids() const {
+    if (!has_sparse_gradient()) PRIMITIV_THROW_ERROR(
+        "The gradient is not row-sparse.");
+    return sparse_ids_;
+  }
+
+  /**
+   * Converts the storage format of the value.
+   * @param precision New storage format of the value.
+   * @remarks This function is intended to reduce the memory of parameters for
+   *          inference, e.g., `Precision::INT8` quantizes each row of the value
+   *          and enables the int8 path of `functions::matmul()` on CPU
+   *          devices. Parameters with reduced precisions could not be updated
+   *          by optimizers.
+   */
+  void convert_value(Precision precision);
+
   /**
    * Adds a new optional statistics tensor.
    * @param name Name of the statistics.
@@ -243,7 +384,7 @@ public:
    * @return true if the entry exists, false otherwise.
    */
   bool has_stats(const std::string &name) const {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+    check_valid();
     return stats_.find(name) != stats_.end();
   }
 
@@ -252,7 +393,7 @@ public:
    * @return Shape object.
    */
   Shape shape() const {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+    check_valid();
     return shape_;
   }
 
@@ -270,7 +411,7 @@ public:
    * @return A tensor representing the parameter tensor.
    */
   const Tensor &value() const {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+    check_valid();
     return value_;
   }
 
@@ -279,7 +420,7 @@ public:
    * @return A tensor representing the parameter tensor.
    */
   Tensor &value() {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+    check_mutable();
     return value_;
   }
 
@@ -288,17 +429,22 @@ public:
    * @return A tensor representing the gradient of the value.
    */
   const Tensor &gradient() const {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+    check_valid();
+    if (frozen_) PRIMITIV_THROW_ERROR("The parameter is frozen.");
     return grad_;
   }
 
   /**
    * Returns the current gradient of the parameter.
    * @return A tensor representing the gradient of the value.
+   * @remarks This function makes the gradient dense.
    */
   Tensor &gradient() {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
-    return grad_; }
+    check_mutable();
+    sparse_grad_ = false;
+    sparse_ids_.clear();
+    return grad_;
+  }
 
   /**
    * Returns the current opotional statistics tensor specified by given name.
@@ -306,7 +452,7 @@ public:
    * @return A tensor.
    */
   const Tensor &stats(const std::string &name) const {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+    check_valid();
     return stats_.at(name);
   }
 
@@ -316,7 +462,7 @@ public:
    * @return A tensor.
    */
   Tensor &stats(const std::string &name) {
-    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+    check_mutable();
     return stats_.at(name);
   }
 
@@ -326,6 +472,59 @@ private:
   Tensor value_;
   Tensor grad_;
   std::unordered_map<std::string, Tensor> stats_;
+
+  // Row-sparse gradient information.
+  bool sparse_grad_;
+  std::uint32_t sparse_dim_;
+  std::vector<std::uint32_t> sparse_ids_;
+
+  // Location of the data deferred by `Model::load_lazy()`.
+  struct PendingData {
+    std::string path;
+    std::uint64_t offset;
+    bool with_stats;
+  };
+  std::unique_ptr<PendingData> pending_;
+  std::atomic<bool> has_pending_;
+  std::mutex pending_mutex_;
+
+  bool frozen_;
+
+  /**
+   * Checks whether the parameter is valid and loads the pending data if
+   * necessary.
+   * @throw primitiv::Error The parameter is invalid or the pending data could
+   *                        not be loaded.
+   */
+  void check_valid() const {
+    if (!valid()) PRIMITIV_THROW_ERROR("Invalid parameter.");
+    if (has_pending_) const_cast<Parameter *>(this)->load_pending();
+  }
+
+  /**
+   * Checks whether the parameter is valid and not frozen.
+   * @throw primitiv::Error The parameter is invalid or frozen.
+   */
+  void check_mutable() const {
+    check_valid();
+    if (frozen_) PRIMITIV_THROW_ERROR("The parameter is frozen.");
+  }
+
+  /**
+   * Loads the pending data.
+   * @remarks This function can be called from multiple threads concurrently,
+   *          and the data is loaded only once.
+   */
+  void load_pending();
+
+  /**
+   * Marks the gradient as row-sparse with no rows.
+   */
+  void reset_sparse_gradient() {
+    sparse_grad_ = true;
+    sparse_dim_ = 0;
+    sparse_ids_.clear();
+  }
 };
 
 }  // namespace primitiv
@@ -0,0 +1,54 @@
+#ifndef PRIMITIV_CORE_PRECISION_H_
+#define PRIMITIV_CORE_PRECISION_H_
+
+#include <cstdint>
+
+#include <primitiv/core/shape.h>
+
+namespace primitiv {
+
+/**
+ * Storage formats of floating point values.
+ * `INT8` holds symmetrically quantized values with per-row scales.
+ */
+enum class Precision : std::uint32_t {
+  FLOAT32 = 0,
+  FLOAT16 = 1,
+  BFLOAT16 = 2,
+  INT8 = 3,
+};
+
+/**
+ * Retrieves the number of single precision elements that are required to store
+ * values with a specific precision.
+ * @param size Number of values.
+ * @param precision Storage format of values.
+ * @return Number of single precision elements.
+ * @remarks 16-bit formats pack two values into one single precision element.
+ *          This function does not support `Precision::INT8`, which requires
+ *          the shape of values.
+ */
+inline std::uint32_t packed_size(std::uint32_t size, Precision precision) {
+  return precision == Precision::FLOAT32 ? size : (size + 1) / 2;
+}
+
+/**
+ * Retrieves the number of single precision elements that are required to store
+ * a tensor with a specific precision.
+ * @param shape Shape of the tensor.
+ * @param precision Storage format of values.
+ * @return Number of single precision elements.
+ * @remarks `Precision::INT8` stores one scale for each row (the first
+ *          dimension) of each minibatch, followed by four values in one single
+ *          precision element.
+ */
+inline std::uint32_t packed_size(const Shape &shape, Precision precision) {
+  if (precision == Precision::INT8) {
+    return shape[0] * shape.batch() + (shape.size() + 3) / 4;
+  }
+  return packed_size(shape.size(), precision);
+}
+
+}  // namespace primitiv
+
+#endif  // PRIMITIV_CORE_PRECISION_H_
@@ -1,31 +1,119 @@
 #ifndef PRIMITIV_CORE_RANDOM_H_
 #define PRIMITIV_CORE_RANDOM_H_
 
+#include <atomic>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <random>
+#include <unordered_map>
 
 #include <primitiv/core/mixins/nonmovable.h>
 
 namespace primitiv {
 
+/**
+ * Calculates a pseudo random 32-bit integer from a seed and a counter.
+ * @param seed Seed value.
+ * @param counter Position of the value in the random sequence.
+ * @return A pseudo random value.
+ * @remarks This function is stateless, and each device implements the same
+ *          mixing to obtain identical sequences from identical seeds.
+ */
+inline std::uint32_t hash_counter(std::uint32_t seed, std::uint32_t counter) {
+  std::uint32_t h = seed + counter * 0x9e3779b9u;
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+/**
+ * Calculates the threshold of `hash_counter()` used by dropout operations.
+ * @param rate Dropout probability in [0, 1).
+ * @return The threshold value. Each element is kept iff the hash is greater
+ *         than or equal to this value.
+ */
+inline std::uint32_t dropout_threshold(float rate) {
+  return static_cast<std::uint32_t>(rate * 4294967296.);
+}
+
 /**
  * Default randomizer for any devices.
+ * @remarks This class is thread-safe. Each thread uses its own random
+ *          sequence: the first thread that uses the randomizer obtains the
+ *          sequence determined by the seed, and other threads obtain
+ *          sequences derived from the seed and the order of their first use.
+ *          Sequences are held by each thread without locks, and released
+ *          when the thread exits.
  */
 class DefaultRandomizer : mixins::Nonmovable<DefaultRandomizer> {
-  std::mt19937 rng_;
+  // Random sequence of a thread.
+  struct Stream {
+    std::uint64_t owner_id;
+    std::mt19937 rng;
+  };
+
+  std::uint64_t id_;
+  std::uint32_t seed_;
+  std::atomic<std::uint32_t> num_streams_;
+
+  /**
+   * Generates a unique ID of the randomizer object.
+   * @return A new ID.
+   */
+  static std::uint64_t new_id() {
+    static std::atomic<std::uint64_t> counter(0);
+    return counter++;
+  }
+
+  /**
+   * Obtains the random sequence of the current thread.
+   * @return Reference of the random number generator.
+   */
+  std::mt19937 &rng() {
+    // NOTE:
+    // Streams are keyed by the address of the randomizer, and the ID detects
+    // the stream left by a destroyed randomizer at the same address.
+    thread_local std::unordered_map<
+      const DefaultRandomizer *, std::unique_ptr<Stream>> streams;
+    std::unique_ptr<Stream> &stream = streams[this];
+    if (!stream || stream->owner_id != id_) {
+      const std::uint32_t index = num_streams_++;
+      stream.reset(new Stream { id_, std::mt19937() });
+      if (index == 0) {
+        stream->rng.seed(seed_);
+      } else {
+        std::seed_seq seq { seed_, index };
+        stream->rng.seed(seq);
+      }
+    }
+    return stream->rng;
+  }
 
 public:
   /**
    * Creates a randomizer object using environment seeds.
    */
-  DefaultRandomizer() : rng_(std::random_device()()) {}
+  DefaultRandomizer() : DefaultRandomizer(std::random_device()()) {}
 
   /**
    * Creates a randomizer object using a user seed.
    * @param seed Seed value of the randomizer.
    */
-  explicit DefaultRandomizer(std::uint32_t seed) : rng_(seed) {}
+  explicit DefaultRandomizer(std::uint32_t seed)
+    : id_(new_id()), seed_(seed), num_streams_(0) {}
+
+  /**
+   * Generates a new seed value for stateless random operations.
+   * @return A random 32-bit integer.
+   */
+  std::uint32_t generate_seed() {
+    return static_cast<std::uint32_t>(rng()());
+  }
 
   /**
    * Fill an array using a Bernoulli distribution.
@@ -35,8 +123,9 @@ public:
    */
   void fill_bernoulli(float p, std::size_t size, float *data) {
     std::bernoulli_distribution dist(p);
+    std::mt19937 &rng = this->rng();
     for (std::size_t i = 0; i < size; ++i) {
-      data[i] = dist(rng_);
+      data[i] = dist(rng);
     }
   }
 
@@ -50,9 +139,10 @@ public:
    */
   void fill_uniform(float lower, float upper, std::size_t size, float *data) {
     std::uniform_real_distribution<float> dist(lower, upper);
+    std::mt19937 &rng = this->rng();
     const float lower_eps = std::nextafter(lower, upper);
     for (std::size_t i = 0; i < size; ++i) {
-      const float x = dist(rng_);
+      const float x = dist(rng);
       data[i] = x < lower_eps ? upper : x;
     }
   }
@@ -66,8 +156,9 @@ public:
    */
   void fill_normal(float mean, float sd, std::size_t size, float *data) {
     std::normal_distribution<float> dist(mean, sd);
+    std::mt19937 &rng = this->rng();
     for (std::size_t i = 0; i < size; ++i) {
-      data[i] = dist(rng_);
+      data[i] = dist(rng);
     }
   }
 
@@ -80,8 +171,9 @@ public:
    */
   void fill_log_normal(float mean, float sd, std::size_t size, float *data) {
     std::lognormal_distribution<float> dist(mean, sd);
+    std::mt19937 &rng = this->rng();
     for (std::size_t i = 0; i < size; ++i) {
-      data[i] = dist(rng_);
+      data[i] = dist(rng);
     }
   }
 };
@@ -5,6 +5,8 @@
 
 namespace primitiv {
 
+const std::uint32_t Shape::MAX_SIZE;
+
 Shape::Shape(std::initializer_list<std::uint32_t> dims, std::uint32_t batch)
 : depth_(0), batch_(batch), volume_(1) {
   if (dims.size() > MAX_DEPTH) {
@@ -12,14 +14,19 @@ Shape::Shape(std::initializer_list<std::uint32_t> dims, std::uint32_t batch)
         "Exceeds dimension depth limit at Shape::Shape()."
         " depth: " << depth_ << " > MAX_DEPTH: " << MAX_DEPTH);
   }
+  std::uint64_t volume = 1;
   for (const std::uint32_t d : dims) {
     dims_[depth_++] = d;
-    volume_ *= d;
+    // Stops multiplying large volumes to avoid the overflow of 64-bit
+    // integers. Such shapes are rejected by check_size().
+    if (volume <= MAX_SIZE || d == 0) volume *= d;
   }
   while (depth_ > 0 && dims_[depth_ - 1] == 1) --depth_;
-  if (volume_ == 0 || batch_ == 0) {
+  if (volume == 0 || batch_ == 0) {
     PRIMITIV_THROW_ERROR("Invalid shape: " << to_string());
   }
+  check_size(volume, batch_);
+  volume_ = volume;
 }
 
 Shape::Shape(const std::vector<std::uint32_t> &dims, std::uint32_t batch)
@@ -29,14 +36,19 @@ Shape::Shape(const std::vector<std::uint32_t> &dims, std::uint32_t batch)
         "Exceeds dimension depth limit at Shape::Shape()."
         " depth: " << depth_ << " > MAX_DEPTH: " << MAX_DEPTH);
   }
+  std::uint64_t volume = 1;
   for (const std::uint32_t d : dims) {
     dims_[depth_++] = d;
-    volume_ *= d;
+    // Stops multiplying large volumes to avoid the overflow of 64-bit
+    // integers. Such shapes are rejected by check_size().
+    if (volume <= MAX_SIZE || d == 0) volume *= d;
   }
   while (depth_ > 0 && dims_[depth_ - 1] == 1) --depth_;
-  if (volume_ == 0 || batch_ == 0) {
+  if (volume == 0 || batch_ == 0) {
     PRIMITIV_THROW_ERROR("Invalid shape: " << to_string());
   }
+  check_size(volume, batch_);
+  volume_ = volume;
 }
 
 Shape &Shape::operator=(Shape &&src) {
@@ -93,19 +105,31 @@ void Shape::update_dim(std::uint32_t dim, std::uint32_t m) {
       " dim: " << dim << " >= MAX_DEPTH: " << MAX_DEPTH);
   }
   if (m == 0) PRIMITIV_THROW_ERROR("Could not set each dimension to 0.");
+  const std::uint64_t volume
+    = static_cast<std::uint64_t>(volume_ / operator[](dim)) * m;
+  check_size(volume, batch_);
   if (dim >= depth_) {
     std::uint32_t new_depth = dim + 1;
     for (std::uint32_t i = depth_; i < new_depth; ++i) dims_[i] = 1;
     depth_ = new_depth;
   }
-  volume_ = (volume_ / dims_[dim]) * m;
+  volume_ = volume;
   dims_[dim] = m;
   while (depth_ > 0 && dims_[depth_ - 1] == 1) --depth_;
 }
 
 void Shape::update_batch(std::uint32_t batch) {
   if (batch == 0) PRIMITIV_THROW_ERROR("Could not set the batch size to 0.");
+  check_size(volume_, batch);
   batch_ = batch;
 }
 
+void Shape::check_size(std::uint64_t volume, std::uint32_t batch) const {
+  if (volume > MAX_SIZE || volume * batch > MAX_SIZE) {
+    PRIMITIV_THROW_ERROR(
+        "Exceeds the maximum number of elements. volume: " << volume
+        << ", batch: " << batch << ", MAX_SIZE: " << MAX_SIZE);
+  }
+}
+
 }  // namespace primitiv
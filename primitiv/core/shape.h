@@ -23,6 +23,13 @@ class Shape {
 public:
   static const std::uint32_t MAX_DEPTH = 8;
 
+  /**
+   * Maximum number of elements in all samples of the mini-batch.
+   * Element indices and offsets in devices fit in 32-bit integers, while the
+   * number of bytes are always calculated with `std::size_t`.
+   */
+  static const std::uint32_t MAX_SIZE = 0xffffffffu;
+
   Shape(const Shape &) = default;
   Shape(Shape &&) = default;
   Shape &operator=(const Shape &) = default;
@@ -205,6 +212,14 @@ public:
   void update_batch(std::uint32_t batch);
 
 private:
+  /**
+   * Checks whether the number of elements is in the range or not.
+   * @param volume Number of elements in each sample.
+   * @param batch Batch size.
+   * @throw primitiv::Error `volume * batch` exceeds `MAX_SIZE`.
+   */
+  void check_size(std::uint64_t volume, std::uint32_t batch) const;
+
   std::array<std::uint32_t, MAX_DEPTH> dims_;
   std::uint32_t depth_;
   std::uint32_t batch_;
@@ -20,6 +20,76 @@ std::vector<float> Tensor::to_vector() const {
   return device_->tensor_to_vector(*this);
 }
 
+void Tensor::to_array(
+    std::uint32_t offset, std::uint32_t size, float values[]) const {
+  check_valid();
+  device_->tensor_to_array(*this, offset, size, values);
+}
+
+bool Tensor::has_host_data() const {
+  if (!valid() || precision_ != Precision::FLOAT32) return false;
+  const std::uint32_t group
+    = static_cast<std::uint32_t>(device_->type())
+    & static_cast<std::uint32_t>(DeviceType::GROUP_FILTER);
+  return group == static_cast<std::uint32_t>(DeviceType::GROUP_CPU);
+}
+
+const float *Tensor::host_data() const {
+  check_valid();
+  if (!has_host_data()) {
+    PRIMITIV_THROW_ERROR(
+        "The tensor could not be accessed directly on the host.");
+  }
+  return static_cast<const float *>(handle_.get());
+}
+
+float *Tensor::mutable_host_data() {
+  check_valid();
+  if (!has_host_data()) {
+    PRIMITIV_THROW_ERROR(
+        "The tensor could not be accessed directly on the host.");
+  }
+  return static_cast<float *>(mutable_handle());
+}
+
+dlpack::DLManagedTensor *Tensor::to_dlpack() const {
+  float *data = const_cast<float *>(host_data());
+
+  // The context owns the tensor and arrays referred by the descriptor.
+  struct Context {
+    Tensor tensor;
+    std::vector<std::int64_t> shape;
+    std::vector<std::int64_t> strides;
+    dlpack::DLManagedTensor managed;
+  };
+  std::unique_ptr<Context> ctx(new Context());
+  ctx->tensor = *this;
+  std::int64_t stride = 1;
+  for (std::uint32_t i = 0; i < shape_.depth(); ++i) {
+    ctx->shape.emplace_back(shape_[i]);
+    ctx->strides.emplace_back(stride);
+    stride *= shape_[i];
+  }
+  if (shape_.has_batch()) {
+    ctx->shape.emplace_back(shape_.batch());
+    ctx->strides.emplace_back(stride);
+  }
+
+  dlpack::DLTensor &dl = ctx->managed.dl_tensor;
+  dl.data = data;
+  dl.device = { dlpack::DEVICE_CPU, 0 };
+  dl.ndim = static_cast<std::int32_t>(ctx->shape.size());
+  dl.dtype = { dlpack::TYPE_FLOAT, 32, 1 };
+  dl.shape = ctx->shape.data();
+  dl.strides = ctx->strides.data();
+  dl.byte_offset = 0;
+  ctx->managed.manager_ctx = ctx.get();
+  ctx->managed.deleter = [](dlpack::DLManagedTensor *self) {
+    delete static_cast<Context *>(self->manager_ctx);
+  };
+  return &ctx.release()->managed;
+}
+
 std::vector<std::uint32_t> Tensor::argmax(std::uint32_t dim) const {
   check_valid();
   return device_->argmax(*this, dim);
@@ -57,12 +127,13 @@ void Tensor::reset_by_vector(const std::vector<float> &values) {
 
 Tensor Tensor::reshape(const Shape &new_shape) const {
   check_valid();
-  return Tensor(shape_ops::reshape(shape_, new_shape), *device_, handle_);
+  return Tensor(
+      shape_ops::reshape(shape_, new_shape), *device_, handle_, precision_);
 }
 
 Tensor Tensor::flatten() const {
   check_valid();
-  return Tensor(shape_ops::flatten(shape_), *device_, handle_);
+  return Tensor(shape_ops::flatten(shape_), *device_, handle_, precision_);
 }
 
 Tensor &Tensor::inplace_multiply_const(float k) {
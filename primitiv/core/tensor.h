@@ -5,7 +5,9 @@
 #include <memory>
 #include <vector>
 
+#include <primitiv/core/dlpack.h>
 #include <primitiv/core/error.h>
+#include <primitiv/core/precision.h>
 #include <primitiv/core/shape.h>
 
 namespace primitiv {
@@ -24,7 +26,8 @@ public:
   Tensor(Tensor &&src)
     : shape_(std::move(src.shape_))
     , device_(src.device_)
-    , handle_(std::move(src.handle_)) {
+    , handle_(std::move(src.handle_))
+    , precision_(src.precision_) {
       src.device_ = nullptr;
     }
 
@@ -35,6 +38,7 @@ public:
       shape_ = std::move(src.shape_);
       device_ = src.device_;
       handle_ = std::move(src.handle_);
+      precision_ = src.precision_;
       src.device_ = nullptr;
     }
     return *this;
@@ -43,7 +47,8 @@ public:
   /**
    * Creates an invalid Tensor.
    */
-  Tensor() : shape_(), device_(nullptr), handle_() {}
+  Tensor()
+    : shape_(), device_(nullptr), handle_(), precision_(Precision::FLOAT32) {}
 
   /**
    * Check whether the object is valid or not.
@@ -53,6 +58,14 @@ public:
    */
   bool valid() const { return !!device_; }
 
+  /**
+   * Checks whether the internal memory is shared with other Tensor objects.
+   * @return true if the memory is shared, false otherwise.
+   * @remarks In-place operations on shared tensors duplicate the memory before
+   *          modifying it (copy-on-write).
+   */
+  bool shared() const { return handle_.use_count() > 1; }
+
   /**
    * Check whether the object is valid or not.
    * @throw primitiv::Error This object is invalid.
@@ -81,6 +94,19 @@ public:
     return *device_;
   }
 
+  /**
+   * Returns the storage format of the internal memory.
+   * @return Storage format of values.
+   * @remarks Tensors with reduced precisions can be created by
+   *          `Device::copy_tensor(x, precision)`. Only a few operations on CPU
+   *          devices accept them as arguments, and results of operations are
+   *          always single precision tensors.
+   */
+  Precision precision() const {
+    check_valid();
+    return precision_;
+  }
+
   /**
    * Retrieves one internal value in the tensor.
    * @return An internal float value.
@@ -97,6 +123,58 @@ public:
    */
   std::vector<float> to_vector() const;
 
+  /**
+   * Retrieves a part of internal values in the tensor.
+   * @param offset Index of the first element to be retrieved.
+   * @param size Number of elements to be retrieved.
+   * @param values Array to store `size` elements.
+   * @remarks This function is used to obtain values of a large tensor chunk
+   *          by chunk without making a whole copy on the host memory.
+   */
+  void to_array(std::uint32_t offset, std::uint32_t size, float values[]) const;
+
+  /**
+   * Checks whether the internal values can be accessed directly on the host.
+   * @return true if the tensor is managed by a device on the host (e.g., Naive
+   *         and Eigen) and has the single precision, false otherwise.
+   */
+  bool has_host_data() const;
+
+  /**
+   * Retrieves the pointer to the internal values on the host.
+   * @return Const-pointer to `shape().size()` values ordered by the
+   *         column-major order.
+   * @throw primitiv::Error `has_host_data()` is false.
+   * @remarks The pointer is available while this object holds the same memory,
+   *          i.e., until this object is destroyed, reassigned or modified.
+   */
+  const float *host_data() const;
+
+  /**
+   * Retrieves the pointer to the internal values on the host for writing.
+   * @return Pointer to `shape().size()` values ordered by the column-major
+   *         order.
+   * @throw primitiv::Error `has_host_data()` is false.
+   * @remarks If the memory is shared with other objects, this function
+   *          duplicates the memory before returning the pointer.
+   *          The pointer is available while this object holds the same memory.
+   */
+  float *mutable_host_data();
+
+  /**
+   * Exports the tensor as a DLPack descriptor without copying.
+   * @return A new descriptor. The caller takes the ownership of it and should
+   *         call its `deleter` after using it.
+   * @throw primitiv::Error `has_host_data()` is false.
+   * @remarks The descriptor has the dimensions of the shape followed by the
+   *          batch size (omitted if it is 1) with column-major strides.
+   *          The descriptor keeps the memory alive, and the memory is shared
+   *          with this tensor: in-place operations on this tensor duplicate
+   *          the memory, but writing values through the descriptor affects
+   *          this tensor.
+   */
+  dlpack::DLManagedTensor *to_dlpack() const;
+
   /**
    * Retrieves argmax indices along an axis.
    * @param dim A specified axis.
@@ -186,12 +264,16 @@ private:
    * @param shape Shape of the new Tensor.
    * @param device Device object to manage the internal memory.
    * @param handle Pointer of the device-specific object.
+   * @param precision Storage format of values.
    */
   template <typename ShapeT, typename SharedPtrT>
-  Tensor(ShapeT &&shape, Device &device, SharedPtrT &&handle)
+  Tensor(
+      ShapeT &&shape, Device &device, SharedPtrT &&handle,
+      Precision precision = Precision::FLOAT32)
     : shape_(std::forward<ShapeT>(shape))
     , device_(&device)
-    , handle_(std::forward<SharedPtrT>(handle)) {}
+    , handle_(std::forward<SharedPtrT>(handle))
+    , precision_(precision) {}
 
   /**
    * Returns the raw const-pointer of the internal memory.
@@ -211,6 +293,7 @@ private:
   Shape shape_;
   Device *device_;
   std::shared_ptr<void> handle_;
+  Precision precision_;
 };
 
 }  // namespace primitiv
@@ -128,12 +128,26 @@ Tensor pown(const Tensor &x, std::int32_t k) {
 }
 
 Tensor input_tensor(
-    const Shape &shape, const std::vector<float> &data, Device *dev) {
-  return ::get_device(dev).new_tensor_by_vector(shape, data);
+    const Shape &shape, std::vector<float> data, Device *dev) {
+  return ::get_device(dev).new_tensor_by_vector(shape, std::move(data));
+}
+
+Tensor shared_input_tensor(
+    const Shape &shape, const std::shared_ptr<float> &data, Device *dev) {
+  if (!data) PRIMITIV_THROW_ERROR("Null data is given to shared_input.");
+  return ::get_device(dev).new_tensor_by_shared_array(shape, data);
 }
 
 Tensor parameter_tensor(Parameter &param) {
-  return param.value();
+  const Parameter &cparam = param;
+  return cparam.value();
+}
+
+Tensor pick_parameter_tensor(
+    Parameter &param, const std::vector<std::uint32_t> &ids,
+    std::uint32_t dim) {
+  const Parameter &cparam = param;
+  return param.device().pick_fw(cparam.value(), ids, dim);
 }
 
 template<>
@@ -282,6 +296,14 @@ Tensor elu(const Tensor &x, float a) {
   return x.device().elu_fw(x, a);
 }
 
+template<>
+Tensor dropout(const Tensor &x, float rate, bool enabled) {
+  if (!enabled) return x;
+  if (rate == 1.) return 0. * x;
+  Device &dev = x.device();
+  return dev.dropout_fw(x, rate, dev.random_seed());
+}
+
 template<>
 Tensor max(const Tensor &x, std::uint32_t dim) {
   return x.device().max_fw(x, dim);
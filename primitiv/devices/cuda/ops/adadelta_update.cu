@@ -0,0 +1,37 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void adadelta_update_dev(
+    const float *pg, float scale, float rho, float eps, std::uint32_t size,
+    float *pm1, float *pm2, float *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    pm2[i] = rho * pm2[i] + (1 - rho) * pg[i] * pg[i];
+    const float d = ::sqrtf((pm1[i] + eps) / (pm2[i] + eps)) * pg[i];
+    pm1[i] = rho * pm1[i] + (1 - rho) * d * d;
+    px[i] -= scale * d;
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA::adadelta_update_impl(
+    const Tensor &g, float scale, float rho, float eps,
+    Tensor &m1, Tensor &m2, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::adadelta_update_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(g), scale, rho, eps, size, MDATA(m1), MDATA(m2), MDATA(x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,34 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void adagrad_update_dev(
+    const float *pg, float eta, float eps, std::uint32_t size, float *pm,
+    float *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    pm[i] += pg[i] * pg[i];
+    px[i] -= eta * pg[i] / (::sqrtf(pm[i]) + eps);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA::adagrad_update_impl(
+    const Tensor &g, float eta, float eps, Tensor &m, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::adagrad_update_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(g), eta, eps, size, MDATA(m), MDATA(x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,41 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void adam_update_dev(
+    const float *pg, float alpha, float beta1, float beta2, float eps,
+    float c1, float c2, std::uint32_t size, float *pm1, float *pm2, float *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    pm1[i] = beta1 * pm1[i] + (1 - beta1) * pg[i];
+    pm2[i] = beta2 * pm2[i] + (1 - beta2) * pg[i] * pg[i];
+    px[i] -= alpha * (pm1[i] / c1) / (::sqrtf(pm2[i] / c2) + eps);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA::adam_update_impl(
+    const Tensor &g, float alpha, float beta1, float beta2, float eps,
+    std::uint32_t epoch, Tensor &m1, Tensor &m2, Tensor &x) {
+  const float c1 = 1 - std::pow(beta1, epoch);
+  const float c2 = 1 - std::pow(beta2, epoch);
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::adam_update_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(g), alpha, beta1, beta2, eps, c1, c2, size, MDATA(m1), MDATA(m2),
+      MDATA(x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
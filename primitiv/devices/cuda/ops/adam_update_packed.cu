@@ -0,0 +1,76 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+
+#include <cuda_fp16.h>
+
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+struct Float16 {
+  __device__ static float load(std::uint16_t h) {
+    return ::__half2float(::__ushort_as_half(h));
+  }
+  __device__ static std::uint16_t store(float x) {
+    return ::__half_as_ushort(::__float2half_rn(x));
+  }
+};
+
+struct BFloat16 {
+  __device__ static float load(std::uint16_t h) {
+    return ::__uint_as_float(static_cast<std::uint32_t>(h) << 16);
+  }
+  __device__ static std::uint16_t store(float x) {
+    const std::uint32_t b = ::__float_as_uint(x);
+    if ((b & 0x7fffffffu) > 0x7f800000u) return (b >> 16) | 0x40u;
+    return (b + 0x7fffu + ((b >> 16) & 1u)) >> 16;
+  }
+};
+
+template<typename Format>
+__global__ void adam_update_packed_dev(
+    const float *pg, float alpha, float beta1, float beta2, float eps,
+    float c1, float c2, std::uint32_t size,
+    std::uint16_t *pm1, std::uint16_t *pm2, float *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    const float m1 = beta1 * Format::load(pm1[i]) + (1 - beta1) * pg[i];
+    const float m2 = beta2 * BFloat16::load(pm2[i]) + (1 - beta2) * pg[i] * pg[i];
+    pm1[i] = Format::store(m1);
+    pm2[i] = BFloat16::store(m2);
+    px[i] -= alpha * (m1 / c1) / (::sqrtf(m2 / c2) + eps);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA::adam_update_packed_impl(
+    const Tensor &g, float alpha, float beta1, float beta2, float eps,
+    std::uint32_t epoch, Precision precision,
+    Tensor &m1, Tensor &m2, Tensor &x) {
+  const float c1 = 1 - std::pow(beta1, epoch);
+  const float c2 = 1 - std::pow(beta2, epoch);
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  std::uint16_t *pm1 = static_cast<std::uint16_t *>(
+      get_mutable_packed_handle(m1));
+  std::uint16_t *pm2 = static_cast<std::uint16_t *>(
+      get_mutable_packed_handle(m2));
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  if (precision == Precision::FLOAT16) {
+    ::adam_update_packed_dev<::Float16><<<num_blocks, dim1_x_>>>(
+        CDATA(g), alpha, beta1, beta2, eps, c1, c2, size, pm1, pm2, MDATA(x));
+  } else {
+    ::adam_update_packed_dev<::BFloat16><<<num_blocks, dim1_x_>>>(
+        CDATA(g), alpha, beta1, beta2, eps, c1, c2, size, pm1, pm2, MDATA(x));
+  }
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,63 @@
+#include <primitiv/config.h>
+
+#include <primitiv/core/random.h>
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+// NOTE: This function must generate the same sequence as
+// primitiv::hash_counter().
+__device__ std::uint32_t hash_counter_dev(
+    std::uint32_t seed, std::uint32_t counter) {
+  std::uint32_t h = seed + counter * 0x9e3779b9u;
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+__global__ void dropout_fw_dev(
+    const float *px, std::uint32_t seed, std::uint32_t th, float scale,
+    std::uint32_t size, float *py) {
+  const std::uint32_t i = IDX;
+  if (i < size) py[i] = hash_counter_dev(seed, i) >= th ? scale * px[i] : 0;
+}
+
+__global__ void dropout_bw_dev(
+    const float *pgy, std::uint32_t seed, std::uint32_t th, float scale,
+    std::uint32_t size, float *pgx) {
+  const std::uint32_t i = IDX;
+  if (i < size && hash_counter_dev(seed, i) >= th) pgx[i] += scale * pgy[i];
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA::dropout_fw_impl(
+    const Tensor &x, float rate, std::uint32_t seed, Tensor &y) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::dropout_fw_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(x), seed, dropout_threshold(rate), 1.f / (1.f - rate), size,
+      MDATA(y));
+}
+
+void CUDA::dropout_bw_impl(
+    const Tensor &gy, float rate, std::uint32_t seed, Tensor &gx) {
+  const std::uint32_t size = gy.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::dropout_bw_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(gy), seed, dropout_threshold(rate), 1.f / (1.f - rate), size,
+      MDATA(gx));
+}
+
+}  // namespace devices
+}  // namespace primitiv
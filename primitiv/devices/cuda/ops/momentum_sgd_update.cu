@@ -0,0 +1,34 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void momentum_sgd_update_dev(
+    const float *pg, float eta, float momentum, std::uint32_t size, float *pm,
+    float *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    pm[i] = momentum * pm[i] - eta * pg[i];
+    px[i] += pm[i];
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA::momentum_sgd_update_impl(
+    const Tensor &g, float eta, float momentum, Tensor &m, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::momentum_sgd_update_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(g), eta, momentum, size, MDATA(m), MDATA(x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,15 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace primitiv {
+namespace devices {
+
+void *CUDA::offset_handle(void *handle, std::uint32_t offset) {
+  return static_cast<float *>(handle) + offset;
+}
+
+}  // namespace devices
+}  // namespace primitiv
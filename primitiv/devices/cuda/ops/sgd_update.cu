@@ -0,0 +1,30 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void sgd_update_dev(
+    const float *pg, float eta, std::uint32_t size, float *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    px[i] -= eta * pg[i];
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA::sgd_update_impl(const Tensor &g, float eta, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::sgd_update_dev<<<num_blocks, dim1_x_>>>(CDATA(g), eta, size, MDATA(x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
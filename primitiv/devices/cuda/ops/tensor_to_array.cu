@@ -0,0 +1,20 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda/device.h>
+#include <primitiv/devices/cuda/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace primitiv {
+namespace devices {
+
+void CUDA::tensor_to_array_impl(
+    const Tensor &x, std::uint32_t offset, std::uint32_t size,
+    float values[]) {
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  CUDA_CALL(::cudaMemcpy(
+        values, CDATA(x) + offset, sizeof(float) * size,
+        cudaMemcpyDeviceToHost));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,45 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void adadelta_update_dev(
+    const half *pg, float scale, float rho, float eps, std::uint32_t size,
+    half *pm1, half *pm2, half *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    const float g = ::__half2float(pg[i]);
+    float m1 = ::__half2float(pm1[i]);
+    float m2 = ::__half2float(pm2[i]);
+    float x = ::__half2float(px[i]);
+    m2 = rho * m2 + (1 - rho) * g * g;
+    const float d = ::sqrtf((m1 + eps) / (m2 + eps)) * g;
+    m1 = rho * m1 + (1 - rho) * d * d;
+    x -= scale * d;
+    pm1[i] = ::__float2half(m1);
+    pm2[i] = ::__float2half(m2);
+    px[i] = ::__float2half(x);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA16::adadelta_update_impl(
+    const Tensor &g, float scale, float rho, float eps,
+    Tensor &m1, Tensor &m2, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::adadelta_update_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(half, g), scale, rho, eps, size, MDATA(half, m1), MDATA(half, m2),
+      MDATA(half, x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,48 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void adam_update_dev(
+    const half *pg, float alpha, float beta1, float beta2, float eps,
+    float c1, float c2, std::uint32_t size, half *pm1, half *pm2, half *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    const float g = ::__half2float(pg[i]);
+    float m1 = ::__half2float(pm1[i]);
+    float m2 = ::__half2float(pm2[i]);
+    float x = ::__half2float(px[i]);
+    m1 = beta1 * m1 + (1 - beta1) * g;
+    m2 = beta2 * m2 + (1 - beta2) * g * g;
+    x -= alpha * (m1 / c1) / (::sqrtf(m2 / c2) + eps);
+    pm1[i] = ::__float2half(m1);
+    pm2[i] = ::__float2half(m2);
+    px[i] = ::__float2half(x);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA16::adam_update_impl(
+    const Tensor &g, float alpha, float beta1, float beta2, float eps,
+    std::uint32_t epoch, Tensor &m1, Tensor &m2, Tensor &x) {
+  const float c1 = 1 - std::pow(beta1, epoch);
+  const float c2 = 1 - std::pow(beta2, epoch);
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::adam_update_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(half, g), alpha, beta1, beta2, eps, c1, c2, size, MDATA(half, m1),
+      MDATA(half, m2), MDATA(half, x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
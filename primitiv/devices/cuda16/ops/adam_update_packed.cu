@@ -0,0 +1,20 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace primitiv {
+namespace devices {
+
+void CUDA16::adam_update_packed_impl(
+    const Tensor &, float, float, float, float, std::uint32_t, Precision,
+    Tensor &, Tensor &, Tensor &) {
+  // NOTE:
+  // CUDA16 always stores tensors with half precision. Optimizers keep moments
+  // as ordinary tensors on this device.
+  PRIMITIV_THROW_NOT_IMPLEMENTED;
+}
+
+}  // namespace devices
+}  // namespace primitiv
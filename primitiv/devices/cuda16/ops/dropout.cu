@@ -0,0 +1,68 @@
+#include <primitiv/config.h>
+
+#include <primitiv/core/random.h>
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+// NOTE: This function must generate the same sequence as
+// primitiv::hash_counter().
+__device__ std::uint32_t hash_counter_dev(
+    std::uint32_t seed, std::uint32_t counter) {
+  std::uint32_t h = seed + counter * 0x9e3779b9u;
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+__global__ void dropout_fw_dev(
+    const half *px, std::uint32_t seed, std::uint32_t th, float scale,
+    std::uint32_t size, half *py) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    py[i] = ::__float2half(
+        hash_counter_dev(seed, i) >= th ? scale * X_VAL : 0);
+  }
+}
+
+__global__ void dropout_bw_dev(
+    const half *pgy, std::uint32_t seed, std::uint32_t th, float scale,
+    std::uint32_t size, half *pgx) {
+  const std::uint32_t i = IDX;
+  if (i < size && hash_counter_dev(seed, i) >= th) {
+    INPLACE_ADD(pgx + i, scale * GY_VAL);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA16::dropout_fw_impl(
+    const Tensor &x, float rate, std::uint32_t seed, Tensor &y) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::dropout_fw_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(half, x), seed, dropout_threshold(rate), 1.f / (1.f - rate), size,
+      MDATA(half, y));
+}
+
+void CUDA16::dropout_bw_impl(
+    const Tensor &gy, float rate, std::uint32_t seed, Tensor &gx) {
+  const std::uint32_t size = gy.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::dropout_bw_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(half, gy), seed, dropout_threshold(rate), 1.f / (1.f - rate), size,
+      MDATA(half, gx));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,77 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void inplace_pick_assign_dev(
+    const half *px, const std::uint32_t *pi,
+    std::uint32_t wy, std::uint32_t wx,
+    std::uint32_t sy, std::uint32_t si, std::uint32_t sx,
+    half *py) {
+  const std::uint32_t t = IDX;
+  const std::uint32_t oy = blockIdx.y * sy + pi[blockIdx.y * si] * wx;
+  const std::uint32_t ox = blockIdx.y * sx;
+  if (t < sx) py[oy + (t / wx) * wy + (t % wx)] = px[ox + t];
+}
+
+__global__ void inplace_pick_reset_dev(
+    float k, const std::uint32_t *pi,
+    std::uint32_t wy, std::uint32_t wx,
+    std::uint32_t sy, std::uint32_t si, std::uint32_t sx,
+    half *py) {
+  const std::uint32_t t = IDX;
+  const std::uint32_t oy = blockIdx.y * sy + pi[blockIdx.y * si] * wx;
+  if (t < sx) py[oy + (t / wx) * wy + (t % wx)] = ::__float2half(k);
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA16::inplace_pick_assign_impl(
+    const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+    Tensor &y) {
+  const std::uint32_t wx = x.shape().lower_volume(dim);
+  const std::uint32_t sx = x.shape().volume();
+  const std::uint32_t g1 = GRID_SIZE(sx, dim1_x_);
+  const std::uint32_t bs = x.shape().batch();
+
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  CUDA_CALL(::cudaMemcpy(
+        ids_ptr_.get(), ids.data(), sizeof(std::uint32_t) * ids.size(),
+        cudaMemcpyHostToDevice));
+  ::inplace_pick_assign_dev<<<dim3(g1, bs), dim1_x_>>>(
+      CDATA(half, x), static_cast<const std::uint32_t *>(ids_ptr_.get()),
+      wx * y.shape()[dim], wx,
+      y.shape().has_batch() * y.shape().volume(), ids.size() > 1, sx,
+      MDATA(half, y));
+}
+
+void CUDA16::inplace_pick_reset_impl(
+    float k, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+    Tensor &y) {
+  const std::uint32_t wx = y.shape().lower_volume(dim);
+  const std::uint32_t sx = y.shape().volume() / y.shape()[dim];
+  const std::uint32_t g1 = GRID_SIZE(sx, dim1_x_);
+  const std::uint32_t bs = std::max<std::uint32_t>(
+      y.shape().batch(), ids.size());
+
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  CUDA_CALL(::cudaMemcpy(
+        ids_ptr_.get(), ids.data(), sizeof(std::uint32_t) * ids.size(),
+        cudaMemcpyHostToDevice));
+  ::inplace_pick_reset_dev<<<dim3(g1, bs), dim1_x_>>>(
+      k, static_cast<const std::uint32_t *>(ids_ptr_.get()),
+      wx * y.shape()[dim], wx,
+      y.shape().has_batch() * y.shape().volume(), ids.size() > 1, sx,
+      MDATA(half, y));
+}
+
+}  // namespace devices
+}  // namespace primitiv
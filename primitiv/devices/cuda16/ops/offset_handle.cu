@@ -0,0 +1,15 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace primitiv {
+namespace devices {
+
+void *CUDA16::offset_handle(void *handle, std::uint32_t offset) {
+  return static_cast<half *>(handle) + offset;
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,23 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace primitiv {
+namespace devices {
+
+std::uint32_t CUDA16::random_seed_impl() {
+  auto temp = state_->pool.allocate(sizeof(std::uint32_t));
+  std::uint32_t *temp_ptr = static_cast<std::uint32_t *>(temp.get());
+  std::uint32_t seed;
+
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  CURAND_CALL(::curandGenerate(state_->curand.get(), temp_ptr, 1));
+  CUDA_CALL(::cudaMemcpy(
+        &seed, temp_ptr, sizeof(std::uint32_t), cudaMemcpyDeviceToHost));
+  return seed;
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,40 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void rmsprop_update_dev(
+    const half *pg, float eta, float alpha, float eps, std::uint32_t size,
+    half *pm, half *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    const float g = ::__half2float(pg[i]);
+    float m = ::__half2float(pm[i]);
+    float x = ::__half2float(px[i]);
+    m = alpha * m + (1 - alpha) * g * g;
+    x -= eta * g / (::sqrtf(m) + eps);
+    pm[i] = ::__float2half(m);
+    px[i] = ::__float2half(x);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA16::rmsprop_update_impl(
+    const Tensor &g, float eta, float alpha, float eps,
+    Tensor &m, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::rmsprop_update_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(half, g), eta, alpha, eps, size, MDATA(half, m), MDATA(half, x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
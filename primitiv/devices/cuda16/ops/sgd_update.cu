@@ -0,0 +1,34 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void sgd_update_dev(
+    const half *pg, float eta, std::uint32_t size, half *px) {
+  const std::uint32_t i = IDX;
+  if (i < size) {
+    const float g = ::__half2float(pg[i]);
+    float x = ::__half2float(px[i]);
+    x -= eta * g;
+    px[i] = ::__float2half(x);
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA16::sgd_update_impl(const Tensor &g, float eta, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = GRID_SIZE(size, dim1_x_);
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::sgd_update_dev<<<num_blocks, dim1_x_>>>(
+      CDATA(half, g), eta, size, MDATA(half, x));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,88 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+template<std::uint32_t BLOCK_SIZE>
+__global__ void squared_norm_dev(
+    const half *px, std::uint32_t size, float *py) {
+  __shared__ float temp[BLOCK_SIZE];
+  const std::uint32_t tid = threadIdx.x;
+  temp[tid] = 0;
+  for (std::uint32_t i = tid; i < size; i += BLOCK_SIZE) {
+    const float x = ::__half2float(px[i]);
+    temp[tid] += x * x;
+  }
+  ::__syncthreads();
+#define REDUCE(k) \
+  if (BLOCK_SIZE >= k << 1) { \
+    if (tid < k) temp[tid] += temp[tid + k]; \
+    ::__syncthreads(); \
+  }
+  REDUCE(512)
+  REDUCE(256)
+  REDUCE(128)
+  REDUCE(64)
+  REDUCE(32)
+  REDUCE(16)
+  REDUCE(8)
+  REDUCE(4)
+  REDUCE(2)
+  REDUCE(1)
+#undef REDUCE
+  if (tid == 0) *py = temp[0];
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+float CUDA16::squared_norm_impl(const std::vector<const Tensor *> &xs) {
+  const std::uint32_t num_xs = xs.size();
+  std::shared_ptr<void> py = state_->pool.allocate(sizeof(float) * num_xs);
+  float *py_ptr = static_cast<float *>(py.get());
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+
+  // NOTE:
+  // Each partial sum is written to the temporary buffer, and all of them are
+  // retrieved by one transfer.
+  for (std::uint32_t i = 0; i < num_xs; ++i) {
+    const std::uint32_t size = xs[i]->shape().size();
+    std::uint32_t block_size = dim1_x_;
+    while (block_size >> 1 >= size) block_size >>= 1;
+    switch (block_size) {
+#define CASE(k) \
+      case k: \
+        ::squared_norm_dev<k><<<1, k>>>( \
+            CDATA(half, *xs[i]), size, py_ptr + i); \
+        break
+      CASE(1024);
+      CASE(512);
+      CASE(256);
+      CASE(128);
+      CASE(64);
+      CASE(32);
+      CASE(16);
+      CASE(8);
+      CASE(4);
+      CASE(2);
+      CASE(1);
+#undef CASE
+    }
+  }
+
+  std::vector<float> partial(num_xs);
+  CUDA_CALL(::cudaMemcpy(
+        partial.data(), py_ptr, sizeof(float) * num_xs,
+        cudaMemcpyDeviceToHost));
+  float ret = 0;
+  for (const float p : partial) ret += p;
+  return ret;
+}
+
+}  // namespace devices
+}  // namespace primitiv
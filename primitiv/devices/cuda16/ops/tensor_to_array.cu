@@ -0,0 +1,34 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/cuda16/device.h>
+#include <primitiv/devices/cuda16/ops/common.h>
+#include <primitiv/internal/cuda/utils.h>
+
+namespace {
+
+__global__ void fp16to32(const half *src, float *dest, std::size_t size) {
+  const std::size_t i = IDX;
+  if (i < size) dest[i] = ::__half2float(src[i]);
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void CUDA16::tensor_to_array_impl(
+    const Tensor &x, std::uint32_t offset, std::uint32_t size,
+    float values[]) {
+  const std::size_t gs = GRID_SIZE(size, dim1_x_);
+
+  auto temp = state_->pool.allocate(sizeof(float) * size);
+  float *temp_ptr = static_cast<float *>(temp.get());
+
+  CUDA_CALL(::cudaSetDevice(dev_id_));
+  ::fp16to32<<<gs, dim1_x_>>>(CDATA(half, x) + offset, temp_ptr, size);
+  CUDA_CALL(::cudaMemcpy(
+        values, temp_ptr, sizeof(float) * size, cudaMemcpyDeviceToHost));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,20 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Eigen::adagrad_update_impl(
+    const Tensor &g_, float eta, float eps, Tensor &m_, Tensor &x_) {
+  const std::size_t size = x_.shape().size();
+  EMap<const EArrayXf> g(CDATA(g_), size);
+  EMap<EArrayXf> m(MDATA(m_), size);
+  EMap<EArrayXf> x(MDATA(x_), size);
+  m += g * g;
+  x -= eta * g / (m.sqrt() + eps);
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,27 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Eigen::adam_update_impl(
+    const Tensor &g_, float alpha, float beta1, float beta2, float eps,
+    std::uint32_t epoch, Tensor &m1_, Tensor &m2_, Tensor &x_) {
+  const float c1 = 1 - std::pow(beta1, epoch);
+  const float c2 = 1 - std::pow(beta2, epoch);
+  const std::size_t size = x_.shape().size();
+  EMap<const EArrayXf> g(CDATA(g_), size);
+  EMap<EArrayXf> m1(MDATA(m1_), size);
+  EMap<EArrayXf> m2(MDATA(m2_), size);
+  EMap<EArrayXf> x(MDATA(x_), size);
+  m1 = beta1 * m1 + (1 - beta1) * g;
+  m2 = beta2 * m2 + (1 - beta2) * g * g;
+  x -= alpha * (m1 / c1) / ((m2 / c2).sqrt() + eps);
+}
+
+}  // namespace devices
+}  // namespace primitiv
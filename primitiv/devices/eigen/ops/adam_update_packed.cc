@@ -0,0 +1,46 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include <primitiv/core/numeric_utils.h>
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Eigen::adam_update_packed_impl(
+    const Tensor &g, float alpha, float beta1, float beta2, float eps,
+    std::uint32_t epoch, Precision precision,
+    Tensor &m1, Tensor &m2, Tensor &x) {
+  const float c1 = 1 - std::pow(beta1, epoch);
+  const float c2 = 1 - std::pow(beta2, epoch);
+  const std::uint32_t size = x.shape().size();
+  const float *pg = CDATA(g);
+  std::uint16_t *pm1 = static_cast<std::uint16_t *>(
+      get_mutable_packed_handle(m1));
+  std::uint16_t *pm2 = static_cast<std::uint16_t *>(
+      get_mutable_packed_handle(m2));
+  float *px = MDATA(x);
+
+#define LOOP(to_float, from_float) \
+  for (std::uint32_t i = 0; i < size; ++i) { \
+    const float m1i = beta1 * to_float(pm1[i]) + (1 - beta1) * pg[i]; \
+    const float m2i = beta2 * numeric_utils::bfloat16_to_float(pm2[i]) \
+        + (1 - beta2) * pg[i] * pg[i]; \
+    pm1[i] = from_float(m1i); \
+    pm2[i] = numeric_utils::float_to_bfloat16(m2i); \
+    px[i] -= alpha * (m1i / c1) / (std::sqrt(m2i / c2) + eps); \
+  }
+
+  if (precision == Precision::FLOAT16) {
+    LOOP(numeric_utils::half_to_float, numeric_utils::float_to_half);
+  } else {
+    LOOP(numeric_utils::bfloat16_to_float, numeric_utils::float_to_bfloat16);
+  }
+#undef LOOP
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -12,6 +12,8 @@
 #define EIGEN_MPL2_ONLY
 #include <Eigen/Eigen>
 
+#include <primitiv/core/numeric_utils.h>
+
 template<typename T>
 using EMap = ::Eigen::Map<T>;
 
@@ -23,14 +25,71 @@ using EMatrixXf = ::Eigen::MatrixXf;
 
 #define MAYBE_USED(x) static_cast<void>(x)
 
+// Functors to load packed values.
+struct EHalfToFloat {
+  float operator()(std::uint16_t h) const {
+    return ::primitiv::numeric_utils::half_to_float(h);
+  }
+};
+struct EBFloat16ToFloat {
+  float operator()(std::uint16_t h) const {
+    return ::primitiv::numeric_utils::bfloat16_to_float(h);
+  }
+};
+
+using EArrayXu16 = ::Eigen::Array<std::uint16_t, ::Eigen::Dynamic, 1>;
+using EMatrixXu16 = ::Eigen::Matrix<
+    std::uint16_t, ::Eigen::Dynamic, ::Eigen::Dynamic>;
+
+#define PDATA(x) static_cast<const std::uint16_t *>(get_packed_handle(x))
+
+// Binds `var` to a single precision expression of `x` with any precision, and
+// runs the following statements.
+// `type` is the Eigen type of the expression, `EArrayXf` or `EMatrixXf`, and
+// `packed_type` is the corresponding type of packed values.
+#define EIGEN_DEV_DISPATCH_CDATA( \
+    x, offset, dims, type, packed_type, var, ...) \
+  switch ((x).precision()) { \
+    case Precision::FLOAT16: \
+      { \
+        const auto var = EMap<const packed_type>( \
+            PDATA(x) + (offset), EIGEN_DEV_DIMS dims).unaryExpr( \
+              EHalfToFloat()); \
+        __VA_ARGS__; \
+      } \
+      break; \
+    case Precision::BFLOAT16: \
+      { \
+        const auto var = EMap<const packed_type>( \
+            PDATA(x) + (offset), EIGEN_DEV_DIMS dims).unaryExpr( \
+              EBFloat16ToFloat()); \
+        __VA_ARGS__; \
+      } \
+      break; \
+    default: \
+      { \
+        EMap<const type> var(CDATA(x) + (offset), EIGEN_DEV_DIMS dims); \
+        __VA_ARGS__; \
+      } \
+  }
+#define EIGEN_DEV_DIMS(...) __VA_ARGS__
+
+// Shorthands of EIGEN_DEV_DISPATCH_CDATA for arrays and matrices.
+#define EIGEN_DEV_DISPATCH_ARRAY(x, offset, size, var, ...) \
+  EIGEN_DEV_DISPATCH_CDATA( \
+      x, offset, (size), EArrayXf, EArrayXu16, var, __VA_ARGS__)
+#define EIGEN_DEV_DISPATCH_MATRIX(x, offset, rows, cols, var, ...) \
+  EIGEN_DEV_DISPATCH_CDATA( \
+      x, offset, (rows, cols), EMatrixXf, EMatrixXu16, var, __VA_ARGS__)
+
 #define REPEAT_OP(i, n, op) \
   for (std::uint32_t i = 0; i < (n); ++i) { (op); }
 
 #define EIGEN_DEV_FW_X(name, op) \
 void Eigen::name##_fw_impl(const Tensor &x_, Tensor &y_) { \
   const std::size_t size = x_.shape().size(); \
-  EMap<const EArrayXf> x(CDATA(x_), size); \
-  EMap<EArrayXf>(MDATA(y_), size) = (op); \
+  EMap<EArrayXf> y(MDATA(y_), size); \
+  EIGEN_DEV_DISPATCH_ARRAY(x_, 0, size, x, y = (op)); \
 }
 
 #define EIGEN_DEV_BW_X(name, op) \
@@ -46,8 +105,8 @@ void Eigen::name##_bw_impl( \
 #define EIGEN_DEV_FW_X_CONST(name, op) \
 void Eigen::name##_fw_impl(const Tensor &x_, float k, Tensor &y_) { \
   const std::size_t size = x_.shape().size(); \
-  EMap<const EArrayXf> x(CDATA(x_), size); \
-  EMap<EArrayXf>(MDATA(y_), size) = (op); \
+  EMap<EArrayXf> y(MDATA(y_), size); \
+  EIGEN_DEV_DISPATCH_ARRAY(x_, 0, size, x, y = (op)); \
 }
 
 #define EIGEN_DEV_BW_X_CONST(name, op) \
@@ -87,16 +146,12 @@ void Eigen::name##_fw_impl(const Tensor &a_, const Tensor &b_, Tensor &y_) { \
   const std::uint32_t bs = y_.shape().batch(); \
   const std::uint32_t skip_a = a_.shape().has_batch() * size; \
   const std::uint32_t skip_b = b_.shape().has_batch() * size; \
-  const float *src_a = CDATA(a_); \
-  const float *src_b = CDATA(b_); \
   float *dest = MDATA(y_); \
   for (std::uint32_t batch = 0; batch < bs; ++batch) { \
-    EMap<const EArrayXf> a(src_a, size); \
-    EMap<const EArrayXf> b(src_b, size); \
-    EMap<EArrayXf>(dest, size) = (op); \
+    EMap<EArrayXf> y(dest, size); \
+    EIGEN_DEV_DISPATCH_ARRAY(a_, batch * skip_a, size, a, \
+        EIGEN_DEV_DISPATCH_ARRAY(b_, batch * skip_b, size, b, y = (op))); \
     dest += size; \
-    src_a += skip_a; \
-    src_b += skip_b; \
   } \
 }
 
@@ -0,0 +1,33 @@
+#include <primitiv/config.h>
+
+#include <primitiv/core/random.h>
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Eigen::dropout_fw_impl(
+    const Tensor &x, float rate, std::uint32_t seed, Tensor &y) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t th = dropout_threshold(rate);
+  const float scale = 1.f / (1.f - rate);
+  const float *src = CDATA(x);
+  float *dest = MDATA(y);
+  REPEAT_OP(i, size,
+      dest[i] = hash_counter(seed, i) >= th ? scale * src[i] : 0);
+}
+
+void Eigen::dropout_bw_impl(
+    const Tensor &gy, float rate, std::uint32_t seed, Tensor &gx) {
+  const std::uint32_t size = gy.shape().size();
+  const std::uint32_t th = dropout_threshold(rate);
+  const float scale = 1.f / (1.f - rate);
+  const float *pgy = CDATA(gy);
+  float *pgx = MDATA(gx);
+  REPEAT_OP(i, size,
+      pgx[i] += hash_counter(seed, i) >= th ? scale * pgy[i] : 0);
+}
+
+}  // namespace devices
+}  // namespace primitiv
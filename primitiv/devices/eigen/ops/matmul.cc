@@ -1,8 +1,190 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX512BW__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include <primitiv/devices/eigen/device.h>
 #include <primitiv/devices/eigen/ops/common.h>
 
+namespace {
+
+// NOTE:
+// The int8 kernel multiplies pairs of 16-bit integers and accumulates them
+// with 32-bit integers. `IVec` holds `LANES` 32-bit lanes, and each lane of
+// the operands of `ivec_madd()` holds a pair of 16-bit integers.
+// `ivec_pack()` sign-extends `LANES` int8 values of `lo` and `hi` into such
+// pairs.
+#if defined(__AVX512BW__)
+
+using IVec = __m512i;
+constexpr std::uint32_t LANES = 16;
+inline IVec ivec_zero() { return _mm512_setzero_si512(); }
+inline IVec ivec_broadcast(std::int32_t x) { return _mm512_set1_epi32(x); }
+inline IVec ivec_load(const std::int32_t *src) {
+  return _mm512_loadu_si512(src);
+}
+inline void ivec_store(std::int32_t *dest, IVec x) {
+  _mm512_storeu_si512(dest, x);
+}
+inline IVec ivec_madd(IVec acc, IVec a, IVec b) {
+  return _mm512_add_epi32(acc, _mm512_madd_epi16(a, b));
+}
+inline IVec ivec_pack(const std::int8_t *lo, const std::int8_t *hi) {
+  const auto load = [](const std::int8_t *src) {
+    return _mm512_cvtepi8_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+  };
+  return _mm512_or_si512(
+      _mm512_and_si512(load(lo), _mm512_set1_epi32(0xffff)),
+      _mm512_slli_epi32(load(hi), 16));
+}
+
+#elif defined(__AVX2__)
+
+using IVec = __m256i;
+constexpr std::uint32_t LANES = 8;
+inline IVec ivec_zero() { return _mm256_setzero_si256(); }
+inline IVec ivec_broadcast(std::int32_t x) { return _mm256_set1_epi32(x); }
+inline IVec ivec_load(const std::int32_t *src) {
+  return _mm256_loadu_si256(reinterpret_cast<const IVec *>(src));
+}
+inline void ivec_store(std::int32_t *dest, IVec x) {
+  _mm256_storeu_si256(reinterpret_cast<IVec *>(dest), x);
+}
+inline IVec ivec_madd(IVec acc, IVec a, IVec b) {
+  return _mm256_add_epi32(acc, _mm256_madd_epi16(a, b));
+}
+inline IVec ivec_pack(const std::int8_t *lo, const std::int8_t *hi) {
+  const auto load = [](const std::int8_t *src) {
+    return _mm256_cvtepi8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+  };
+  return _mm256_or_si256(
+      _mm256_and_si256(load(lo), _mm256_set1_epi32(0xffff)),
+      _mm256_slli_epi32(load(hi), 16));
+}
+
+#else
+
+using IVec = std::int32_t;
+constexpr std::uint32_t LANES = 1;
+inline IVec ivec_zero() { return 0; }
+inline IVec ivec_broadcast(std::int32_t x) { return x; }
+inline IVec ivec_load(const std::int32_t *src) { return *src; }
+inline void ivec_store(std::int32_t *dest, IVec x) { *dest = x; }
+inline IVec ivec_madd(IVec acc, IVec a, IVec b) {
+  const auto lo = [](IVec x) { return static_cast<std::int16_t>(x); };
+  const auto hi = [](IVec x) { return static_cast<std::int16_t>(x >> 16); };
+  return acc + lo(a) * lo(b) + hi(a) * hi(b);
+}
+inline IVec ivec_pack(const std::int8_t *lo, const std::int8_t *hi) {
+  return static_cast<std::int32_t>(
+      static_cast<std::uint16_t>(*lo) |
+      static_cast<std::uint32_t>(static_cast<std::uint16_t>(*hi)) << 16);
+}
+
+#endif
+
+// Number of rows and columns of the destination computed at once.
+constexpr std::uint32_t BLOCK_ROWS = 2 * LANES;
+constexpr std::uint32_t BLOCK_COLS = 4;
+
+// Packs two int8 values into a pair of 16-bit integers.
+inline std::int32_t pack_pair(std::int8_t lo, std::int8_t hi) {
+  return static_cast<std::int32_t>(
+      static_cast<std::uint16_t>(lo) |
+      static_cast<std::uint32_t>(static_cast<std::uint16_t>(hi)) << 16);
+}
+
+// Multiplies int8 values with per-row scales and single precision values.
+// All columns of `src_b` are quantized in advance, and the products are
+// accumulated with 32-bit integers block by block.
+void matmul_fw_int8_kernel(
+    const float *scales_a, const std::int8_t *src_a, const float *src_b,
+    std::uint32_t di, std::uint32_t dj, std::uint32_t dk, float *dest) {
+  // Quantizes each column of `src_b` and interleaves adjacent rows.
+  const std::uint32_t dp = (dj + 1) / 2;
+  std::vector<std::int8_t> qb(dj * dk);
+  std::vector<float> scales_b(dk);
+  primitiv::numeric_utils::quantize_int8(
+      src_b, 1, dj, dk, scales_b.data(), qb.data());
+  std::vector<std::int32_t> pb(dp * dk);
+  for (std::uint32_t k = 0; k < dk; ++k) {
+    const std::int8_t *col = qb.data() + k * dj;
+    for (std::uint32_t p = 0; p < dp; ++p) {
+      pb[k * dp + p] = pack_pair(
+          col[2 * p], 2 * p + 1 < dj ? col[2 * p + 1] : 0);
+    }
+  }
+
+  std::vector<std::int32_t> panel(dp * BLOCK_ROWS);
+  std::int32_t acc[BLOCK_COLS][BLOCK_ROWS];
+  for (std::uint32_t i0 = 0; i0 < di; i0 += BLOCK_ROWS) {
+    const std::uint32_t ni = std::min(BLOCK_ROWS, di - i0);
+
+    // Interleaves adjacent columns of the current rows of `src_a`.
+    for (std::uint32_t p = 0; p < dp; ++p) {
+      const std::int8_t *col0 = src_a + 2 * p * di + i0;
+      const std::int8_t *col1 = 2 * p + 1 < dj ? col0 + di : nullptr;
+      std::int32_t *pa = panel.data() + p * BLOCK_ROWS;
+      if (ni == BLOCK_ROWS && col1) {
+        ivec_store(pa, ivec_pack(col0, col1));
+        ivec_store(pa + LANES, ivec_pack(col0 + LANES, col1 + LANES));
+      } else {
+        for (std::uint32_t i = 0; i < ni; ++i) {
+          pa[i] = pack_pair(col0[i], col1 ? col1[i] : 0);
+        }
+        std::fill(pa + ni, pa + BLOCK_ROWS, 0);
+      }
+    }
+
+    for (std::uint32_t k0 = 0; k0 < dk; k0 += BLOCK_COLS) {
+      const std::uint32_t nk = std::min(BLOCK_COLS, dk - k0);
+
+      // NOTE:
+      // Columns beyond `dk` repeat the last one so that the loop below is
+      // always unrolled, and their results are discarded.
+      const std::int32_t *pbs[BLOCK_COLS];
+      for (std::uint32_t c = 0; c < BLOCK_COLS; ++c) {
+        pbs[c] = pb.data() + std::min(k0 + c, dk - 1) * dp;
+      }
+
+      IVec lo[BLOCK_COLS], hi[BLOCK_COLS];
+      for (std::uint32_t c = 0; c < BLOCK_COLS; ++c) {
+        lo[c] = hi[c] = ivec_zero();
+      }
+      for (std::uint32_t p = 0; p < dp; ++p) {
+        const IVec a_lo = ivec_load(panel.data() + p * BLOCK_ROWS);
+        const IVec a_hi = ivec_load(panel.data() + p * BLOCK_ROWS + LANES);
+        for (std::uint32_t c = 0; c < BLOCK_COLS; ++c) {
+          const IVec b = ivec_broadcast(pbs[c][p]);
+          lo[c] = ivec_madd(lo[c], a_lo, b);
+          hi[c] = ivec_madd(hi[c], a_hi, b);
+        }
+      }
+
+      for (std::uint32_t c = 0; c < BLOCK_COLS; ++c) {
+        ivec_store(acc[c], lo[c]);
+        ivec_store(acc[c] + LANES, hi[c]);
+      }
+      for (std::uint32_t c = 0; c < nk; ++c) {
+        const float sb = scales_b[k0 + c];
+        float *py = dest + (k0 + c) * di + i0;
+        for (std::uint32_t i = 0; i < ni; ++i) {
+          py[i] = acc[c][i] * scales_a[i0 + i] * sb;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
 namespace primitiv {
 namespace devices {
 
@@ -11,10 +193,34 @@ void Eigen::matmul_fw_impl(const Tensor &a, const Tensor &b, Tensor &y) {
   const std::uint32_t dj = a.shape()[1];
   const std::uint32_t dk = b.shape()[1];
 
-  const float *src_a = CDATA(a);
-  const float *src_b = CDATA(b);
+  if (a.precision() == Precision::INT8) {
+    const float *scales_a = static_cast<const float *>(get_packed_handle(a));
+    const std::int8_t *src_a = reinterpret_cast<const std::int8_t *>(
+        scales_a + di * a.shape().batch());
+    const float *src_b = CDATA(b);
+    float *dest = MDATA(y);
+    if (a.shape().has_batch()) {
+      // Do multiplication multiple times.
+      const std::uint32_t b_skip = b.shape().has_batch() * dj * dk;
+      const std::uint32_t bs = a.shape().batch();
+      for (std::uint32_t n = 0; n < bs; ++n) {
+        ::matmul_fw_int8_kernel(
+            scales_a + n * di, src_a + n * di * dj, src_b + n * b_skip,
+            di, dj, dk, dest + n * di * dk);
+      }
+    } else {
+      // Do multiplication only once using a combined matrix.
+      ::matmul_fw_int8_kernel(
+          scales_a, src_a, src_b, di, dj, dk * b.shape().batch(), dest);
+    }
+    return;
+  }
+
   float *dest = MDATA(y);
 
+  // NOTE:
+  // Packed operands are converted to the single precision on the fly, and
+  // Eigen evaluates them into temporary matrices before the multiplication.
   if (a.shape().has_batch()) {
     // Do multiplication multiple times.
     const std::uint32_t a_skip = di * dj;
@@ -22,18 +228,18 @@ void Eigen::matmul_fw_impl(const Tensor &a, const Tensor &b, Tensor &y) {
     const std::uint32_t y_skip = di * dk;
     const std::uint32_t bs = a.shape().batch();
     for (std::uint32_t n = 0; n < bs; ++n) {
-      EMap<const EMatrixXf> aa(src_a + n * a_skip, di, dj);
-      EMap<const EMatrixXf> bb(src_b + n * b_skip, dj, dk);
       EMap<EMatrixXf> yy(dest + n * y_skip, di, dk);
-      yy.noalias() = aa * bb;
+      EIGEN_DEV_DISPATCH_MATRIX(a, n * a_skip, di, dj, aa,
+          EIGEN_DEV_DISPATCH_MATRIX(b, n * b_skip, dj, dk, bb,
+            yy.noalias() = aa * bb));
     }
   } else {
     // Do multiplication only once using a combined matrix.
     const std::uint32_t dk_batch = dk * b.shape().batch();
-    EMap<const EMatrixXf> aa(src_a, di, dj);
-    EMap<const EMatrixXf> bb(src_b, dj, dk_batch);
     EMap<EMatrixXf> yy(dest, di, dk_batch);
-    yy.noalias() = aa * bb;
+    EIGEN_DEV_DISPATCH_MATRIX(a, 0, di, dj, aa,
+        EIGEN_DEV_DISPATCH_MATRIX(b, 0, dj, dk_batch, bb,
+          yy.noalias() = aa * bb));
   }
 }
 
@@ -0,0 +1,20 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Eigen::momentum_sgd_update_impl(
+    const Tensor &g_, float eta, float momentum, Tensor &m_, Tensor &x_) {
+  const std::size_t size = x_.shape().size();
+  EMap<const EArrayXf> g(CDATA(g_), size);
+  EMap<EArrayXf> m(MDATA(m_), size);
+  EMap<EArrayXf> x(MDATA(x_), size);
+  m = momentum * m - eta * g;
+  x += m;
+}
+
+}  // namespace devices
+}  // namespace primitiv
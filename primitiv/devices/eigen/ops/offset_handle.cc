@@ -0,0 +1,14 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void *Eigen::offset_handle(void *handle, std::uint32_t offset) {
+  return static_cast<float *>(handle) + offset;
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -20,11 +20,11 @@ void Eigen::pick_fw_impl(
 
   float *dest = MDATA(y);
   for (std::uint32_t batch = 0; batch < bs; ++batch) {
-    const float *src = CDATA(x) + batch * skip_x + base * ids[batch * skip_i];
+    const std::uint32_t offset = batch * skip_x + base * ids[batch * skip_i];
     for (std::uint32_t i = 0; i < repeat; ++i) {
-      const float *sp = src;
-      REPEAT_OP(j, base, *dest++ = *sp++);
-      src += skip;
+      EMap<EArrayXf> yy(dest, base);
+      EIGEN_DEV_DISPATCH_ARRAY(x, offset + i * skip, base, xx, yy = xx);
+      dest += base;
     }
   }
 }
@@ -0,0 +1,21 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Eigen::rmsprop_update_impl(
+    const Tensor &g_, float eta, float alpha, float eps,
+    Tensor &m_, Tensor &x_) {
+  const std::size_t size = x_.shape().size();
+  EMap<const EArrayXf> g(CDATA(g_), size);
+  EMap<EArrayXf> m(MDATA(m_), size);
+  EMap<EArrayXf> x(MDATA(x_), size);
+  m = alpha * m + (1 - alpha) * g * g;
+  x -= eta * g / (m.sqrt() + eps);
+}
+
+}  // namespace devices
+}  // namespace primitiv
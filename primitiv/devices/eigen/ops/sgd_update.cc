@@ -0,0 +1,17 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Eigen::sgd_update_impl(const Tensor &g_, float eta, Tensor &x_) {
+  const std::size_t size = x_.shape().size();
+  EMap<const EArrayXf> g(CDATA(g_), size);
+  EMap<EArrayXf> x(MDATA(x_), size);
+  x -= eta * g;
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,19 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+float Eigen::squared_norm_impl(const std::vector<const Tensor *> &xs) {
+  float ret = 0;
+  for (const Tensor *x_ : xs) {
+    EMap<const EArrayXf> x(CDATA(*x_), x_->shape().size());
+    ret += x.square().sum();
+  }
+  return ret;
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,18 @@
+#include <primitiv/config.h>
+
+#include <cstring>
+
+#include <primitiv/devices/eigen/device.h>
+#include <primitiv/devices/eigen/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Eigen::tensor_to_array_impl(
+    const Tensor &x, std::uint32_t offset, std::uint32_t size,
+    float values[]) {
+  std::memcpy(values, CDATA(x) + offset, sizeof(float) * size);
+}
+
+}  // namespace devices
+}  // namespace primitiv
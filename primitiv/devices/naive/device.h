@@ -9,6 +9,10 @@ namespace devices {
 
 /**
  * Device class for the naive function implementations on CPU.
+ * @remarks Functions of this device can be called from multiple threads
+ *          concurrently as long as each thread writes distinct tensors:
+ *          memory is allocated by `malloc()`, and each thread draws random
+ *          numbers from its own stream.
  */
 class Naive : public Device {
 public:
@@ -30,8 +34,10 @@ public:
 
 private:
   std::shared_ptr<void> new_handle(const Shape &shape) override;
+  void *offset_handle(void *handle, std::uint32_t offset) override;
 
   std::vector<float> tensor_to_vector_impl(const Tensor &x) override;
+  void tensor_to_array_impl(const Tensor &x, std::uint32_t offset, std::uint32_t size, float values[]) override;
   std::vector<std::uint32_t> argmax_impl(const Tensor &x, std::uint32_t dim) override;
   std::vector<std::uint32_t> argmin_impl(const Tensor &x, std::uint32_t dim) override;
 
@@ -46,6 +52,7 @@ private:
   void random_uniform_impl(float lower, float upper, Tensor &y) override;
   void random_normal_impl(float mean, float sd, Tensor &y) override;
   void random_log_normal_impl(float mean, float sd, Tensor &y) override;
+  std::uint32_t random_seed_impl() override;
 
   void pick_fw_impl(const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim, Tensor &y) override;
   void slice_fw_impl(const Tensor &x, std::uint32_t dim, std::uint32_t offset, Tensor &y) override;
@@ -111,6 +118,9 @@ private:
 
   void pown_bw_impl(const Tensor &x, const Tensor &y, const Tensor &gy, std::int32_t k, Tensor &gx) override;
 
+  void dropout_fw_impl(const Tensor &x, float rate, std::uint32_t seed, Tensor &y) override;
+  void dropout_bw_impl(const Tensor &gy, float rate, std::uint32_t seed, Tensor &gx) override;
+
   void add_scalar_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) override;
   void subtract_scalar_r_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) override;
   void subtract_scalar_l_fw_impl(const Tensor &x, const Tensor &k, Tensor &y) override;
@@ -194,6 +204,29 @@ private:
 
   void inplace_add_impl(const Tensor &x, Tensor &y) override;
   void inplace_subtract_impl(const Tensor &x, Tensor &y) override;
+  void inplace_pick_assign_impl(const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim, Tensor &y) override;
+  void inplace_pick_reset_impl(float k, const std::vector<std::uint32_t> &ids, std::uint32_t dim, Tensor &y) override;
+
+  void sgd_update_impl(const Tensor &g, float eta, Tensor &x) override;
+  void momentum_sgd_update_impl(
+      const Tensor &g, float eta, float momentum, Tensor &m, Tensor &x) override;
+  void adagrad_update_impl(
+      const Tensor &g, float eta, float eps, Tensor &m, Tensor &x) override;
+  void rmsprop_update_impl(
+      const Tensor &g, float eta, float alpha, float eps,
+      Tensor &m, Tensor &x) override;
+  void adadelta_update_impl(
+      const Tensor &g, float scale, float rho, float eps,
+      Tensor &m1, Tensor &m2, Tensor &x) override;
+  void adam_update_impl(
+      const Tensor &g, float alpha, float beta1, float beta2, float eps,
+      std::uint32_t epoch, Tensor &m1, Tensor &m2, Tensor &x) override;
+  void adam_update_packed_impl(
+      const Tensor &g, float alpha, float beta1, float beta2, float eps,
+      std::uint32_t epoch, Precision precision,
+      Tensor &m1, Tensor &m2, Tensor &x) override;
+
+  float squared_norm_impl(const std::vector<const Tensor *> &xs) override;
 
 private:
   DefaultRandomizer randomizer_;
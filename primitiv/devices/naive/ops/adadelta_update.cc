@@ -0,0 +1,28 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Naive::adadelta_update_impl(
+    const Tensor &g, float scale, float rho, float eps,
+    Tensor &m1, Tensor &m2, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const float *pg = CDATA(g);
+  float *pm1 = MDATA(m1);
+  float *pm2 = MDATA(m2);
+  float *px = MDATA(x);
+  for (std::uint32_t i = 0; i < size; ++i) {
+    pm2[i] = rho * pm2[i] + (1 - rho) * pg[i] * pg[i];
+    const float d = std::sqrt((pm1[i] + eps) / (pm2[i] + eps)) * pg[i];
+    pm1[i] = rho * pm1[i] + (1 - rho) * d * d;
+    px[i] -= scale * d;
+  }
+}
+
+}  // namespace devices
+}  // namespace primitiv
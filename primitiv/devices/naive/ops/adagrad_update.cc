@@ -0,0 +1,24 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Naive::adagrad_update_impl(
+    const Tensor &g, float eta, float eps, Tensor &m, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const float *pg = CDATA(g);
+  float *pm = MDATA(m);
+  float *px = MDATA(x);
+  for (std::uint32_t i = 0; i < size; ++i) {
+    pm[i] += pg[i] * pg[i];
+    px[i] -= eta * pg[i] / (std::sqrt(pm[i]) + eps);
+  }
+}
+
+}  // namespace devices
+}  // namespace primitiv
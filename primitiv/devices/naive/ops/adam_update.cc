@@ -0,0 +1,29 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Naive::adam_update_impl(
+    const Tensor &g, float alpha, float beta1, float beta2, float eps,
+    std::uint32_t epoch, Tensor &m1, Tensor &m2, Tensor &x) {
+  const float c1 = 1 - std::pow(beta1, epoch);
+  const float c2 = 1 - std::pow(beta2, epoch);
+  const std::uint32_t size = x.shape().size();
+  const float *pg = CDATA(g);
+  float *pm1 = MDATA(m1);
+  float *pm2 = MDATA(m2);
+  float *px = MDATA(x);
+  for (std::uint32_t i = 0; i < size; ++i) {
+    pm1[i] = beta1 * pm1[i] + (1 - beta1) * pg[i];
+    pm2[i] = beta2 * pm2[i] + (1 - beta2) * pg[i] * pg[i];
+    px[i] -= alpha * (pm1[i] / c1) / (std::sqrt(pm2[i] / c2) + eps);
+  }
+}
+
+}  // namespace devices
+}  // namespace primitiv
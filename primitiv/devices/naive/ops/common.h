@@ -1,6 +1,8 @@
 #ifndef PRIMITIV_DEVICES_NAIVE_OPS_COMMON_H_
 #define PRIMITIV_DEVICES_NAIVE_OPS_COMMON_H_
 
+#include <primitiv/core/numeric_utils.h>
+
 #define MAYBE_USED(x) static_cast<void>(x)
 
 #define CDATA(x) static_cast<const float *>(get_handle(x))
@@ -9,12 +11,34 @@
 #define REPEAT_OP(i, n, op) \
   for (std::uint32_t i = 0; i < (n); ++i) { (op); }
 
+// Binds `ptr` to a const pointer-like object of `x` with any precision, and
+// runs the following statements.
+#define DISPATCH_CDATA(x, ptr, ...) \
+  switch ((x).precision()) { \
+    case Precision::FLOAT16: \
+      { \
+        numeric_utils::HalfConstPointer ptr(get_packed_handle(x)); \
+        __VA_ARGS__; \
+      } \
+      break; \
+    case Precision::BFLOAT16: \
+      { \
+        numeric_utils::BFloat16ConstPointer ptr(get_packed_handle(x)); \
+        __VA_ARGS__; \
+      } \
+      break; \
+    default: \
+      { \
+        const float *ptr = CDATA(x); \
+        __VA_ARGS__; \
+      } \
+  }
+
 #define CPUDEV_FW_X(name, op) \
 void Naive::name##_fw_impl(const Tensor &x, Tensor &y) { \
   float *dest = MDATA(y); \
-  const float *src = CDATA(x); \
   const std::uint32_t size = x.shape().size(); \
-  REPEAT_OP(i, size, dest[i] = (op)); \
+  DISPATCH_CDATA(x, src, REPEAT_OP(i, size, dest[i] = (op))); \
 }
 
 #define CPUDEV_BW_X(name, op) \
@@ -31,9 +55,8 @@ void Naive::name##_bw_impl( \
 #define CPUDEV_FW_X_CONST(name, op) \
 void Naive::name##_fw_impl(const Tensor &x, float k, Tensor &y) { \
   float *dest = MDATA(y); \
-  const float *src = CDATA(x); \
   const std::uint32_t size = x.shape().size(); \
-  REPEAT_OP(i, size, dest[i] = (op)); \
+  DISPATCH_CDATA(x, src, REPEAT_OP(i, size, dest[i] = (op))); \
 }
 
 #define CPUDEV_BW_X_CONST(name, op) \
@@ -72,14 +95,14 @@ void Naive::name##_fw_impl(const Tensor &a, const Tensor &b, Tensor &y) { \
   const std::uint32_t skip_a = a.shape().has_batch() * size; \
   const std::uint32_t skip_b = b.shape().has_batch() * size; \
   float *dest = MDATA(y); \
-  const float *src_a = CDATA(a); \
-  const float *src_b = CDATA(b); \
-  for (std::uint32_t batch = 0; batch < bs; ++batch) { \
-    REPEAT_OP(i, size, dest[i] = (op)); \
-    dest += size; \
-    src_a += skip_a; \
-    src_b += skip_b; \
-  } \
+  DISPATCH_CDATA(a, src_a, DISPATCH_CDATA(b, src_b, \
+    for (std::uint32_t batch = 0; batch < bs; ++batch) { \
+      REPEAT_OP(i, size, dest[i] = (op)); \
+      dest += size; \
+      src_a += skip_a; \
+      src_b += skip_b; \
+    } \
+  )); \
 }
 
 #endif  // PRIMITIV_DEVICES_NAIVE_OPS_COMMON_H_
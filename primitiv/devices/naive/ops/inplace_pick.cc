@@ -0,0 +1,74 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace {
+
+// `T` is `float` or `std::uint16_t` for packed 16-bit values.
+template<typename T>
+void inplace_pick_assign_kernel(
+    const T *src, const std::vector<std::uint32_t> &ids, std::uint32_t bs,
+    std::uint32_t skip_y, std::uint32_t skip_i, std::uint32_t base,
+    std::uint32_t skip, std::uint32_t repeat, T *py) {
+  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+    T *dest = py + batch * skip_y + base * ids[batch * skip_i];
+    for (std::uint32_t i = 0; i < repeat; ++i) {
+      T *dp = dest;
+      REPEAT_OP(j, base, *dp++ = *src++);
+      dest += skip;
+    }
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void Naive::inplace_pick_assign_impl(
+    const Tensor &x, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+    Tensor &y) {
+  const std::uint32_t bs = x.shape().batch();
+  const std::uint32_t skip_y = y.shape().has_batch() * y.shape().volume();
+  const std::uint32_t skip_i = ids.size() > 1;
+  const std::uint32_t base = x.shape().lower_volume(dim);
+  const std::uint32_t skip = base * y.shape()[dim];
+  const std::uint32_t repeat = x.shape().volume() / base;
+  if (y.precision() == Precision::FLOAT32) {
+    ::inplace_pick_assign_kernel(
+        CDATA(x), ids, bs, skip_y, skip_i, base, skip, repeat, MDATA(y));
+  } else {
+    // 16-bit values are copied without conversions.
+    ::inplace_pick_assign_kernel(
+        static_cast<const std::uint16_t *>(get_packed_handle(x)),
+        ids, bs, skip_y, skip_i, base, skip, repeat,
+        static_cast<std::uint16_t *>(get_mutable_packed_handle(y)));
+  }
+}
+
+void Naive::inplace_pick_reset_impl(
+    float k, const std::vector<std::uint32_t> &ids, std::uint32_t dim,
+    Tensor &y) {
+  const std::uint32_t bs = std::max<std::uint32_t>(
+      y.shape().batch(), ids.size());
+  const std::uint32_t skip_y = y.shape().has_batch() * y.shape().volume();
+  const std::uint32_t skip_i = ids.size() > 1;
+  const std::uint32_t base = y.shape().lower_volume(dim);
+  const std::uint32_t skip = base * y.shape()[dim];
+  const std::uint32_t repeat = y.shape().volume() / skip;
+  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+    float *dest = MDATA(y) + batch * skip_y + base * ids[batch * skip_i];
+    for (std::uint32_t i = 0; i < repeat; ++i) {
+      float *dp = dest;
+      REPEAT_OP(j, base, *dp++ = k);
+      dest += skip;
+    }
+  }
+}
+
+}  // namespace devices
+}  // namespace primitiv
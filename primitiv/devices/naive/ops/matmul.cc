@@ -1,24 +1,22 @@
 #include <primitiv/config.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 #include <primitiv/devices/naive/device.h>
 #include <primitiv/devices/naive/ops/common.h>
 
-namespace primitiv {
-namespace devices {
+namespace {
 
-void Naive::matmul_fw_impl(const Tensor &a, const Tensor &b, Tensor &y) {
-  const std::uint32_t d1 = a.shape()[0];
-  const std::uint32_t d2 = a.shape()[1];
-  const std::uint32_t d3 = b.shape()[1];
-  const std::uint32_t bs = y.shape().batch();
+// `ConstPtrA` and `ConstPtrB` are `const float *` or pointer-like objects of
+// packed values.
+template<typename ConstPtrA, typename ConstPtrB>
+void matmul_fw_kernel(
+    ConstPtrA src_a, ConstPtrB src_b, std::uint32_t d1, std::uint32_t d2,
+    std::uint32_t d3, std::uint32_t bs, std::uint32_t src_a_shift,
+    std::uint32_t src_b_shift, float *dest) {
   const std::uint32_t dest_shift = d1 * d3;
-  const std::uint32_t src_a_shift = a.shape().has_batch() * d1 * d2;
-  const std::uint32_t src_b_shift = b.shape().has_batch() * d2 * d3;
-
-  float *dest = MDATA(y);
-  const float *src_a = CDATA(a);
-  const float *src_b = CDATA(b);
-
   for (std::uint32_t batch = 0; batch < bs; ++batch) {
     for (std::uint32_t n = 0; n < dest_shift; ++n) {
       dest[n] = 0;
@@ -49,6 +47,69 @@ void Naive::matmul_fw_impl(const Tensor &a, const Tensor &b, Tensor &y) {
   }
 }
 
+// Multiplies int8 values with per-row scales and single precision values.
+// Each column of `src_b` is quantized dynamically, and the products are
+// accumulated with 32-bit integers.
+void matmul_fw_int8_kernel(
+    const float *scales_a, const std::int8_t *src_a, const float *src_b,
+    std::uint32_t d1, std::uint32_t d2, std::uint32_t d3, std::uint32_t bs,
+    bool a_has_batch, std::uint32_t src_b_shift, float *dest) {
+  std::vector<std::int8_t> qb(d2);
+  std::vector<std::int32_t> acc(d1);
+  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+    for (std::uint32_t k = 0; k < d3; ++k) {
+      float scale_b;
+      primitiv::numeric_utils::quantize_int8(
+          src_b + k * d2, 1, d2, 1, &scale_b, qb.data());
+      std::fill(acc.begin(), acc.end(), 0);
+      for (std::uint32_t j = 0; j < d2; ++j) {
+        const std::int32_t bj = qb[j];
+        if (bj == 0) continue;
+        const std::int8_t *col = src_a + j * d1;
+        for (std::uint32_t i = 0; i < d1; ++i) {
+          acc[i] += col[i] * bj;
+        }
+      }
+      float *yk = dest + k * d1;
+      for (std::uint32_t i = 0; i < d1; ++i) {
+        yk[i] = acc[i] * scales_a[i] * scale_b;
+      }
+    }
+    dest += d1 * d3;
+    if (a_has_batch) {
+      src_a += d1 * d2;
+      scales_a += d1;
+    }
+    src_b += src_b_shift;
+  }
+}
+
+}  // namespace
+
+namespace primitiv {
+namespace devices {
+
+void Naive::matmul_fw_impl(const Tensor &a, const Tensor &b, Tensor &y) {
+  const std::uint32_t d1 = a.shape()[0];
+  const std::uint32_t d2 = a.shape()[1];
+  const std::uint32_t d3 = b.shape()[1];
+  const std::uint32_t bs = y.shape().batch();
+  const std::uint32_t src_a_shift = a.shape().has_batch() * d1 * d2;
+  const std::uint32_t src_b_shift = b.shape().has_batch() * d2 * d3;
+  float *dest = MDATA(y);
+  if (a.precision() == Precision::INT8) {
+    const float *scales_a = static_cast<const float *>(get_packed_handle(a));
+    ::matmul_fw_int8_kernel(
+        scales_a, reinterpret_cast<const std::int8_t *>(
+          scales_a + d1 * a.shape().batch()),
+        CDATA(b), d1, d2, d3, bs, a.shape().has_batch(), src_b_shift, dest);
+    return;
+  }
+  DISPATCH_CDATA(a, src_a, DISPATCH_CDATA(b, src_b,
+      ::matmul_fw_kernel(
+        src_a, src_b, d1, d2, d3, bs, src_a_shift, src_b_shift, dest)));
+}
+
 void Naive::matmul_bw_impl(
     const Tensor &a, const Tensor &b, const Tensor &, const Tensor &gy,
     Tensor &ga, Tensor &gb) {
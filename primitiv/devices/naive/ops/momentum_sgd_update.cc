@@ -0,0 +1,22 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Naive::momentum_sgd_update_impl(
+    const Tensor &g, float eta, float momentum, Tensor &m, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const float *pg = CDATA(g);
+  float *pm = MDATA(m);
+  float *px = MDATA(x);
+  for (std::uint32_t i = 0; i < size; ++i) {
+    pm[i] = momentum * pm[i] - eta * pg[i];
+    px[i] += pm[i];
+  }
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,14 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void *Naive::offset_handle(void *handle, std::uint32_t offset) {
+  return static_cast<float *>(handle) + offset;
+}
+
+}  // namespace devices
+}  // namespace primitiv
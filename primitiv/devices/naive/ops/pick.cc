@@ -3,6 +3,26 @@
 #include <primitiv/devices/naive/device.h>
 #include <primitiv/devices/naive/ops/common.h>
 
+namespace {
+
+// `ConstPtr` is `const float *` or a pointer-like object of packed values.
+template<typename ConstPtr>
+void pick_fw_kernel(
+    ConstPtr px, const std::vector<std::uint32_t> &ids, std::uint32_t bs,
+    std::uint32_t skip_x, std::uint32_t skip_i, std::uint32_t base,
+    std::uint32_t skip, std::uint32_t repeat, float *dest) {
+  for (std::uint32_t batch = 0; batch < bs; ++batch) {
+    ConstPtr src = px + batch * skip_x + base * ids[batch * skip_i];
+    for (std::uint32_t i = 0; i < repeat; ++i) {
+      ConstPtr sp = src;
+      REPEAT_OP(j, base, *dest++ = *sp++);
+      src += skip;
+    }
+  }
+}
+
+}  // namespace
+
 namespace primitiv {
 namespace devices {
 
@@ -17,14 +37,8 @@ void Naive::pick_fw_impl(
   const std::uint32_t repeat = y.shape().volume() / base;
 
   float *dest = MDATA(y);
-  for (std::uint32_t batch = 0; batch < bs; ++batch) {
-    const float *src = CDATA(x) + batch * skip_x + base * ids[batch * skip_i];
-    for (std::uint32_t i = 0; i < repeat; ++i) {
-      const float *sp = src;
-      REPEAT_OP(j, base, *dest++ = *sp++);
-      src += skip;
-    }
-  }
+  DISPATCH_CDATA(x, px,
+      ::pick_fw_kernel(px, ids, bs, skip_x, skip_i, base, skip, repeat, dest));
 }
 
 void Naive::pick_bw_impl(
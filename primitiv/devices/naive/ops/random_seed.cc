@@ -0,0 +1,14 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+std::uint32_t Naive::random_seed_impl() {
+  return randomizer_.generate_seed();
+}
+
+}  // namespace devices
+}  // namespace primitiv
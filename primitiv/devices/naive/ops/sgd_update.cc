@@ -0,0 +1,19 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void Naive::sgd_update_impl(const Tensor &g, float eta, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const float *pg = CDATA(g);
+  float *px = MDATA(x);
+  for (std::uint32_t i = 0; i < size; ++i) {
+    px[i] -= eta * pg[i];
+  }
+}
+
+}  // namespace devices
+}  // namespace primitiv
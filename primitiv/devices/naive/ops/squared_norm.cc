@@ -0,0 +1,22 @@
+#include <primitiv/config.h>
+
+#include <primitiv/devices/naive/device.h>
+#include <primitiv/devices/naive/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+float Naive::squared_norm_impl(const std::vector<const Tensor *> &xs) {
+  float ret = 0;
+  for (const Tensor *x : xs) {
+    const std::uint32_t size = x->shape().size();
+    const float *src = CDATA(*x);
+    float temp = 0;
+    for (std::uint32_t i = 0; i < size; ++i) temp += src[i] * src[i];
+    ret += temp;
+  }
+  return ret;
+}
+
+}  // namespace devices
+}  // namespace primitiv
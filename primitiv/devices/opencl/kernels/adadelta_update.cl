@@ -0,0 +1,12 @@
+kernel void adadelta_update_kernel(
+    const global float *pg, const float scale, const float rho,
+    const float eps, const unsigned size, global float *pm1,
+    global float *pm2, global float *px) {
+  const unsigned i = get_global_id(0);
+  if (i < size) {
+    pm2[i] = rho * pm2[i] + (1 - rho) * pg[i] * pg[i];
+    const float d = sqrt((pm1[i] + eps) / (pm2[i] + eps)) * pg[i];
+    pm1[i] = rho * pm1[i] + (1 - rho) * d * d;
+    px[i] -= scale * d;
+  }
+}
@@ -0,0 +1,9 @@
+kernel void adagrad_update_kernel(
+    const global float *pg, const float eta, const float eps,
+    const unsigned size, global float *pm, global float *px) {
+  const unsigned i = get_global_id(0);
+  if (i < size) {
+    pm[i] += pg[i] * pg[i];
+    px[i] -= eta * pg[i] / (sqrt(pm[i]) + eps);
+  }
+}
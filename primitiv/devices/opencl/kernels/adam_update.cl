@@ -0,0 +1,12 @@
+kernel void adam_update_kernel(
+    const global float *pg, const float alpha, const float beta1,
+    const float beta2, const float eps, const float c1, const float c2,
+    const unsigned size, global float *pm1, global float *pm2,
+    global float *px) {
+  const unsigned i = get_global_id(0);
+  if (i < size) {
+    pm1[i] = beta1 * pm1[i] + (1 - beta1) * pg[i];
+    pm2[i] = beta2 * pm2[i] + (1 - beta2) * pg[i] * pg[i];
+    px[i] -= alpha * (pm1[i] / c1) / (sqrt(pm2[i] / c2) + eps);
+  }
+}
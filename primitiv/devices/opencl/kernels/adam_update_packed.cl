@@ -0,0 +1,34 @@
+float load_packed(const global ushort *p, const unsigned i,
+                  const unsigned precision) {
+  return precision == 1 ? vload_half(i, (const global half *) p)
+                        : as_float((uint) p[i] << 16);
+}
+
+void store_packed(global ushort *p, const unsigned i, const float x,
+                  const unsigned precision) {
+  if (precision == 1) {
+    vstore_half_rte(x, i, (global half *) p);
+  } else {
+    const uint b = as_uint(x);
+    p[i] = (b & 0x7fffffff) > 0x7f800000
+        ? (ushort) ((b >> 16) | 0x40)
+        : (ushort) ((b + 0x7fff + ((b >> 16) & 1)) >> 16);
+  }
+}
+
+kernel void adam_update_packed_kernel(
+    const global float *pg, const float alpha, const float beta1,
+    const float beta2, const float eps, const float c1, const float c2,
+    const unsigned size, const unsigned precision,
+    global ushort *pm1, global ushort *pm2, global float *px) {
+  const unsigned i = get_global_id(0);
+  if (i < size) {
+    const float m1 = beta1 * load_packed(pm1, i, precision)
+        + (1 - beta1) * pg[i];
+    const float m2 = beta2 * load_packed(pm2, i, 2)
+        + (1 - beta2) * pg[i] * pg[i];
+    store_packed(pm1, i, m1, precision);
+    store_packed(pm2, i, m2, 2);
+    px[i] -= alpha * (m1 / c1) / (sqrt(m2 / c2) + eps);
+  }
+}
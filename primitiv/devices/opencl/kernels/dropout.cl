@@ -0,0 +1,25 @@
+// NOTE: This function must generate the same sequence as
+// primitiv::hash_counter().
+inline unsigned hash_counter(const unsigned seed, const unsigned counter) {
+  unsigned h = seed + counter * 0x9e3779b9u;
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+kernel void dropout_fw_kernel(
+    const global float *px, const unsigned seed, const unsigned th,
+    const float scale, const unsigned size, global float *py) {
+  const unsigned i = get_global_id(0);
+  if (i < size) py[i] = hash_counter(seed, i) >= th ? scale * px[i] : .0f;
+}
+
+kernel void dropout_bw_kernel(
+    const global float *pgy, const unsigned seed, const unsigned th,
+    const float scale, const unsigned size, global float *pgx) {
+  const unsigned i = get_global_id(0);
+  if (i < size && hash_counter(seed, i) >= th) pgx[i] += scale * pgy[i];
+}
@@ -0,0 +1,22 @@
+kernel void inplace_pick_assign_kernel(
+    const global float *px, const global unsigned *pi,
+    const unsigned wy, const unsigned wx,
+    const unsigned sy, const unsigned si, const unsigned sx,
+    global float *py) {
+  const unsigned t = get_global_id(0);
+  const unsigned bid_y = get_group_id(1);
+  const unsigned oy = bid_y * sy + pi[bid_y * si] * wx;
+  const unsigned ox = bid_y * sx;
+  if (t < sx) py[oy + (t / wx) * wy + (t % wx)] = px[ox + t];
+}
+
+kernel void inplace_pick_reset_kernel(
+    const float k, const global unsigned *pi,
+    const unsigned wy, const unsigned wx,
+    const unsigned sy, const unsigned si, const unsigned sx,
+    global float *py) {
+  const unsigned t = get_global_id(0);
+  const unsigned bid_y = get_group_id(1);
+  const unsigned oy = bid_y * sy + pi[bid_y * si] * wx;
+  if (t < sx) py[oy + (t / wx) * wy + (t % wx)] = k;
+}
@@ -0,0 +1,9 @@
+kernel void momentum_sgd_update_kernel(
+    const global float *pg, const float eta, const float momentum,
+    const unsigned size, global float *pm, global float *px) {
+  const unsigned i = get_global_id(0);
+  if (i < size) {
+    pm[i] = momentum * pm[i] - eta * pg[i];
+    px[i] += pm[i];
+  }
+}
@@ -0,0 +1,8 @@
+kernel void sgd_update_kernel(
+    const global float *pg, const float eta, const unsigned size,
+    global float *px) {
+  const unsigned i = get_global_id(0);
+  if (i < size) {
+    px[i] -= eta * pg[i];
+  }
+}
@@ -0,0 +1,43 @@
+#define REDUCE(k, GROUP_SIZE) \
+  if (GROUP_SIZE >= k << 1) { \
+    if (tid < k) temp[tid] += temp[tid + k]; \
+    barrier(CLK_LOCAL_MEM_FENCE); \
+  }
+
+#define SQUARED_NORM_KERNEL(GROUP_SIZE) \
+kernel void squared_norm_kernel_##GROUP_SIZE( \
+    const global float *px, const unsigned size, const unsigned index, \
+    global float *py) { \
+  const unsigned tid = get_local_id(0); \
+  local float temp[GROUP_SIZE]; \
+  temp[tid] = 0; \
+  for (unsigned i = tid; i < size; i += GROUP_SIZE) { \
+    temp[tid] += px[i] * px[i]; \
+  } \
+  barrier(CLK_LOCAL_MEM_FENCE); \
+  REDUCE(512, GROUP_SIZE) \
+  REDUCE(256, GROUP_SIZE) \
+  REDUCE(128, GROUP_SIZE) \
+  REDUCE(64, GROUP_SIZE) \
+  REDUCE(32, GROUP_SIZE) \
+  REDUCE(16, GROUP_SIZE) \
+  REDUCE(8, GROUP_SIZE) \
+  REDUCE(4, GROUP_SIZE) \
+  REDUCE(2, GROUP_SIZE) \
+  REDUCE(1, GROUP_SIZE) \
+  if (tid == 0) py[index] = temp[0]; \
+}
+
+SQUARED_NORM_KERNEL(1024)
+SQUARED_NORM_KERNEL(512)
+SQUARED_NORM_KERNEL(256)
+SQUARED_NORM_KERNEL(128)
+SQUARED_NORM_KERNEL(64)
+SQUARED_NORM_KERNEL(32)
+SQUARED_NORM_KERNEL(16)
+SQUARED_NORM_KERNEL(8)
+SQUARED_NORM_KERNEL(4)
+SQUARED_NORM_KERNEL(2)
+SQUARED_NORM_KERNEL(1)
+
+#undef REDUCE
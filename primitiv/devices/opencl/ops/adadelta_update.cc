@@ -0,0 +1,30 @@
+#include <primitiv/config.h>
+
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void OpenCL::adadelta_update_impl(
+    const Tensor &g, float scale, float rho, float eps,
+    Tensor &m1, Tensor &m2, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = ::calc_num_blocks(
+      size, state_->adadelta_update_group_size);
+  state_->adadelta_update_kernel.setArg(0, CDATA(g));
+  state_->adadelta_update_kernel.setArg(1, scale);
+  state_->adadelta_update_kernel.setArg(2, rho);
+  state_->adadelta_update_kernel.setArg(3, eps);
+  state_->adadelta_update_kernel.setArg(4, size);
+  state_->adadelta_update_kernel.setArg(5, MDATA(m1));
+  state_->adadelta_update_kernel.setArg(6, MDATA(m2));
+  state_->adadelta_update_kernel.setArg(7, MDATA(x));
+  state_->queue.enqueueNDRangeKernel(
+      state_->adadelta_update_kernel, cl::NullRange,
+      cl::NDRange(num_blocks * state_->adadelta_update_group_size),
+      cl::NDRange(state_->adadelta_update_group_size));
+}
+
+}  // namespace devices
+}  // namespace primitiv
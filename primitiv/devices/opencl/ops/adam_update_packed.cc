@@ -0,0 +1,42 @@
+#include <primitiv/config.h>
+
+#include <cmath>
+
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void OpenCL::adam_update_packed_impl(
+    const Tensor &g, float alpha, float beta1, float beta2, float eps,
+    std::uint32_t epoch, Precision precision,
+    Tensor &m1, Tensor &m2, Tensor &x) {
+  const float c1 = 1 - std::pow(beta1, epoch);
+  const float c2 = 1 - std::pow(beta2, epoch);
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = ::calc_num_blocks(
+      size, state_->adam_update_packed_group_size);
+  state_->adam_update_packed_kernel.setArg(0, CDATA(g));
+  state_->adam_update_packed_kernel.setArg(1, alpha);
+  state_->adam_update_packed_kernel.setArg(2, beta1);
+  state_->adam_update_packed_kernel.setArg(3, beta2);
+  state_->adam_update_packed_kernel.setArg(4, eps);
+  state_->adam_update_packed_kernel.setArg(5, c1);
+  state_->adam_update_packed_kernel.setArg(6, c2);
+  state_->adam_update_packed_kernel.setArg(7, size);
+  state_->adam_update_packed_kernel.setArg(
+      8, static_cast<std::uint32_t>(precision));
+  state_->adam_update_packed_kernel.setArg(
+      9, *static_cast<cl::Buffer *>(get_mutable_packed_handle(m1)));
+  state_->adam_update_packed_kernel.setArg(
+      10, *static_cast<cl::Buffer *>(get_mutable_packed_handle(m2)));
+  state_->adam_update_packed_kernel.setArg(11, MDATA(x));
+  state_->queue.enqueueNDRangeKernel(
+      state_->adam_update_packed_kernel, cl::NullRange,
+      cl::NDRange(num_blocks * state_->adam_update_packed_group_size),
+      cl::NDRange(state_->adam_update_packed_group_size));
+}
+
+}  // namespace devices
+}  // namespace primitiv
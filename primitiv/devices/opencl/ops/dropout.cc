@@ -0,0 +1,49 @@
+#include <primitiv/config.h>
+
+#include <primitiv/core/random.h>
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void OpenCL::dropout_fw_impl(
+    const Tensor &x, float rate, std::uint32_t seed, Tensor &y) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t th = dropout_threshold(rate);
+  const float scale = 1.f / (1.f - rate);
+  const std::uint32_t num_blocks = ::calc_num_blocks(
+      size, state_->dropout_fw_group_size);
+  state_->dropout_fw_kernel.setArg(0, CDATA(x));
+  state_->dropout_fw_kernel.setArg(1, seed);
+  state_->dropout_fw_kernel.setArg(2, th);
+  state_->dropout_fw_kernel.setArg(3, scale);
+  state_->dropout_fw_kernel.setArg(4, size);
+  state_->dropout_fw_kernel.setArg(5, MDATA(y));
+  state_->queue.enqueueNDRangeKernel(
+      state_->dropout_fw_kernel, cl::NullRange,
+      cl::NDRange(num_blocks * state_->dropout_fw_group_size),
+      cl::NDRange(state_->dropout_fw_group_size));
+}
+
+void OpenCL::dropout_bw_impl(
+    const Tensor &gy, float rate, std::uint32_t seed, Tensor &gx) {
+  const std::uint32_t size = gy.shape().size();
+  const std::uint32_t th = dropout_threshold(rate);
+  const float scale = 1.f / (1.f - rate);
+  const std::uint32_t num_blocks = ::calc_num_blocks(
+      size, state_->dropout_bw_group_size);
+  state_->dropout_bw_kernel.setArg(0, CDATA(gy));
+  state_->dropout_bw_kernel.setArg(1, seed);
+  state_->dropout_bw_kernel.setArg(2, th);
+  state_->dropout_bw_kernel.setArg(3, scale);
+  state_->dropout_bw_kernel.setArg(4, size);
+  state_->dropout_bw_kernel.setArg(5, MDATA(gx));
+  state_->queue.enqueueNDRangeKernel(
+      state_->dropout_bw_kernel, cl::NullRange,
+      cl::NDRange(num_blocks * state_->dropout_bw_group_size),
+      cl::NDRange(state_->dropout_bw_group_size));
+}
+
+}  // namespace devices
+}  // namespace primitiv
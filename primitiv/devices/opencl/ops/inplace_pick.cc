@@ -0,0 +1,69 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void OpenCL::inplace_pick_assign_impl(
+    const Tensor &x, const std::vector<std::uint32_t> &ids,
+    std::uint32_t dim, Tensor &y) {
+  const std::uint32_t wx = x.shape().lower_volume(dim);
+  const std::uint32_t wy = wx * y.shape()[dim];
+  const std::uint32_t sy = y.shape().has_batch() * y.shape().volume();
+  const std::uint32_t si = ids.size() > 1;
+  const std::uint32_t sx = x.shape().volume();
+  const std::uint32_t g1 = ::calc_num_blocks(
+      sx, state_->inplace_pick_assign_group_size);
+  const std::uint32_t bs = x.shape().batch();
+  std::shared_ptr<void> ids_buf = state_->pool.allocate(
+      sizeof(std::uint32_t) * ids.size());
+  ::write_buffer(state_->queue, ::get_buffer(ids_buf), ids.data(), ids.size());
+  state_->inplace_pick_assign_kernel.setArg(0, CDATA(x));
+  state_->inplace_pick_assign_kernel.setArg(1, ::get_buffer(ids_buf));
+  state_->inplace_pick_assign_kernel.setArg(2, wy);
+  state_->inplace_pick_assign_kernel.setArg(3, wx);
+  state_->inplace_pick_assign_kernel.setArg(4, sy);
+  state_->inplace_pick_assign_kernel.setArg(5, si);
+  state_->inplace_pick_assign_kernel.setArg(6, sx);
+  state_->inplace_pick_assign_kernel.setArg(7, MDATA(y));
+  state_->queue.enqueueNDRangeKernel(
+      state_->inplace_pick_assign_kernel, cl::NullRange,
+      cl::NDRange(g1 * state_->inplace_pick_assign_group_size, bs),
+      cl::NDRange(state_->inplace_pick_assign_group_size, 1));
+}
+
+void OpenCL::inplace_pick_reset_impl(
+    float k, const std::vector<std::uint32_t> &ids,
+    std::uint32_t dim, Tensor &y) {
+  const std::uint32_t wx = y.shape().lower_volume(dim);
+  const std::uint32_t wy = wx * y.shape()[dim];
+  const std::uint32_t sy = y.shape().has_batch() * y.shape().volume();
+  const std::uint32_t si = ids.size() > 1;
+  const std::uint32_t sx = y.shape().volume() / y.shape()[dim];
+  const std::uint32_t g1 = ::calc_num_blocks(
+      sx, state_->inplace_pick_reset_group_size);
+  const std::uint32_t bs = std::max<std::uint32_t>(
+      y.shape().batch(), ids.size());
+  std::shared_ptr<void> ids_buf = state_->pool.allocate(
+      sizeof(std::uint32_t) * ids.size());
+  ::write_buffer(state_->queue, ::get_buffer(ids_buf), ids.data(), ids.size());
+  state_->inplace_pick_reset_kernel.setArg(0, k);
+  state_->inplace_pick_reset_kernel.setArg(1, ::get_buffer(ids_buf));
+  state_->inplace_pick_reset_kernel.setArg(2, wy);
+  state_->inplace_pick_reset_kernel.setArg(3, wx);
+  state_->inplace_pick_reset_kernel.setArg(4, sy);
+  state_->inplace_pick_reset_kernel.setArg(5, si);
+  state_->inplace_pick_reset_kernel.setArg(6, sx);
+  state_->inplace_pick_reset_kernel.setArg(7, MDATA(y));
+  state_->queue.enqueueNDRangeKernel(
+      state_->inplace_pick_reset_kernel, cl::NullRange,
+      cl::NDRange(g1 * state_->inplace_pick_reset_group_size, bs),
+      cl::NDRange(state_->inplace_pick_reset_group_size, 1));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,17 @@
+#include <primitiv/config.h>
+
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void *OpenCL::offset_handle(void *, std::uint32_t) {
+  // NOTE:
+  // Handles of this device are cl::Buffer objects, and sub-buffers require
+  // the device-specific alignment of the origin.
+  PRIMITIV_THROW_NOT_IMPLEMENTED;
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,14 @@
+#include <primitiv/config.h>
+
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+std::uint32_t OpenCL::random_seed_impl() {
+  return state_->randomizer_.generate_seed();
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,24 @@
+#include <primitiv/config.h>
+
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void OpenCL::sgd_update_impl(const Tensor &g, float eta, Tensor &x) {
+  const std::uint32_t size = x.shape().size();
+  const std::uint32_t num_blocks = ::calc_num_blocks(
+      size, state_->sgd_update_group_size);
+  state_->sgd_update_kernel.setArg(0, CDATA(g));
+  state_->sgd_update_kernel.setArg(1, eta);
+  state_->sgd_update_kernel.setArg(2, size);
+  state_->sgd_update_kernel.setArg(3, MDATA(x));
+  state_->queue.enqueueNDRangeKernel(
+      state_->sgd_update_kernel, cl::NullRange,
+      cl::NDRange(num_blocks * state_->sgd_update_group_size),
+      cl::NDRange(state_->sgd_update_group_size));
+}
+
+}  // namespace devices
+}  // namespace primitiv
@@ -0,0 +1,49 @@
+#include <primitiv/config.h>
+
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+float OpenCL::squared_norm_impl(const std::vector<const Tensor *> &xs) {
+  const std::uint32_t num_xs = xs.size();
+  std::shared_ptr<void> py = state_->pool.allocate(sizeof(float) * num_xs);
+  for (std::uint32_t i = 0; i < num_xs; ++i) {
+    const std::uint32_t size = xs[i]->shape().size();
+    std::uint32_t group_size = std::min(state_->squared_norm_group_size, 1024u);
+    while (group_size >> 1 >= size) group_size >>= 1;
+    switch (group_size) {
+#define CASE(k, m) \
+      case k: \
+        state_->squared_norm_kernel[m].setArg(0, CDATA(*xs[i])); \
+        state_->squared_norm_kernel[m].setArg(1, size); \
+        state_->squared_norm_kernel[m].setArg(2, i); \
+        state_->squared_norm_kernel[m].setArg(3, ::get_buffer(py)); \
+        state_->queue.enqueueNDRangeKernel( \
+            state_->squared_norm_kernel[m], \
+            cl::NullRange, cl::NDRange(k), cl::NDRange(k)); \
+        break;
+      CASE(1024, 10);
+      CASE(512, 9);
+      CASE(256, 8);
+      CASE(128, 7);
+      CASE(64, 6);
+      CASE(32, 5);
+      CASE(16, 4);
+      CASE(8, 3);
+      CASE(4, 2);
+      CASE(2, 1);
+      CASE(1, 0);
+#undef CASE
+    }
+  }
+  std::vector<float> partial(num_xs);
+  ::read_buffer(state_->queue, ::get_buffer(py), partial.data(), num_xs);
+  float ret = 0;
+  for (const float p : partial) ret += p;
+  return ret;
+}
+
+}  // namespace devices
+}  // namespace primitiv
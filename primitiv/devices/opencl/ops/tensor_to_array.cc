@@ -0,0 +1,18 @@
+#include <primitiv/config.h>
+
+#include <primitiv/internal/opencl/utils.h>
+#include <primitiv/devices/opencl/ops/common.h>
+
+namespace primitiv {
+namespace devices {
+
+void OpenCL::tensor_to_array_impl(
+    const Tensor &x, std::uint32_t offset, std::uint32_t size,
+    float values[]) {
+  state_->queue.enqueueReadBuffer(
+      CDATA(x), CL_TRUE, sizeof(float) * offset, sizeof(float) * size,
+      values);
+}
+
+}  // namespace devices
+}  // namespace primitiv
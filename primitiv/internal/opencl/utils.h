@@ -249,6 +249,9 @@ public:
 
       CONFIGURE_KERNEL(pown_bw);
 
+      CONFIGURE_KERNEL(dropout_fw);
+      CONFIGURE_KERNEL(dropout_bw);
+
       CONFIGURE_KERNEL(add_scalar_fw);
       CONFIGURE_KERNEL(subtract_scalar_r_fw);
       CONFIGURE_KERNEL(subtract_scalar_l_fw);
@@ -296,6 +299,19 @@ public:
       CONFIGURE_KERNEL(inplace_multiply_const);
       CONFIGURE_KERNEL(inplace_add);
       CONFIGURE_KERNEL(inplace_subtract);
+      CONFIGURE_KERNEL(inplace_pick_assign);
+      CONFIGURE_KERNEL(inplace_pick_reset);
+
+      CONFIGURE_KERNEL(sgd_update);
+      CONFIGURE_KERNEL(momentum_sgd_update);
+      CONFIGURE_KERNEL(adagrad_update);
+      CONFIGURE_KERNEL(rmsprop_update);
+      CONFIGURE_KERNEL(adadelta_update);
+      CONFIGURE_KERNEL(adam_update);
+      CONFIGURE_KERNEL(adam_update_packed);
+
+      CONFIGURE_KERNEL_LIST(squared_norm);
+      squared_norm_group_size = calc_dim1_size(squared_norm_group_size);
 
 #undef CONFIGURE_KERNEL
 #undef CONFIGURE_KERNEL_LIST
@@ -393,6 +409,9 @@ public:
 
   DECL_KERNEL(pown_bw);
 
+  DECL_KERNEL(dropout_fw);
+  DECL_KERNEL(dropout_bw);
+
   DECL_KERNEL(add_scalar_fw);
   DECL_KERNEL(subtract_scalar_r_fw);
   DECL_KERNEL(subtract_scalar_l_fw);
@@ -434,6 +453,18 @@ public:
   DECL_KERNEL(inplace_multiply_const);
   DECL_KERNEL(inplace_add);
   DECL_KERNEL(inplace_subtract);
+  DECL_KERNEL(inplace_pick_assign);
+  DECL_KERNEL(inplace_pick_reset);
+
+  DECL_KERNEL(sgd_update);
+  DECL_KERNEL(momentum_sgd_update);
+  DECL_KERNEL(adagrad_update);
+  DECL_KERNEL(rmsprop_update);
+  DECL_KERNEL(adadelta_update);
+  DECL_KERNEL(adam_update);
+  DECL_KERNEL(adam_update_packed);
+
+  DECL_KERNEL_LIST(squared_norm, 11);
 
 #undef DECL_KERNEL
 #undef DECL_KERNEL_LIST
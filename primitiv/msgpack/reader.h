@@ -198,18 +198,7 @@ public:
   }
 
   Reader &operator>>(objects::Binary &x) {
-    static_assert(sizeof(std::size_t) >= sizeof(std::uint32_t), "");
-    const std::uint8_t type = get_uint8();
-    std::size_t size;
-    switch (type) {
-      case 0xc4: size = get_uint8(); break;
-      case 0xc5: size = get_uint16(); break;
-      case 0xc6: size = get_uint32(); break;
-      default:
-        PRIMITIV_THROW_ERROR(
-            "MessagePack: Next object does not have the 'bin' type. "
-            "observed: " << type);
-    }
+    const std::size_t size = read_binary_header();
     objects::Binary ret;
     read(ret.allocate(size), size);
     x = std::move(ret);
@@ -240,6 +229,36 @@ public:
     return *this;
   }
 
+  /**
+   * Reads only the header of the next 'bin' object.
+   * @return Number of bytes of the data following the header.
+   * @remarks After calling this function, the stream points the head of the
+   *          data. The caller should consume or `skip()` the data before
+   *          reading the next object.
+   */
+  std::size_t read_binary_header() {
+    static_assert(sizeof(std::size_t) >= sizeof(std::uint32_t), "");
+    const std::uint8_t type = get_uint8();
+    switch (type) {
+      case 0xc4: return get_uint8();
+      case 0xc5: return get_uint16();
+      case 0xc6: return get_uint32();
+      default:
+        PRIMITIV_THROW_ERROR(
+            "MessagePack: Next object does not have the 'bin' type. "
+            "observed: " << type);
+    }
+  }
+
+  /**
+   * Skips raw bytes on the stream.
+   * @param size Number of bytes to skip.
+   */
+  void skip(std::size_t size) {
+    is_.seekg(size, std::ios_base::cur);
+    check_eof();
+  }
+
   template<typename T>
   Reader &operator>>(std::vector<T> &x) {
     static_assert(sizeof(std::size_t) >= sizeof(std::uint32_t), "");
@@ -27,7 +27,7 @@ class Writer : mixins::Nonmovable<Writer> {
   std::ostream &os_;
 
 private:
-  Writer &write_string(const char *x, std::size_t size) {
+  Writer &write_shortest_string(const char *x, std::size_t size) {
 #ifdef PRIMITIV_WORDSIZE_64
     static_assert(sizeof(std::size_t) > sizeof(std::uint32_t), "");
     if (size < (1 << 5)) {
@@ -201,17 +201,22 @@ public:
   }
 
   Writer &operator<<(const char *x) {
-    return write_string(x, std::strlen(x));
+    return write_shortest_string(x, std::strlen(x));
   }
 
   Writer &operator<<(const std::string &x) {
-    return write_string(x.data(), x.size());
+    return write_shortest_string(x.data(), x.size());
   }
 
-  Writer &operator<<(const objects::Binary &x) {
+  /**
+   * Writes only the header of a 'bin' object.
+   * @param size Number of bytes of the data.
+   * @remarks The caller should write exactly `size` bytes of the data using
+   *          `write_bytes()` before writing the next object.
+   */
+  Writer &write_binary_header(std::size_t size) {
 #ifdef PRIMITIV_WORDSIZE_64
     static_assert(sizeof(std::size_t) > sizeof(std::uint32_t), "");
-    const std::size_t size = x.size();
     if (size < (1ull << 8)) {
       const char buf[2] { PRIMITIV_UC(0xc4), PRIMITIV_UC(size) };
       os_.write(buf, 2);
@@ -232,11 +237,9 @@ public:
           "MessagePack: Can't store more than 2^32 - 1 bytes "
           "in one bin message.");
     }
-    os_.write(reinterpret_cast<const char *>(x.data()), size);
     return *this;
 #else
     static_assert(sizeof(std::size_t) == sizeof(std::uint32_t), "");
-    const std::size_t size = x.size();
     if (size < (1ul << 8)) {
       const char buf[2] { PRIMITIV_UC(0xc4), PRIMITIV_UC(size) };
       os_.write(buf, 2);
@@ -253,11 +256,25 @@ public:
       };
       os_.write(buf, 5);
     }
-    os_.write(reinterpret_cast<const char *>(x.data()), size);
     return *this;
 #endif
   }
 
+  /**
+   * Writes raw bytes to the stream.
+   * @param data Pointer to the data.
+   * @param size Number of bytes to write.
+   */
+  Writer &write_bytes(const char *data, std::size_t size) {
+    os_.write(data, size);
+    return *this;
+  }
+
+  Writer &operator<<(const objects::Binary &x) {
+    write_binary_header(x.size());
+    return write_bytes(x.data(), x.size());
+  }
+
   Writer &operator<<(const objects::Extension &x) {
 #ifdef PRIMITIV_WORDSIZE_64
     static_assert(sizeof(std::size_t) > sizeof(std::uint32_t), "");
@@ -388,6 +405,83 @@ public:
 #endif
   }
 
+  /**
+   * Retrieves the current position of the output stream.
+   * @return Position of the stream, or -1 if the stream does not support it.
+   */
+  std::streamoff position() {
+    return os_.tellp();
+  }
+
+  /**
+   * Writes the header of an 'array' object with a specific length.
+   * @param size Number of elements following this header.
+   * @param header_size Number of bytes of the header. This value should be 1
+   *                    (up to 15 elements), 3 (up to 2^16 - 1 elements) or 5.
+   * @remarks This function and `write_string()` are used to adjust the
+   *          position of the following objects.
+   */
+  Writer &write_array_header(std::size_t size, std::size_t header_size) {
+    const std::uint64_t size64 = size;
+    if (header_size == 1 && size64 < (1ull << 4)) {
+      const char buf[1] { PRIMITIV_UC(0x90 | (size & 0x0f)) };
+      os_.write(buf, 1);
+    } else if (header_size == 3 && size64 < (1ull << 16)) {
+      const char buf[3] {
+        PRIMITIV_UC(0xdc), PRIMITIV_UC(size >> 8), PRIMITIV_UC(size)
+      };
+      os_.write(buf, 3);
+    } else if (header_size == 5 && size64 < (1ull << 32)) {
+      const char buf[5] {
+        PRIMITIV_UC(0xdd),
+        PRIMITIV_UC(size64 >> 24), PRIMITIV_UC(size64 >> 16),
+        PRIMITIV_UC(size64 >> 8), PRIMITIV_UC(size64),
+      };
+      os_.write(buf, 5);
+    } else {
+      PRIMITIV_THROW_ERROR(
+          "MessagePack: Invalid header size of the array message. "
+          "size: " << size << ", header_size: " << header_size);
+    }
+    return *this;
+  }
+
+  /**
+   * Writes a 'str' object with a specific length of the header.
+   * @param x A string.
+   * @param header_size Number of bytes of the header. This value should be 1
+   *                    (up to 31 bytes), 2 (up to 255 bytes),
+   *                    3 (up to 2^16 - 1 bytes) or 5.
+   */
+  Writer &write_string(const std::string &x, std::size_t header_size) {
+    const std::uint64_t size64 = x.size();
+    if (header_size == 1 && size64 < (1ull << 5)) {
+      const char buf[1] { PRIMITIV_UC(0xa0 | (size64 & 0x1f)) };
+      os_.write(buf, 1);
+    } else if (header_size == 2 && size64 < (1ull << 8)) {
+      const char buf[2] { PRIMITIV_UC(0xd9), PRIMITIV_UC(size64) };
+      os_.write(buf, 2);
+    } else if (header_size == 3 && size64 < (1ull << 16)) {
+      const char buf[3] {
+        PRIMITIV_UC(0xda), PRIMITIV_UC(size64 >> 8), PRIMITIV_UC(size64)
+      };
+      os_.write(buf, 3);
+    } else if (header_size == 5 && size64 < (1ull << 32)) {
+      const char buf[5] {
+        PRIMITIV_UC(0xdb),
+        PRIMITIV_UC(size64 >> 24), PRIMITIV_UC(size64 >> 16),
+        PRIMITIV_UC(size64 >> 8), PRIMITIV_UC(size64),
+      };
+      os_.write(buf, 5);
+    } else {
+      PRIMITIV_THROW_ERROR(
+          "MessagePack: Invalid header size of the str message. "
+          "size: " << x.size() << ", header_size: " << header_size);
+    }
+    os_.write(x.data(), x.size());
+    return *this;
+  }
+
   template<typename T>
   Writer &operator<<(const std::vector<T> &x) {
 #ifdef PRIMITIV_WORDSIZE_64
@@ -5,6 +5,8 @@
 
 // This header file describes some include directives and may help users to use
 // the primitiv library.
+#include <primitiv/core/batcher.h>
+#include <primitiv/core/data_loader.h>
 #include <primitiv/core/error.h>
 #include <primitiv/core/functions.h>
 #include <primitiv/core/graph.h>
@@ -14,6 +16,7 @@
 #include <primitiv/core/shape.h>
 #include <primitiv/core/tensor.h>
 #include <primitiv/core/optimizer_impl.h>
+#include <primitiv/core/packed_sequence.h>
 #include <primitiv/devices/naive/device.h>
 
 // Header files for specific device classes.
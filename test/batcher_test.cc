@@ -0,0 +1,228 @@
+#include <primitiv/config.h>
+
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <primitiv/core/batcher.h>
+#include <primitiv/core/error.h>
+#include <primitiv/core/functions.h>
+#include <primitiv/core/graph.h>
+#include <primitiv/devices/naive/device.h>
+
+#include <test_utils.h>
+
+using std::vector;
+using test_utils::vector_match;
+
+namespace primitiv {
+
+namespace F = functions;
+
+class BatcherTest : public testing::Test {
+protected:
+  devices::Naive dev;
+
+  // Records batch sizes of given minibatches.
+  std::mutex mutex;
+  vector<std::uint32_t> batch_sizes;
+
+  Batcher::Function double_func() {
+    return [this](const Node &x) {
+      std::lock_guard<std::mutex> lock(mutex);
+      batch_sizes.emplace_back(x.shape().batch());
+      return 2 * x;
+    };
+  }
+
+  void SetUp() override {
+    Device::set_default(dev);
+  }
+};
+
+TEST_F(BatcherTest, CheckNew) {
+  Batcher batcher(double_func(), 8, 100);
+  EXPECT_EQ(8u, batcher.max_batch_size());
+  EXPECT_EQ(100u, batcher.max_delay_us());
+  EXPECT_EQ(0u, batcher.num_batches());
+}
+
+TEST_F(BatcherTest, CheckInvalidNew) {
+  EXPECT_THROW(Batcher(Batcher::Function(), 8, 100), Error);
+  EXPECT_THROW(Batcher(double_func(), 0, 100), Error);
+}
+
+TEST_F(BatcherTest, CheckSingleRequest) {
+  Batcher batcher(double_func(), 8, 100);
+  std::future<Tensor> y = batcher.push({2}, {1, 2});
+  const Tensor t = y.get();
+  EXPECT_EQ(Shape({2}), t.shape());
+  EXPECT_TRUE(vector_match(vector<float> {2, 4}, t.to_vector()));
+  EXPECT_EQ(1u, batcher.num_batches());
+  EXPECT_EQ(vector<std::uint32_t> {1}, batch_sizes);
+}
+
+TEST_F(BatcherTest, CheckMinibatch) {
+  // Requests are processed when the bucket becomes full.
+  Batcher batcher(double_func(), 3, 10000000);
+  vector<std::future<Tensor>> ys;
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    ys.emplace_back(batcher.push({2}, {1.f * i, -1.f * i}));
+  }
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    const Tensor t = ys[i].get();
+    EXPECT_EQ(Shape({2}), t.shape());
+    EXPECT_TRUE(vector_match(
+          vector<float> {2.f * i, -2.f * i}, t.to_vector()));
+  }
+  EXPECT_EQ(1u, batcher.num_batches());
+  EXPECT_EQ(vector<std::uint32_t> {3}, batch_sizes);
+}
+
+TEST_F(BatcherTest, CheckBuckets) {
+  vector<std::future<Tensor>> ys;
+  {
+    Batcher batcher(double_func(), 2, 10000000);
+    ys.emplace_back(batcher.push({2}, {1, 2}));
+    ys.emplace_back(batcher.push({3}, {3, 4, 5}));
+    ys.emplace_back(batcher.push({2}, {6, 7}));
+    ys.emplace_back(batcher.push({3}, {8, 9, 10}));
+    ys.emplace_back(batcher.push({3}, {11, 12, 13}));
+    // The destructor processes the remaining request.
+  }
+  const vector<vector<float>> expected {
+    {2, 4}, {6, 8, 10}, {12, 14}, {16, 18, 20}, {22, 24, 26},
+  };
+  for (std::uint32_t i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(vector_match(expected[i], ys[i].get().to_vector()));
+  }
+  EXPECT_EQ((vector<std::uint32_t> {2, 2, 1}), batch_sizes);
+}
+
+TEST_F(BatcherTest, CheckNewWithLengthBuckets) {
+  Batcher batcher(double_func(), 8, 100, 1, {4, 8}, -1);
+  EXPECT_EQ(1u, batcher.length_dim());
+  EXPECT_EQ((vector<std::uint32_t> {4, 8}), batcher.bucket_lengths());
+  EXPECT_EQ(-1, batcher.pad_value());
+
+  Batcher batcher2(double_func(), 8, 100);
+  EXPECT_EQ(0u, batcher2.length_dim());
+  EXPECT_TRUE(batcher2.bucket_lengths().empty());
+  EXPECT_EQ(0, batcher2.pad_value());
+}
+
+TEST_F(BatcherTest, CheckInvalidLengthBuckets) {
+  EXPECT_THROW(Batcher(double_func(), 8, 100, 0, {0, 4}), Error);
+  EXPECT_THROW(Batcher(double_func(), 8, 100, 0, {4, 4}), Error);
+  EXPECT_THROW(Batcher(double_func(), 8, 100, 0, {8, 4}), Error);
+  EXPECT_THROW(Batcher(double_func(), 8, 100, Shape::MAX_DEPTH, {4}), Error);
+}
+
+TEST_F(BatcherTest, CheckLengthBuckets) {
+  // Inputs with the shape {2, length} are padded to the length 4 or 8.
+  vector<vector<float>> inputs;
+  vector<std::future<Tensor>> ys;
+  {
+    Batcher batcher(
+        [&](const Node &x) {
+          inputs.emplace_back(x.to_vector());
+          return double_func()(x);
+        }, 2, 10000000, 1, {4, 8}, -1);
+    ys.emplace_back(batcher.push({2, 3}, {1, 2, 3, 4, 5, 6}));
+    ys.emplace_back(batcher.push({2, 4}, {1, 2, 3, 4, 5, 6, 7, 8}));
+    ys.emplace_back(batcher.push({2, 5}, vector<float>(10, 1)));
+    ys.emplace_back(batcher.push({2, 9}, vector<float>(18, 1)));
+    // The destructor processes remaining requests.
+  }
+  const vector<Shape> shapes {{2, 3}, {2, 4}, {2, 5}, {2, 9}};
+  const vector<vector<float>> expected {
+    {2, 4, 6, 8, 10, 12},
+    {2, 4, 6, 8, 10, 12, 14, 16},
+    vector<float>(10, 2),
+    vector<float>(18, 2),
+  };
+  for (std::uint32_t i = 0; i < expected.size(); ++i) {
+    const Tensor t = ys[i].get();
+    EXPECT_EQ(shapes[i], t.shape());
+    EXPECT_TRUE(vector_match(expected[i], t.to_vector()));
+  }
+  EXPECT_EQ((vector<std::uint32_t> {2, 1, 1}), batch_sizes);
+  EXPECT_TRUE(vector_match(
+        vector<float> {
+          1, 2, 3, 4, 5, 6, -1, -1,
+          1, 2, 3, 4, 5, 6, 7, 8,
+        }, inputs[0]));
+}
+
+TEST_F(BatcherTest, CheckLengthBucketsWithFixedOutputs) {
+  // Outputs without the length dimension are not sliced.
+  std::future<Tensor> y;
+  {
+    Batcher batcher(
+        [](const Node &x) { return F::sum(x, 0); }, 2, 10000000, 0, {4});
+    y = batcher.push({3}, {1, 2, 3});
+  }
+  const Tensor t = y.get();
+  EXPECT_EQ(Shape(), t.shape());
+  EXPECT_TRUE(vector_match(vector<float> {6}, t.to_vector()));
+}
+
+TEST_F(BatcherTest, CheckDelay) {
+  // Requests are processed after the deadline even if the bucket is not full.
+  Batcher batcher(double_func(), 100, 1000);
+  std::future<Tensor> y1 = batcher.push({2}, {1, 2});
+  std::future<Tensor> y2 = batcher.push({2}, {3, 4});
+  EXPECT_TRUE(vector_match(vector<float> {2, 4}, y1.get().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {6, 8}, y2.get().to_vector()));
+  EXPECT_LE(1u, batcher.num_batches());
+}
+
+TEST_F(BatcherTest, CheckConcurrentRequests) {
+  static const std::uint32_t NUM_THREADS = 4;
+  static const std::uint32_t NUM_REQUESTS = 25;
+  Batcher batcher(double_func(), 8, 1000);
+
+  vector<vector<vector<float>>> results(NUM_THREADS);
+  vector<std::thread> threads;
+  for (std::uint32_t t = 0; t < NUM_THREADS; ++t) {
+    threads.emplace_back([&, t]() {
+        for (std::uint32_t i = 0; i < NUM_REQUESTS; ++i) {
+          const float k = 100.f * t + i;
+          results[t].emplace_back(
+              batcher.push({2}, {k, -k}).get().to_vector());
+        }
+    });
+  }
+  for (std::thread &th : threads) th.join();
+
+  for (std::uint32_t t = 0; t < NUM_THREADS; ++t) {
+    for (std::uint32_t i = 0; i < NUM_REQUESTS; ++i) {
+      const float k = 100.f * t + i;
+      EXPECT_TRUE(vector_match(vector<float> {2 * k, -2 * k}, results[t][i]));
+    }
+  }
+  std::uint32_t total = 0;
+  for (std::uint32_t n : batch_sizes) total += n;
+  EXPECT_EQ(NUM_THREADS * NUM_REQUESTS, total);
+}
+
+TEST_F(BatcherTest, CheckInvalidPush) {
+  Batcher batcher(double_func(), 8, 100);
+  EXPECT_THROW(batcher.push(Shape({2}, 2), {1, 2, 3, 4}), Error);
+  EXPECT_THROW(batcher.push({2}, {1, 2, 3}), Error);
+  EXPECT_EQ(0u, batcher.num_batches());
+}
+
+TEST_F(BatcherTest, CheckInvalidOutput) {
+  Batcher batcher(
+      [](const Node &x) { return F::batch::sum(x); }, 2, 10000000);
+  std::future<Tensor> y1 = batcher.push({2}, {1, 2});
+  std::future<Tensor> y2 = batcher.push({2}, {3, 4});
+  EXPECT_THROW(y1.get(), Error);
+  EXPECT_THROW(y2.get(), Error);
+}
+
+}  // namespace primitiv
@@ -1,5 +1,7 @@
 #include <primitiv/config.h>
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <primitiv/c/devices/naive/device.h>
@@ -44,5 +46,28 @@ TEST_F(CDeviceTest, CheckDefault) {
             ::primitivGetDefaultDevice(&device));
 }
 
+TEST_F(CDeviceTest, CheckThreadDefault) {
+  ::primitivDevice_t *dev1;
+  ::primitivDevice_t *dev2;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCreateNaiveDevice(&dev1));
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCreateNaiveDevice(&dev2));
+  ::primitivSetDefaultDevice(dev1);
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivSetThreadDefaultDevice(dev2));
+  EXPECT_EQ(PRIMITIV_C_ERROR, ::primitivSetThreadDefaultDevice(nullptr));
+
+  ::primitivDevice_t *device;
+  ::primitivGetDefaultDevice(&device);
+  EXPECT_EQ(dev2, device);
+  std::thread([&]() { ::primitivGetDefaultDevice(&device); }).join();
+  EXPECT_EQ(dev1, device);
+
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivResetThreadDefaultDevice());
+  ::primitivGetDefaultDevice(&device);
+  EXPECT_EQ(dev1, device);
+
+  ::primitivDeleteDevice(dev2);
+  ::primitivDeleteDevice(dev1);
+}
+
 }  // namespace c
 }  // namespace primitiv
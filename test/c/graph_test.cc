@@ -1,5 +1,6 @@
 #include <primitiv/config.h>
 
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -8,6 +9,7 @@
 #include <primitiv/c/devices/naive/device.h>
 #include <primitiv/c/functions.h>
 #include <primitiv/c/graph.h>
+#include <primitiv/c/operator_records.h>
 #include <primitiv/c/parameter.h>
 #include <primitiv/c/status.h>
 #include <primitiv/c/tensor.h>
@@ -387,5 +389,154 @@ TEST_F(CGraphTest, CheckMultipleReturnValues) {
   ::primitivDeleteGraph(g);
 }
 
+TEST_F(CGraphTest, CheckGetNodeFromGraph) {
+  ::primitivGraph_t *g;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCreateGraph(&g));
+  ::primitivShape_t *shape;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCreateShape(&shape));
+  const float values[] = {42};
+  ::primitivNode_t *x;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyNodeInput(shape, values, 1, dev, g, &x));
+  std::uint32_t oid;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetNodeOperatorId(x, &oid));
+
+  ::primitivNode_t *y;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetNodeFromGraph(g, oid, 0, &y));
+  float value;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivEvaluateNodeAsFloat(y, &value));
+  EXPECT_EQ(42, value);
+  EXPECT_EQ(PRIMITIV_C_ERROR, ::primitivGetNodeFromGraph(g, oid, 1, &y));
+  EXPECT_EQ(PRIMITIV_C_ERROR, ::primitivGetNodeFromGraph(g, oid + 1, 0, &y));
+
+  ::primitivDeleteNode(y);
+  ::primitivDeleteNode(x);
+  ::primitivDeleteShape(shape);
+  ::primitivDeleteGraph(g);
+}
+
+TEST_F(CGraphTest, CheckApplyNodeRecords) {
+  ::primitivGraph_t *g;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCreateGraph(&g));
+  const uint32_t dims[] = {2};
+  ::primitivShape_t *shape;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCreateShapeWithDims(dims, 1, 1, &shape));
+  const float data_a[] = {1, 2};
+  const float data_b[] = {3, 4};
+  ::primitivNode_t *a;
+  ::primitivNode_t *b;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyNodeInput(shape, data_a, 2, dev, g, &a));
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyNodeInput(shape, data_b, 2, dev, g, &b));
+  ::primitivNodeId_t inputs[2];
+  ::primitivGetNodeOperatorId(a, &inputs[0].operator_id);
+  ::primitivGetNodeValueId(a, &inputs[0].value_id);
+  ::primitivGetNodeOperatorId(b, &inputs[1].operator_id);
+  ::primitivGetNodeValueId(b, &inputs[1].value_id);
+
+  // sum(tanh(a * b + 1), 0) and concat(a, b)
+  ::primitivOperatorRecord_t records[5] = {};
+  records[0].opcode = PRIMITIV_C_OP_MULTIPLY;
+  records[0].args[0] = 0;
+  records[0].args[1] = 1;
+  records[1].opcode = PRIMITIV_C_OP_ADD_XC;
+  records[1].args[0] = 2;
+  records[1].fattr = 1;
+  records[2].opcode = PRIMITIV_C_OP_TANH;
+  records[2].args[0] = 3;
+  records[3].opcode = PRIMITIV_C_OP_SUM;
+  records[3].args[0] = 4;
+  records[3].iattrs[0] = 0;
+  records[4].opcode = PRIMITIV_C_OP_CONCAT;
+  records[4].args[0] = 0;
+  records[4].args[1] = 1;
+  records[4].iattrs[0] = 0;
+  ::primitivNodeId_t ids[5];
+  std::uint32_t num_ops;
+  ::primitivGetGraphNumOperators(g, &num_ops);
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyNodeRecords(g, inputs, 2, records, 5, ids));
+  std::uint32_t num_ops2;
+  ::primitivGetGraphNumOperators(g, &num_ops2);
+  EXPECT_EQ(num_ops + 5, num_ops2);
+
+  ::primitivNode_t *y;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetNodeFromGraph(
+        g, ids[3].operator_id, ids[3].value_id, &y));
+  float value;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivEvaluateNodeAsFloat(y, &value));
+  EXPECT_FLOAT_EQ(std::tanh(4.f) + std::tanh(9.f), value);
+  ::primitivDeleteNode(y);
+
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetNodeFromGraph(
+        g, ids[4].operator_id, ids[4].value_id, &y));
+  float values[4];
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCopyNodeToArray(y, values, 4));
+  float expected[] = {1, 2, 3, 4};
+  EXPECT_TRUE(array_match(expected, values, 4));
+  ::primitivDeleteNode(y);
+
+  // Results can be used as inputs of another call.
+  ::primitivOperatorRecord_t neg = {};
+  neg.opcode = PRIMITIV_C_OP_NEGATIVE;
+  ::primitivNodeId_t neg_id;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyNodeRecords(g, &ids[3], 1, &neg, 1, &neg_id));
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetNodeFromGraph(
+        g, neg_id.operator_id, neg_id.value_id, &y));
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivEvaluateNodeAsFloat(y, &value));
+  EXPECT_FLOAT_EQ(-std::tanh(4.f) - std::tanh(9.f), value);
+  ::primitivDeleteNode(y);
+
+  // Errors.
+  ::primitivOperatorRecord_t invalid = {};
+  invalid.opcode = PRIMITIV_C_OP_NEGATIVE;
+  invalid.args[0] = 1;
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivApplyNodeRecords(g, inputs, 1, &invalid, 1, &neg_id));
+  invalid.opcode = 0xffffffffu;
+  invalid.args[0] = 0;
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivApplyNodeRecords(g, inputs, 1, &invalid, 1, &neg_id));
+  invalid.opcode = PRIMITIV_C_OP_MATMUL;
+  invalid.args[1] = 1;
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivApplyNodeRecords(g, inputs, 2, &invalid, 1, &neg_id));
+  ::primitivNodeId_t unknown = {num_ops2 + 1, 0};
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivApplyNodeRecords(g, &unknown, 1, &neg, 1, &neg_id));
+
+  // pick(reshape(batch::concat(a, b), {1, 2}), {1}, 1)
+  ::primitivOperatorRecord_t ops[3] = {};
+  ops[0].opcode = PRIMITIV_C_OP_BATCH_CONCAT;
+  ops[0].args[0] = 0;
+  ops[0].args[1] = 1;
+  ops[1].opcode = PRIMITIV_C_OP_RESHAPE;
+  ops[1].args[0] = 2;
+  ops[1].iattrs[0] = 1;
+  ops[1].iattrs[1] = 2;
+  ops[1].iattrs[2] = 1;
+  ops[2].opcode = PRIMITIV_C_OP_PICK;
+  ops[2].args[0] = 3;
+  ops[2].iattrs[0] = 1;
+  ops[2].iattrs[1] = 1;
+  ::primitivNodeId_t op_ids[3];
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyNodeRecords(g, inputs, 2, ops, 3, op_ids));
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetNodeFromGraph(
+        g, op_ids[2].operator_id, op_ids[2].value_id, &y));
+  float picked[2];
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCopyNodeToArray(y, picked, 2));
+  float expected_picked[] = {2, 4};
+  EXPECT_TRUE(array_match(expected_picked, picked, 2));
+  ::primitivDeleteNode(y);
+
+  ::primitivDeleteNode(b);
+  ::primitivDeleteNode(a);
+  ::primitivDeleteShape(shape);
+  ::primitivDeleteGraph(g);
+}
+
 }  // namespace c
 }  // namespace primitiv
@@ -64,5 +64,88 @@ TEST_F(CNodeTest, CheckCopy) {
   ::primitivDeleteNode(b);
 }
 
+namespace {
+
+void release_counter(float *, void *user_data) {
+  ++*static_cast<int *>(user_data);
+}
+
+}  // namespace
+
+TEST_F(CNodeTest, CheckSharedInput) {
+  std::vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  const uint32_t dims[] = {2, 2};
+  ::primitivShape_t *shape;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivCreateShapeWithDims(dims, 2, 3, &shape));
+  int released = 0;
+  ::primitivNode_t *a;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyNodeSharedInput(
+              shape, data.data(), 12, release_counter, &released,
+              nullptr, nullptr, &a));
+  EXPECT_EQ(0, released);
+
+  std::vector<float> values(12);
+  std::size_t size = values.size();
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivEvaluateNodeAsArray(a, values.data(), &size));
+  EXPECT_TRUE(test_utils::vector_match(data, values));
+
+  ::primitivDeleteNode(a);
+  EXPECT_EQ(0, released);
+  ::primitivClearGraph(g);
+  EXPECT_EQ(1, released);
+
+  // The callback is called also when the function fails.
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivApplyNodeSharedInput(
+              shape, data.data(), 11, release_counter, &released,
+              nullptr, nullptr, &a));
+  EXPECT_EQ(2, released);
+
+  ::primitivTensor_t *t;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyTensorSharedInput(
+              shape, data.data(), 12, release_counter, &released,
+              nullptr, &t));
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivEvaluateTensorAsArray(t, values.data(), &size));
+  EXPECT_TRUE(test_utils::vector_match(data, values));
+  EXPECT_EQ(2, released);
+  ::primitivDeleteTensor(t);
+  EXPECT_EQ(3, released);
+
+  ::primitivDeleteShape(shape);
+}
+
+TEST_F(CNodeTest, CheckGetData) {
+  const std::vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  const uint32_t dims[] = {2, 2};
+  ::primitivShape_t *shape;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivCreateShapeWithDims(dims, 2, 3, &shape));
+  ::primitivNode_t *a;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyNodeInput(
+              shape, data.data(), 12, nullptr, nullptr, &a));
+
+  const float *ptr;
+  std::size_t size;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetNodeData(a, &ptr, &size));
+  EXPECT_EQ(12u, size);
+  EXPECT_TRUE(test_utils::vector_match(data, std::vector<float>(ptr, ptr + size)));
+
+  std::vector<float> values(12);
+  EXPECT_EQ(PRIMITIV_C_OK,
+            ::primitivCopyNodeToArray(a, values.data(), values.size()));
+  EXPECT_TRUE(test_utils::vector_match(data, values));
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivCopyNodeToArray(a, values.data(), 11));
+
+  ::primitivDeleteNode(a);
+  ::primitivDeleteShape(shape);
+}
+
 }  // namespace c
 }  // namespace primitiv
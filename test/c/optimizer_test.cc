@@ -5,6 +5,7 @@
 #include <primitiv/c/devices/naive/device.h>
 #include <primitiv/c/parameter.h>
 #include <primitiv/c/optimizer_impl.h>
+#include <primitiv/c/shape.h>
 #include <primitiv/c/status.h>
 
 namespace primitiv {
@@ -144,6 +145,39 @@ TEST_F(COptimizerTest, CheckAddModelWithMultipleModels) {
   ::primitivDeleteParameter(param3);
 }
 
+TEST_F(COptimizerTest, CheckAddFrozenParameter) {
+  ::primitivResetStatus();
+  ::primitivSetDefaultDevice(dev);
+  ::primitivOptimizer_t *optimizer;
+  ::primitivCreateSgdOptimizer(0.1, &optimizer);
+  uint32_t dims[] = {2};
+  ::primitivShape_t *shape;
+  ::primitivCreateShapeWithDims(dims, 1, 1, &shape);
+  const float values[] = {1, 2};
+  ::primitivParameter_t *param;
+  ::primitivCreateParameterWithValues(shape, values, 2, nullptr, &param);
+
+  PRIMITIV_C_BOOL frozen;
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivIsFrozenParameter(param, &frozen));
+  EXPECT_FALSE(frozen);
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivFreezeParameter(param));
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivIsFrozenParameter(param, &frozen));
+  EXPECT_TRUE(frozen);
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+      ::primitivAddParameterToOptimizer(optimizer, param));
+  ::primitivResetStatus();
+
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivUnfreezeParameter(param));
+  EXPECT_EQ(PRIMITIV_C_OK, ::primitivIsFrozenParameter(param, &frozen));
+  EXPECT_FALSE(frozen);
+  EXPECT_EQ(PRIMITIV_C_OK,
+      ::primitivAddParameterToOptimizer(optimizer, param));
+
+  ::primitivDeleteOptimizer(optimizer);
+  ::primitivDeleteParameter(param);
+  ::primitivDeleteShape(shape);
+}
+
 TEST_F(COptimizerTest, CheckConfigs) {
   ::primitivResetStatus();
   ::primitivSetDefaultDevice(dev);
@@ -0,0 +1,143 @@
+#include <primitiv/config.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <primitiv/c/devices/naive/device.h>
+#include <primitiv/c/functions.h>
+#include <primitiv/c/status.h>
+#include <primitiv/c/tensor.h>
+
+#include <test_utils.h>
+
+using std::vector;
+using test_utils::vector_match;
+
+namespace primitiv {
+namespace c {
+
+class CTensorTest : public testing::Test {
+  void SetUp() override {
+    ::primitivCreateNaiveDevice(&dev);
+    ::primitivSetDefaultDevice(dev);
+  }
+  void TearDown() override {
+    ::primitivDeleteDevice(dev);
+  }
+ protected:
+  ::primitivDevice_t *dev;
+};
+
+TEST_F(CTensorTest, CheckCopyToArray) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  const uint32_t dims[] = {2, 2};
+  ::primitivShape_t *shape;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivCreateShapeWithDims(dims, 2, 3, &shape));
+  ::primitivTensor_t *x;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyTensorInput(shape, data.data(), 12, nullptr, &x));
+
+  vector<float> values(13, -1);
+  EXPECT_EQ(PRIMITIV_C_OK,
+            ::primitivCopyTensorToArray(x, values.data(), values.size()));
+  vector<float> expected = data;
+  expected.emplace_back(-1);
+  EXPECT_TRUE(vector_match(expected, values));
+
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivCopyTensorToArray(x, values.data(), 11));
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivCopyTensorToArray(x, nullptr, 12));
+
+  ::primitivDeleteTensor(x);
+  ::primitivDeleteShape(shape);
+}
+
+TEST_F(CTensorTest, CheckGetData) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  const uint32_t dims[] = {2, 2};
+  ::primitivShape_t *shape;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivCreateShapeWithDims(dims, 2, 3, &shape));
+  ::primitivTensor_t *x;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyTensorInput(shape, data.data(), 12, nullptr, &x));
+  ::primitivTensor_t *y;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivCloneTensor(x, &y));
+
+  const float *ptr;
+  std::size_t size;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetTensorData(x, &ptr, &size));
+  EXPECT_EQ(12u, size);
+  EXPECT_TRUE(vector_match(data, vector<float>(ptr, ptr + size)));
+
+  // Writing into `x` does not affect `y`.
+  float *mutable_ptr;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivGetTensorMutableData(x, &mutable_ptr, &size));
+  EXPECT_EQ(12u, size);
+  mutable_ptr[0] = 42;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetTensorData(x, &ptr, &size));
+  EXPECT_FLOAT_EQ(42, ptr[0]);
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetTensorData(y, &ptr, &size));
+  EXPECT_FLOAT_EQ(1, ptr[0]);
+
+  ::primitivTensor_t *invalid;
+  ::primitivCreateTensor(&invalid);
+  EXPECT_EQ(PRIMITIV_C_ERROR, ::primitivGetTensorData(invalid, &ptr, &size));
+
+  ::primitivDeleteTensor(invalid);
+  ::primitivDeleteTensor(y);
+  ::primitivDeleteTensor(x);
+  ::primitivDeleteShape(shape);
+}
+
+TEST_F(CTensorTest, CheckDLPack) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  const uint32_t dims[] = {2, 3};
+  ::primitivShape_t *shape;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivCreateShapeWithDims(dims, 2, 2, &shape));
+  ::primitivTensor_t *x;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivApplyTensorInput(shape, data.data(), 12, nullptr, &x));
+
+  ::primitivDLManagedTensor_t *dl;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivExportTensorToDLPack(x, &dl));
+  EXPECT_EQ(3, dl->dl_tensor.ndim);
+  EXPECT_EQ(PRIMITIV_C_DLPACK_DEVICE_CPU, dl->dl_tensor.device.device_type);
+  EXPECT_EQ(PRIMITIV_C_DLPACK_TYPE_FLOAT, dl->dl_tensor.dtype.code);
+  EXPECT_EQ(2, dl->dl_tensor.shape[0]);
+  EXPECT_EQ(3, dl->dl_tensor.shape[1]);
+  EXPECT_EQ(2, dl->dl_tensor.shape[2]);
+  const void *ptr = dl->dl_tensor.data;
+
+  // The descriptor survives the tensor.
+  ::primitivDeleteTensor(x);
+
+  ::primitivTensor_t *y;
+  ASSERT_EQ(PRIMITIV_C_OK,
+            ::primitivCreateTensorFromDLPack(
+                dl, PRIMITIV_C_TRUE, nullptr, &y));
+  const float *values;
+  std::size_t size;
+  ASSERT_EQ(PRIMITIV_C_OK, ::primitivGetTensorData(y, &values, &size));
+  EXPECT_EQ(ptr, values);
+  EXPECT_TRUE(vector_match(data, vector<float>(values, values + size)));
+
+  ::primitivTensor_t *invalid;
+  ::primitivCreateTensor(&invalid);
+  EXPECT_EQ(PRIMITIV_C_ERROR, ::primitivExportTensorToDLPack(invalid, &dl));
+  EXPECT_EQ(PRIMITIV_C_ERROR,
+            ::primitivCreateTensorFromDLPack(
+                nullptr, PRIMITIV_C_FALSE, nullptr, &y));
+
+  ::primitivDeleteTensor(invalid);
+  ::primitivDeleteTensor(y);
+  ::primitivDeleteShape(shape);
+}
+
+}  // namespace c
+}  // namespace primitiv
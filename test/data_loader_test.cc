@@ -0,0 +1,179 @@
+#include <primitiv/config.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <primitiv/core/data_loader.h>
+#include <primitiv/core/error.h>
+#include <primitiv/core/functions.h>
+#include <primitiv/devices/naive/device.h>
+
+#include <test_utils.h>
+
+using std::vector;
+using test_utils::vector_match;
+
+namespace primitiv {
+
+namespace F = functions;
+
+class DataLoaderTest : public testing::Test {
+protected:
+  devices::Naive dev;
+
+  // Lengths: {3, 1, 2, 3, 1, 2, 4}
+  const vector<vector<std::uint32_t>> corpus {
+    {1, 2, 3}, {4}, {5, 6}, {7, 8, 9}, {10}, {11, 12}, {13, 14, 15, 16},
+  };
+
+  void SetUp() override {
+    Device::set_default(dev);
+  }
+
+  // Retrieves all minibatches in one epoch.
+  vector<DataLoader::Batch> read_epoch(DataLoader &loader) {
+    vector<DataLoader::Batch> ret;
+    DataLoader::Batch batch;
+    while (loader.next(batch)) ret.emplace_back(std::move(batch));
+    return ret;
+  }
+};
+
+TEST_F(DataLoaderTest, CheckNew) {
+  DataLoader loader(corpus, 3, 2, false, 0);
+  EXPECT_EQ(7u, loader.num_sequences());
+  EXPECT_EQ(3u, loader.num_batches());
+  EXPECT_EQ(3u, loader.batch_size());
+  EXPECT_EQ(2u, loader.num_prefetch());
+}
+
+TEST_F(DataLoaderTest, CheckInvalidNew) {
+  EXPECT_THROW(DataLoader({}, 3, 2, false, 0), Error);
+  EXPECT_THROW(DataLoader({{1}, {}}, 3, 2, false, 0), Error);
+  EXPECT_THROW(DataLoader(corpus, 0, 2, false, 0), Error);
+  EXPECT_THROW(DataLoader(corpus, 3, 0, false, 0), Error);
+}
+
+TEST_F(DataLoaderTest, CheckSequential) {
+  DataLoader loader(corpus, 3, 2, false, 0);
+  const vector<vector<std::uint32_t>> expected {{1, 4, 2}, {5, 0, 3}, {6}};
+  for (std::uint32_t epoch = 0; epoch < 3; ++epoch) {
+    const vector<DataLoader::Batch> batches = read_epoch(loader);
+    ASSERT_EQ(expected.size(), batches.size());
+    for (std::uint32_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i], batches[i].indices);
+      EXPECT_TRUE(batches[i].tensors.empty());
+      const PackedSequence &seq = batches[i].sequences;
+      ASSERT_EQ(expected[i].size(), seq.num_sequences());
+      for (std::uint32_t j = 0; j < seq.num_sequences(); ++j) {
+        const std::uint32_t index = expected[i][seq.order()[j]];
+        EXPECT_EQ(corpus[index].size(), seq.lengths()[j]);
+        EXPECT_EQ(corpus[index][0], seq.ids(0)[j]);
+      }
+    }
+  }
+}
+
+TEST_F(DataLoaderTest, CheckShuffle) {
+  DataLoader loader(corpus, 2, 3, true, 12345);
+  for (std::uint32_t epoch = 0; epoch < 5; ++epoch) {
+    vector<DataLoader::Batch> batches = read_epoch(loader);
+    ASSERT_EQ(4u, batches.size());
+
+    // Every sequence appears once.
+    vector<std::uint32_t> all;
+    for (const DataLoader::Batch &b : batches) {
+      all.insert(all.end(), b.indices.begin(), b.indices.end());
+    }
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ((vector<std::uint32_t> {0, 1, 2, 3, 4, 5, 6}), all);
+
+    // Each minibatch covers a contiguous range of lengths.
+    std::sort(
+        batches.begin(), batches.end(),
+        [](const DataLoader::Batch &a, const DataLoader::Batch &b) {
+          return a.sequences.lengths().back() < b.sequences.lengths().back();
+        });
+    for (std::uint32_t i = 1; i < batches.size(); ++i) {
+      EXPECT_LE(
+          batches[i - 1].sequences.max_length(),
+          batches[i].sequences.lengths().back());
+    }
+  }
+}
+
+TEST_F(DataLoaderTest, CheckTensors) {
+  DataLoader loader(
+      corpus, 4, 2, false, 0,
+      [](const PackedSequence &seq, Device &dev) {
+        vector<Tensor> ret;
+        for (std::uint32_t t = 0; t < seq.max_length(); ++t) {
+          const vector<std::uint32_t> &ids = seq.ids(t);
+          ret.emplace_back(F::input<Tensor>(
+                Shape({}, ids.size()),
+                vector<float>(ids.begin(), ids.end()), &dev));
+        }
+        return ret;
+      });
+  const vector<DataLoader::Batch> batches = read_epoch(loader);
+  ASSERT_EQ(2u, batches.size());
+  for (const DataLoader::Batch &b : batches) {
+    const PackedSequence &seq = b.sequences;
+    ASSERT_EQ(seq.max_length(), b.tensors.size());
+    for (std::uint32_t t = 0; t < seq.max_length(); ++t) {
+      EXPECT_EQ(&dev, &b.tensors[t].device());
+      EXPECT_EQ(Shape({}, seq.batch_size(t)), b.tensors[t].shape());
+      EXPECT_TRUE(vector_match(
+            vector<float>(seq.ids(t).begin(), seq.ids(t).end()),
+            b.tensors[t].to_vector()));
+    }
+  }
+}
+
+TEST_F(DataLoaderTest, CheckError) {
+  DataLoader loader(
+      corpus, 3, 2, false, 0,
+      [](const PackedSequence &seq, Device &) {
+        if (seq.num_sequences() == 1) PRIMITIV_THROW_ERROR("error");
+        return vector<Tensor>();
+      });
+  DataLoader::Batch batch;
+  EXPECT_TRUE(loader.next(batch));
+  EXPECT_TRUE(loader.next(batch));
+  EXPECT_THROW(loader.next(batch), Error);
+  EXPECT_FALSE(loader.next(batch));
+  EXPECT_TRUE(loader.next(batch));
+  EXPECT_EQ((vector<std::uint32_t> {1, 4, 2}), batch.indices);
+}
+
+TEST_F(DataLoaderTest, CheckPrefetch) {
+  // The background thread stops after filling the queue.
+  std::atomic<std::uint32_t> count(0);
+  DataLoader loader(
+      corpus, 1, 2, false, 0,
+      [&count](const PackedSequence &, Device &) {
+        ++count;
+        return vector<Tensor>();
+      });
+  for (std::uint32_t i = 0; i < 1000 && count < 3; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // 2 minibatches in the queue and 1 minibatch waiting for a space.
+  EXPECT_EQ(3u, count);
+
+  DataLoader::Batch batch;
+  EXPECT_TRUE(loader.next(batch));
+  for (std::uint32_t i = 0; i < 1000 && count < 4; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(4u, count);
+}
+
+}  // namespace primitiv
@@ -1,5 +1,7 @@
 #include <primitiv/config.h>
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <primitiv/devices/naive/device.h>
@@ -27,4 +29,34 @@ TEST_F(DeviceTest, CheckDefault) {
   EXPECT_THROW(Device::get_default(), Error);
 }
 
+TEST_F(DeviceTest, CheckThreadDefault) {
+  devices::Naive dev1;
+  devices::Naive dev2;
+  Device::set_default(dev1);
+  Device::set_thread_default(dev2);
+  EXPECT_EQ(&dev2, &Device::get_default());
+
+  // Other threads use the global default.
+  Device *other = nullptr;
+  std::thread([&]() { other = &Device::get_default(); }).join();
+  EXPECT_EQ(&dev1, other);
+
+  // Threads can have their own defaults.
+  std::thread([&]() {
+      Device::set_thread_default(dev2);
+      other = &Device::get_default();
+  }).join();
+  EXPECT_EQ(&dev2, other);
+
+  Device::reset_thread_default();
+  EXPECT_EQ(&dev1, &Device::get_default());
+
+  {
+    devices::Naive dev3;
+    Device::set_thread_default(dev3);
+    EXPECT_EQ(&dev3, &Device::get_default());
+  }
+  EXPECT_EQ(&dev1, &Device::get_default());
+}
+
 }  // namespace primitiv
@@ -1,6 +1,7 @@
 #include <primitiv/config.h>
 
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -46,6 +47,177 @@ TEST_F(GraphTest, CheckDefault) {
   EXPECT_THROW(Graph::get_default(), Error);
 }
 
+TEST_F(GraphTest, CheckThreadDefault) {
+  Graph g1;
+  Graph g2;
+  Graph::set_default(g1);
+  Graph::set_thread_default(g2);
+  EXPECT_EQ(&g2, &Graph::get_default());
+
+  Graph *other = nullptr;
+  std::thread([&]() { other = &Graph::get_default(); }).join();
+  EXPECT_EQ(&g1, other);
+
+  Graph::reset_thread_default();
+  EXPECT_EQ(&g1, &Graph::get_default());
+}
+
+TEST_F(GraphTest, CheckConcurrentInference) {
+  Device::set_default(dev);
+
+  Parameter pw({2, 2}, {1, -2, 3, -4});
+  Parameter pb({2}, {.5, -.5});
+
+  auto run = [&](float k) {
+    const Node x = functions::input<Node>({2}, {k, -k});
+    const Node w = functions::parameter<Node>(pw);
+    const Node b = functions::parameter<Node>(pb);
+    return functions::tanh(functions::matmul(w, x) + b).to_vector();
+  };
+
+  static const std::uint32_t NUM_THREADS = 4;
+  static const std::uint32_t NUM_STEPS = 50;
+  vector<vector<float>> expected;
+  {
+    Graph g;
+    Graph::set_default(g);
+    for (std::uint32_t i = 0; i < NUM_STEPS; ++i) {
+      expected.emplace_back(run(.1 * i));
+    }
+  }
+
+  // Each thread builds its own graph on the shared parameters.
+  vector<vector<vector<float>>> results(NUM_THREADS);
+  vector<std::thread> threads;
+  for (std::uint32_t t = 0; t < NUM_THREADS; ++t) {
+    threads.emplace_back([&, t]() {
+        Graph g;
+        Graph::set_thread_default(g);
+        for (std::uint32_t i = 0; i < NUM_STEPS; ++i) {
+          results[t].emplace_back(run(.1 * i));
+          g.clear();
+        }
+        Graph::reset_thread_default();
+    });
+  }
+  for (std::thread &th : threads) th.join();
+
+  for (std::uint32_t t = 0; t < NUM_THREADS; ++t) {
+    ASSERT_EQ(NUM_STEPS, results[t].size());
+    for (std::uint32_t i = 0; i < NUM_STEPS; ++i) {
+      EXPECT_TRUE(vector_match(expected[i], results[t][i]));
+    }
+  }
+}
+
+TEST_F(GraphTest, CheckForwardBatched) {
+  Device::set_default(dev);
+
+  Parameter pw({2, 2}, {.1, -.2, .3, -.4});
+  Parameter pb({2}, {.5, -.5});
+
+  // Simple RNNs over sequences with different lengths.
+  auto build = [&]() {
+    const Node w = functions::parameter<Node>(pw);
+    const Node b = functions::parameter<Node>(pb);
+    vector<Node> ys;
+    for (std::uint32_t n = 1; n <= 3; ++n) {
+      Node h = functions::input<Node>({2}, {1.f * n, -1.f * n});
+      for (std::uint32_t t = 0; t < n; ++t) {
+        h = functions::tanh(functions::matmul(w, h) + b);
+      }
+      ys.emplace_back(functions::sum(h, 0));
+    }
+    return ys;
+  };
+
+  vector<vector<float>> expected_v;
+  vector<float> expected_w, expected_b;
+  {
+    Graph g;
+    Graph::set_default(g);
+    const vector<Node> ys = build();
+    for (const Node &y : ys) expected_v.emplace_back(y.to_vector());
+    pw.reset_gradient();
+    pb.reset_gradient();
+    (ys[0] + ys[1] + ys[2]).backward();
+    expected_w = pw.gradient().to_vector();
+    expected_b = pb.gradient().to_vector();
+  }
+
+  Graph g;
+  Graph::set_default(g);
+  const vector<Node> ys = build();
+  // 3 inputs, 3 operators for each step, and 3 sums.
+  EXPECT_EQ(15u, g.forward_batched(ys));
+  for (std::uint32_t i = 0; i < ys.size(); ++i) {
+    EXPECT_TRUE(vector_match(expected_v[i], ys[i].to_vector()));
+  }
+
+  // Already calculated nodes are not calculated again.
+  EXPECT_EQ(0u, g.forward_batched(ys));
+
+  pw.reset_gradient();
+  pb.reset_gradient();
+  (ys[0] + ys[1] + ys[2]).backward();
+  EXPECT_TRUE(vector_near(expected_w, pw.gradient().to_vector(), 1e-6));
+  EXPECT_TRUE(vector_near(expected_b, pb.gradient().to_vector(), 1e-6));
+}
+
+TEST_F(GraphTest, CheckForwardBatchedWithVariousShapes) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+
+  const Node c = functions::input<Node>({2}, {10, 20});
+  const Node x1 = functions::input<Node>(Shape({2}, 2), {1, 2, 3, 4});
+  const Node x2 = functions::input<Node>({2}, {5, 6});
+  const Node x3 = functions::input<Node>({3}, {7, 8, 9});
+  const Node x4 = functions::input<Node>(Shape({2}, 3), {1, 2, 3, 4, 5, 6});
+  const vector<Node> ys {
+    x1 + c, x2 + c, functions::exp(x3) * 0, x4 + c, x2 + x2, c + c,
+  };
+
+  // 5 inputs, `x1 + c` and `x4 + c` with the broadcasted `c`, other 3 adds,
+  // `exp` and the multiplication.
+  EXPECT_EQ(9u, g.forward_batched(ys));
+  const vector<vector<float>> expected {
+    {11, 22, 13, 24},
+    {15, 26},
+    {0, 0, 0},
+    {11, 22, 13, 24, 15, 26},
+    {10, 12},
+    {20, 40},
+  };
+  for (std::uint32_t i = 0; i < ys.size(); ++i) {
+    EXPECT_EQ(ys[i].shape().batch(), g.forward(ys[i]).shape().batch());
+    EXPECT_TRUE(vector_match(expected[i], ys[i].to_vector()));
+  }
+}
+
+TEST_F(GraphTest, CheckBackwardWithFrozenParameter) {
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+
+  Parameter pw({2, 2}, {1, -2, 3, -4});
+  Parameter pb({2}, {.5, -.5});
+  pw.freeze();
+
+  const Node x = functions::input<Node>({2}, {1, 2});
+  const Node w = functions::parameter<Node>(pw);
+  const Node b = functions::parameter<Node>(pb);
+  const Node y = functions::sum(functions::matmul(w, x) + b, 0);
+  EXPECT_TRUE(vector_match(vector<float> {-3}, y.to_vector()));
+
+  pb.reset_gradient();
+  EXPECT_NO_THROW(y.backward());
+  EXPECT_THROW(static_cast<const Parameter &>(pw).gradient(), Error);
+  EXPECT_TRUE(vector_match(
+        vector<float> {1, 1},
+        static_cast<const Parameter &>(pb).gradient().to_vector()));
+}
+
 TEST_F(GraphTest, CheckInvalidNode) {
   Node node;
   EXPECT_FALSE(node.valid());
@@ -163,6 +335,25 @@ TEST_F(GraphTest, CheckClear) {
   EXPECT_EQ(0u, g.num_operators());
 }
 
+TEST_F(GraphTest, CheckInplaceOperationOnBatchSliceAfterClear) {
+  Device::set_default(dev);
+  Parameter p({2, 2}, {1, 2, 3, 4});
+  Tensor t;
+  {
+    Graph g;
+    Graph::set_default(g);
+    t = g.forward(
+        functions::batch::slice(functions::parameter<Node>(p), 0, 1));
+    g.clear();
+  }
+  t *= 100;
+  EXPECT_TRUE(vector_match(
+        vector<float> {100, 200, 300, 400}, t.to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {1, 2, 3, 4},
+        static_cast<const Parameter &>(p).value().to_vector()));
+}
+
 TEST_F(GraphTest, CheckForwardBackward) {
   Device::set_default(dev);
 
@@ -297,6 +488,25 @@ TEST_F(GraphTest, CheckMultipleBackward) {
         vector<float> {3, 6, 9, 12}, pw.gradient().to_vector()));
 }
 
+TEST_F(GraphTest, CheckQuantizedParameter) {
+  Device::set_default(dev);
+
+  Graph g;
+  Graph::set_default(g);
+
+  Parameter pw({3, 2}, {1, -2, .5, 4, 0, -1});
+  pw.convert_value(Precision::INT8);
+  EXPECT_EQ(Precision::INT8, pw.value().precision());
+  EXPECT_TRUE(vector_near(
+        vector<float> {1, -2, .5, 4, 0, -1}, pw.value().to_vector(), .01));
+
+  const Node w = functions::parameter<Node>(pw);
+  const Node x = functions::input<Node>(Shape({2}, 2), {1, 1, 2, -1});
+  const Node y = functions::matmul(w, x);
+  EXPECT_TRUE(vector_near(
+        vector<float> {5, -2, -.5, -2, -4, 2}, y.to_vector(), .05));
+}
+
 TEST_F(GraphTest, CheckNonzeroArgs) {
   Device::set_default(dev);
 
@@ -359,6 +569,27 @@ TEST_F(GraphTest, CheckMultipleReturnValues) {
   EXPECT_THROW(functions::split(x, 0, 2), Error);
 }
 
+TEST_F(GraphTest, CheckGetNode) {
+  Device::set_default(dev);
+
+  Graph g;
+  Graph::set_default(g);
+
+  const Node x = functions::input<Node>({3}, {1, 2, 3});
+  const vector<Node> ys = functions::split(x, 0, 3);
+
+  const Node x2 = g.get_node(x.operator_id(), x.value_id());
+  EXPECT_EQ(&g, &x2.graph());
+  EXPECT_EQ(x.operator_id(), x2.operator_id());
+  EXPECT_EQ(x.value_id(), x2.value_id());
+
+  const Node y2 = g.get_node(ys[2].operator_id(), 2);
+  EXPECT_TRUE(vector_match(vector<float> {3}, y2.to_vector()));
+
+  EXPECT_THROW(g.get_node(ys[0].operator_id(), 3), Error);
+  EXPECT_THROW(g.get_node(g.num_operators(), 0), Error);
+}
+
 TEST_F(GraphTest, CheckXor) {
   Device::set_default(dev);
 
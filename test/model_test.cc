@@ -1,8 +1,12 @@
 #include <primitiv/config.h>
 
 #include <cstdio>
+#include <fstream>
+#include <future>
+#include <iterator>
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -10,6 +14,8 @@
 #include <primitiv/core/model.h>
 #include <primitiv/devices/naive/device.h>
 #include <primitiv/core/parameter.h>
+#include <primitiv/msgpack/reader.h>
+#include <primitiv/msgpack/writer.h>
 
 #include <test_utils.h>
 
@@ -331,6 +337,35 @@ TEST_F(ModelTest, CheckGetTrainableParametersWithSubmodels) {
   EXPECT_EQ(&p3, params3.at(vector<string> { "p" }));
 }
 
+TEST_F(ModelTest, CheckFreeze) {
+  Model m1, m2;
+  Parameter p1({2}, {1, 2}), p2({2}, {3, 4}), p3({2}, {5, 6});
+  m1.add("p", p1);
+  m2.add("p", p2);
+  m2.add("q", p3);
+  m1.add("sm", m2);
+
+  m2.freeze();
+  EXPECT_FALSE(p1.frozen());
+  EXPECT_TRUE(p2.frozen());
+  EXPECT_TRUE(p3.frozen());
+  EXPECT_EQ(3u, m1.get_all_parameters().size());
+  const map<vector<string>, Parameter *> params1 = m1.get_trainable_parameters();
+  EXPECT_EQ(1u, params1.size());
+  EXPECT_EQ(&p1, params1.at(vector<string> { "p" }));
+  EXPECT_TRUE(m2.get_trainable_parameters().empty());
+
+  p3.unfreeze();
+  const map<vector<string>, Parameter *> params2 = m1.get_trainable_parameters();
+  EXPECT_EQ(2u, params2.size());
+  EXPECT_EQ(&p3, params2.at(vector<string> { "sm", "q" }));
+
+  m1.freeze();
+  EXPECT_TRUE(m1.get_trainable_parameters().empty());
+  m1.unfreeze();
+  EXPECT_EQ(3u, m1.get_trainable_parameters().size());
+}
+
 TEST_F(ModelTest, CheckSaveLoad_Same) {
   const Shape shape {2, 2};
   const vector<float> values1 {1, 2, 3, 4};
@@ -561,4 +596,571 @@ TEST_F(ModelTest, CheckLoadWithoutStats) {
   }
 }
 
+TEST_F(ModelTest, CheckSaveToMappedFile) {
+  // Parameters spanning multiple pages of the mapped file.
+  const Shape shape {256, 256};
+  vector<float> values(shape.size());
+  for (std::uint32_t i = 0; i < values.size(); ++i) values[i] = i;
+  const string path = "/tmp/primitiv_ModelTest_CheckSaveToMappedFile.data";
+
+  {
+    Model m;
+    Parameter p(shape, values);
+    m.add("p", p);
+    ASSERT_NO_THROW(m.save(path));
+  }
+
+  Model m;
+  Parameter p;
+  m.add("p", p);
+  ASSERT_NO_THROW(m.load_mapped(path));
+
+  // Saving into the mapped file does not break the mapped parameter.
+  EXPECT_NO_THROW(m.save(path));
+  EXPECT_TRUE(vector_match(values, p.value().to_vector()));
+  EXPECT_NO_THROW(m.save_async(path).get());
+  EXPECT_TRUE(vector_match(values, p.value().to_vector()));
+
+  Model m2;
+  Parameter p2;
+  m2.add("p", p2);
+  EXPECT_NO_THROW(m2.load(path));
+  std::remove(path.c_str());
+  EXPECT_TRUE(vector_match(values, p2.value().to_vector()));
+}
+
+TEST_F(ModelTest, CheckSaveLoadMapped) {
+  const Shape shape {2, 2};
+  const vector<float> values1 {1, 2, 3, 4};
+  const vector<float> values2 {5, 6, 7, 8};
+  const vector<float> stats1 {10, 20, 30, 40};
+  const vector<float> stats2 {50, 60, 70, 80};
+  const string path = "/tmp/primitiv_ModelTest_CheckSaveLoadMapped.data";
+
+  {
+    Model m1, m2;
+    Parameter p1(shape, values1), p2(shape, values2);
+    p1.add_stats("a", shape);
+    p2.add_stats("bb", shape);
+    p1.stats("a").reset_by_vector(stats1);
+    p2.stats("bb").reset_by_vector(stats2);
+    m1.add("p", p1);
+    m2.add("pp", p2);
+    m1.add("sm", m2);
+
+    ASSERT_NO_THROW(m1.save(path));
+  }
+
+  {
+    Model m1, m2;
+    Parameter p1, p2;
+    m1.add("p", p1);
+    m2.add("pp", p2);
+    m1.add("sm", m2);
+
+    EXPECT_NO_THROW(m1.load_mapped(path));
+
+    ASSERT_TRUE(p1.valid());
+    ASSERT_TRUE(p2.valid());
+    EXPECT_EQ(shape, p1.shape());
+    EXPECT_EQ(shape, p2.shape());
+    EXPECT_TRUE(vector_match(values1, p1.value().to_vector()));
+    EXPECT_TRUE(vector_match(values2, p2.value().to_vector()));
+    ASSERT_TRUE(p1.has_stats("a"));
+    ASSERT_TRUE(p2.has_stats("bb"));
+    EXPECT_TRUE(vector_match(stats1, p1.stats("a").to_vector()));
+    EXPECT_TRUE(vector_match(stats2, p2.stats("bb").to_vector()));
+
+    // Updating parameters does not modify the file.
+    p1.value().reset(0);
+    p2.stats("bb").reset(0);
+    EXPECT_TRUE(vector_match(vector<float>(4, 0), p1.value().to_vector()));
+    EXPECT_TRUE(
+        vector_match(vector<float>(4, 0), p2.stats("bb").to_vector()));
+  }
+
+  {
+    Model m1, m2;
+    Parameter p1, p2;
+    m1.add("p", p1);
+    m2.add("pp", p2);
+    m1.add("sm", m2);
+
+    EXPECT_NO_THROW(m1.load(path));
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(vector_match(values1, p1.value().to_vector()));
+    EXPECT_TRUE(vector_match(stats2, p2.stats("bb").to_vector()));
+  }
+}
+
+TEST_F(ModelTest, CheckSaveAlignment) {
+  const string path = "/tmp/primitiv_ModelTest_CheckSaveAlignment.data";
+  const vector<string> names {"a", "bb", "ccc", "dddd"};
+  const vector<Shape> shapes {{}, {3}, {2, 3}, {40, 50}};
+
+  {
+    Model m;
+    vector<Parameter> params(names.size());
+    for (std::uint32_t i = 0; i < names.size(); ++i) {
+      params[i].init(shapes[i], vector<float>(shapes[i].size(), i));
+      for (std::uint32_t j = 0; j <= i; ++j) {
+        params[i].add_stats(names[j], shapes[j]);
+      }
+      m.add(names[i], params[i]);
+    }
+    ASSERT_NO_THROW(m.save(path));
+  }
+
+  // Checks the position of each data directly.
+  std::ifstream ifs(path);
+  ASSERT_TRUE(ifs.is_open());
+  msgpack::Reader reader(ifs);
+  std::uint32_t major, minor, datatype, num_params;
+  reader >> major >> minor >> datatype >> num_params;
+  EXPECT_EQ(0u, major);
+  EXPECT_EQ(2u, minor);
+  ASSERT_EQ(names.size(), num_params);
+  vector<std::uint64_t> offsets(num_params);
+  for (std::uint32_t i = 0; i < num_params; ++i) {
+    vector<string> key;
+    reader >> key >> offsets[i];
+    EXPECT_EQ(vector<string> {names[i]}, key);
+  }
+  const auto check_tensor = [&]() {
+    vector<std::uint32_t> dims;
+    std::uint32_t batch;
+    reader >> dims >> batch;
+    const std::size_t size = reader.read_binary_header();
+    EXPECT_EQ(0, ifs.tellg() % sizeof(float));
+    reader.skip(size);
+  };
+  for (std::uint32_t i = 0; i < num_params; ++i) {
+    ifs.seekg(offsets[i]);
+    string name;
+    reader >> name;
+    EXPECT_EQ(names[i], name);
+    check_tensor();
+    std::uint32_t num_stats;
+    reader >> num_stats;
+    EXPECT_EQ(i + 1, num_stats);
+    for (std::uint32_t j = 0; j < num_stats; ++j) {
+      string stats_key;
+      reader >> stats_key;
+      check_tensor();
+    }
+  }
+  ifs.close();
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckLoadVersion0_1) {
+  const Shape shape {2, 2};
+  const vector<float> values1 {1, 2, 3, 4};
+  const vector<float> values2 {5, 6, 7, 8};
+  const string path = "/tmp/primitiv_ModelTest_CheckLoadVersion0_1.data";
+
+  {
+    // Writes a file with the format v0.1 directly.
+    std::ofstream ofs(path);
+    msgpack::Writer writer(ofs);
+    writer << std::uint32_t(0) << std::uint32_t(1) << std::uint32_t(0x300);
+    writer << std::uint32_t(2);
+    for (const auto &kv : map<vector<string>, vector<float>> {
+        {{"p"}, values1}, {{"sm", "p"}, values2}}) {
+      writer << kv.first << shape.dims() << shape.batch();
+      writer << msgpack::objects::Binary(
+          sizeof(float) * kv.second.size(),
+          reinterpret_cast<const char *>(kv.second.data()));
+      writer << std::uint32_t(0);
+    }
+  }
+
+  for (const bool mapped : {false, true}) {
+    Model m1, m2;
+    Parameter p1, p2;
+    m1.add("p", p1);
+    m2.add("p", p2);
+    m1.add("sm", m2);
+
+    if (mapped) {
+      EXPECT_NO_THROW(m1.load_mapped(path));
+    } else {
+      EXPECT_NO_THROW(m1.load(path));
+    }
+
+    ASSERT_TRUE(p1.valid());
+    ASSERT_TRUE(p2.valid());
+    EXPECT_EQ(shape, p1.shape());
+    EXPECT_EQ(shape, p2.shape());
+    EXPECT_TRUE(vector_match(values1, p1.value().to_vector()));
+    EXPECT_TRUE(vector_match(values2, p2.value().to_vector()));
+  }
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckNumIOThreads) {
+  Model m;
+  EXPECT_EQ(0u, m.get_num_io_threads());
+  m.set_num_io_threads(4);
+  EXPECT_EQ(4u, m.get_num_io_threads());
+}
+
+TEST_F(ModelTest, CheckSaveLoadMultithread) {
+  const string path = "/tmp/primitiv_ModelTest_CheckSaveLoadMultithread.data";
+  const std::uint32_t num_params = 20;
+
+  {
+    Model m;
+    vector<Parameter> params(num_params);
+    for (std::uint32_t i = 0; i < num_params; ++i) {
+      params[i].init({i + 1, 3}, vector<float>(3 * (i + 1), i));
+      params[i].add_stats("s", {i + 1});
+      params[i].stats("s").reset(-1.f * i);
+      m.add("p" + std::to_string(i), params[i]);
+    }
+    m.set_num_io_threads(4);
+    ASSERT_NO_THROW(m.save(path));
+  }
+
+  for (const std::uint32_t num_threads : {1u, 4u}) {
+    Model m;
+    vector<Parameter> params(num_params);
+    for (std::uint32_t i = 0; i < num_params; ++i) {
+      m.add("p" + std::to_string(i), params[i]);
+    }
+    m.set_num_io_threads(num_threads);
+    ASSERT_NO_THROW(m.load(path));
+    for (std::uint32_t i = 0; i < num_params; ++i) {
+      ASSERT_TRUE(params[i].valid());
+      EXPECT_EQ(Shape({i + 1, 3}), params[i].shape());
+      EXPECT_TRUE(vector_match(
+            vector<float>(3 * (i + 1), i), params[i].value().to_vector()));
+      EXPECT_TRUE(vector_match(
+            vector<float>(i + 1, -1.f * i),
+            params[i].stats("s").to_vector()));
+    }
+  }
+
+  {
+    // Breaks the file.
+    std::ifstream ifs(path);
+    const string data(
+        (std::istreambuf_iterator<char>(ifs)),
+        std::istreambuf_iterator<char>());
+    ifs.close();
+    std::ofstream ofs(path);
+    ofs << data.substr(0, data.size() / 2);
+  }
+
+  {
+    Model m;
+    vector<Parameter> params(num_params);
+    for (std::uint32_t i = 0; i < num_params; ++i) {
+      m.add("p" + std::to_string(i), params[i]);
+    }
+    m.set_num_io_threads(4);
+    EXPECT_THROW(m.load(path), Error);
+  }
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckLoadSubmodel) {
+  const Shape shape {2, 2};
+  const vector<float> values1 {1, 2, 3, 4};
+  const vector<float> values2 {5, 6, 7, 8};
+  const vector<float> values3 {9, 10, 11, 12};
+  const string path = "/tmp/primitiv_ModelTest_CheckLoadSubmodel.data";
+
+  {
+    Model m1, m2, m3;
+    Parameter p1(shape, values1), p2(shape, values2), p3(shape, values3);
+    m1.add("p", p1);
+    m2.add("p", p2);
+    m3.add("p", p3);
+    m1.add("enc", m2);
+    m2.add("sub", m3);
+    ASSERT_NO_THROW(m1.save(path));
+  }
+
+  {
+    Model m2, m3;
+    Parameter p2, p3;
+    m2.add("p", p2);
+    m3.add("p", p3);
+    m2.add("sub", m3);
+    EXPECT_NO_THROW(m2.load_submodel(path, {"enc"}));
+    ASSERT_TRUE(p2.valid());
+    ASSERT_TRUE(p3.valid());
+    EXPECT_TRUE(vector_match(values2, p2.value().to_vector()));
+    EXPECT_TRUE(vector_match(values3, p3.value().to_vector()));
+  }
+
+  {
+    Model m3;
+    Parameter p3;
+    m3.add("p", p3);
+    EXPECT_NO_THROW(m3.load_submodel(path, {"enc", "sub"}));
+    ASSERT_TRUE(p3.valid());
+    EXPECT_TRUE(vector_match(values3, p3.value().to_vector()));
+  }
+
+  {
+    // `enc.sub.p` is not registered.
+    Model m2;
+    Parameter p2;
+    m2.add("p", p2);
+    EXPECT_THROW(m2.load_submodel(path, {"enc"}), Error);
+  }
+
+  {
+    Model m;
+    Parameter p;
+    m.add("p", p);
+    EXPECT_THROW(m.load_submodel(path, {"dec"}), Error);
+    EXPECT_THROW(m.load_submodel(path, {"enc", "sub", "p"}), Error);
+    EXPECT_FALSE(p.valid());
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckLoadSubmodelVersion0_1) {
+  const Shape shape {2, 2};
+  const vector<float> values1 {1, 2, 3, 4};
+  const vector<float> values2 {5, 6, 7, 8};
+  const string path =
+    "/tmp/primitiv_ModelTest_CheckLoadSubmodelVersion0_1.data";
+
+  {
+    // Writes a file with the format v0.1 directly.
+    std::ofstream ofs(path);
+    msgpack::Writer writer(ofs);
+    writer << std::uint32_t(0) << std::uint32_t(1) << std::uint32_t(0x300);
+    writer << std::uint32_t(2);
+    for (const auto &kv : map<vector<string>, vector<float>> {
+        {{"enc", "p"}, values1}, {{"p"}, values2}}) {
+      writer << kv.first << shape.dims() << shape.batch();
+      writer << msgpack::objects::Binary(
+          sizeof(float) * kv.second.size(),
+          reinterpret_cast<const char *>(kv.second.data()));
+      writer << std::uint32_t(1) << string("s");
+      writer << shape.dims() << shape.batch();
+      writer << msgpack::objects::Binary(
+          sizeof(float) * kv.second.size(),
+          reinterpret_cast<const char *>(kv.second.data()));
+    }
+  }
+
+  Model m;
+  Parameter p;
+  m.add("p", p);
+  EXPECT_NO_THROW(m.load_submodel(path, {"enc"}));
+  ASSERT_TRUE(p.valid());
+  EXPECT_TRUE(vector_match(values1, p.value().to_vector()));
+  EXPECT_TRUE(vector_match(values1, p.stats("s").to_vector()));
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckLoadLazy) {
+  const Shape shape {2, 2};
+  const vector<float> values1 {1, 2, 3, 4};
+  const vector<float> values2 {5, 6, 7, 8};
+  const string path = "/tmp/primitiv_ModelTest_CheckLoadLazy.data";
+
+  {
+    Model m1, m2;
+    Parameter p1(shape, values1), p2(shape, values2);
+    p2.add_stats("a", {2});
+    p2.stats("a").reset_by_vector({-1, -2});
+    m1.add("p", p1);
+    m2.add("p", p2);
+    m1.add("sm", m2);
+    ASSERT_NO_THROW(m1.save(path));
+  }
+
+  Model m1, m2;
+  Parameter p1, p2;
+  m1.add("p", p1);
+  m2.add("p", p2);
+  m1.add("sm", m2);
+  EXPECT_FALSE(p1.pending());
+  EXPECT_NO_THROW(m1.load_lazy(path));
+
+  EXPECT_TRUE(p1.valid());
+  EXPECT_TRUE(p2.valid());
+  EXPECT_TRUE(p1.pending());
+  EXPECT_TRUE(p2.pending());
+
+  EXPECT_EQ(shape, p1.shape());
+  EXPECT_FALSE(p1.pending());
+  EXPECT_TRUE(p2.pending());
+  EXPECT_TRUE(vector_match(values1, p1.value().to_vector()));
+
+  EXPECT_TRUE(p2.has_stats("a"));
+  EXPECT_FALSE(p2.pending());
+  EXPECT_TRUE(vector_match(values2, p2.value().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {-1, -2}, p2.stats("a").to_vector()));
+
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckLoadLazyConcurrently) {
+  const Shape shape {256};
+  vector<float> values(256);
+  for (std::uint32_t i = 0; i < 256; ++i) values[i] = i;
+  const string path = "/tmp/primitiv_ModelTest_CheckLoadLazyConcurrently.data";
+
+  {
+    Model m;
+    Parameter p(shape, values);
+    m.add("p", p);
+    ASSERT_NO_THROW(m.save(path));
+  }
+
+  Model m;
+  Parameter p;
+  m.add("p", p);
+  ASSERT_NO_THROW(m.load_lazy(path));
+  ASSERT_TRUE(p.pending());
+
+  // The first accesses from multiple threads load the data only once.
+  static const std::uint32_t NUM_THREADS = 8;
+  vector<const Tensor *> tensors(NUM_THREADS, nullptr);
+  vector<vector<float>> results(NUM_THREADS);
+  vector<std::thread> threads;
+  for (std::uint32_t t = 0; t < NUM_THREADS; ++t) {
+    threads.emplace_back([&, t]() {
+        const Parameter &cp = p;
+        tensors[t] = &cp.value();
+        results[t] = cp.value().to_vector();
+    });
+  }
+  for (std::thread &th : threads) th.join();
+
+  EXPECT_FALSE(p.pending());
+  for (std::uint32_t t = 0; t < NUM_THREADS; ++t) {
+    EXPECT_EQ(&p.value(), tensors[t]);
+    EXPECT_TRUE(vector_match(values, results[t]));
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckLoadLazyMissingFile) {
+  const Shape shape {2, 2};
+  const vector<float> values {1, 2, 3, 4};
+  const string path = "/tmp/primitiv_ModelTest_CheckLoadLazyMissingFile.data";
+
+  {
+    Model m;
+    Parameter p(shape, values);
+    m.add("p", p);
+    ASSERT_NO_THROW(m.save(path));
+  }
+
+  Model m;
+  Parameter p;
+  m.add("p", p);
+  EXPECT_NO_THROW(m.load_lazy(path));
+  std::remove(path.c_str());
+
+  EXPECT_TRUE(p.pending());
+  EXPECT_THROW(p.value(), Error);
+  EXPECT_TRUE(p.pending());
+
+  // Initialization discards the pending data.
+  p.init(shape, values);
+  EXPECT_FALSE(p.pending());
+  EXPECT_TRUE(vector_match(values, p.value().to_vector()));
+}
+
+TEST_F(ModelTest, CheckSaveLazy) {
+  const Shape shape {2, 2};
+  const vector<float> values {1, 2, 3, 4};
+  const string path1 = "/tmp/primitiv_ModelTest_CheckSaveLazy1.data";
+  const string path2 = "/tmp/primitiv_ModelTest_CheckSaveLazy2.data";
+
+  {
+    Model m;
+    Parameter p(shape, values);
+    m.add("p", p);
+    ASSERT_NO_THROW(m.save(path1));
+  }
+
+  {
+    Model m;
+    Parameter p;
+    m.add("p", p);
+    ASSERT_NO_THROW(m.load_lazy(path1));
+    ASSERT_TRUE(p.pending());
+    EXPECT_NO_THROW(m.save(path2));
+    EXPECT_FALSE(p.pending());
+  }
+
+  Model m;
+  Parameter p;
+  m.add("p", p);
+  ASSERT_NO_THROW(m.load(path2));
+  EXPECT_TRUE(vector_match(values, p.value().to_vector()));
+
+  std::remove(path1.c_str());
+  std::remove(path2.c_str());
+}
+
+TEST_F(ModelTest, CheckSaveAsync) {
+  const Shape shape {2, 2};
+  const vector<float> values {1, 2, 3, 4};
+  const string path = "/tmp/primitiv_ModelTest_CheckSaveAsync.data";
+
+  Model m1;
+  Parameter p1(shape, values);
+  p1.add_stats("a", shape);
+  p1.stats("a").reset(5);
+  m1.add("p", p1);
+  std::future<void> future = m1.save_async(path);
+
+  // Updates after taking the snapshot do not affect the file.
+  p1.value().reset(-1);
+  p1.stats("a").reset(-1);
+  ASSERT_NO_THROW(future.get());
+
+  Model m2;
+  Parameter p2;
+  m2.add("p", p2);
+  ASSERT_NO_THROW(m2.load(path));
+  EXPECT_TRUE(vector_match(values, p2.value().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float>(4, 5), p2.stats("a").to_vector()));
+  EXPECT_TRUE(vector_match(vector<float>(4, -1), p1.value().to_vector()));
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckSaveAsyncWithoutStats) {
+  const Shape shape {2, 2};
+  const vector<float> values {1, 2, 3, 4};
+  const string path = "/tmp/primitiv_ModelTest_CheckSaveAsyncWithoutStats.data";
+
+  Model m1;
+  Parameter p1(shape, values);
+  p1.add_stats("a", shape);
+  m1.add("p", p1);
+  ASSERT_NO_THROW(m1.save_async(path, false).get());
+
+  Model m2;
+  Parameter p2;
+  m2.add("p", p2);
+  ASSERT_NO_THROW(m2.load(path));
+  EXPECT_TRUE(vector_match(values, p2.value().to_vector()));
+  EXPECT_FALSE(p2.has_stats("a"));
+  std::remove(path.c_str());
+}
+
+TEST_F(ModelTest, CheckSaveAsyncInvalidPath) {
+  Model m;
+  Parameter p({2}, {1, 2});
+  m.add("p", p);
+  std::future<void> future = m.save_async("/nonexistent/primitiv.data");
+  EXPECT_THROW(future.get(), Error);
+}
+
 }  // namespace primitiv
@@ -389,6 +389,19 @@ TEST_F(ReaderTest, CheckBinary_0x10000) {
   EXPECT_EQ(expected, string(data, size));
 }
 
+TEST_F(ReaderTest, CheckBinaryHeader) {
+  prepare_str({ 0xc5, 0x00, 0x04 }, "abcd");
+  EXPECT_EQ(4u, reader->read_binary_header());
+  EXPECT_EQ(3, ss->tellg());
+  EXPECT_NO_THROW(reader->skip(4));
+  EXPECT_NO_THROW(*reader >> nullptr);  // Sentinel
+}
+
+TEST_F(ReaderTest, CheckInvalidBinaryHeader) {
+  prepare({ 0xa0 });
+  EXPECT_THROW(reader->read_binary_header(), Error);
+}
+
 TEST_F(ReaderTest, CheckExtension_0) {
   prepare({ 0xc7, 0x00, 'X' });
   objects::Extension x;
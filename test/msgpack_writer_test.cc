@@ -154,6 +154,26 @@ TEST_F(WriterTest, CheckString_0x10000) {
   match_str({ 0xdb, 0x00, 0x01, 0x00, 0x00 }, data);
 }
 
+TEST_F(WriterTest, CheckStringWithHeaderSize) {
+  writer.write_string("x", 1);
+  writer.write_string("x", 2);
+  writer.write_string("x", 3);
+  writer.write_string("x", 5);
+  match_str(
+      { 0xa1, 'x', 0xd9, 0x01, 'x', 0xda, 0x00, 0x01, 'x',
+        0xdb, 0x00, 0x00, 0x00, 0x01 }, "x");
+  EXPECT_EQ(15, writer.position());
+}
+
+TEST_F(WriterTest, CheckStringWithInvalidHeaderSize) {
+  EXPECT_THROW(writer.write_string("x", 0), Error);
+  EXPECT_THROW(writer.write_string("x", 4), Error);
+  EXPECT_THROW(writer.write_string(string(32, 'a'), 1), Error);
+  EXPECT_THROW(writer.write_string(string(0x100, 'a'), 2), Error);
+  EXPECT_THROW(writer.write_string(string(0x10000, 'a'), 3), Error);
+  match({});
+}
+
 TEST_F(WriterTest, CheckBinary_0) {
   writer << objects::Binary(0, "");
   match({ 0xc4, 0x00 });
@@ -188,6 +208,14 @@ TEST_F(WriterTest, CheckBinary_0x10000) {
   match_str({ 0xc6, 0x00, 0x01, 0x00, 0x00 }, data);
 }
 
+TEST_F(WriterTest, CheckBinaryHeaderAndBytes) {
+  writer.write_binary_header(3);
+  writer.write_bytes("ab", 2);
+  writer.write_bytes("c", 1);
+  writer.write_binary_header(0x100);
+  match_str({ 0xc4, 0x03, 'a', 'b', 'c', 0xc5, 0x01 }, string(1, 0x00));
+}
+
 TEST_F(WriterTest, CheckExtension_0) {
   writer << objects::Extension('X', 0, "");
   match({ 0xc7, 0x00, 'X' });
@@ -242,6 +270,22 @@ TEST_F(WriterTest, CheckExtension_0x10000) {
   match_str({ 0xc9, 0x00, 0x01, 0x00, 0x00, 'D' }, data);
 }
 
+TEST_F(WriterTest, CheckArrayHeader) {
+  writer.write_array_header(15, 1);
+  writer.write_array_header(15, 3);
+  writer.write_array_header(15, 5);
+  match({ 0x9f, 0xdc, 0x00, 0x0f, 0xdd, 0x00, 0x00, 0x00, 0x0f });
+  EXPECT_EQ(9, writer.position());
+}
+
+TEST_F(WriterTest, CheckInvalidArrayHeader) {
+  EXPECT_THROW(writer.write_array_header(0, 0), Error);
+  EXPECT_THROW(writer.write_array_header(0, 2), Error);
+  EXPECT_THROW(writer.write_array_header(16, 1), Error);
+  EXPECT_THROW(writer.write_array_header(0x10000, 3), Error);
+  match({});
+}
+
 TEST_F(WriterTest, CheckVector_Nil_0) {
   vector<std::nullptr_t> vec;
   writer << vec;
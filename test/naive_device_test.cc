@@ -93,6 +93,14 @@ TEST_F(NaiveDeviceTest, CheckRandomBernoulliWithSeed) {
   EXPECT_TRUE(vector_match(expected, x.to_vector()));
 }
 
+TEST_F(NaiveDeviceTest, CheckRandomSeedWithSeed) {
+  devices::Naive dev1(12345);
+  devices::Naive dev2(12345);
+  for (std::uint32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(dev1.random_seed(), dev2.random_seed());
+  }
+}
+
 #ifdef PRIMITIV_BUILD_TESTS_PROBABILISTIC
 TEST_F(NaiveDeviceTest, CheckRandomUniform) {
   vector<vector<float>> history;
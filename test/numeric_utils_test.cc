@@ -1,5 +1,6 @@
 #include <primitiv/config.h>
 
+#include <cmath>
 #include <cstdint>
 
 #include <vector>
@@ -31,5 +32,105 @@ TEST_F(NumericUtilsTest, CheckCalculateShifts) {
   EXPECT_EQ(64ull, calculate_shifts(0xffffffffffffffffull));
 }
 
+TEST_F(NumericUtilsTest, CheckHalfConversion) {
+  struct TestCase { float x; std::uint16_t h; float y; };
+  const std::vector<TestCase> test_cases {
+    {0, 0x0000, 0},
+    {-0.f, 0x8000, -0.f},
+    {1, 0x3c00, 1},
+    {-2, 0xc000, -2},
+    {.5, 0x3800, .5},
+    {65504, 0x7bff, 65504},
+    {65519, 0x7bff, 65504},
+    {65520, 0x7c00, INFINITY},
+    {1e10, 0x7c00, INFINITY},
+    {-INFINITY, 0xfc00, -INFINITY},
+    {1.f + 1.f / 2048, 0x3c00, 1},  // Tie to even (down).
+    {1.f + 3.f / 2048, 0x3c02, 1.f + 2.f / 1024},  // Tie to even (up).
+    {6.103515625e-5f, 0x0400, 6.103515625e-5f},  // Minimum normal.
+    {5.9604645e-8f, 0x0001, 5.9604645e-8f},  // Minimum subnormal.
+    {2.9802322e-8f, 0x0000, 0},  // Tie to even (down).
+    {8.9406967e-8f, 0x0002, 1.1920929e-7f},  // Tie to even (up).
+    {1e-10f, 0x0000, 0},
+  };
+  for (const TestCase &tc : test_cases) {
+    EXPECT_EQ(tc.h, float_to_half(tc.x));
+    EXPECT_EQ(tc.y, half_to_float(tc.h));
+  }
+  EXPECT_TRUE(std::isnan(half_to_float(float_to_half(NAN))));
+}
+
+TEST_F(NumericUtilsTest, CheckBFloat16Conversion) {
+  struct TestCase { float x; std::uint16_t h; float y; };
+  const std::vector<TestCase> test_cases {
+    {0, 0x0000, 0},
+    {-0.f, 0x8000, -0.f},
+    {1, 0x3f80, 1},
+    {-2, 0xc000, -2},
+    {1.f + 1.f / 256, 0x3f80, 1},  // Tie to even (down).
+    {1.f + 3.f / 256, 0x3f82, 1.f + 2.f / 128},  // Tie to even (up).
+    {1.f + 1.1f / 256, 0x3f81, 1.f + 1.f / 128},
+    {3.3895314e38f, 0x7f7f, 3.3895314e38f},
+    {3.4028235e38f, 0x7f80, INFINITY},
+    {INFINITY, 0x7f80, INFINITY},
+    {-INFINITY, 0xff80, -INFINITY},
+  };
+  for (const TestCase &tc : test_cases) {
+    EXPECT_EQ(tc.h, float_to_bfloat16(tc.x));
+    EXPECT_EQ(tc.y, bfloat16_to_float(tc.h));
+  }
+  EXPECT_TRUE(std::isnan(bfloat16_to_float(float_to_bfloat16(NAN))));
+}
+
+TEST_F(NumericUtilsTest, CheckPackedConversion) {
+  const std::vector<float> src {1, -2, .5, 3.140625};
+  for (Precision precision : {Precision::FLOAT16, Precision::BFLOAT16}) {
+    std::vector<std::uint16_t> packed(src.size());
+    encode_packed(src.data(), precision, src.size(), packed.data());
+    std::vector<float> dest(src.size());
+    decode_packed(packed.data(), precision, src.size(), dest.data());
+    EXPECT_EQ(src, dest);
+
+    if (precision == Precision::FLOAT16) {
+      const HalfConstPointer p(packed.data());
+      EXPECT_EQ(1, *p);
+      EXPECT_EQ(-2, p[1]);
+      EXPECT_EQ(.5, *(p + 2));
+    } else {
+      BFloat16ConstPointer p(packed.data());
+      EXPECT_EQ(1, *p++);
+      EXPECT_EQ(-2, *p);
+      p += 2;
+      EXPECT_EQ(3.140625, *p);
+    }
+  }
+}
+
+TEST_F(NumericUtilsTest, CheckQuantizeInt8) {
+  // 2x3 matrices with 2 minibatches.
+  const std::vector<float> src {
+    1, -.5, -2, .25, 3, 0,
+    0, 0, 0, 1e-3, 0, -1e-3,
+  };
+  std::vector<float> scales(4);
+  std::vector<std::int8_t> q(12);
+  quantize_int8(src.data(), 2, 3, 2, scales.data(), q.data());
+  EXPECT_FLOAT_EQ(3.f / 127, scales[0]);
+  EXPECT_FLOAT_EQ(.5f / 127, scales[1]);
+  EXPECT_EQ(0, scales[2]);
+  EXPECT_FLOAT_EQ(1e-3f / 127, scales[3]);
+  EXPECT_EQ(127, q[4]);
+  EXPECT_EQ(-127, q[1]);
+  EXPECT_EQ(127, q[9]);
+  EXPECT_EQ(-127, q[11]);
+
+  std::vector<float> dest(12);
+  dequantize_int8(scales.data(), q.data(), 2, 3, 2, dest.data());
+  for (std::uint32_t i = 0; i < 12; ++i) {
+    const float scale = scales[(i / 6) * 2 + i % 2];
+    EXPECT_NEAR(src[i], dest[i], scale / 2 + 1e-9);
+  }
+}
+
 }  // namespace numeric_utils
 }  // namespace primitiv
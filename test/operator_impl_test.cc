@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -231,6 +232,32 @@ TEST_F(OperatorImplTest, CheckInput) {
   EXPECT_TRUE(vector_match(ret_data, cur_value.to_vector()));
 }
 
+TEST_F(OperatorImplTest, CheckSharedInput) {
+  const Shape ret_shape({2, 2}, 3);
+  vector<float> ret_data {1, 2, 3, 4, 0, 0, 0, 0, -1, -2, -3, -4};
+  const vector<float> expected = ret_data;
+  bool released = false;
+  {
+    Input node(
+        ret_shape,
+        std::shared_ptr<float>(
+          ret_data.data(), [&released](float *) { released = true; }),
+        *dev);
+    Shape cur_shape;
+    Tensor cur_value;
+    node.forward_shape(arg_shapes, { &cur_shape });
+    node.forward(arg_values, { &cur_value });
+    EXPECT_EQ(ret_shape, cur_shape);
+    EXPECT_TRUE(vector_match(expected, cur_value.to_vector()));
+
+    // In-place operations do not modify the external array.
+    cur_value.reset(0);
+    EXPECT_TRUE(vector_match(expected, ret_data));
+    EXPECT_FALSE(released);
+  }
+  EXPECT_TRUE(released);
+}
+
 TEST_F(OperatorImplTest, CheckParameter) {
   const Shape ret_shape {2, 2};
   const initializers::Constant init(42);
@@ -257,6 +284,30 @@ TEST_F(OperatorImplTest, CheckParameter) {
   EXPECT_EQ(&param.value(), cur_value);
 }
 
+TEST_F(OperatorImplTest, CheckParameterPick) {
+  const Shape ret_shape({2}, 2);
+  primitiv::Parameter param({2, 3}, {1, 2, 3, 4, 5, 6}, *dev);
+
+  ParameterPick node(param, {2, 0}, 1);
+  Shape cur_shape;
+  Tensor cur_value;
+  node.forward_shape(arg_shapes, { &cur_shape });
+  node.forward(arg_values, { &cur_value });
+  const Tensor cur_grad = dev->new_tensor_by_vector(ret_shape, {1, 2, 3, 4});
+  // backward() adds a row-sparse gradient to `param`.
+  EXPECT_NO_THROW(node.backward(
+        arg_values, { &cur_value }, { &cur_grad }, arg_grads));
+  EXPECT_EQ("ParameterPick(1)", node.name());
+  EXPECT_EQ(ret_shape, cur_shape);
+  EXPECT_EQ(dev, node.get_device());
+  EXPECT_TRUE(vector_match(vector<float> {5, 6, 1, 2}, cur_value.to_vector()));
+  ASSERT_TRUE(param.has_sparse_gradient());
+  EXPECT_EQ(1u, param.sparse_gradient_dim());
+  EXPECT_EQ(vector<std::uint32_t>({0, 2}), param.sparse_gradient_ids());
+  EXPECT_TRUE(vector_match(
+        vector<float> {3, 4, 0, 0, 1, 2}, param.gradient().to_vector()));
+}
+
 TEST_F(OperatorImplTest, CheckCopy) {
   devices::Naive dev2;
   const Shape ret_shape({2, 2}, 3);
@@ -1379,6 +1430,31 @@ TEST_F(OperatorImplTest, CheckELU) {
   TEST_1ARG_K_NEAR(ELU, 1, 1e-6);
 }
 
+TEST_F(OperatorImplTest, CheckDropout) {
+  // y = mask * x / (1 - rate)
+  // dy/dx = mask / (1 - rate)
+  setup_1arg();
+  Dropout node(.5);
+  EXPECT_EQ("Dropout(" + std::to_string(.5f) + ')', node.name());
+  Shape cur_shape;
+  Tensor cur_value;
+  node.forward_shape(arg_shapes, { &cur_shape });
+  node.forward(arg_values, { &cur_value });
+  const Tensor cur_grad = functions::ones<Tensor>(cur_shape, *dev);
+  reset_gradients();
+  node.backward(arg_values, { &cur_value }, { &cur_grad }, arg_grads);
+  EXPECT_EQ(Shape({2, 2}, 3), cur_shape);
+  EXPECT_EQ(nullptr, node.get_device());
+  const vector<float> x_val = arg_values[0]->to_vector();
+  const vector<float> y_val = cur_value.to_vector();
+  const vector<float> gx_val = arg_grads[0]->to_vector();
+  for (std::uint32_t i = 0; i < x_val.size(); ++i) {
+    // Backward must reproduce the mask used in forward.
+    EXPECT_TRUE(gx_val[i] == 0 || gx_val[i] == 2);
+    EXPECT_FLOAT_EQ(gx_val[i] * x_val[i], y_val[i]);
+  }
+}
+
 TEST_F(OperatorImplTest, CheckFlip) {
   // y = flip(x, dim)
   // dy/dx = flip(1, dim)
@@ -1616,6 +1692,8 @@ TEST_F(OperatorImplTest, CheckBatchSlice) {
     EXPECT_EQ(nullptr, node.get_device());
     EXPECT_TRUE(vector_match(tc.ret_data, cur_value.to_vector()));
     EXPECT_TRUE(vector_match(tc.bw_grad, arg_grads[0]->to_vector()));
+    // Host devices do not copy the memory.
+    EXPECT_TRUE(dev->is_view(cur_value, *arg_values[0], tc.lower * 4));
   }
 }
 
@@ -2082,5 +2160,21 @@ TEST_F(OperatorImplTest, CheckStopGradient) {
   TEST_1ARG(StopGradient);
 }
 
+TEST_F(OperatorImplTest, CheckBatchSignature) {
+  EXPECT_EQ("", Input({2}, {1, 2}, *dev).batch_signature());
+  EXPECT_EQ("", BatchSum().batch_signature());
+  EXPECT_EQ("", Dropout(.5).batch_signature());
+  EXPECT_EQ("Tanh", Tanh().batch_signature());
+  EXPECT_EQ("MatrixMultiply", MatrixMultiply().batch_signature());
+  EXPECT_EQ("Slice(0,1:2)", Slice(0, 1, 2).batch_signature());
+  EXPECT_EQ(
+      AddConst(.1f).batch_signature(), AddConst(.1f).batch_signature());
+  EXPECT_NE(
+      AddConst(.1f).batch_signature(),
+      AddConst(.1000001f).batch_signature());
+  EXPECT_NE(
+      AddConst(.1f).batch_signature(), MultiplyConst(.1f).batch_signature());
+}
+
 }  // namespace operators
 }  // namespace primitiv
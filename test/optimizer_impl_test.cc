@@ -1,6 +1,8 @@
 #include <primitiv/config.h>
 
+#include <cmath>
 #include <cstdio>
+#include <future>
 
 #include <gtest/gtest.h>
 
@@ -129,6 +131,26 @@ TEST_F(OptimizerImplTest, CheckSGDSaveLoad) {
   EXPECT_EQ(5, optimizer2.get_gradient_clipping());
 }
 
+TEST_F(OptimizerImplTest, CheckSGDSaveLoadAsync) {
+  SGD optimizer(1);
+  optimizer.set_epoch(2);
+
+  const std::string path =
+    "/tmp/primitiv_OptimizerImplTest_CheckSGDSaveLoadAsync.data";
+  std::future<void> future = optimizer.save_async(path);
+
+  // Configurations are already retrieved.
+  optimizer.set_epoch(3);
+  ASSERT_NO_THROW(future.get());
+
+  SGD optimizer2;
+  optimizer2.load(path);
+  std::remove(path.c_str());
+
+  EXPECT_EQ(1, optimizer2.eta());
+  EXPECT_EQ(2u, optimizer2.get_epoch());
+}
+
 TEST_F(OptimizerImplTest, CheckSGDGetConfigs) {
   SGD optimizer(1);
   optimizer.set_epoch(2);
@@ -140,10 +162,12 @@ TEST_F(OptimizerImplTest, CheckSGDGetConfigs) {
   std::unordered_map<std::string, float> float_configs;
   optimizer.get_configs(uint_configs, float_configs);
 
-  EXPECT_EQ(1u, uint_configs.size());
+  EXPECT_EQ(3u, uint_configs.size());
   EXPECT_EQ(4u, float_configs.size());
   EXPECT_EQ(1, float_configs.at("SGD.eta"));
   EXPECT_EQ(2u, uint_configs.at("Optimizer.epoch"));
+  EXPECT_EQ(1u, uint_configs.at("Optimizer.accum_steps"));
+  EXPECT_EQ(0u, uint_configs.at("Optimizer.accum_count"));
   EXPECT_EQ(3, float_configs.at("Optimizer.lr_scale"));
   EXPECT_EQ(4, float_configs.at("Optimizer.l2_strength"));
   EXPECT_EQ(5, float_configs.at("Optimizer.clip_threshold"));
@@ -235,11 +259,13 @@ TEST_F(OptimizerImplTest, CheckMomentumSGDGetConfigs) {
   std::unordered_map<std::string, float> float_configs;
   optimizer.get_configs(uint_configs, float_configs);
 
-  EXPECT_EQ(1u, uint_configs.size());
+  EXPECT_EQ(3u, uint_configs.size());
   EXPECT_EQ(5u, float_configs.size());
   EXPECT_EQ(1, float_configs.at("MomentumSGD.eta"));
   EXPECT_EQ(2, float_configs.at("MomentumSGD.momentum"));
   EXPECT_EQ(3u, uint_configs.at("Optimizer.epoch"));
+  EXPECT_EQ(1u, uint_configs.at("Optimizer.accum_steps"));
+  EXPECT_EQ(0u, uint_configs.at("Optimizer.accum_count"));
   EXPECT_EQ(4, float_configs.at("Optimizer.lr_scale"));
   EXPECT_EQ(5, float_configs.at("Optimizer.l2_strength"));
   EXPECT_EQ(6, float_configs.at("Optimizer.clip_threshold"));
@@ -345,11 +371,13 @@ TEST_F(OptimizerImplTest, CheckAdaGradGetConfigs) {
   std::unordered_map<std::string, float> float_configs;
   optimizer.get_configs(uint_configs, float_configs);
 
-  EXPECT_EQ(1u, uint_configs.size());
+  EXPECT_EQ(3u, uint_configs.size());
   EXPECT_EQ(5u, float_configs.size());
   EXPECT_EQ(1, float_configs.at("AdaGrad.eta"));
   EXPECT_EQ(2, float_configs.at("AdaGrad.eps"));
   EXPECT_EQ(3u, uint_configs.at("Optimizer.epoch"));
+  EXPECT_EQ(1u, uint_configs.at("Optimizer.accum_steps"));
+  EXPECT_EQ(0u, uint_configs.at("Optimizer.accum_count"));
   EXPECT_EQ(4, float_configs.at("Optimizer.lr_scale"));
   EXPECT_EQ(5, float_configs.at("Optimizer.l2_strength"));
   EXPECT_EQ(6, float_configs.at("Optimizer.clip_threshold"));
@@ -456,12 +484,14 @@ TEST_F(OptimizerImplTest, CheckRMSPropGetConfigs) {
   std::unordered_map<std::string, float> float_configs;
   optimizer.get_configs(uint_configs, float_configs);
 
-  EXPECT_EQ(1u, uint_configs.size());
+  EXPECT_EQ(3u, uint_configs.size());
   EXPECT_EQ(6u, float_configs.size());
   EXPECT_EQ(1, float_configs.at("RMSProp.eta"));
   EXPECT_EQ(2, float_configs.at("RMSProp.alpha"));
   EXPECT_EQ(3, float_configs.at("RMSProp.eps"));
   EXPECT_EQ(4u, uint_configs.at("Optimizer.epoch"));
+  EXPECT_EQ(1u, uint_configs.at("Optimizer.accum_steps"));
+  EXPECT_EQ(0u, uint_configs.at("Optimizer.accum_count"));
   EXPECT_EQ(5, float_configs.at("Optimizer.lr_scale"));
   EXPECT_EQ(6, float_configs.at("Optimizer.l2_strength"));
   EXPECT_EQ(7, float_configs.at("Optimizer.clip_threshold"));
@@ -569,11 +599,13 @@ TEST_F(OptimizerImplTest, CheckAdaDeltaGetConfigs) {
   std::unordered_map<std::string, float> float_configs;
   optimizer.get_configs(uint_configs, float_configs);
 
-  EXPECT_EQ(1u, uint_configs.size());
+  EXPECT_EQ(3u, uint_configs.size());
   EXPECT_EQ(5u, float_configs.size());
   EXPECT_EQ(1, float_configs.at("AdaDelta.rho"));
   EXPECT_EQ(2, float_configs.at("AdaDelta.eps"));
   EXPECT_EQ(3u, uint_configs.at("Optimizer.epoch"));
+  EXPECT_EQ(1u, uint_configs.at("Optimizer.accum_steps"));
+  EXPECT_EQ(0u, uint_configs.at("Optimizer.accum_count"));
   EXPECT_EQ(4, float_configs.at("Optimizer.lr_scale"));
   EXPECT_EQ(5, float_configs.at("Optimizer.l2_strength"));
   EXPECT_EQ(6, float_configs.at("Optimizer.clip_threshold"));
@@ -693,13 +725,16 @@ TEST_F(OptimizerImplTest, CheckAdamGetConfigs) {
   std::unordered_map<std::string, float> float_configs;
   optimizer.get_configs(uint_configs, float_configs);
 
-  EXPECT_EQ(1u, uint_configs.size());
+  EXPECT_EQ(4u, uint_configs.size());
   EXPECT_EQ(7u, float_configs.size());
+  EXPECT_EQ(0u, uint_configs.at("Adam.stats_precision"));
   EXPECT_EQ(1, float_configs.at("Adam.alpha"));
   EXPECT_EQ(2, float_configs.at("Adam.beta1"));
   EXPECT_EQ(3, float_configs.at("Adam.beta2"));
   EXPECT_EQ(4, float_configs.at("Adam.eps"));
   EXPECT_EQ(5u, uint_configs.at("Optimizer.epoch"));
+  EXPECT_EQ(1u, uint_configs.at("Optimizer.accum_steps"));
+  EXPECT_EQ(0u, uint_configs.at("Optimizer.accum_count"));
   EXPECT_EQ(6, float_configs.at("Optimizer.lr_scale"));
   EXPECT_EQ(7, float_configs.at("Optimizer.l2_strength"));
   EXPECT_EQ(8, float_configs.at("Optimizer.clip_threshold"));
@@ -714,6 +749,7 @@ TEST_F(OptimizerImplTest, CheckAdamSetConfigs) {
 
   std::unordered_map<std::string, std::uint32_t> uint_configs {
     std::make_pair("Optimizer.epoch", 5),
+    std::make_pair("Adam.stats_precision", 2),
   };
   std::unordered_map<std::string, float> float_configs {
     std::make_pair("Adam.alpha", 1),
@@ -730,10 +766,14 @@ TEST_F(OptimizerImplTest, CheckAdamSetConfigs) {
   EXPECT_EQ(2, optimizer.beta1());
   EXPECT_EQ(3, optimizer.beta2());
   EXPECT_EQ(4, optimizer.eps());
+  EXPECT_EQ(Precision::BFLOAT16, optimizer.get_stats_precision());
   EXPECT_EQ(5u, optimizer.get_epoch());
   EXPECT_EQ(6, optimizer.get_learning_rate_scaling());
   EXPECT_EQ(7, optimizer.get_weight_decay());
   EXPECT_EQ(8, optimizer.get_gradient_clipping());
+
+  uint_configs.at("Adam.stats_precision") = 3;
+  EXPECT_THROW(optimizer.set_configs(uint_configs, float_configs), Error);
 }
 
 TEST_F(OptimizerImplTest, CheckAdamUpdate) {
@@ -789,5 +829,95 @@ TEST_F(OptimizerImplTest, CheckAdamUpdate) {
   }
 }
 
+TEST_F(OptimizerImplTest, CheckAdamUpdateWithCompactStats) {
+  struct TestCase {
+    Precision precision;
+    float tol;
+  };
+  const vector<TestCase> test_cases {
+    {Precision::FLOAT16, 1e-4},
+    {Precision::BFLOAT16, 1e-3},
+  };
+  for (const TestCase &tc : test_cases) {
+    Parameter param({2, 2}, {1, 2, 3, 4}, dev);
+    Parameter param_ref({2, 2}, {1, 2, 3, 4}, dev);
+
+    Adam optimizer;
+    optimizer.set_learning_rate_scaling(.1);
+    optimizer.set_stats_precision(tc.precision);
+    optimizer.add(param);
+    ASSERT_TRUE(param.has_stats("Adam.m1"));
+    ASSERT_TRUE(param.has_stats("Adam.m2"));
+    EXPECT_EQ(Shape({2, 2}), param.stats("Adam.m1").shape());
+    EXPECT_EQ(Shape({2, 2}), param.stats("Adam.m2").shape());
+    EXPECT_EQ(tc.precision, param.stats("Adam.m1").precision());
+    EXPECT_EQ(Precision::BFLOAT16, param.stats("Adam.m2").precision());
+
+    Adam optimizer_ref;
+    optimizer_ref.set_learning_rate_scaling(.1);
+    optimizer_ref.add(param_ref);
+
+    for (std::uint32_t i = 0; i < 5; ++i) {
+      optimizer.reset_gradients();
+      optimizer_ref.reset_gradients();
+      param.gradient() += param.value();
+      param_ref.gradient() += param_ref.value();
+      optimizer.update();
+      optimizer_ref.update();
+      EXPECT_TRUE(vector_near(
+            param_ref.value().to_vector(), param.value().to_vector(),
+            tc.tol));
+      EXPECT_TRUE(vector_near(
+            param_ref.stats("Adam.m1").to_vector(),
+            param.stats("Adam.m1").to_vector(), 1e-2));
+      EXPECT_TRUE(vector_near(
+            param_ref.stats("Adam.m2").to_vector(),
+            param.stats("Adam.m2").to_vector(), 1e-2));
+    }
+
+    // Stats are converted to the format of the optimizer that updates them.
+    Adam optimizer2;
+    optimizer2.add(param);
+    EXPECT_EQ(Precision::FLOAT32, param.stats("Adam.m1").precision());
+    EXPECT_EQ(Precision::FLOAT32, param.stats("Adam.m2").precision());
+    optimizer.reset_gradients();
+    param.gradient() += param.value();
+    optimizer.update();
+    EXPECT_EQ(tc.precision, param.stats("Adam.m1").precision());
+    EXPECT_EQ(Precision::BFLOAT16, param.stats("Adam.m2").precision());
+  }
+}
+
+TEST_F(OptimizerImplTest, CheckAdamUpdateWithCompactStatsAndSmallGradients) {
+  // (1 - beta2) * g^2 is not representable by FLOAT16 for these gradients.
+  const vector<float> grads {1e-3, -2e-3, 5e-4, -1e-3};
+  const Tensor g = dev.new_tensor_by_vector({2, 2}, grads);
+  for (Precision precision : {Precision::FLOAT16, Precision::BFLOAT16}) {
+    Parameter param({2, 2}, {0, 0, 0, 0}, dev);
+    Parameter param_ref({2, 2}, {0, 0, 0, 0}, dev);
+    Adam optimizer, optimizer_ref;
+    optimizer.set_stats_precision(precision);
+    optimizer.add(param);
+    optimizer_ref.add(param_ref);
+
+    for (std::uint32_t i = 0; i < 50; ++i) {
+      optimizer.reset_gradients();
+      optimizer_ref.reset_gradients();
+      param.gradient() += g;
+      param_ref.gradient() += g;
+      optimizer.update();
+      optimizer_ref.update();
+    }
+
+    // Each element moves about alpha per step.
+    const vector<float> expected = param_ref.value().to_vector();
+    const vector<float> actual = param.value().to_vector();
+    for (std::uint32_t i = 0; i < grads.size(); ++i) {
+      EXPECT_NEAR(.05, std::abs(expected[i]), 1e-3);
+      EXPECT_NEAR(expected[i], actual[i], 1e-2 * std::abs(expected[i]));
+    }
+  }
+}
+
 }  // namespace optimizers
 }  // namespace primitiv
@@ -1,8 +1,16 @@
 #include <primitiv/config.h>
 
+#include <cstdio>
+#include <future>
+#include <limits>
+#include <string>
+
 #include <gtest/gtest.h>
 
+#include <primitiv/core/arithmetic.h>
 #include <primitiv/core/error.h>
+#include <primitiv/core/functions.h>
+#include <primitiv/core/graph.h>
 #include <primitiv/core/model.h>
 #include <primitiv/devices/naive/device.h>
 #include <primitiv/core/optimizer.h>
@@ -114,6 +122,53 @@ TEST_F(OptimizerTest, CheckAddModel) {
   EXPECT_TRUE(optimizer.ok());
 }
 
+TEST_F(OptimizerTest, CheckAddFrozenParameters) {
+  Device::set_default(dev);
+  TestOptimizer optimizer(1u);
+  Model m;
+  Parameter param1({2}, {1, 2});
+  Parameter param2({2}, {3, 4});
+  m.add("param1", param1);
+  m.add("param2", param2);
+  param2.freeze();
+
+  EXPECT_THROW(optimizer.add(param2), Error);
+  EXPECT_NO_THROW(optimizer.add(m));
+
+  EXPECT_NO_THROW(optimizer.update());
+
+  EXPECT_TRUE(optimizer.ok());
+}
+
+TEST_F(OptimizerTest, CheckFreezeAfterAdd) {
+  Device::set_default(dev);
+  for (const bool pack : {false, true}) {
+    optimizers::SGD optimizer(.5);
+    Parameter param1({2}, {1, 2});
+    Parameter param2({2}, {3, 4});
+    optimizer.add(param1, param2);
+    if (pack) optimizer.pack_parameters();
+    param2.freeze();
+
+    EXPECT_NO_THROW(optimizer.reset_gradients());
+    param1.gradient().reset(2);
+    EXPECT_NO_THROW(optimizer.update());
+    const Parameter &frozen = param2;
+    EXPECT_TRUE(vector_match(vector<float> {0, 1}, param1.value().to_vector()));
+    EXPECT_TRUE(vector_match(vector<float> {3, 4}, frozen.value().to_vector()));
+
+    // Unfrozen parameters are updated again.
+    param2.unfreeze();
+    optimizer.reset_gradients();
+    param1.gradient().reset(2);
+    param2.gradient().reset(2);
+    optimizer.update();
+    EXPECT_TRUE(vector_match(
+          vector<float> {-1, 0}, param1.value().to_vector()));
+    EXPECT_TRUE(vector_match(vector<float> {2, 3}, param2.value().to_vector()));
+  }
+}
+
 TEST_F(OptimizerTest, CheckAddModelWithMultipleModels) {
   Device::set_default(dev);
   TestOptimizer optimizer(3u);
@@ -333,4 +388,394 @@ TEST_F(OptimizerTest, CheckGradientClipping) {
   EXPECT_THROW(optimizer.set_gradient_clipping(-1), Error);
 }
 
+TEST_F(OptimizerTest, CheckGradientAccumulation) {
+  Device::set_default(dev);
+  optimizers::SGD optimizer(.5);
+  ASSERT_EQ(1u, optimizer.get_accumulation_steps());
+  ASSERT_EQ(0u, optimizer.get_accumulated_count());
+
+  Parameter param({2}, {1, 2});
+  optimizer.add(param);
+  optimizer.set_accumulation_steps(3);
+  EXPECT_EQ(3u, optimizer.get_accumulation_steps());
+
+  const vector<vector<float>> grads {{1, 2}, {3, 4}, {5, 0}};
+  for (std::uint32_t n = 0; n < 2; ++n) {
+    for (std::uint32_t i = 0; i < 3; ++i) {
+      optimizer.reset_gradients();
+      param.gradient() += dev.new_tensor_by_vector({2}, grads[i]);
+      optimizer.update();
+      if (i < 2) {
+        EXPECT_EQ(i + 1, optimizer.get_accumulated_count());
+        EXPECT_EQ(n, optimizer.get_epoch());
+      }
+    }
+    EXPECT_EQ(0u, optimizer.get_accumulated_count());
+    EXPECT_EQ(n + 1, optimizer.get_epoch());
+    EXPECT_TRUE(vector_match(vector<float> {3, 2}, param.gradient().to_vector()));
+  }
+  // value -= .5 * average(grads) twice.
+  EXPECT_TRUE(vector_match(vector<float> {-2, 0}, param.value().to_vector()));
+
+  EXPECT_THROW(optimizer.set_accumulation_steps(0), Error);
+
+  // The number of steps could not be changed in the middle of accumulation.
+  optimizer.reset_gradients();
+  param.gradient() += dev.new_tensor_by_vector({2}, grads[0]);
+  optimizer.update();
+  ASSERT_EQ(1u, optimizer.get_accumulated_count());
+  EXPECT_THROW(optimizer.set_accumulation_steps(1), Error);
+  EXPECT_NO_THROW(optimizer.set_accumulation_steps(3));
+  EXPECT_EQ(3u, optimizer.get_accumulation_steps());
+  EXPECT_EQ(1u, optimizer.get_accumulated_count());
+}
+
+TEST_F(OptimizerTest, CheckInvalidAccumulationConfigs) {
+  optimizers::SGD optimizer;
+  optimizer.set_accumulation_steps(3);
+  const std::unordered_map<std::string, float> float_configs;
+  const vector<std::unordered_map<std::string, std::uint32_t>> uint_configs {
+    {{"Optimizer.accum_steps", 0}},
+    {{"Optimizer.accum_steps", 2}, {"Optimizer.accum_count", 2}},
+    {{"Optimizer.accum_count", 3}},
+  };
+  for (const auto &configs : uint_configs) {
+    EXPECT_THROW(optimizer.set_configs(configs, float_configs), Error);
+    EXPECT_EQ(3u, optimizer.get_accumulation_steps());
+    EXPECT_EQ(0u, optimizer.get_accumulated_count());
+  }
+  optimizer.set_configs(
+      {{"Optimizer.accum_steps", 4}, {"Optimizer.accum_count", 3}},
+      float_configs);
+  EXPECT_EQ(4u, optimizer.get_accumulation_steps());
+  EXPECT_EQ(3u, optimizer.get_accumulated_count());
+}
+
+TEST_F(OptimizerTest, CheckUpdateOrder) {
+  /*
+   * Optimizer class which records the order of update_parameter() calls.
+   */
+  class OrderedOptimizer : public Optimizer {
+  public:
+    vector<Parameter *> updated;
+    void get_configs(
+        std::unordered_map<std::string, std::uint32_t> &,
+        std::unordered_map<std::string, float> &) const override {}
+    void set_configs(
+        const std::unordered_map<std::string, std::uint32_t> &,
+        const std::unordered_map<std::string, float> &) override {}
+  private:
+    void configure_parameter(Parameter &) override {}
+    void update_parameter(float, Parameter &param) override {
+      updated.emplace_back(&param);
+    }
+  };
+
+  Device::set_default(dev);
+  Parameter params[8];
+  OrderedOptimizer optimizer;
+  const vector<std::uint32_t> order {3, 1, 4, 0, 5, 2, 7, 6};
+  for (const std::uint32_t i : order) {
+    optimizer.add(params[i]);
+  }
+  optimizer.add(params[4]);
+
+  const vector<Parameter *> expected {
+    &params[3], &params[1], &params[4], &params[0],
+    &params[5], &params[2], &params[7], &params[6],
+  };
+  for (std::uint32_t n = 0; n < 3; ++n) {
+    optimizer.updated.clear();
+    optimizer.update();
+    EXPECT_EQ(expected, optimizer.updated);
+  }
+}
+
+TEST_F(OptimizerTest, CheckPackParameters) {
+  Device::set_default(dev);
+  const vector<Shape> shapes {{2, 2}, {3}, {}, {2, 3}};
+
+  auto init_params = [&](Parameter (&params)[4]) {
+    float k = 0;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+      vector<float> values(shapes[i].size());
+      for (float &v : values) v = k += .5;
+      params[i].init(shapes[i], values);
+    }
+  };
+  auto set_grads = [&](Parameter (&params)[4], std::uint32_t step) {
+    float k = step;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+      vector<float> grads(shapes[i].size());
+      for (float &g : grads) g = (k += 1.25) * ((i + step) % 2 ? 1 : -1);
+      params[i].gradient() += dev.new_tensor_by_vector(shapes[i], grads);
+    }
+  };
+
+  Parameter params1[4], params2[4];
+  init_params(params1);
+  init_params(params2);
+  optimizers::Adam optimizer1, optimizer2;
+  for (Optimizer *opt : vector<Optimizer *> {&optimizer1, &optimizer2}) {
+    opt->set_weight_decay(.1);
+    opt->set_gradient_clipping(2);
+  }
+  optimizer1.add(params1[0], params1[1], params1[2], params1[3]);
+  optimizer2.add(params2[0], params2[1], params2[2], params2[3]);
+
+  EXPECT_FALSE(optimizer2.packed());
+  optimizer2.pack_parameters();
+  EXPECT_TRUE(optimizer2.packed());
+  for (std::uint32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(shapes[i], params2[i].value().shape());
+    EXPECT_EQ(shapes[i], params2[i].gradient().shape());
+    EXPECT_EQ(shapes[i], params2[i].stats("Adam.m1").shape());
+    EXPECT_TRUE(vector_match(
+          params1[i].value().to_vector(), params2[i].value().to_vector()));
+  }
+
+  for (std::uint32_t step = 0; step < 5; ++step) {
+    optimizer1.reset_gradients();
+    optimizer2.reset_gradients();
+    for (std::uint32_t i = 0; i < 4; ++i) {
+      EXPECT_TRUE(vector_match(
+            vector<float>(shapes[i].size(), 0),
+            params2[i].gradient().to_vector()));
+    }
+    set_grads(params1, step);
+    set_grads(params2, step);
+    optimizer1.update();
+    optimizer2.update();
+    EXPECT_TRUE(optimizer2.packed());
+    for (std::uint32_t i = 0; i < 4; ++i) {
+      EXPECT_TRUE(vector_match(
+            params1[i].value().to_vector(), params2[i].value().to_vector()));
+      EXPECT_TRUE(vector_match(
+            params1[i].stats("Adam.m2").to_vector(),
+            params2[i].stats("Adam.m2").to_vector()));
+    }
+  }
+}
+
+TEST_F(OptimizerTest, CheckPackParametersWithLooseParameters) {
+  Device::set_default(dev);
+  optimizers::SGD optimizer(.5);
+  Parameter param1({2}, {1, 2});
+  Parameter param2({3}, {3, 4, 5});
+  optimizer.add(param1);
+  optimizer.pack_parameters();
+  optimizer.add(param2);
+  EXPECT_TRUE(optimizer.packed());
+
+  param1.gradient().reset(2);
+  param2.gradient().reset(4);
+  optimizer.update();
+  EXPECT_TRUE(vector_match(vector<float> {0, 1}, param1.value().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {1, 2, 3}, param2.value().to_vector()));
+
+  optimizer.reset_gradients();
+  EXPECT_TRUE(vector_match(vector<float> {0, 0}, param1.gradient().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {0, 0, 0}, param2.gradient().to_vector()));
+}
+
+TEST_F(OptimizerTest, CheckPackParametersFallback) {
+  Device::set_default(dev);
+  optimizers::SGD optimizer(.5);
+  Parameter param1({2}, {1, 2});
+  Parameter param2({3}, {3, 4, 5});
+  optimizer.add(param1, param2);
+  optimizer.pack_parameters();
+  ASSERT_TRUE(optimizer.packed());
+
+  // Reinitialization releases the buffers.
+  param1.init({2}, {6, 7});
+  EXPECT_FALSE(optimizer.packed());
+
+  param1.gradient().reset(2);
+  param2.gradient().reset(4);
+  optimizer.update();
+  EXPECT_TRUE(vector_match(vector<float> {5, 6}, param1.value().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {1, 2, 3}, param2.value().to_vector()));
+
+  // Replacing a tensor also releases the buffers.
+  optimizer.pack_parameters();
+  ASSERT_TRUE(optimizer.packed());
+  param2.value() = dev.new_tensor_by_constant({3}, 1);
+  EXPECT_FALSE(optimizer.packed());
+  optimizer.update();
+  EXPECT_TRUE(vector_match(vector<float> {4, 5}, param1.value().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {-1, -1, -1}, param2.value().to_vector()));
+}
+
+TEST_F(OptimizerTest, CheckPackParametersWithSharedTensor) {
+  Device::set_default(dev);
+  optimizers::SGD optimizer(.5);
+  Parameter param1({2}, {1, 2});
+  Parameter param2({3}, {3, 4, 5});
+  optimizer.add(param1, param2);
+  optimizer.pack_parameters();
+  ASSERT_TRUE(optimizer.packed());
+
+  // Copies of packed tensors are not modified by updates.
+  const Tensor copy = param1.value();
+  EXPECT_TRUE(optimizer.packed());
+
+  param1.gradient().reset(2);
+  param2.gradient().reset(4);
+  optimizer.update();
+  EXPECT_TRUE(optimizer.packed());
+  EXPECT_TRUE(vector_match(vector<float> {1, 2}, copy.to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {0, 1}, param1.value().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {1, 2, 3}, param2.value().to_vector()));
+
+  // Buffers are still used after releasing the copy.
+  optimizer.update();
+  EXPECT_TRUE(optimizer.packed());
+  EXPECT_TRUE(vector_match(vector<float> {-1, 0}, param1.value().to_vector()));
+}
+
+TEST_F(OptimizerTest, CheckPackParametersWithSaveAsync) {
+  Device::set_default(dev);
+  optimizers::Adam optimizer;
+  Parameter param1({2}, {1, 2});
+  Parameter param2({3}, {3, 4, 5});
+  Model m;
+  m.add("param1", param1);
+  m.add("param2", param2);
+  optimizer.add(m);
+  optimizer.pack_parameters();
+  ASSERT_TRUE(optimizer.packed());
+
+  const std::string path =
+    "/tmp/primitiv_OptimizerTest_CheckPackParametersWithSaveAsync.data";
+  std::future<void> saved = m.save_async(path);
+  param1.gradient().reset(1);
+  param2.gradient().reset(1);
+  optimizer.update();
+  EXPECT_TRUE(optimizer.packed());
+  saved.get();
+
+  // The snapshot keeps values before the update.
+  Parameter loaded1, loaded2;
+  Model m2;
+  m2.add("param1", loaded1);
+  m2.add("param2", loaded2);
+  m2.load(path);
+  std::remove(path.c_str());
+  EXPECT_TRUE(vector_match(vector<float> {1, 2}, loaded1.value().to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {0, 0}, loaded1.stats("Adam.m1").to_vector()));
+  EXPECT_TRUE(vector_match(
+        vector<float> {3, 4, 5}, loaded2.value().to_vector()));
+  EXPECT_FALSE(vector_match(
+        param1.value().to_vector(), loaded1.value().to_vector()));
+}
+
+TEST_F(OptimizerTest, CheckSparseUpdate) {
+  namespace F = functions;
+  Device::set_default(dev);
+  Graph g;
+  Graph::set_default(g);
+  const vector<float> init {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  const vector<vector<std::uint32_t>> ids {{3, 1, 3}, {0}, {4, 4}, {1}};
+
+  // Without the weight decay, SGD and AdaGrad do not change untouched rows,
+  // and lazy updates should produce the same results as dense updates.
+  optimizers::SGD sgd1(.1), sgd2(.1);
+  optimizers::AdaGrad adagrad1(.1), adagrad2(.1);
+  for (auto &opts : vector<std::pair<Optimizer *, Optimizer *>> {
+      {&sgd1, &sgd2}, {&adagrad1, &adagrad2}}) {
+    Parameter sparse({2, 5}, init), dense({2, 5}, init);
+    opts.first->add(sparse);
+    opts.second->add(dense);
+    for (const auto &cur_ids : ids) {
+      g.clear();
+      opts.first->reset_gradients();
+      opts.second->reset_gradients();
+      const Node y1 = F::pick_parameter<Node>(sparse, cur_ids, 1);
+      const Node y2 = F::pick(F::parameter<Node>(dense), cur_ids, 1);
+      F::batch::sum(F::sum(y1 * y1, 0)).backward();
+      F::batch::sum(F::sum(y2 * y2, 0)).backward();
+      const Parameter &cs = sparse;
+      ASSERT_TRUE(cs.has_sparse_gradient());
+      EXPECT_EQ(cur_ids.size() == 3 ? 2u : 1u, cs.sparse_gradient_ids().size());
+      opts.first->update();
+      opts.second->update();
+      EXPECT_TRUE(vector_match(
+            dense.value().to_vector(), sparse.value().to_vector()));
+      EXPECT_TRUE(vector_match(
+            dense.gradient().to_vector(), sparse.gradient().to_vector()));
+    }
+  }
+
+  // Adam updates only touched rows and their statistics, also with 16-bit
+  // statistics.
+  for (Precision precision : {
+      Precision::FLOAT32, Precision::FLOAT16, Precision::BFLOAT16}) {
+    optimizers::Adam adam;
+    adam.set_stats_precision(precision);
+    Parameter param({2, 5}, init);
+    adam.add(param);
+    g.clear();
+    adam.reset_gradients();
+    const Node y = F::pick_parameter<Node>(param, {1, 3}, 1);
+    F::batch::sum(F::sum(y, 0)).backward();
+    adam.update();
+    const vector<float> value = param.value().to_vector();
+    const vector<float> m1 = param.stats("Adam.m1").to_vector();
+    EXPECT_EQ(precision, param.stats("Adam.m1").precision());
+    for (std::uint32_t i = 0; i < 10; ++i) {
+      const std::uint32_t row = i / 2;
+      if (row == 1 || row == 3) {
+        EXPECT_NEAR(init[i] - .001, value[i], 1e-6);
+        EXPECT_NEAR(.1, m1[i], 1e-3);
+      } else {
+        EXPECT_EQ(init[i], value[i]);
+        EXPECT_EQ(0, m1[i]);
+      }
+    }
+
+    // Rows touched by the previous update are not changed by lazy updates.
+    g.clear();
+    adam.reset_gradients();
+    F::batch::sum(F::sum(F::pick_parameter<Node>(param, {0}, 1), 0))
+      .backward();
+    adam.update();
+    const vector<float> value2 = param.value().to_vector();
+    const vector<float> m1_2 = param.stats("Adam.m1").to_vector();
+    for (std::uint32_t i = 2; i < 10; ++i) {
+      EXPECT_EQ(value[i], value2[i]);
+      EXPECT_EQ(m1[i], m1_2[i]);
+    }
+    EXPECT_NE(value[0], value2[0]);
+  }
+
+  // The weight decay is not applied to untouched rows.
+  optimizers::SGD decayed(.1);
+  decayed.set_weight_decay(1);
+  Parameter param2({2, 2}, {1, 2, 3, 4});
+  decayed.add(param2);
+  g.clear();
+  decayed.reset_gradients();
+  F::batch::sum(F::sum(F::pick_parameter<Node>(param2, {0}, 1), 0)).backward();
+  decayed.update();
+  EXPECT_TRUE(vector_match(
+        vector<float> {.8, 1.7, 3, 4}, param2.value().to_vector()));
+
+  // Non-finite values of touched rows are written back as they are.
+  const float inf = std::numeric_limits<float>::infinity();
+  optimizers::SGD sgd(.1);
+  Parameter param3({2, 2}, {inf, 2, 3, 4});
+  sgd.add(param3);
+  g.clear();
+  sgd.reset_gradients();
+  F::batch::sum(F::sum(F::pick_parameter<Node>(param3, {0}, 1), 0)).backward();
+  sgd.update();
+  const vector<float> value3 = param3.value().to_vector();
+  EXPECT_EQ(inf, value3[0]);
+  EXPECT_FLOAT_EQ(1.9, value3[1]);
+  EXPECT_EQ(3, value3[2]);
+  EXPECT_EQ(4, value3[3]);
+}
+
 }  // namespace primitiv
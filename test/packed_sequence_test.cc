@@ -0,0 +1,137 @@
+#include <primitiv/config.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <primitiv/core/error.h>
+#include <primitiv/core/functions.h>
+#include <primitiv/core/graph.h>
+#include <primitiv/core/packed_sequence.h>
+#include <primitiv/devices/naive/device.h>
+
+#include <test_utils.h>
+
+using std::vector;
+using test_utils::vector_match;
+
+namespace primitiv {
+
+namespace F = functions;
+
+class PackedSequenceTest : public testing::Test {
+protected:
+  devices::Naive dev;
+  Graph g;
+
+  void SetUp() override {
+    Device::set_default(dev);
+    Graph::set_default(g);
+  }
+};
+
+TEST_F(PackedSequenceTest, CheckDefault) {
+  const PackedSequence seq;
+  EXPECT_EQ(0u, seq.num_sequences());
+  EXPECT_EQ(0u, seq.max_length());
+  EXPECT_EQ(0u, seq.num_tokens());
+  EXPECT_THROW(seq.batch_size(0), Error);
+  EXPECT_THROW(seq.ids(0), Error);
+}
+
+TEST_F(PackedSequenceTest, CheckNew) {
+  const PackedSequence seq({{1, 2}, {3, 4, 5, 6}, {7}, {8, 9, 10, 11}});
+  EXPECT_EQ(4u, seq.num_sequences());
+  EXPECT_EQ(4u, seq.max_length());
+  EXPECT_EQ(11u, seq.num_tokens());
+  EXPECT_EQ(vector<std::uint32_t>({4, 3, 2, 2}), seq.batch_sizes());
+  EXPECT_EQ(vector<std::uint32_t>({1, 3, 0, 2}), seq.order());
+  EXPECT_EQ(vector<std::uint32_t>({4, 4, 2, 1}), seq.lengths());
+  EXPECT_EQ(vector<std::uint32_t>({3, 8, 1, 7}), seq.ids(0));
+  EXPECT_EQ(vector<std::uint32_t>({4, 9, 2}), seq.ids(1));
+  EXPECT_EQ(vector<std::uint32_t>({5, 10}), seq.ids(2));
+  EXPECT_EQ(vector<std::uint32_t>({6, 11}), seq.ids(3));
+  for (std::uint32_t t = 0; t < 4; ++t) {
+    EXPECT_EQ(seq.batch_sizes()[t], seq.batch_size(t));
+  }
+  EXPECT_TRUE(vector_match(vector<float> {1, 1, 1, 0}, seq.mask(1)));
+  EXPECT_TRUE(vector_match(vector<float> {1, 1, 0, 0}, seq.mask(3)));
+  EXPECT_THROW(seq.batch_size(4), Error);
+  EXPECT_THROW(seq.ids(4), Error);
+  EXPECT_THROW(seq.mask(4), Error);
+}
+
+TEST_F(PackedSequenceTest, CheckInvalidNew) {
+  EXPECT_THROW(PackedSequence(vector<vector<std::uint32_t>> {}), Error);
+  EXPECT_THROW(PackedSequence({{1}, {}}), Error);
+}
+
+TEST_F(PackedSequenceTest, CheckUnpackAndLast) {
+  const PackedSequence seq({{1, 2}, {3, 4, 5}, {6}});
+  vector<Node> steps;
+  for (std::uint32_t t = 0; t < seq.max_length(); ++t) {
+    vector<float> data;
+    for (const std::uint32_t id : seq.ids(t)) data.emplace_back(id);
+    steps.emplace_back(
+        F::input<Node>(Shape({}, seq.batch_size(t)), data));
+  }
+
+  const vector<vector<Node>> unpacked = seq.unpack(steps);
+  const vector<vector<float>> expected {{1, 2}, {3, 4, 5}, {6}};
+  ASSERT_EQ(expected.size(), unpacked.size());
+  for (std::uint32_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i].size(), unpacked[i].size());
+    for (std::uint32_t t = 0; t < expected[i].size(); ++t) {
+      EXPECT_EQ(Shape(), unpacked[i][t].shape());
+      EXPECT_FLOAT_EQ(expected[i][t], unpacked[i][t].to_float());
+    }
+  }
+
+  const Node last = seq.last(steps);
+  EXPECT_EQ(Shape({}, 3), last.shape());
+  EXPECT_TRUE(vector_match(vector<float> {2, 5, 6}, last.to_vector()));
+
+  // Tensors are also available.
+  vector<Tensor> tensors;
+  for (const Node &step : steps) tensors.emplace_back(g.forward(step));
+  EXPECT_TRUE(vector_match(
+        vector<float> {2, 5, 6}, seq.last(tensors).to_vector()));
+
+  steps.pop_back();
+  EXPECT_THROW(seq.unpack(steps), Error);
+  EXPECT_THROW(seq.last(steps), Error);
+  steps.emplace_back(F::input<Node>(Shape({}, 2), {1, 2}));
+  EXPECT_THROW(seq.last(steps), Error);
+}
+
+TEST_F(PackedSequenceTest, CheckRNN) {
+  // Packed RNN should be equivalent to running each sequence solely.
+  const vector<vector<std::uint32_t>> seqs {{0, 1}, {2, 0, 1}, {1}};
+  const vector<float> embed_data {.1, .2, -.3, .4, .5, -.6};
+  const vector<float> w_data {.1, -.2, .3, .4, -.5, .6, -.7, .8};
+
+  auto run = [&](const PackedSequence &seq) {
+    const Node embed = F::input<Node>({2, 3}, embed_data);
+    const Node w = F::input<Node>({2, 4}, w_data);
+    vector<Node> hs;
+    Node h = F::zeros<Node>({2});
+    for (std::uint32_t t = 0; t < seq.max_length(); ++t) {
+      const Node x = F::pick(embed, seq.ids(t), 1);
+      if (t > 0) h = F::batch::slice(h, 0, seq.batch_size(t));
+      h = F::tanh(F::matmul(w, F::concat({x, h}, 0)));
+      hs.emplace_back(h);
+    }
+    return seq.last(hs);
+  };
+
+  const vector<float> observed = run(PackedSequence(seqs)).to_vector();
+  ASSERT_EQ(6u, observed.size());
+  for (std::uint32_t i = 0; i < seqs.size(); ++i) {
+    const vector<float> expected = run(PackedSequence({seqs[i]})).to_vector();
+    EXPECT_TRUE(vector_match(
+          expected,
+          vector<float>(observed.begin() + 2 * i, observed.begin() + 2 * i + 2)));
+  }
+}
+
+}  // namespace primitiv
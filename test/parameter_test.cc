@@ -1,6 +1,8 @@
 #include <primitiv/config.h>
 
 #include <cstdio>
+#include <fstream>
+#include <limits>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -10,6 +12,7 @@
 #include <primitiv/core/initializer_impl.h>
 #include <primitiv/devices/naive/device.h>
 #include <primitiv/core/parameter.h>
+#include <primitiv/msgpack/reader.h>
 
 #include <test_utils.h>
 
@@ -299,6 +302,26 @@ TEST_F(ParameterTest, CheckSaveLoad) {
   EXPECT_TRUE(vector_match({0, 0, 0, 0}, p2.gradient().to_vector()));
 }
 
+TEST_F(ParameterTest, CheckSaveLoadLarge) {
+  Device::set_default(dev);
+  // Larger than the chunk size used while saving.
+  const Shape shape {1 << 10, (1 << 10) + 3};
+  vector<float> values(shape.size());
+  for (std::uint32_t i = 0; i < values.size(); ++i) values[i] = i;
+  const Parameter p1(shape, values);
+
+  const std::string path =
+    "/tmp/primitiv_ParameterTest_CheckSaveLoadLarge.data";
+  p1.save(path);
+
+  Parameter p2;
+  p2.load(path);
+  std::remove(path.c_str());
+
+  EXPECT_EQ(shape, p2.shape());
+  EXPECT_TRUE(vector_match(values, p2.value().to_vector()));
+}
+
 TEST_F(ParameterTest, CheckSaveLoadWithStats) {
   Device::set_default(dev);
   const Shape shape {2, 2};
@@ -342,6 +365,27 @@ TEST_F(ParameterTest, CheckSaveWithoutStats) {
   EXPECT_FALSE(p2.has_stats("a"));
 }
 
+TEST_F(ParameterTest, CheckSaveVersion) {
+  // Parameter files are unchanged since v0.1.
+  Device::set_default(dev);
+  const Parameter p({2, 2}, {1, 2, 3, 4});
+  const std::string path = "/tmp/primitiv_ParameterTest_CheckSaveVersion.data";
+  p.save(path);
+
+  std::uint32_t major, minor, datatype;
+  {
+    std::ifstream ifs(path);
+    ASSERT_TRUE(ifs.is_open());
+    msgpack::Reader reader(ifs);
+    reader >> major >> minor >> datatype;
+  }
+  std::remove(path.c_str());
+
+  EXPECT_EQ(0u, major);
+  EXPECT_EQ(1u, minor);
+  EXPECT_EQ(0x200u, datatype);
+}
+
 TEST_F(ParameterTest, CheckLoadWithoutStats) {
   Device::set_default(dev);
   const Shape shape {2, 2};
@@ -368,4 +412,79 @@ TEST_F(ParameterTest, CheckInvalidSave) {
   EXPECT_THROW(invalid.save("/tmp/not_generated"), Error);
 }
 
+TEST_F(ParameterTest, CheckSparseGradient) {
+  Parameter p({2, 4}, {1, 2, 3, 4, 5, 6, 7, 8}, dev);
+  ASSERT_TRUE(p.has_sparse_gradient());
+  EXPECT_TRUE(p.sparse_gradient_ids().empty());
+
+  p.add_sparse_gradient(dev.new_tensor_by_vector({2}, {1, 1}), {3}, 1);
+  p.add_sparse_gradient(
+      dev.new_tensor_by_vector(Shape({2}, 3), {1, 2, 3, 4, 5, 6}), {1, 3, 1}, 1);
+  ASSERT_TRUE(p.has_sparse_gradient());
+  EXPECT_EQ(1u, p.sparse_gradient_dim());
+  EXPECT_EQ(vector<std::uint32_t>({1, 3}), p.sparse_gradient_ids());
+  const Parameter &cp = p;
+  EXPECT_TRUE(vector_match(
+        vector<float> {0, 0, 6, 8, 0, 0, 4, 5}, cp.gradient().to_vector()));
+
+  // Resets only recorded rows.
+  p.reset_gradient();
+  ASSERT_TRUE(p.has_sparse_gradient());
+  EXPECT_TRUE(p.sparse_gradient_ids().empty());
+  EXPECT_TRUE(vector_match(vector<float>(8, 0), cp.gradient().to_vector()));
+
+  // Non-finite values are also reset.
+  const float inf = std::numeric_limits<float>::infinity();
+  p.add_sparse_gradient(
+      dev.new_tensor_by_vector(Shape({2}, 2), {inf, -inf, 1, inf}), {0, 2}, 1);
+  p.add_sparse_gradient(dev.new_tensor_by_vector({2}, {-inf, 1}), {0}, 1);
+  p.reset_gradient();
+  EXPECT_TRUE(vector_match(vector<float>(8, 0), cp.gradient().to_vector()));
+
+  // Different dimensions make the gradient dense.
+  p.add_sparse_gradient(dev.new_tensor_by_vector({2}, {1, 1}), {0}, 1);
+  p.add_sparse_gradient(dev.new_tensor_by_vector({1, 4}, {1, 1, 1, 1}), {1}, 0);
+  EXPECT_FALSE(p.has_sparse_gradient());
+  EXPECT_THROW(p.sparse_gradient_ids(), Error);
+  EXPECT_THROW(p.sparse_gradient_dim(), Error);
+  EXPECT_TRUE(vector_match(
+        vector<float> {1, 2, 0, 1, 0, 1, 0, 1}, cp.gradient().to_vector()));
+  p.reset_gradient();
+  EXPECT_TRUE(p.has_sparse_gradient());
+  EXPECT_TRUE(vector_match(vector<float>(8, 0), cp.gradient().to_vector()));
+
+  // Accessing the mutable gradient makes the gradient dense.
+  p.add_sparse_gradient(dev.new_tensor_by_vector({2}, {1, 1}), {2}, 1);
+  p.gradient() += dev.new_tensor_by_constant({2, 4}, 1);
+  EXPECT_FALSE(p.has_sparse_gradient());
+  p.reset_gradient();
+  EXPECT_TRUE(vector_match(vector<float>(8, 0), cp.gradient().to_vector()));
+}
+
+TEST_F(ParameterTest, CheckFreeze) {
+  Parameter p({2}, {1, 2}, dev);
+  p.add_stats("a", {2});
+  EXPECT_FALSE(p.frozen());
+
+  p.freeze();
+  EXPECT_TRUE(p.frozen());
+  const Parameter &cp = p;
+  EXPECT_TRUE(vector_match(vector<float> {1, 2}, cp.value().to_vector()));
+  EXPECT_TRUE(vector_match(vector<float> {0, 0}, cp.stats("a").to_vector()));
+  EXPECT_THROW(cp.gradient(), Error);
+  EXPECT_THROW(p.value(), Error);
+  EXPECT_THROW(p.gradient(), Error);
+  EXPECT_THROW(p.stats("a"), Error);
+  EXPECT_THROW(p.reset_gradient(), Error);
+  EXPECT_THROW(p.add_stats("b", {2}), Error);
+  EXPECT_THROW(
+      p.add_sparse_gradient(dev.new_tensor_by_vector({}, {1}), {0}, 0), Error);
+
+  p.unfreeze();
+  EXPECT_FALSE(p.frozen());
+  EXPECT_TRUE(vector_match(vector<float> {0, 0}, cp.gradient().to_vector()));
+  p.value() += dev.new_tensor_by_constant({2}, 1);
+  EXPECT_TRUE(vector_match(vector<float> {2, 3}, cp.value().to_vector()));
+}
+
 }  // namespace primitiv
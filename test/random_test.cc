@@ -1,5 +1,6 @@
 #include <primitiv/config.h>
 
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -99,4 +100,57 @@ TEST_F(DefaultRandomizerTest, CheckFillLogNormal) {
 #endif
 }
 
+TEST_F(DefaultRandomizerTest, CheckThreadStreams) {
+  const std::size_t size = 16;
+  vector<float> expected(size);
+  {
+    DefaultRandomizer randomizer(12345);
+    randomizer.fill_uniform(0, 1, size, expected.data());
+  }
+
+  // The first thread uses the seeded stream, and others use distinct streams.
+  vector<float> observed1(size), observed2(size), observed3(size);
+  std::thread([&]() {
+      randomizer_.fill_uniform(0, 1, size, observed1.data());
+  }).join();
+  std::thread([&]() {
+      randomizer_.fill_uniform(0, 1, size, observed2.data());
+  }).join();
+  randomizer_.fill_uniform(0, 1, size, observed3.data());
+  EXPECT_TRUE(vector_match(expected, observed1));
+  EXPECT_FALSE(vector_match(expected, observed2));
+  EXPECT_FALSE(vector_match(expected, observed3));
+  EXPECT_FALSE(vector_match(observed2, observed3));
+}
+
+TEST_F(DefaultRandomizerTest, CheckRecreatedRandomizer) {
+  // A new randomizer does not take over the stream of a destroyed one, even
+  // if it is allocated at the same address.
+  const std::size_t size = 16;
+  vector<vector<float>> observed;
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    DefaultRandomizer randomizer(12345);
+    vector<float> values(size);
+    randomizer.fill_uniform(0, 1, size, values.data());
+    observed.emplace_back(std::move(values));
+  }
+  EXPECT_TRUE(vector_match(observed[0], observed[1]));
+  EXPECT_TRUE(vector_match(observed[0], observed[2]));
+}
+
+TEST_F(DefaultRandomizerTest, CheckManyThreads) {
+  // Streams of finished threads are released, and every thread obtains a
+  // new stream.
+  const std::size_t size = 4;
+  vector<float> first(size);
+  randomizer_.fill_uniform(0, 1, size, first.data());
+  for (std::uint32_t i = 0; i < 100; ++i) {
+    vector<float> values(size);
+    std::thread([&]() {
+        randomizer_.fill_uniform(0, 1, size, values.data());
+    }).join();
+    EXPECT_FALSE(vector_match(first, values));
+  }
+}
+
 }  // namespace primitiv
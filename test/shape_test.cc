@@ -453,4 +453,28 @@ TEST_F(ShapeTest, CheckUpdateBatch) {
   EXPECT_THROW(src.update_batch(0), Error);
 }
 
+TEST_F(ShapeTest, CheckMaxSize) {
+  EXPECT_EQ(0xffffffffu, Shape::MAX_SIZE);
+  EXPECT_EQ(0xffffffffu, Shape({65535, 65537}).size());
+  EXPECT_EQ(0xffffffffu, Shape({65535}, 65537).size());
+  EXPECT_EQ(0xfffe0001u, Shape({65535, 65535}).size());
+  EXPECT_THROW(Shape({65536, 65536}), Error);
+  EXPECT_THROW(Shape({65536}, 65536), Error);
+  EXPECT_THROW(Shape(std::vector<std::uint32_t> {65536, 65536}), Error);
+  EXPECT_THROW(
+      Shape({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}), Error);
+  EXPECT_THROW(Shape({0xffffffffu, 0xffffffffu, 0}), Error);
+
+  Shape src({65536, 65535});
+  EXPECT_THROW(src.update_dim(1, 65536), Error);
+  EXPECT_THROW(src.update_dim(2, 2), Error);
+  EXPECT_THROW(src.update_batch(2), Error);
+  EXPECT_THROW(src.resize_dim(0, 65538), Error);
+  EXPECT_THROW(src.resize_batch(65536), Error);
+  EXPECT_EQ(Shape({65536, 65535}), src);
+  EXPECT_NO_THROW(src.update_dim(0, 1));
+  EXPECT_NO_THROW(src.update_batch(65536));
+  EXPECT_EQ(Shape({1, 65535}, 65536), src);
+}
+
 }  // namespace primitiv
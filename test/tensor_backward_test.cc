@@ -8,6 +8,7 @@
 
 #include <primitiv/core/error.h>
 #include <primitiv/devices/naive/device.h>
+#include <primitiv/core/random.h>
 #include <primitiv/core/tensor.h>
 
 #include <test_utils.h>
@@ -772,6 +773,27 @@ TEST_F(TensorBackwardTest, CheckELU) {
   }
 }
 
+TEST_F(TensorBackwardTest, CheckDropout) {
+  const vector<float> rates {0., .1, .5, .9};
+  const vector<float> gy_data = make_iota_vector(64, 1);
+  for (Device *dev : devices) {
+    for (const float rate : rates) {
+      const std::uint32_t seed = 12345;
+      const std::uint32_t th = dropout_threshold(rate);
+      vector<float> gx_data(gy_data.size());
+      for (std::uint32_t i = 0; i < gy_data.size(); ++i) {
+        gx_data[i] = 1 + (
+            hash_counter(seed, i) >= th ? gy_data[i] / (1 - rate) : 0);
+      }
+      const Tensor gy = dev->new_tensor_by_vector(Shape({4, 4}, 4), gy_data);
+      Tensor gx = dev->new_tensor_by_constant(gy.shape(), 1);
+      dev->dropout_bw(gy, rate, seed, gx);
+      EXPECT_TRUE(vector_match_ulps(
+            gx_data, gx.to_vector(), get_default_ulps(*dev)));
+    }
+  }
+}
+
 TEST_F(TensorBackwardTest, CheckMaxDims) {
   const vector<float> x_data = {
     0, 1, 2, 6, 7, 8, 3, 4, 5, -3, -4, -5, 0, -1, -2, -6, -7, -8,
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <memory>
 #include <numeric>
 #include <utility>
 #include <vector>
@@ -12,6 +14,7 @@
 #include <primitiv/core/functions.h>
 #include <primitiv/devices/naive/device.h>
 #include <primitiv/core/parameter.h>
+#include <primitiv/core/random.h>
 #include <primitiv/core/tensor.h>
 
 #include <test_utils.h>
@@ -53,6 +56,42 @@ TEST_F(TensorForwardTest, CheckInputByVector) {
   }
 }
 
+TEST_F(TensorForwardTest, CheckInputByMovedVector) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  for (Device *dev : devices) {
+    vector<float> moved = data;
+    const Tensor y = input<Tensor>(Shape({2, 2}, 3), std::move(moved), *dev);
+    EXPECT_EQ(Shape({2, 2}, 3), y.shape());
+    EXPECT_EQ(dev, &y.device());
+    EXPECT_TRUE(vector_match(data, y.to_vector()));
+  }
+}
+
+TEST_F(TensorForwardTest, CheckInputByInvalidVector) {
+  for (Device *dev : devices) {
+    EXPECT_THROW(
+        input<Tensor>(Shape({2, 2}, 3), vector<float>(11), *dev), Error);
+  }
+}
+
+TEST_F(TensorForwardTest, CheckSharedInput) {
+  vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  for (Device *dev : devices) {
+    std::uint32_t released = 0;
+    {
+      const std::shared_ptr<float> shared(
+          data.data(), [&released](float *) { ++released; });
+      const Tensor y = shared_input<Tensor>(Shape({2, 2}, 3), shared, *dev);
+      EXPECT_EQ(Shape({2, 2}, 3), y.shape());
+      EXPECT_EQ(dev, &y.device());
+      EXPECT_TRUE(vector_match(data, y.to_vector()));
+    }
+    EXPECT_EQ(1u, released);
+    EXPECT_THROW(
+        shared_input<Tensor>(Shape({2, 2}, 3), nullptr, *dev), Error);
+  }
+}
+
 TEST_F(TensorForwardTest, CheckInputByParameter) {
   vector<float> data {1, 2, 3, 4};
   for (Device *dev : devices) {
@@ -2303,6 +2342,65 @@ TEST_F(TensorForwardTest, CheckELU) {
   }
 }
 
+TEST_F(TensorForwardTest, CheckDropout) {
+  const vector<float> rates {0., .1, .5, .9};
+  const vector<float> x_data = make_iota_vector(64, 1);
+  for (Device *dev : devices) {
+    for (const float rate : rates) {
+      const std::uint32_t seed = 12345;
+      const std::uint32_t th = dropout_threshold(rate);
+      vector<float> y_data(x_data.size());
+      for (std::uint32_t i = 0; i < x_data.size(); ++i) {
+        y_data[i] = hash_counter(seed, i) >= th ? x_data[i] / (1 - rate) : 0;
+      }
+      const Tensor x = dev->new_tensor_by_vector(Shape({4, 4}, 4), x_data);
+      const Tensor y = dev->dropout_fw(x, rate, seed);
+      EXPECT_EQ(Shape({4, 4}, 4), y.shape());
+      EXPECT_TRUE(vector_match_ulps(
+            y_data, y.to_vector(), get_default_ulps(*dev)));
+    }
+  }
+}
+
+TEST_F(TensorForwardTest, CheckDropoutNonFinite) {
+  // Dropped elements are 0 even if they are not finite.
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float rate = .5;
+  const std::uint32_t seed = 12345;
+  const std::uint32_t th = dropout_threshold(rate);
+  vector<float> x_data(64);
+  for (std::uint32_t i = 0; i < x_data.size(); ++i) {
+    x_data[i] = i % 2 ? inf : nan;
+  }
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_vector(Shape({4, 4}, 4), x_data);
+    const vector<float> y_data = dev->dropout_fw(x, rate, seed).to_vector();
+    for (std::uint32_t i = 0; i < x_data.size(); ++i) {
+      if (hash_counter(seed, i) < th) EXPECT_EQ(0, y_data[i]);
+    }
+  }
+}
+
+TEST_F(TensorForwardTest, CheckDropoutDisabled) {
+  for (Device *dev : devices) {
+    const vector<float> x_data {1, 2, 3, 4, 5, 6};
+    const Tensor x = dev->new_tensor_by_vector(Shape({2, 3}), x_data);
+    EXPECT_TRUE(vector_match(x_data, dropout(x, .5, false).to_vector()));
+    EXPECT_TRUE(vector_match(
+          vector<float>(6, 0), dropout(x, 1, true).to_vector()));
+  }
+}
+
+TEST_F(TensorForwardTest, CheckInvalidDropout) {
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_constant(Shape({2, 3}), 1);
+    EXPECT_THROW(dev->dropout_fw(x, -.1, 0), Error);
+    EXPECT_THROW(dev->dropout_fw(x, 1, 0), Error);
+    EXPECT_THROW(dev->dropout_fw(x, 1.1, 0), Error);
+  }
+}
+
 TEST_F(TensorForwardTest, CheckMaxDims) {
   struct TestCase {
     std::uint32_t dim;
@@ -1,7 +1,10 @@
 #include <primitiv/config.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <utility>
@@ -17,7 +20,10 @@
 #include <test_utils.h>
 
 using std::vector;
+using test_utils::get_default_ulps;
 using test_utils::vector_match;
+using test_utils::vector_match_ulps;
+using test_utils::vector_near;
 
 namespace primitiv {
 
@@ -79,6 +85,26 @@ TEST_F(TensorTest, CheckNewMatrixWithData) {
   }
 }
 
+TEST_F(TensorTest, CheckNewTensorBySharedArray) {
+  for (Device *dev : devices) {
+    const vector<float> data {3, 1, 4, 1, 5, 9, 2, 6};
+    std::shared_ptr<float> values(
+        new float[8], std::default_delete<float[]>());
+    std::copy(data.begin(), data.end(), values.get());
+    Tensor x = dev->new_tensor_by_shared_array(Shape({2, 2}, 2), values);
+    EXPECT_TRUE(x.valid());
+    EXPECT_EQ(dev, &x.device());
+    EXPECT_EQ(Shape({2, 2}, 2), x.shape());
+    EXPECT_TRUE(vector_match(data, x.to_vector()));
+
+    // Updating the tensor does not affect the shared array.
+    x.reset(0);
+    EXPECT_TRUE(vector_match(vector<float>(8, 0), x.to_vector()));
+    EXPECT_TRUE(vector_match(
+          data, vector<float>(values.get(), values.get() + 8)));
+  }
+}
+
 TEST_F(TensorTest, CheckNewMatrixMinibatchWithData) {
   for (Device *dev : devices) {
     const vector<float> data {
@@ -633,6 +659,137 @@ TEST_F(TensorTest, CheckCopyAndInplaceSubtract) {
   }
 }
 
+TEST_F(TensorTest, CheckInplacePickAssign) {
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  struct TestCase {
+    Shape a_shape;
+    vector<float> a_data;
+    Shape b_shape;
+    vector<float> b_data;
+    std::uint32_t dim;
+    vector<std::uint32_t> ids;
+    vector<float> y_data;
+  };
+  const vector<TestCase> test_cases {
+    {{2, 2}, {0, 1, 2, 3}, {1, 2}, {7, 8}, 0, {1}, {0, 7, 2, 8}},
+    {{2, 2}, {0, 1, 2, 3}, Shape({2}, 2), {5, 6, 7, 8}, 1, {1, 0},
+      {7, 8, 5, 6}},
+    {{2, 2}, {inf, nan, 2, 3}, {2}, {1, 1}, 1, {0}, {1, 1, 2, 3}},
+    {Shape({2, 2}, 2), {0, 1, 2, 3, 4, 5, 6, 7},
+      Shape({1, 2}, 2), {10, 11, 12, 13}, 0, {1, 0},
+      {0, 10, 2, 11, 12, 5, 13, 7}},
+    {Shape({2, 2}, 2), {0, 1, 2, 3, 4, 5, 6, 7},
+      Shape({2}, 2), {10, 11, 12, 13}, 1, {1},
+      {0, 1, 10, 11, 4, 5, 12, 13}},
+  };
+  for (Device *dev : devices) {
+    for (const TestCase &tc : test_cases) {
+      Tensor a = dev->new_tensor_by_vector(tc.a_shape, tc.a_data);
+      const Tensor b = dev->new_tensor_by_vector(tc.b_shape, tc.b_data);
+      dev->inplace_pick_assign(b, tc.ids, tc.dim, a);
+      EXPECT_TRUE(vector_match(tc.y_data, a.to_vector()));
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckInplacePickReset) {
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  struct TestCase {
+    Shape a_shape;
+    vector<float> a_data;
+    float k;
+    std::uint32_t dim;
+    vector<std::uint32_t> ids;
+    vector<float> y_data;
+  };
+  const vector<TestCase> test_cases {
+    {{2, 2}, {inf, 1, nan, 3}, 0, 0, {0}, {0, 1, 0, 3}},
+    {{2, 2}, {0, -inf, 2, nan}, 0, 0, {1, 1}, {0, 0, 2, 0}},
+    {{2, 2}, {0, 1, 2, 3}, 5, 1, {0, 1}, {5, 5, 5, 5}},
+    {Shape({2, 2}, 2), {0, 1, 2, 3, 4, 5, 6, 7}, -1, 1, {1, 0},
+      {0, 1, -1, -1, -1, -1, 6, 7}},
+    {Shape({2, 2}, 2), {0, 1, 2, 3, 4, 5, 6, 7}, -1, 0, {1},
+      {0, -1, 2, -1, 4, -1, 6, -1}},
+  };
+  for (Device *dev : devices) {
+    for (const TestCase &tc : test_cases) {
+      Tensor a = dev->new_tensor_by_vector(tc.a_shape, tc.a_data);
+      dev->inplace_pick_reset(tc.k, tc.ids, tc.dim, a);
+      EXPECT_TRUE(vector_match(tc.y_data, a.to_vector()));
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckCopyAndInplacePick) {
+  const vector<float> a_data {0, 1, 2, 3};
+  for (Device *dev : devices) {
+    Tensor a = dev->new_tensor_by_vector({2, 2}, a_data);
+    const Tensor copied = a;
+    dev->inplace_pick_assign(
+        dev->new_tensor_by_vector({2}, {5, 6}), {1}, 1, a);
+    dev->inplace_pick_reset(0, {0}, 0, a);
+    EXPECT_TRUE(vector_match(vector<float> {0, 1, 0, 6}, a.to_vector()));
+    EXPECT_TRUE(vector_match(a_data, copied.to_vector()));
+  }
+}
+
+TEST_F(TensorTest, CheckPackedInplacePickAssign) {
+  const vector<float> a_data {0, 1, 2, 3, 4, 5};
+  for (Device *dev : devices) {
+    for (Precision precision : {Precision::FLOAT16, Precision::BFLOAT16}) {
+      Tensor a = dev->copy_tensor(
+          dev->new_tensor_by_vector({2, 3}, a_data), precision);
+      const Tensor b = dev->copy_tensor(
+          dev->new_tensor_by_vector({2}, {-1, -2}), precision);
+      const Tensor f = dev->new_tensor_by_vector({2}, {-1, -2});
+      // Values are not converted implicitly.
+      EXPECT_THROW(dev->inplace_pick_assign(f, {1}, 1, a), Error);
+      if (dev->type() != DeviceType::NAIVE &&
+          dev->type() != DeviceType::EIGEN) {
+        continue;
+      }
+      const Tensor copied = a;
+      dev->inplace_pick_assign(b, {1}, 1, a);
+      EXPECT_EQ(precision, a.precision());
+      EXPECT_TRUE(vector_match(
+            vector<float> {0, 1, -1, -2, 4, 5}, a.to_vector()));
+      EXPECT_TRUE(vector_match(a_data, copied.to_vector()));
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckInvalidInplacePick) {
+  struct TestCase {
+    Shape a_shape, b_shape;
+    std::uint32_t dim;
+    vector<std::uint32_t> ids;
+  };
+  const vector<TestCase> test_cases {
+    // Out-of-range IDs.
+    {{2}, {}, 0, {2}},
+    {{2}, Shape({}, 3), 0, {0, 1, 2}},
+    // Batch size mismatched.
+    {{2}, {}, 0, {}},
+    {Shape({2}, 3), Shape({}, 2), 0, {0, 1}},
+    // Shape mismatched (assign only).
+    {{2}, {2}, 0, {0}},
+    {{2, 2}, Shape({1, 2}, 2), 0, {0}},
+  };
+  for (Device *dev : devices) {
+    for (std::uint32_t i = 0; i < test_cases.size(); ++i) {
+      const TestCase &tc = test_cases[i];
+      Tensor a = dev->new_tensor_by_constant(tc.a_shape, 0);
+      const Tensor b = dev->new_tensor_by_constant(tc.b_shape, 0);
+      EXPECT_THROW(dev->inplace_pick_assign(b, tc.ids, tc.dim, a), Error);
+      if (i < 4) {
+        EXPECT_THROW(dev->inplace_pick_reset(0, tc.ids, tc.dim, a), Error);
+      }
+    }
+  }
+}
+
 TEST_F(TensorTest, CheckInvalidInplaceOps) {
   const vector<Shape> shapes {
     Shape(),
@@ -804,4 +961,715 @@ TEST_F(TensorTest, CheckArgMinMultipleLarge) {
   }
 }
 
+TEST_F(TensorTest, CheckSGDUpdate) {
+  const vector<float> g_data {1, -2, 3, -4, .5, -.5};
+  const vector<float> x_data {1, 2, 3, 4, 5, 6};
+  vector<float> x_expected(x_data);
+  for (std::uint32_t i = 0; i < 6; ++i) x_expected[i] -= .1f * g_data[i];
+  for (Device *dev : devices) {
+    const Tensor g = dev->new_tensor_by_vector({2, 3}, g_data);
+    Tensor x = dev->new_tensor_by_vector({2, 3}, x_data);
+    dev->sgd_update(g, .1, x);
+    EXPECT_TRUE(vector_match_ulps(
+          x_expected, x.to_vector(), get_default_ulps(*dev)));
+  }
+}
+
+TEST_F(TensorTest, CheckMomentumSGDUpdate) {
+  const vector<float> g_data {1, -2, 3, -4, .5, -.5};
+  const vector<float> m_data {.1, .2, -.3, .4, -.5, 0};
+  const vector<float> x_data {1, 2, 3, 4, 5, 6};
+  vector<float> m_expected(m_data), x_expected(x_data);
+  for (std::uint32_t i = 0; i < 6; ++i) {
+    m_expected[i] = .9f * m_expected[i] - .1f * g_data[i];
+    x_expected[i] += m_expected[i];
+  }
+  for (Device *dev : devices) {
+    const Tensor g = dev->new_tensor_by_vector({2, 3}, g_data);
+    Tensor m = dev->new_tensor_by_vector({2, 3}, m_data);
+    Tensor x = dev->new_tensor_by_vector({2, 3}, x_data);
+    dev->momentum_sgd_update(g, .1, .9, m, x);
+    EXPECT_TRUE(vector_match_ulps(
+          m_expected, m.to_vector(), get_default_ulps(*dev)));
+    EXPECT_TRUE(vector_match_ulps(
+          x_expected, x.to_vector(), get_default_ulps(*dev)));
+  }
+}
+
+TEST_F(TensorTest, CheckAdaGradUpdate) {
+  const vector<float> g_data {1, -2, 3, -4, .5, -.5};
+  const vector<float> m_data {.1, .2, .3, .4, .5, 0};
+  const vector<float> x_data {1, 2, 3, 4, 5, 6};
+  vector<float> m_expected(m_data), x_expected(x_data);
+  for (std::uint32_t i = 0; i < 6; ++i) {
+    m_expected[i] += g_data[i] * g_data[i];
+    x_expected[i] -= .1f * g_data[i] / (std::sqrt(m_expected[i]) + 1e-8f);
+  }
+  for (Device *dev : devices) {
+    const Tensor g = dev->new_tensor_by_vector({2, 3}, g_data);
+    Tensor m = dev->new_tensor_by_vector({2, 3}, m_data);
+    Tensor x = dev->new_tensor_by_vector({2, 3}, x_data);
+    dev->adagrad_update(g, .1, 1e-8, m, x);
+    EXPECT_TRUE(vector_match_ulps(
+          m_expected, m.to_vector(), get_default_ulps(*dev)));
+    EXPECT_TRUE(vector_match_ulps(
+          x_expected, x.to_vector(), get_default_ulps(*dev)));
+  }
+}
+
+TEST_F(TensorTest, CheckRMSPropUpdate) {
+  const vector<float> g_data {1, -2, 3, -4, .5, -.5};
+  const vector<float> m_data {.1, .2, .3, .4, .5, 0};
+  const vector<float> x_data {1, 2, 3, 4, 5, 6};
+  vector<float> m_expected(m_data), x_expected(x_data);
+  for (std::uint32_t i = 0; i < 6; ++i) {
+    m_expected[i]
+      = .9f * m_expected[i] + (1 - .9f) * g_data[i] * g_data[i];
+    x_expected[i] -= .1f * g_data[i] / (std::sqrt(m_expected[i]) + 1e-8f);
+  }
+  for (Device *dev : devices) {
+    const Tensor g = dev->new_tensor_by_vector({2, 3}, g_data);
+    Tensor m = dev->new_tensor_by_vector({2, 3}, m_data);
+    Tensor x = dev->new_tensor_by_vector({2, 3}, x_data);
+    dev->rmsprop_update(g, .1, .9, 1e-8, m, x);
+    EXPECT_TRUE(vector_match_ulps(
+          m_expected, m.to_vector(), get_default_ulps(*dev)));
+    EXPECT_TRUE(vector_match_ulps(
+          x_expected, x.to_vector(), get_default_ulps(*dev)));
+  }
+}
+
+TEST_F(TensorTest, CheckAdaDeltaUpdate) {
+  const vector<float> g_data {1, -2, 3, -4, .5, -.5};
+  const vector<float> m1_data {.1, .2, .3, .4, .5, 0};
+  const vector<float> m2_data {.5, .4, .3, .2, .1, 0};
+  const vector<float> x_data {1, 2, 3, 4, 5, 6};
+  vector<float> m1_expected(m1_data), m2_expected(m2_data);
+  vector<float> x_expected(x_data);
+  for (std::uint32_t i = 0; i < 6; ++i) {
+    m2_expected[i]
+      = .95f * m2_expected[i] + (1 - .95f) * g_data[i] * g_data[i];
+    const float d = std::sqrt(
+        (m1_expected[i] + 1e-6f) / (m2_expected[i] + 1e-6f)) * g_data[i];
+    m1_expected[i] = .95f * m1_expected[i] + (1 - .95f) * d * d;
+    x_expected[i] -= .1f * d;
+  }
+  for (Device *dev : devices) {
+    const Tensor g = dev->new_tensor_by_vector({2, 3}, g_data);
+    Tensor m1 = dev->new_tensor_by_vector({2, 3}, m1_data);
+    Tensor m2 = dev->new_tensor_by_vector({2, 3}, m2_data);
+    Tensor x = dev->new_tensor_by_vector({2, 3}, x_data);
+    dev->adadelta_update(g, .1, .95, 1e-6, m1, m2, x);
+    EXPECT_TRUE(vector_match_ulps(
+          m1_expected, m1.to_vector(), get_default_ulps(*dev)));
+    EXPECT_TRUE(vector_match_ulps(
+          m2_expected, m2.to_vector(), get_default_ulps(*dev)));
+    EXPECT_TRUE(vector_match_ulps(
+          x_expected, x.to_vector(), get_default_ulps(*dev)));
+  }
+}
+
+TEST_F(TensorTest, CheckAdamUpdate) {
+  const vector<float> g_data {1, -2, 3, -4, .5, -.5};
+  const vector<float> m1_data {.1, .2, -.3, .4, -.5, 0};
+  const vector<float> m2_data {.5, .4, .3, .2, .1, 0};
+  const vector<float> x_data {1, 2, 3, 4, 5, 6};
+  const std::uint32_t epoch = 3;
+  const float c1 = 1 - std::pow(.9f, epoch);
+  const float c2 = 1 - std::pow(.999f, epoch);
+  vector<float> m1_expected(m1_data), m2_expected(m2_data);
+  vector<float> x_expected(x_data);
+  for (std::uint32_t i = 0; i < 6; ++i) {
+    m1_expected[i] = .9f * m1_expected[i] + (1 - .9f) * g_data[i];
+    m2_expected[i]
+      = .999f * m2_expected[i] + (1 - .999f) * g_data[i] * g_data[i];
+    x_expected[i]
+      -= .1f * (m1_expected[i] / c1)
+      / (std::sqrt(m2_expected[i] / c2) + 1e-8f);
+  }
+  for (Device *dev : devices) {
+    const Tensor g = dev->new_tensor_by_vector({2, 3}, g_data);
+    Tensor m1 = dev->new_tensor_by_vector({2, 3}, m1_data);
+    Tensor m2 = dev->new_tensor_by_vector({2, 3}, m2_data);
+    Tensor x = dev->new_tensor_by_vector({2, 3}, x_data);
+    dev->adam_update(g, .1, .9, .999, 1e-8, epoch, m1, m2, x);
+    EXPECT_TRUE(vector_match_ulps(
+          m1_expected, m1.to_vector(), get_default_ulps(*dev)));
+    EXPECT_TRUE(vector_match_ulps(
+          m2_expected, m2.to_vector(), get_default_ulps(*dev)));
+    EXPECT_TRUE(vector_match_ulps(
+          x_expected, x.to_vector(), get_default_ulps(*dev)));
+  }
+}
+
+TEST_F(TensorTest, CheckPackedAdamUpdate) {
+  const vector<float> g_data {1, -2, 3, -4, .5};
+  const vector<float> x_data {1, 2, 3, 4, 5};
+  const std::uint32_t size = g_data.size();
+  for (Device *dev : devices) {
+    if (dev->type() == DeviceType::CUDA16) {
+      // CUDA16 keeps moments as ordinary tensors.
+      continue;
+    }
+    for (Precision precision : {Precision::FLOAT16, Precision::BFLOAT16}) {
+      const float tol = precision == Precision::FLOAT16 ? 1e-3 : 1e-2;
+      const Tensor g = dev->new_tensor_by_vector({size}, g_data);
+      const Tensor zeros = dev->new_tensor_by_constant({size}, 0);
+      Tensor m1 = dev->copy_tensor(zeros, precision);
+      Tensor m2 = dev->copy_tensor(zeros, Precision::BFLOAT16);
+      Tensor x = dev->new_tensor_by_vector({size}, x_data);
+      Tensor m1_ref = dev->new_tensor_by_constant({size}, 0);
+      Tensor m2_ref = dev->new_tensor_by_constant({size}, 0);
+      Tensor x_ref = dev->new_tensor_by_vector({size}, x_data);
+      for (std::uint32_t epoch = 1; epoch <= 3; ++epoch) {
+        dev->adam_update(g, .1, .9, .999, 1e-8, epoch, m1, m2, x);
+        dev->adam_update(
+            g, .1, .9, .999, 1e-8, epoch, m1_ref, m2_ref, x_ref);
+        EXPECT_TRUE(vector_near(x_ref.to_vector(), x.to_vector(), tol));
+      }
+      EXPECT_EQ(precision, m1.precision());
+      EXPECT_EQ(Precision::BFLOAT16, m2.precision());
+      EXPECT_TRUE(vector_near(m1_ref.to_vector(), m1.to_vector(), tol));
+      EXPECT_TRUE(vector_near(m2_ref.to_vector(), m2.to_vector(), tol));
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckInvalidPackedAdamUpdate) {
+  for (Device *dev : devices) {
+    const Tensor g = dev->new_tensor_by_constant({5}, 1);
+    const Tensor zeros = dev->new_tensor_by_constant({5}, 0);
+    Tensor x = dev->new_tensor_by_constant({5}, 0);
+    Tensor m32 = dev->copy_tensor(zeros);
+    Tensor m16 = dev->copy_tensor(zeros, Precision::FLOAT16);
+    Tensor mb16 = dev->copy_tensor(zeros, Precision::BFLOAT16);
+    Tensor m8 = dev->copy_tensor(zeros, Precision::INT8);
+    Tensor mb16_ng = dev->copy_tensor(
+        dev->new_tensor_by_constant({3}, 0), Precision::BFLOAT16);
+    EXPECT_THROW(
+        dev->adam_update(g, .1, .9, .999, 1e-8, 1, m16, m16, x), Error);
+    EXPECT_THROW(
+        dev->adam_update(g, .1, .9, .999, 1e-8, 1, m32, mb16, x), Error);
+    EXPECT_THROW(
+        dev->adam_update(g, .1, .9, .999, 1e-8, 1, mb16, m32, x), Error);
+    EXPECT_THROW(
+        dev->adam_update(g, .1, .9, .999, 1e-8, 1, m8, mb16, x), Error);
+    EXPECT_THROW(
+        dev->adam_update(g, .1, .9, .999, 1e-8, 1, m16, mb16_ng, x), Error);
+    EXPECT_THROW(
+        dev->adam_update(g, .1, .9, .999, 1e-8, 0, m16, mb16, x), Error);
+  }
+}
+
+TEST_F(TensorTest, CheckInvalidUpdates) {
+  for (Device *dev : devices) {
+    const Tensor g = dev->new_tensor_by_constant({2, 3}, 1);
+    Tensor m1 = dev->new_tensor_by_constant({2, 3}, 0);
+    Tensor m2 = dev->new_tensor_by_constant({3, 2}, 0);
+    Tensor x = dev->new_tensor_by_constant({2, 2}, 0);
+    EXPECT_THROW(dev->sgd_update(g, .1, x), Error);
+    EXPECT_THROW(dev->momentum_sgd_update(g, .1, .9, m1, x), Error);
+    EXPECT_THROW(dev->adagrad_update(g, .1, 1e-8, m2, m1), Error);
+    EXPECT_THROW(dev->rmsprop_update(g, .1, .9, 1e-8, m2, m1), Error);
+    EXPECT_THROW(dev->adadelta_update(g, .1, .95, 1e-6, m1, m2, m1), Error);
+    EXPECT_THROW(dev->adam_update(g, .1, .9, .999, 1e-8, 1, m1, m2, m1), Error);
+    EXPECT_THROW(dev->adam_update(g, .1, .9, .999, 1e-8, 0, m1, m1, m1), Error);
+  }
+}
+
+TEST_F(TensorTest, CheckSquaredNorm) {
+  for (Device *dev : devices) {
+    const Tensor x1 = dev->new_tensor_by_vector({2, 2}, {1, -2, 3, -4});
+    const Tensor x2 = dev->new_tensor_by_vector(Shape({3}, 2), {
+        .5, -.5, 1, 2, -2, 0,
+    });
+    const Tensor x3 = dev->new_tensor_by_constant({1000}, .5);
+    EXPECT_FLOAT_EQ(0, dev->squared_norm({}));
+    EXPECT_FLOAT_EQ(30, dev->squared_norm({&x1}));
+    EXPECT_FLOAT_EQ(39.5, dev->squared_norm({&x1, &x2}));
+    EXPECT_FLOAT_EQ(289.5, dev->squared_norm({&x1, &x2, &x3}));
+  }
+}
+
+TEST_F(TensorTest, CheckToArray) {
+  const vector<float> data {
+    3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8,
+    9, 7, 9, 3, 2, 3, 8, 4, 6, 2, 6, 4,
+  };
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_vector(Shape({2, 3}, 4), data);
+    for (Precision precision :
+        {Precision::FLOAT32, Precision::FLOAT16, Precision::BFLOAT16}) {
+      const Tensor y = dev->copy_tensor(x, precision);
+      for (std::uint32_t offset : {0u, 1u, 5u, 24u}) {
+        for (std::uint32_t size : {0u, 1u, 2u, 7u}) {
+          if (offset + size > data.size()) continue;
+          vector<float> values(size + 1, -1);
+          y.to_array(offset, size, values.data());
+          vector<float> expected(
+              data.begin() + offset, data.begin() + offset + size);
+          expected.emplace_back(-1);
+          EXPECT_TRUE(vector_match(expected, values));
+        }
+      }
+      float value;
+      EXPECT_THROW(y.to_array(24, 1, &value), Error);
+      EXPECT_THROW(y.to_array(25, 0, &value), Error);
+      EXPECT_THROW(y.to_array(1, 0xffffffffu, &value), Error);
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckToArrayInt8) {
+  vector<float> data(36);
+  for (std::uint32_t i = 0; i < data.size(); ++i) {
+    data[i] = (i % 7) * (i % 2 ? 1.5 : -.25);
+  }
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_vector(Shape({3, 4}, 3), data);
+    const Tensor y = dev->copy_tensor(x, Precision::INT8);
+    const vector<float> all = y.to_vector();
+    // Every range, including ranges across columns and minibatches.
+    for (std::uint32_t offset = 0; offset < data.size(); ++offset) {
+      for (std::uint32_t size = 0; offset + size <= data.size(); ++size) {
+        vector<float> values(size + 1, -1);
+        y.to_array(offset, size, values.data());
+        vector<float> expected(
+            all.begin() + offset, all.begin() + offset + size);
+        expected.emplace_back(-1);
+        EXPECT_TRUE(vector_match(expected, values));
+      }
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckHostData) {
+  const vector<float> data {1, 2, 3, 4, 5, 6};
+  for (Device *dev : devices) {
+    const std::uint32_t group
+      = static_cast<std::uint32_t>(dev->type())
+      & static_cast<std::uint32_t>(DeviceType::GROUP_FILTER);
+    Tensor x = dev->new_tensor_by_vector({2, 3}, data);
+    if (group != static_cast<std::uint32_t>(DeviceType::GROUP_CPU)) {
+      EXPECT_FALSE(x.has_host_data());
+      EXPECT_THROW(x.host_data(), Error);
+      EXPECT_THROW(x.mutable_host_data(), Error);
+      continue;
+    }
+    ASSERT_TRUE(x.has_host_data());
+    const float *ptr = x.host_data();
+    EXPECT_TRUE(vector_match(data, vector<float>(ptr, ptr + data.size())));
+
+    // Unshared memory is not duplicated.
+    float *mutable_ptr = x.mutable_host_data();
+    EXPECT_EQ(ptr, mutable_ptr);
+    mutable_ptr[0] = 42;
+    EXPECT_FLOAT_EQ(42, x.to_vector()[0]);
+
+    // Shared memory is duplicated.
+    const Tensor y = x;
+    EXPECT_EQ(ptr, y.host_data());
+    mutable_ptr = x.mutable_host_data();
+    EXPECT_NE(ptr, mutable_ptr);
+    mutable_ptr[1] = 43;
+    EXPECT_FLOAT_EQ(43, x.to_vector()[1]);
+    EXPECT_FLOAT_EQ(2, y.to_vector()[1]);
+
+    const Tensor z = dev->copy_tensor(x, Precision::FLOAT16);
+    EXPECT_FALSE(z.has_host_data());
+    EXPECT_THROW(z.host_data(), Error);
+  }
+  EXPECT_FALSE(Tensor().has_host_data());
+  EXPECT_THROW(Tensor().host_data(), Error);
+}
+
+TEST_F(TensorTest, CheckToDLPack) {
+  const vector<float> data {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  for (Device *dev : devices) {
+    Tensor x = dev->new_tensor_by_vector(Shape({2, 3}, 2), data);
+    if (!x.has_host_data()) {
+      EXPECT_THROW(x.to_dlpack(), Error);
+      continue;
+    }
+    dlpack::DLManagedTensor *dl = x.to_dlpack();
+    const dlpack::DLTensor &t = dl->dl_tensor;
+    EXPECT_EQ(x.host_data(), t.data);
+    EXPECT_EQ(dlpack::DEVICE_CPU, t.device.device_type);
+    EXPECT_EQ(dlpack::TYPE_FLOAT, t.dtype.code);
+    EXPECT_EQ(32u, t.dtype.bits);
+    EXPECT_EQ(1u, t.dtype.lanes);
+    EXPECT_EQ(0u, t.byte_offset);
+    ASSERT_EQ(3, t.ndim);
+    EXPECT_TRUE(vector_match(
+          vector<std::int64_t> {2, 3, 2},
+          vector<std::int64_t>(t.shape, t.shape + 3)));
+    EXPECT_TRUE(vector_match(
+          vector<std::int64_t> {1, 2, 6},
+          vector<std::int64_t>(t.strides, t.strides + 3)));
+
+    // The descriptor keeps the memory alive, and in-place operations on `x`
+    // do not affect it.
+    const float *ptr = static_cast<const float *>(t.data);
+    x.reset(0);
+    x.invalidate();
+    EXPECT_TRUE(vector_match(data, vector<float>(ptr, ptr + data.size())));
+    dl->deleter(dl);
+
+    const Tensor y = dev->new_tensor_by_constant({}, 42);
+    dl = y.to_dlpack();
+    EXPECT_EQ(0, dl->dl_tensor.ndim);
+    EXPECT_FLOAT_EQ(42, *static_cast<const float *>(dl->dl_tensor.data));
+    dl->deleter(dl);
+  }
+  EXPECT_THROW(Tensor().to_dlpack(), Error);
+}
+
+namespace {
+
+// Descriptor of an external array with the counter of deleter calls.
+struct ExternalTensor {
+  vector<float> data;
+  vector<std::int64_t> shape;
+  vector<std::int64_t> strides;
+  dlpack::DLManagedTensor managed;
+  std::uint32_t num_deleted;
+
+  ExternalTensor(
+      const vector<float> &data, const vector<std::int64_t> &shape,
+      const vector<std::int64_t> &strides)
+  : data(data), shape(shape), strides(strides), num_deleted(0) {
+    managed.dl_tensor.data = this->data.data();
+    managed.dl_tensor.device = { dlpack::DEVICE_CPU, 0 };
+    managed.dl_tensor.ndim = static_cast<std::int32_t>(shape.size());
+    managed.dl_tensor.dtype = { dlpack::TYPE_FLOAT, 32, 1 };
+    managed.dl_tensor.shape = this->shape.data();
+    managed.dl_tensor.strides
+      = strides.empty() ? nullptr : this->strides.data();
+    managed.dl_tensor.byte_offset = 0;
+    managed.manager_ctx = this;
+    managed.deleter = [](dlpack::DLManagedTensor *self) {
+      ++static_cast<ExternalTensor *>(self->manager_ctx)->num_deleted;
+    };
+  }
+};
+
+}  // namespace
+
+TEST_F(TensorTest, CheckNewTensorByDLPack) {
+  for (Device *dev : devices) {
+    const std::uint32_t group
+      = static_cast<std::uint32_t>(dev->type())
+      & static_cast<std::uint32_t>(DeviceType::GROUP_FILTER);
+    const bool on_host
+      = group == static_cast<std::uint32_t>(DeviceType::GROUP_CPU);
+    {
+      // Column-major values are shared.
+      ExternalTensor ext({1, 2, 3, 4, 5, 6}, {2, 3}, {1, 2});
+      {
+        const Tensor x = dev->new_tensor_by_dlpack(&ext.managed, false);
+        EXPECT_EQ(Shape({2, 3}), x.shape());
+        EXPECT_TRUE(vector_match(ext.data, x.to_vector()));
+        if (on_host) {
+          EXPECT_EQ(ext.data.data(), x.host_data());
+          EXPECT_EQ(0u, ext.num_deleted);
+        }
+      }
+      EXPECT_EQ(1u, ext.num_deleted);
+    }
+    {
+      // Row-major values are copied.
+      ExternalTensor ext({1, 2, 3, 4, 5, 6}, {2, 3}, {});
+      const Tensor x = dev->new_tensor_by_dlpack(&ext.managed, false);
+      EXPECT_EQ(1u, ext.num_deleted);
+      EXPECT_EQ(Shape({2, 3}), x.shape());
+      EXPECT_TRUE(vector_match(
+            vector<float> {1, 4, 2, 5, 3, 6}, x.to_vector()));
+    }
+    {
+      // Batched values with a byte offset.
+      ExternalTensor ext({0, 1, 2, 3, 4, 5, 6}, {3, 2}, {1, 3});
+      ext.managed.dl_tensor.byte_offset = sizeof(float);
+      const Tensor x = dev->new_tensor_by_dlpack(&ext.managed, true);
+      EXPECT_EQ(Shape({3}, 2), x.shape());
+      EXPECT_TRUE(vector_match(
+            vector<float> {1, 2, 3, 4, 5, 6}, x.to_vector()));
+    }
+    {
+      // Round trip.
+      const Tensor x = dev->new_tensor_by_vector(
+          Shape({2, 2}, 2), {1, 2, 3, 4, 5, 6, 7, 8});
+      if (on_host) {
+        const Tensor y = dev->new_tensor_by_dlpack(x.to_dlpack(), true);
+        EXPECT_EQ(x.shape(), y.shape());
+        EXPECT_EQ(x.host_data(), y.host_data());
+      }
+    }
+    {
+      // Errors.
+      ExternalTensor ext({1, 2, 3, 4, 5, 6}, {2, 3}, {1, 2});
+      ext.managed.dl_tensor.dtype.bits = 64;
+      EXPECT_THROW(dev->new_tensor_by_dlpack(&ext.managed, false), Error);
+      EXPECT_EQ(1u, ext.num_deleted);
+      ext.managed.dl_tensor.dtype.bits = 32;
+      ext.managed.dl_tensor.device.device_type = 2;
+      EXPECT_THROW(dev->new_tensor_by_dlpack(&ext.managed, false), Error);
+      EXPECT_EQ(2u, ext.num_deleted);
+      ext.managed.dl_tensor.device.device_type = dlpack::DEVICE_CPU;
+      ext.managed.dl_tensor.ndim = 0;
+      EXPECT_THROW(dev->new_tensor_by_dlpack(&ext.managed, true), Error);
+      EXPECT_EQ(3u, ext.num_deleted);
+      ext.managed.dl_tensor.ndim = 2;
+      ext.shape[0] = 0;
+      EXPECT_THROW(dev->new_tensor_by_dlpack(&ext.managed, false), Error);
+      EXPECT_EQ(4u, ext.num_deleted);
+    }
+    EXPECT_THROW(dev->new_tensor_by_dlpack(nullptr, false), Error);
+  }
+}
+
+TEST_F(TensorTest, CheckCopyTensorWithPrecision) {
+  const vector<float> data {1, -2.5, 3.25, 65504, -.125, 1e-3};
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_vector({2, 3}, data);
+    EXPECT_EQ(Precision::FLOAT32, x.precision());
+    for (Precision precision : {Precision::FLOAT16, Precision::BFLOAT16}) {
+      const Tensor y = dev->copy_tensor(x, precision);
+      EXPECT_EQ(Precision::FLOAT32, x.precision());
+      EXPECT_EQ(precision, y.precision());
+      EXPECT_EQ(Shape({2, 3}), y.shape());
+      const vector<float> y_val = y.to_vector();
+      ASSERT_EQ(data.size(), y_val.size());
+      for (std::uint32_t i = 0; i < data.size(); ++i) {
+        EXPECT_NEAR(data[i], y_val[i], std::abs(data[i]) / 128);
+      }
+      EXPECT_EQ(1, y_val[0]);
+      EXPECT_EQ(-2.5, y_val[1]);
+      EXPECT_EQ(3.25, y_val[2]);
+
+      // Copies keep the precision.
+      const Tensor y2 = dev->copy_tensor(y);
+      EXPECT_EQ(precision, y2.precision());
+      EXPECT_TRUE(vector_match(y_val, y2.to_vector()));
+      const Tensor y3 = y.reshape({3, 2});
+      EXPECT_EQ(precision, y3.precision());
+      EXPECT_TRUE(vector_match(y_val, y3.to_vector()));
+
+      const Tensor z = dev->copy_tensor(y, Precision::FLOAT32);
+      EXPECT_EQ(Precision::FLOAT32, z.precision());
+      EXPECT_TRUE(vector_match(y_val, z.to_vector()));
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckPackedOperations) {
+  const vector<float> a_data {1, -2, 3, .5, -1.5, 4};
+  const vector<float> b_data {2, 1, -1, .25, 3, -2};
+  for (Device *dev : devices) {
+    if (dev->type() != DeviceType::NAIVE && dev->type() != DeviceType::EIGEN) {
+      // Only CPU devices have kernels for packed values.
+      continue;
+    }
+    const Tensor a = dev->new_tensor_by_vector({2, 3}, a_data);
+    const Tensor b = dev->new_tensor_by_vector({3, 2}, b_data);
+    const Tensor bt = dev->new_tensor_by_vector(Shape({2, 3}, 2), {
+        2, 1, -1, .25, 3, -2, -2, 3, .25, -1, 1, 2});
+    for (Precision precision : {Precision::FLOAT16, Precision::BFLOAT16}) {
+      const Tensor pa = dev->copy_tensor(a, precision);
+      const Tensor pb = dev->copy_tensor(b, precision);
+      const Tensor pbt = dev->copy_tensor(bt, precision);
+
+      const vector<float> ab = dev->matmul_fw(a, b).to_vector();
+      EXPECT_TRUE(vector_match(ab, dev->matmul_fw(pa, b).to_vector()));
+      EXPECT_TRUE(vector_match(ab, dev->matmul_fw(a, pb).to_vector()));
+      const Tensor y = dev->matmul_fw(pa, pb);
+      EXPECT_EQ(Precision::FLOAT32, y.precision());
+      EXPECT_TRUE(vector_match(ab, y.to_vector()));
+
+      const vector<float> exp_a = dev->exp_fw(a).to_vector();
+      EXPECT_TRUE(vector_match(exp_a, dev->exp_fw(pa).to_vector()));
+      EXPECT_TRUE(vector_match(
+            dev->multiply_const_fw(a, 3).to_vector(),
+            dev->multiply_const_fw(pa, 3).to_vector()));
+      EXPECT_TRUE(vector_match(
+            dev->add_fw(a, bt).to_vector(),
+            dev->add_fw(pa, pbt).to_vector()));
+      EXPECT_TRUE(vector_match(
+            dev->subtract_fw(bt, a).to_vector(),
+            dev->subtract_fw(pbt, a).to_vector()));
+
+      const vector<std::uint32_t> ids {2, 0};
+      EXPECT_TRUE(vector_match(
+            dev->pick_fw(bt, ids, 1).to_vector(),
+            dev->pick_fw(pbt, ids, 1).to_vector()));
+      EXPECT_TRUE(vector_match(
+            dev->pick_fw(a, {1}, 0).to_vector(),
+            dev->pick_fw(pa, {1}, 0).to_vector()));
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckInt8MatmulAccuracy) {
+  std::mt19937 rng(12345);
+  std::normal_distribution<float> dist(0, 1);
+  const auto make_data = [&](std::uint32_t n) {
+    vector<float> data(n);
+    for (float &x : data) x = dist(rng);
+    return data;
+  };
+  const auto relative_error = [](
+      const vector<float> &expected, const vector<float> &actual) {
+    float num = 0, den = 0;
+    for (std::uint32_t i = 0; i < expected.size(); ++i) {
+      num += (expected[i] - actual[i]) * (expected[i] - actual[i]);
+      den += expected[i] * expected[i];
+    }
+    return std::sqrt(num / den);
+  };
+  const vector<float> a_data = make_data(2 * 32 * 64);
+  const vector<float> b_data = make_data(2 * 64 * 5);
+  for (Device *dev : devices) {
+    if (dev->type() != DeviceType::NAIVE && dev->type() != DeviceType::EIGEN) {
+      continue;
+    }
+    const Tensor a = dev->new_tensor_by_vector(
+        {32, 64}, vector<float>(a_data.begin(), a_data.begin() + 32 * 64));
+    const Tensor ab = dev->new_tensor_by_vector(Shape({32, 64}, 2), a_data);
+    const Tensor b = dev->new_tensor_by_vector(
+        {64, 5}, vector<float>(b_data.begin(), b_data.begin() + 64 * 5));
+    const Tensor bb = dev->new_tensor_by_vector(Shape({64, 5}, 2), b_data);
+    const Tensor qa = dev->copy_tensor(a, Precision::INT8);
+    const Tensor qab = dev->copy_tensor(ab, Precision::INT8);
+    EXPECT_EQ(Precision::INT8, qa.precision());
+    EXPECT_LT(relative_error(a.to_vector(), qa.to_vector()), .01);
+
+    const vector<std::pair<const Tensor *, const Tensor *>> cases {
+      {&a, &b}, {&a, &bb}, {&ab, &b}, {&ab, &bb},
+    };
+    const vector<const Tensor *> quantized {&qa, &qa, &qab, &qab};
+    for (std::uint32_t i = 0; i < cases.size(); ++i) {
+      const Tensor expected = dev->matmul_fw(
+          *cases[i].first, *cases[i].second);
+      const Tensor actual = dev->matmul_fw(*quantized[i], *cases[i].second);
+      EXPECT_EQ(Precision::FLOAT32, actual.precision());
+      EXPECT_EQ(expected.shape(), actual.shape());
+      EXPECT_LT(relative_error(expected.to_vector(), actual.to_vector()), .02);
+    }
+
+    // Zero rows and columns.
+    const Tensor z = dev->new_tensor_by_vector({2, 2}, {0, 1, 0, -1});
+    const Tensor qz = dev->copy_tensor(z, Precision::INT8);
+    const Tensor x = dev->new_tensor_by_vector({2, 2}, {0, 0, 2, 3});
+    EXPECT_TRUE(vector_near(
+          vector<float> {0, 0, 0, -1}, dev->matmul_fw(qz, x).to_vector(),
+          .02));
+
+    // Sizes which are not multiples of the block sizes.
+    const Tensor c = dev->new_tensor_by_vector(
+        {37, 19}, vector<float>(a_data.begin(), a_data.begin() + 37 * 19));
+    const Tensor d = dev->new_tensor_by_vector(
+        {19, 6}, vector<float>(b_data.begin(), b_data.begin() + 19 * 6));
+    EXPECT_LT(
+        relative_error(
+          dev->matmul_fw(c, d).to_vector(),
+          dev->matmul_fw(dev->copy_tensor(c, Precision::INT8), d).to_vector()),
+        .02);
+
+    // The int8 path requires single precision operands on the right side.
+    EXPECT_THROW(
+        dev->matmul_fw(qa, dev->copy_tensor(b, Precision::INT8)), Error);
+    EXPECT_THROW(dev->matmul_fw(b.flatten(), qa), Error);
+  }
+}
+
+TEST_F(TensorTest, CheckInvalidPackedOperations) {
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_constant({2, 3}, 1);
+    for (Precision precision : {Precision::FLOAT16, Precision::BFLOAT16}) {
+      Tensor px = dev->copy_tensor(x, precision);
+      EXPECT_THROW(dev->sum_fw(px, 0), Error);
+      EXPECT_THROW(dev->new_view(px, 0, {2}), Error);
+      EXPECT_THROW(px.reset(0), Error);
+      EXPECT_THROW(px.inplace_add(x), Error);
+      EXPECT_THROW(dev->copy_tensor(x, static_cast<Precision>(4)), Error);
+    }
+  }
+}
+
+TEST_F(TensorTest, CheckNewView) {
+  for (Device *dev : devices) {
+    try {
+      Tensor x = dev->new_tensor_by_vector({2, 3}, {1, 2, 3, 4, 5, 6});
+      Tensor v1 = dev->new_view(x, 0, {2});
+      Tensor v2 = dev->new_view(x, 2, Shape({2}, 2));
+      EXPECT_EQ(Shape({2}), v1.shape());
+      EXPECT_EQ(Shape({2}, 2), v2.shape());
+      EXPECT_TRUE(vector_match(vector<float> {1, 2}, v1.to_vector()));
+      EXPECT_TRUE(vector_match(vector<float> {3, 4, 5, 6}, v2.to_vector()));
+      EXPECT_TRUE(dev->is_view(v1, x, 0));
+      EXPECT_TRUE(dev->is_view(v2, x, 2));
+      EXPECT_FALSE(dev->is_view(v2, x, 0));
+
+      // In-place operations on views modify the source.
+      v1 += dev->new_tensor_by_constant({2}, 10);
+      v2.reset(0);
+      EXPECT_TRUE(vector_match(
+            vector<float> {11, 12, 0, 0, 0, 0}, x.to_vector()));
+
+      // Views keep the memory alive.
+      x = Tensor();
+      EXPECT_TRUE(vector_match(vector<float> {11, 12}, v1.to_vector()));
+
+      // In-place operations on copies of views detach the copy.
+      Tensor copied = v1;
+      copied.reset(1);
+      EXPECT_TRUE(vector_match(vector<float> {11, 12}, v1.to_vector()));
+      EXPECT_TRUE(vector_match(vector<float> {1, 1}, copied.to_vector()));
+    } IGNORE_NOT_IMPLEMENTED
+  }
+}
+
+TEST_F(TensorTest, CheckNewSharedView) {
+  for (Device *dev : devices) {
+    try {
+      Tensor x = dev->new_tensor_by_vector({2, 3}, {1, 2, 3, 4, 5, 6});
+      Tensor v = dev->new_shared_view(x, 2, Shape({2}, 2));
+      EXPECT_EQ(Shape({2}, 2), v.shape());
+      EXPECT_TRUE(vector_match(vector<float> {3, 4, 5, 6}, v.to_vector()));
+      EXPECT_TRUE(dev->is_view(v, x, 2));
+
+      // In-place operations on the view do not modify the source.
+      v.reset(0);
+      EXPECT_FALSE(dev->is_view(v, x, 2));
+      EXPECT_TRUE(vector_match(vector<float> {0, 0, 0, 0}, v.to_vector()));
+      EXPECT_TRUE(vector_match(
+            vector<float> {1, 2, 3, 4, 5, 6}, x.to_vector()));
+
+      // In-place operations on the source do not modify the view.
+      v = dev->new_shared_view(x, 0, {2});
+      x.reset(0);
+      EXPECT_TRUE(vector_match(vector<float> {1, 2}, v.to_vector()));
+
+      // The view keeps the memory alive.
+      x = dev->new_tensor_by_vector({2, 3}, {1, 2, 3, 4, 5, 6});
+      v = dev->new_shared_view(x, 2, {2});
+      x = Tensor();
+      EXPECT_TRUE(vector_match(vector<float> {3, 4}, v.to_vector()));
+      v += dev->new_tensor_by_constant({2}, 10);
+      EXPECT_TRUE(vector_match(vector<float> {13, 14}, v.to_vector()));
+    } IGNORE_NOT_IMPLEMENTED
+  }
+}
+
+TEST_F(TensorTest, CheckInvalidNewView) {
+  for (Device *dev : devices) {
+    const Tensor x = dev->new_tensor_by_constant({2, 3}, 0);
+    EXPECT_THROW(dev->new_view(x, 0, {7}), Error);
+    EXPECT_THROW(dev->new_view(x, 5, {2}), Error);
+    EXPECT_THROW(dev->new_view(Tensor(), 0, {}), Error);
+    EXPECT_THROW(dev->new_shared_view(x, 0, {7}), Error);
+    EXPECT_THROW(dev->new_shared_view(x, 5, {2}), Error);
+    EXPECT_THROW(dev->new_shared_view(Tensor(), 0, {}), Error);
+  }
+}
+
 }  // namespace primitiv